@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+Benchmark the startup of a FunctionDatabase from its cache.
+
+Builds the cache of a corpus once (or reuses --cache-dir), then loads it
+in a fresh database and times the phases a --search or call tree query
+goes through: mapping the cache, validating the source files, the first
+lookup_function() and search_functions().
+
+Usage:
+    python scripts/generate_large_demo.py
+    python scripts/benchmark_cache_startup.py [corpus_dir] [--cache-dir DIR]
+"""
+
+import argparse
+import contextlib
+import io
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+
+from autosar_calltree.database.function_database import FunctionDatabase
+
+
+def timed(label: str, action):
+    """Run action() and print its duration."""
+    start = time.perf_counter()
+    result = action()
+    print(f"  {label:<22} {(time.perf_counter() - start) * 1000:9.1f} ms")
+    return result
+
+
+def main() -> int:
+    """Run the benchmark."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("corpus_dir", nargs="?", default="demo/large_scale")
+    arg_parser.add_argument("--cache-dir", help="Reuse (or create) this cache")
+    arg_parser.add_argument("--search", default="Init", help="Search pattern")
+    args = arg_parser.parse_args()
+
+    corpus_dir = Path(args.corpus_dir)
+    if not any(corpus_dir.rglob("*.c")):
+        print(f"No .c files in {corpus_dir}, run scripts/generate_large_demo.py first")
+        return 1
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        cache_dir = args.cache_dir or temp_dir
+        db = FunctionDatabase(str(corpus_dir), cache_dir=cache_dir)
+        if not db.cache_file.exists():
+            print("Building cache...")
+            with contextlib.redirect_stdout(io.StringIO()):
+                db.build_database(use_cache=False)
+                db._save_to_cache()
+
+        db = FunctionDatabase(str(corpus_dir), cache_dir=cache_dir)
+        validate = db._validate_file_entries
+        validation = []
+
+        def timed_validate(*validate_args):
+            start = time.perf_counter()
+            result = validate(*validate_args)
+            validation.append(time.perf_counter() - start)
+            return result
+
+        db._validate_file_entries = timed_validate  # type: ignore[assignment]
+        if not timed("load from cache", lambda: db._load_from_cache()):
+            print("Cache could not be loaded")
+            return 1
+        print(f"    {'file validation':<20} {validation[0] * 1000:9.1f} ms")
+
+        name = next(iter(db.functions))
+        matches = timed("lookup_function", lambda: db.lookup_function(name))
+        results = timed("search_functions", lambda: db.search_functions(args.search))
+        timed("call graph", db.get_call_graph)
+
+    print(f"  {'functions':<22} {db.total_functions_found:9d}")
+    print(f"  {'lookup matches':<22} {len(matches):9d}")
+    print(f"  {'search results':<22} {len(results):9d}")
+    print(f"  {'materialized':<22} {len(db.store._objects):9d}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
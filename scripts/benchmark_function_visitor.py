@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""
+Benchmark the call walk of FunctionVisitor on large function bodies.
+
+Generates translation units with a few very large functions (statements,
+nested if/else, loops, switches, calls with call arguments), parses them
+once with pycparser and times the extraction of the calls of every
+function by FunctionVisitor against the generic NodeVisitor walk it
+replaced (kept below as the legacy baseline), and against that walk
+descending into call arguments too, which finds the same calls as
+FunctionVisitor. Also times the walk of a translation unit with many
+declarations, like cpp output with its headers, and reports an else-if
+chain that is too deep for the recursive baseline.
+
+Usage:
+    python scripts/benchmark_function_visitor.py [--functions N]
+        [--statements N] [--declarations N] [--repeat N] [--chain-length N]
+"""
+
+import argparse
+import random
+import sys
+import time
+from pathlib import Path
+from typing import Callable, List, Set
+
+sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+
+from pycparser import c_ast, c_parser
+
+from autosar_calltree.parsers.function_visitor import FunctionVisitor
+
+
+class LegacyCallVisitor(c_ast.NodeVisitor):
+    """Call walk of FunctionVisitor before the single-pass walker."""
+
+    def __init__(self) -> None:
+        self.calls: List[str] = []
+        self.seen: Set[str] = set()
+
+    def visit_FuncCall(self, call_node: c_ast.FuncCall) -> None:
+        if isinstance(call_node.name, c_ast.IdentifierType):
+            func_name = call_node.name.names[0]
+        elif isinstance(call_node.name, c_ast.ID):
+            func_name = call_node.name.name
+        else:
+            return
+        if (
+            func_name in FunctionVisitor.C_KEYWORDS
+            or func_name in FunctionVisitor.AUTOSAR_TYPES
+            or func_name in FunctionVisitor.AUTOSAR_MACROS
+        ):
+            return
+        if func_name not in self.seen:
+            self.seen.add(func_name)
+            self.calls.append(func_name)
+
+
+class LegacyArgumentsCallVisitor(LegacyCallVisitor):
+    """Legacy call walk that also visits the arguments of calls."""
+
+    def visit_FuncCall(self, call_node: c_ast.FuncCall) -> None:
+        super().visit_FuncCall(call_node)
+        self.generic_visit(call_node)
+
+
+class LegacyFileVisitor(c_ast.NodeVisitor):
+    """Legacy walk of a translation unit: every node of every declaration."""
+
+    def __init__(self) -> None:
+        self.calls: List[List[str]] = []
+
+    def visit_FuncDef(self, node: c_ast.FuncDef) -> None:
+        call_visitor = LegacyCallVisitor()
+        call_visitor.visit(node)
+        self.calls.append(call_visitor.calls)
+
+
+def generate_function(name: str, statements: int, rng: random.Random) -> str:
+    """Generate a function with the given number of statements."""
+    lines = [f"int {name}(int x, int *p)", "{", "    int i;"]
+    for index in range(statements):
+        callee = f"f{rng.randrange(statements // 4 + 1)}"
+        kind = index % 5
+        if kind == 0:
+            lines.append(f"    x = x + {callee}(x, p[{index % 7}]);")
+        elif kind == 1:
+            lines.append(
+                f"    if (x > {index}) {{ {callee}(x); }} "
+                f"else if (p[0]) {{ g{index % 13}(); }} else {{ x--; }}"
+            )
+        elif kind == 2:
+            lines.append(
+                f"    for (i = 0; i < {index}; i++) {{ p[i] = {callee}(i) * 2; }}"
+            )
+        elif kind == 3:
+            lines.append(
+                f"    switch (x) {{ case {index}: {callee}(); break; "
+                "default: x = 0; break; }"
+            )
+        else:
+            lines.append(f"    while (x < {index}) {{ x = {callee}(x) ? x + 1 : x; }}")
+    lines.extend(["    return x;", "}", ""])
+    return "\n".join(lines)
+
+
+def generate_declarations(count: int) -> str:
+    """Generate header-like declarations followed by two small functions."""
+    lines = []
+    for index in range(count):
+        lines.append(
+            f"typedef struct {{ int a{index}; unsigned char b[{index % 8 + 1}]; }} "
+            f"T{index};"
+        )
+        lines.append(f"extern int proto{index}(const T{index} *value, int n);")
+        lines.append(f"static const int table{index}[3] = {{ 1, {index}, 3 }};")
+    lines.append("int first(int x) { return proto0(0, x); }")
+    lines.append("int second(int x) { return first(x) + proto1(0, x); }")
+    return "\n".join(lines) + "\n"
+
+
+def generate_chain(length: int) -> str:
+    """Generate a function with an else-if chain of the given length."""
+    branches = " else ".join(f"if (x == {i}) {{ c{i}(); }}" for i in range(length))
+    return f"void chain(int x)\n{{\n    {branches}\n}}\n"
+
+
+def best_time(action: Callable[[], object], repeat: int) -> float:
+    """Get the best wall time of action() over repeat runs."""
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        action()
+        best = min(best, time.perf_counter() - start)
+    return best
+
+
+def main() -> int:
+    """Run the benchmark."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("--functions", type=int, default=5)
+    arg_parser.add_argument("--statements", type=int, default=4000)
+    arg_parser.add_argument("--declarations", type=int, default=5000)
+    arg_parser.add_argument("--repeat", type=int, default=5)
+    arg_parser.add_argument("--chain-length", type=int, default=1500)
+    args = arg_parser.parse_args()
+
+    rng = random.Random(42)
+    source = "".join(
+        generate_function(f"Func{i}", args.statements, rng)
+        for i in range(args.functions)
+    )
+    start = time.perf_counter()
+    ast = c_parser.CParser().parse(source, filename="<benchmark>")
+    print(
+        f"{args.functions} functions x {args.statements} statements "
+        f"({len(source) / 1e6:.1f} MB), pycparser: {time.perf_counter() - start:.2f}s"
+    )
+    functions = [ext for ext in ast.ext if isinstance(ext, c_ast.FuncDef)]
+    visitor = FunctionVisitor(Path("<benchmark>"), source)
+
+    def legacy(visitor_class: type = LegacyCallVisitor) -> List[List[str]]:
+        results = []
+        for function in functions:
+            call_visitor = visitor_class()
+            call_visitor.visit(function)
+            results.append(call_visitor.calls)
+        return results
+
+    def walker() -> List[List[str]]:
+        return [
+            [call.name for call in visitor._extract_function_calls(function)]
+            for function in functions
+        ]
+
+    if legacy(LegacyArgumentsCallVisitor) != walker():
+        print("ERROR: the walker and the legacy visitor find different calls")
+        return 1
+
+    legacy_time = best_time(legacy, args.repeat)
+    arguments_time = best_time(
+        lambda: legacy(LegacyArgumentsCallVisitor), args.repeat
+    )
+    walker_time = best_time(walker, args.repeat)
+    print(f"  legacy NodeVisitor               {legacy_time:8.3f}s")
+    print(f"  legacy, with call arguments      {arguments_time:8.3f}s")
+    print(
+        f"  single-pass walker               {walker_time:8.3f}s "
+        f"({arguments_time / walker_time:.2f}x, with call contexts)"
+    )
+
+    declarations_source = generate_declarations(args.declarations)
+    declarations_ast = c_parser.CParser().parse(declarations_source)
+    declarations_visitor = FunctionVisitor(Path("<declarations>"), "")
+
+    def walk_declarations() -> None:
+        declarations_visitor.functions = []
+        declarations_visitor.visit(declarations_ast)
+
+    legacy_time = best_time(
+        lambda: LegacyFileVisitor().visit(declarations_ast), args.repeat
+    )
+    walker_time = best_time(walk_declarations, args.repeat)
+    print(f"{args.declarations * 3} declarations and 2 functions")
+    print(f"  legacy NodeVisitor               {legacy_time:8.3f}s")
+    print(
+        f"  FunctionVisitor                  {walker_time:8.3f}s "
+        f"({legacy_time / walker_time:.2f}x, with return types and parameters)"
+    )
+
+    chain_source = generate_chain(args.chain_length)
+    chain_function = c_parser.CParser().parse(chain_source).ext[0]
+    try:
+        LegacyCallVisitor().visit(chain_function)
+        legacy_result = "ok"
+    except RecursionError:
+        legacy_result = "RecursionError"
+    calls = FunctionVisitor(Path("<chain>"), chain_source)._extract_function_calls(
+        chain_function
+    )
+    print(
+        f"else-if chain of {args.chain_length}: legacy {legacy_result}, "
+        f"walker {len(calls)} calls"
+    )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
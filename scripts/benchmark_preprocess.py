@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+Micro-benchmark for CParser._preprocess_content().
+
+Compares the single-pass AUTOSAR macro lowering with the previous chain of
+full-text re.sub passes on the corpus of scripts/generate_large_demo.py.
+
+Usage:
+    python scripts/generate_large_demo.py
+    python scripts/benchmark_preprocess.py [corpus_dir] [--repeat N]
+"""
+
+import argparse
+import re
+import sys
+import time
+from pathlib import Path
+from typing import Callable, List
+
+sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+
+from autosar_calltree.parsers.c_parser import AUTOSAR_TYPEDEFS, CParser
+
+
+def legacy_preprocess(parser: CParser, content: str) -> str:
+    """Previous implementation: comment removal plus one re.sub per macro form."""
+    preprocessed = parser._remove_comments(content)
+    preprocessed = AUTOSAR_TYPEDEFS + preprocessed
+    preprocessed = re.sub(
+        r"FUNC\s*\(\s*([^,]+)\s*,\s*[^)]+\)\s*", r"\1 ", preprocessed
+    )
+    preprocessed = re.sub(
+        r"FUNC_P2\w+\s*\(\s*([^,]+)\s*,\s*[^,]+,\s*[^)]+\)\s*", r"\1* ", preprocessed
+    )
+    preprocessed = re.sub(r"VAR\s*\(\s*([^,]+)\s*,\s*[^)]+\)", r"\1", preprocessed)
+    preprocessed = re.sub(
+        r"P2VAR\s*\(\s*([^,]+)\s*,\s*[^,]+,\s*[^)]+\)", r"\1*", preprocessed
+    )
+    preprocessed = re.sub(
+        r"P2CONST\s*\(\s*([^,]+)\s*,\s*[^,]+,\s*[^)]+\)", r"const \1*", preprocessed
+    )
+    preprocessed = re.sub(
+        r"CONST\s*\(\s*([^,]+)\s*,\s*[^)]+\)", r"const \1", preprocessed
+    )
+    preprocessed = re.sub(
+        r"^#\s*(pragma|line|error|warning).*$", "", preprocessed, flags=re.MULTILINE
+    )
+    return preprocessed
+
+
+def time_variant(
+    name: str, preprocess: Callable[[str], str], contents: List[str], repeat: int
+) -> float:
+    """Run one variant over the corpus and print the best time."""
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        for content in contents:
+            preprocess(content)
+        best = min(best, time.perf_counter() - start)
+    print(f"  {name:<12} {best * 1000:9.1f} ms")
+    return best
+
+
+def main() -> int:
+    """Run the benchmark."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("corpus_dir", nargs="?", default="demo/large_scale")
+    arg_parser.add_argument("--repeat", type=int, default=5)
+    args = arg_parser.parse_args()
+
+    corpus_dir = Path(args.corpus_dir)
+    files = sorted(corpus_dir.rglob("*.c"))
+    if not files:
+        print(f"No .c files in {corpus_dir}, run scripts/generate_large_demo.py first")
+        return 1
+
+    contents = [f.read_text(encoding="utf-8", errors="ignore") for f in files]
+    # Concatenated corpus approximates one large preprocessed .i file
+    contents.append("\n".join(contents))
+    total_mb = sum(len(c) for c in contents) / (1024 * 1024)
+    print(f"Corpus: {len(files)} files + concatenation, {total_mb:.1f} MB")
+
+    parser = CParser()
+    legacy = time_variant(
+        "re.sub chain",
+        lambda c: legacy_preprocess(parser, c),
+        contents,
+        args.repeat,
+    )
+    single = time_variant(
+        "single pass", parser._preprocess_content, contents, args.repeat
+    )
+    print(f"  speedup      {legacy / single:9.2f}x")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
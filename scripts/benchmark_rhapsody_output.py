@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+Benchmark RhapsodyXmiGenerator.generate() on very large call trees.
+
+Builds two synthetic trees and writes their XMI documents with random and
+with deterministic element IDs, printing the time, the peak Python memory
+(tracemalloc; allocations inside libxml2 are not traced) and the file
+size: a wide tree whose levels share their children lists like the shared
+subtrees of CallTreeBuilder, and a single call chain deeper than the
+recursion limit.
+
+Usage:
+    python scripts/benchmark_rhapsody_output.py [--fan-out N] [--depth N]
+                                                [--chain-length N]
+"""
+
+import argparse
+import sys
+import tempfile
+import time
+import tracemalloc
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+
+from autosar_calltree.database.models import (
+    AnalysisResult,
+    AnalysisStatistics,
+    CallTreeNode,
+    FunctionInfo,
+    Parameter,
+)
+from autosar_calltree.generators.rhapsody_generator import RhapsodyXmiGenerator
+
+
+def make_function(name: str) -> FunctionInfo:
+    """Create a function with one parameter."""
+    return FunctionInfo(
+        name=name,
+        return_type="void",
+        file_path=Path(f"{name.split('_')[0]}.c"),
+        line_number=1,
+        is_static=False,
+        parameters=[Parameter(name="value", param_type="uint8")],
+    )
+
+
+def wide_tree(fan_out: int, depth: int) -> CallTreeNode:
+    """Create a tree in which every level shares one children list."""
+    children: list = []
+    for level in range(depth, 0, -1):
+        children = [
+            CallTreeNode(make_function(f"L{level}_{i}"), level, children)
+            for i in range(fan_out)
+        ]
+    return CallTreeNode(make_function("Root"), 0, children)
+
+
+def chain(length: int) -> CallTreeNode:
+    """Create a single call chain."""
+    node = CallTreeNode(make_function(f"C{length}"), length)
+    for depth in range(length - 1, -1, -1):
+        node = CallTreeNode(make_function(f"C{depth}"), depth, [node])
+    return node
+
+
+def measure(
+    label: str, root: CallTreeNode, output_dir: Path, deterministic_ids: bool
+) -> None:
+    """Generate one document and print its costs."""
+    result = AnalysisResult(
+        root_function=root.function_info.name,
+        call_tree=root,
+        statistics=AnalysisStatistics(),
+    )
+    output_path = output_dir / f"{label}.xmi"
+    generator = RhapsodyXmiGenerator(deterministic_ids=deterministic_ids)
+    label = f"{label}{' deterministic' if deterministic_ids else ''}"
+    tracemalloc.start()
+    start = time.perf_counter()
+    try:
+        generator.generate(result, str(output_path))
+    except RecursionError:
+        print(f"  {label:<42} RecursionError")
+        return
+    finally:
+        elapsed = time.perf_counter() - start
+        peak = tracemalloc.get_traced_memory()[1]
+        tracemalloc.stop()
+    print(
+        f"  {label:<42} {elapsed:7.2f}s {peak / 1e6:9.1f} MB "
+        f"{output_path.stat().st_size / 1e6:9.1f} MB"
+    )
+
+
+def main() -> int:
+    """Run the benchmark."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("--fan-out", type=int, default=8)
+    arg_parser.add_argument("--depth", type=int, default=5)
+    arg_parser.add_argument("--chain-length", type=int, default=5000)
+    args = arg_parser.parse_args()
+
+    nodes = sum(args.fan_out**level for level in range(args.depth + 1))
+    trees = [
+        (f"wide ({nodes} nodes)", wide_tree(args.fan_out, args.depth)),
+        (f"chain ({args.chain_length} deep)", chain(args.chain_length)),
+    ]
+    print(f"  {'tree':<42} {'time':>8} {'peak':>12} {'file':>12}")
+    with tempfile.TemporaryDirectory() as temp_dir:
+        for label, root in trees:
+            for deterministic_ids in (False, True):
+                measure(label, root, Path(temp_dir), deterministic_ids)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,308 @@
+#!/usr/bin/env python3
+"""
+Scalability benchmark suite on corpora of scripts/generate_large_demo.py.
+
+Generates a corpus for every size and times each stage of the tool on it
+separately: cpp preprocessing, parsing, indexing with _add_function(), the
+call graph and name search index, cache save and load, build_tree() of
+several roots at every depth, and Mermaid and XMI generation of the
+deepest trees. Every phase reports its wall time and peak Python memory
+(tracemalloc; cpp subprocesses and allocations inside C extensions are not
+traced, and tracing slows the phases down, see --no-trace-memory).
+
+The results are written as JSON, with the commit, so runs of different
+commits can be compared with --baseline.
+
+Usage:
+    python scripts/benchmark_scalability.py [--sizes 1000,10000,50000]
+        [--fan-out N] [--static-collisions R] [--depths 3,6,10] [--roots N]
+        [--jobs N] [--no-preprocess] [--no-trace-memory]
+        [--output FILE] [--baseline FILE] [--max-slowdown FACTOR]
+"""
+
+import argparse
+import contextlib
+import json
+import os
+import platform
+import subprocess
+import sys
+import tempfile
+import time
+import tracemalloc
+from datetime import datetime
+from pathlib import Path
+from typing import Any, Callable, Dict, List, Optional, TypeVar
+
+sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+sys.path.insert(0, str(Path(__file__).parent))
+
+from generate_large_demo import generate_corpus
+
+from autosar_calltree.analyzers.call_tree_builder import CallTreeBuilder
+from autosar_calltree.config import PreprocessorConfig
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.generators.mermaid_generator import MermaidGenerator
+from autosar_calltree.generators.rhapsody_generator import RhapsodyXmiGenerator
+from autosar_calltree.parsers.c_parser import CParser
+from autosar_calltree.preprocessing.cpp_preprocessor import CPPPreprocessor
+
+# Increment when the layout of the results file changes
+RESULTS_VERSION = 1
+
+T = TypeVar("T")
+
+
+def int_list(value: str) -> List[int]:
+    """Parse a comma-separated list of integers."""
+    return [int(item) for item in value.split(",") if item.strip()]
+
+
+def git_commit() -> Optional[str]:
+    """Get the commit of the working tree, or None outside of git."""
+    try:
+        result = subprocess.run(
+            ["git", "rev-parse", "--short", "HEAD"],
+            cwd=Path(__file__).parent,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.DEVNULL,
+            universal_newlines=True,
+        )
+    except OSError:
+        return None
+    return result.stdout.strip() or None
+
+
+class PhaseTimer:
+    """Runs the phases of one corpus and records their costs."""
+
+    def __init__(self, trace_memory: bool):
+        self.trace_memory = trace_memory
+        self.phases: Dict[str, Dict[str, Any]] = {}
+
+    def run(self, name: str, action: Callable[[], T]) -> T:
+        """Run action() with its output discarded and record the phase."""
+        if self.trace_memory:
+            tracemalloc.start()
+        start = time.perf_counter()
+        try:
+            with open(os.devnull, "w") as devnull:
+                with contextlib.redirect_stdout(devnull):
+                    result = action()
+        finally:
+            elapsed = time.perf_counter() - start
+            peak = None
+            if self.trace_memory:
+                peak = tracemalloc.get_traced_memory()[1] / 1e6
+                tracemalloc.stop()
+        self.phases[name] = {
+            "seconds": round(elapsed, 4),
+            "peak_mb": None if peak is None else round(peak, 2),
+        }
+        peak_text = "-" if peak is None else f"{peak:.1f}"
+        print(f"  {name:<22} {elapsed:9.2f}s {peak_text:>10} MB")
+        return result
+
+
+def benchmark_corpus(size: int, args: argparse.Namespace, work_dir: Path) -> dict:
+    """Generate one corpus and run all phases on it."""
+    timer = PhaseTimer(args.trace_memory)
+    corpus_dir = work_dir / f"corpus_{size}"
+    cache_dir = work_dir / f"cache_{size}"
+    output_dir = work_dir / f"output_{size}"
+    output_dir.mkdir(parents=True, exist_ok=True)
+
+    functions = timer.run(
+        "generate",
+        lambda: generate_corpus(
+            corpus_dir,
+            size,
+            fan_out=args.fan_out,
+            static_collision_rate=args.static_collisions,
+            seed=args.seed,
+            verbose=False,
+        ),
+    )
+    c_files = sorted(corpus_dir.glob("*.c"))
+
+    if args.preprocess:
+        config = PreprocessorConfig()
+        config.include_dirs = [str(corpus_dir)]
+        preprocessor = CPPPreprocessor(config=config, jobs=args.jobs)
+        try:
+            stats = timer.run(
+                "preprocess", lambda: preprocessor.preprocess_all(c_files, False)
+            )
+        finally:
+            preprocessor.cleanup()
+        timer.phases["preprocess"]["failed"] = stats.failed
+
+    parser = CParser()
+
+    def parse() -> list:
+        if args.jobs > 1:
+            results = parser.parse_files_parallel(
+                [(file_path, None) for file_path in c_files], args.jobs
+            )
+            return [(r.source_file, r.functions) for r in results if r.success]
+        return [(file_path, parser.parse_file(file_path)) for file_path in c_files]
+
+    parsed = timer.run("parse", parse)
+    timer.phases["parse"]["failed"] = len(c_files) - len(parsed)
+
+    db = FunctionDatabase(str(corpus_dir), cache_dir=str(cache_dir))
+
+    def index() -> None:
+        for file_path, file_functions in parsed:
+            db._register_file_functions(file_path, file_functions)
+        db.total_files_scanned = len(c_files)
+        db._scanned_files = c_files
+
+    timer.run("index", index)
+    del parsed
+    timer.run("call_graph", db.get_call_graph)
+    timer.run("name_index", db.get_name_search_index)
+    timer.run("cache_save", db._save_to_cache)
+    if not db.cache_file.exists():
+        raise RuntimeError(f"cache of the {size} file corpus was not written")
+
+    # Trees are built on the loaded cache, like a CLI run after the first one
+    db = FunctionDatabase(str(corpus_dir), cache_dir=str(cache_dir))
+    if not timer.run("cache_load", db._load_from_cache):
+        raise RuntimeError(f"cache of the {size} file corpus could not be loaded")
+
+    # Public functions of files spread over the corpus; later files call
+    # into earlier ones, so the last file is always a root
+    step = max(1, len(c_files) // args.roots)
+    roots = [
+        db.get_functions_in_file(str(file_path))[0].name
+        for file_path in c_files[::-1][::step][: args.roots]
+    ]
+    results = []
+    for depth in args.depths:
+        builder = CallTreeBuilder(db)
+        results = timer.run(
+            f"build_tree_depth_{depth}",
+            lambda: [builder.build_tree(root, max_depth=depth) for root in roots],
+        )
+        timer.phases[f"build_tree_depth_{depth}"]["nodes"] = sum(
+            result.statistics.total_functions for result in results
+        )
+
+    def generate(generator: Any, suffix: str) -> int:
+        size_bytes = 0
+        for tree_index, result in enumerate(results):
+            output_path = output_dir / f"tree_{tree_index}{suffix}"
+            generator.generate(result, str(output_path))
+            size_bytes += output_path.stat().st_size
+        return size_bytes
+
+    mermaid_bytes = timer.run("mermaid", lambda: generate(MermaidGenerator(), ".md"))
+    timer.phases["mermaid"]["bytes"] = mermaid_bytes
+    xmi_bytes = timer.run("xmi", lambda: generate(RhapsodyXmiGenerator(), ".xmi"))
+    timer.phases["xmi"]["bytes"] = xmi_bytes
+
+    return {
+        "files": size,
+        "functions": functions,
+        "calls": db.store.call_offsets[len(db.store)],
+        "roots": len(roots),
+        "phases": timer.phases,
+    }
+
+
+def compare(results: dict, baseline: dict, max_slowdown: Optional[float]) -> int:
+    """Print the time ratios against a baseline run and check the limit."""
+    old_corpora = {corpus["files"]: corpus for corpus in baseline["corpora"]}
+    print(f"\nAgainst {baseline.get('commit') or 'baseline'}:")
+    changed = [
+        name
+        for name, value in results["options"].items()
+        if baseline.get("options", {}).get(name) != value
+    ]
+    if changed:
+        print(f"  Note: different options ({', '.join(changed)})")
+    regressions = 0
+    for corpus in results["corpora"]:
+        old_corpus = old_corpora.get(corpus["files"])
+        if old_corpus is None:
+            continue
+        print(f"  {corpus['files']} files")
+        for name, phase in corpus["phases"].items():
+            old_phase = old_corpus["phases"].get(name)
+            if not old_phase or not old_phase["seconds"]:
+                continue
+            ratio = phase["seconds"] / old_phase["seconds"]
+            slower = max_slowdown is not None and ratio > max_slowdown
+            regressions += slower
+            print(
+                f"    {name:<22} {old_phase['seconds']:9.2f}s -> "
+                f"{phase['seconds']:9.2f}s {ratio:6.2f}x{'  SLOWER' if slower else ''}"
+            )
+    return 1 if regressions else 0
+
+
+def main() -> int:
+    """Run the benchmark suite."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("--sizes", type=int_list, default=[1000, 10000, 50000])
+    arg_parser.add_argument("--fan-out", type=int, default=3)
+    arg_parser.add_argument("--static-collisions", type=float, default=0.2)
+    arg_parser.add_argument("--seed", type=int, default=42)
+    arg_parser.add_argument("--depths", type=int_list, default=[3, 6, 10])
+    arg_parser.add_argument("--roots", type=int, default=10)
+    arg_parser.add_argument("--jobs", "-j", type=int, default=1)
+    arg_parser.add_argument(
+        "--no-preprocess", dest="preprocess", action="store_false"
+    )
+    arg_parser.add_argument(
+        "--no-trace-memory", dest="trace_memory", action="store_false"
+    )
+    arg_parser.add_argument(
+        "--work-dir", help="Keep corpora, caches and outputs in this directory"
+    )
+    arg_parser.add_argument("--output", default="benchmark_scalability.json")
+    arg_parser.add_argument("--baseline", help="Results file of an earlier run")
+    arg_parser.add_argument(
+        "--max-slowdown",
+        type=float,
+        help="Exit with 1 if a phase is slower than the baseline by this factor",
+    )
+    args = arg_parser.parse_args()
+
+    results = {
+        "version": RESULTS_VERSION,
+        "commit": git_commit(),
+        "created_at": datetime.now().isoformat(timespec="seconds"),
+        "python": platform.python_version(),
+        "platform": platform.platform(),
+        "options": {
+            "fan_out": args.fan_out,
+            "static_collisions": args.static_collisions,
+            "seed": args.seed,
+            "depths": args.depths,
+            "roots": args.roots,
+            "jobs": args.jobs,
+            "trace_memory": args.trace_memory,
+        },
+        "corpora": [],
+    }
+    with tempfile.TemporaryDirectory() as temp_dir:
+        work_dir = Path(args.work_dir or temp_dir)
+        for size in args.sizes:
+            print(f"\n{size} files")
+            print(f"  {'phase':<22} {'time':>10} {'peak':>13}")
+            results["corpora"].append(benchmark_corpus(size, args, work_dir))
+
+    output_path = Path(args.output)
+    output_path.write_text(json.dumps(results, indent=2) + "\n", encoding="utf-8")
+    print(f"\nResults written to {output_path}")
+
+    if args.baseline:
+        baseline = json.loads(Path(args.baseline).read_text(encoding="utf-8"))
+        return compare(results, baseline, args.max_slowdown)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""
+Benchmark FunctionDatabase.search_functions() against a linear scan.
+
+Loads (or builds) the cached database of a corpus and times substring,
+prefix and regex searches through the name search index, with and
+without a result limit, next to the previous scan over all names.
+
+Usage:
+    python scripts/generate_large_demo.py
+    python scripts/benchmark_search.py [corpus_dir] [--cache-dir DIR]
+"""
+
+import argparse
+import contextlib
+import io
+import re
+import sys
+import tempfile
+import time
+from pathlib import Path
+from typing import Callable, List
+
+sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+
+from autosar_calltree.database.function_database import FunctionDatabase
+
+SEARCHES = (
+    ("substring", "ToggleSignal"),
+    ("substring", "_Init"),
+    ("substring", "er"),
+    ("prefix", "monitor_"),
+    ("regex", r"^Filter_\w+Warning$"),
+)
+
+
+def best_time(action: Callable[[], List[str]], repeat: int) -> float:
+    """Run action() repeatedly and return the best duration in ms."""
+    best = float("inf")
+    for _ in range(repeat):
+        start = time.perf_counter()
+        action()
+        best = min(best, time.perf_counter() - start)
+    return best * 1000
+
+
+def linear_scan(db: FunctionDatabase, mode: str, pattern: str) -> List[str]:
+    """Previous implementation: compare every name."""
+    if mode == "regex":
+        regex = re.compile(pattern)
+        return [name for name in db.functions if regex.search(name)]
+    pattern_lower = pattern.lower()
+    if mode == "prefix":
+        return [n for n in db.functions if n.lower().startswith(pattern_lower)]
+    return [n for n in db.functions if pattern_lower in n.lower()]
+
+
+def main() -> int:
+    """Run the benchmark."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("corpus_dir", nargs="?", default="demo/large_scale")
+    arg_parser.add_argument("--cache-dir", help="Reuse (or create) this cache")
+    arg_parser.add_argument("--repeat", type=int, default=5)
+    args = arg_parser.parse_args()
+
+    corpus_dir = Path(args.corpus_dir)
+    if not any(corpus_dir.rglob("*.c")):
+        print(f"No .c files in {corpus_dir}, run scripts/generate_large_demo.py first")
+        return 1
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        db = FunctionDatabase(str(corpus_dir), cache_dir=args.cache_dir or temp_dir)
+        with contextlib.redirect_stdout(io.StringIO()):
+            db.build_database()
+        print(f"{len(db.functions)} names, {db.total_functions_found} functions")
+        print(
+            f"  {'search':<36} {'matches':>8} "
+            f"{'scan':>9} {'index':>9} {'limit 20':>9}"
+        )
+        for mode, pattern in SEARCHES:
+            names = db.search_function_names(pattern, mode)
+            assert names == linear_scan(db, mode, pattern)
+            scan = best_time(lambda: linear_scan(db, mode, pattern), args.repeat)
+            indexed = best_time(
+                lambda: db.search_function_names(pattern, mode), args.repeat
+            )
+            limited = best_time(
+                lambda: db.search_function_names(pattern, mode, limit=20),
+                args.repeat,
+            )
+            print(
+                f"  {mode + ' ' + pattern:<36} {len(names):8d} "
+                f"{scan:7.2f}ms {indexed:7.2f}ms {limited:7.2f}ms"
+            )
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,11 +1,22 @@
 #!/usr/bin/env python3
 """
-Generate 1000 demo AUTOSAR C files for testing function database performance.
+Generate demo AUTOSAR C files for testing function database performance.
+
+Each file defines one public function followed by static functions that
+call each other in a chain. --fan-out N adds N - 1 calls per function to
+public functions of earlier files, and --static-collisions R gives that
+share of the static functions a name from a small pool, so the same
+static name is defined in many files.
+
+Usage:
+    python scripts/generate_large_demo.py [--files N] [--output-dir DIR]
+                                          [--fan-out N] [--static-collisions R]
 """
 
+import argparse
 import random
 from pathlib import Path
-from typing import List
+from typing import List, Optional, Tuple
 
 # AUTOSAR patterns
 FUNCTION_TYPES = [
@@ -51,7 +62,6 @@ PARAMETER_TYPES = [
     "float32", "float64", "boolean", "Std_ReturnType"
 ]
 
-random.seed(42)
 
 
 def generate_function_name() -> str:
@@ -88,7 +98,9 @@ def generate_parameters(num_params: int = None) -> List[str]:
     return params
 
 
-def generate_function_declaration(func_name: str, is_static: bool = False) -> tuple[str, str]:
+def generate_function_declaration(
+    func_name: str, is_static: bool = False
+) -> Tuple[str, str, str]:
     """Generate a function declaration and its definition."""
     return_type = random.choice(FUNCTION_TYPES)
     func_class = random.choice(FUNCTION_CLASSES)
@@ -113,8 +125,30 @@ def generate_function_declaration(func_name: str, is_static: bool = False) -> tu
     return declaration, return_type, params_str
 
 
-def generate_file_content(file_index: int, num_functions: int = 5) -> str:
-    """Generate content for a single C file."""
+def generate_file_content(
+    file_index: int,
+    num_functions: int = 5,
+    fan_out: int = 1,
+    public_names: Optional[List[str]] = None,
+    static_collision_rate: float = 0.0,
+    include_header: bool = True,
+) -> Tuple[str, List[str], str]:
+    """
+    Generate content for a single C file.
+
+    Args:
+        file_index: Index of the file
+        num_functions: Number of functions in the file
+        fan_out: Calls per function: the next function of the file plus
+            fan_out - 1 calls to names from public_names
+        public_names: Public functions of other files that may be called
+        static_collision_rate: Share of static functions with a pooled name
+        include_header: Whether to include the header of the file
+
+    Returns:
+        File content, the names of its functions and the declaration of
+        its public function
+    """
     module_name = f"Module{file_index:04d}"
     functions = []
 
@@ -122,12 +156,16 @@ def generate_file_content(file_index: int, num_functions: int = 5) -> str:
     for i in range(num_functions):
         func_name = generate_function_name()
         is_static = i > 0  # First function is public, rest are static
+        if is_static and static_collision_rate > 0:
+            if random.random() < static_collision_rate:
+                func_name = f"Local_{random.choice(FUNCTION_VERBS)}"
         decl, return_type, params_str = generate_function_declaration(func_name, is_static)
         functions.append((decl, return_type, params_str, func_name))
 
     # Build file content
     content = f"/*\n * {module_name} - AUTOSAR Demo File {file_index}\n */\n\n"
-    content += f'#include "{module_name}.h"\n\n'
+    if include_header:
+        content += f'#include "module_{file_index:04d}.h"\n\n'
 
     # Add function definitions
     for i, (decl, return_type, params_str, func_name) in enumerate(functions):
@@ -146,6 +184,11 @@ def generate_file_content(file_index: int, num_functions: int = 5) -> str:
                 args = ", ".join([f"0x{i*16:02X}" for i in range(num_args)])
                 content += f"    {next_func}({args});\n"
 
+        # Add calls to public functions of other files
+        if public_names:
+            for _ in range(fan_out - 1):
+                content += f"    {random.choice(public_names)}();\n"
+
         # Add some inline logic comments
         content += "    /* Local processing */\n"
 
@@ -154,7 +197,7 @@ def generate_file_content(file_index: int, num_functions: int = 5) -> str:
 
         content += "}\n\n"
 
-    return content
+    return content, [function[3] for function in functions], functions[0][0]
 
 
 def generate_header_content(file_index: int, functions: List[str]) -> str:
@@ -173,46 +216,94 @@ def generate_header_content(file_index: int, functions: List[str]) -> str:
     return content
 
 
-def main():
-    """Generate 1000 demo files."""
-    output_dir = Path("demo/large_scale")
-    output_dir.mkdir(exist_ok=True)
-
-    num_files = 1000
-
-    print(f"Generating {num_files} AUTOSAR C files in {output_dir}/...")
-
+def generate_corpus(
+    output_dir: Path,
+    num_files: int = 1000,
+    fan_out: int = 1,
+    static_collision_rate: float = 0.0,
+    seed: int = 42,
+    verbose: bool = True,
+) -> int:
+    """
+    Generate the C and header files of a corpus.
+
+    Args:
+        output_dir: Directory for the files, created if needed
+        num_files: Number of C files
+        fan_out: Calls per function (see generate_file_content())
+        static_collision_rate: Share of static functions with a pooled name
+        seed: Seed of the random generator; equal arguments give equal files
+        verbose: Print progress
+
+    Returns:
+        Number of generated functions
+    """
+    random.seed(seed)
+    output_dir.mkdir(parents=True, exist_ok=True)
+    (output_dir / "Std_Types.h").write_text(
+        "#ifndef STD_TYPES_H\n#define STD_TYPES_H\n#endif /* STD_TYPES_H */\n"
+    )
+
+    if verbose:
+        print(f"Generating {num_files} AUTOSAR C files in {output_dir}/...")
+
+    public_names: List[str] = []
+    num_functions = 0
     for i in range(num_files):
-        # Generate C file
-        c_content = generate_file_content(i, num_functions=random.randint(3, 8))
+        # Generate C file; every other file gets a header
+        has_header = i % 2 == 0
+        c_content, names, public_decl = generate_file_content(
+            i,
+            num_functions=random.randint(3, 8),
+            fan_out=fan_out,
+            public_names=public_names,
+            static_collision_rate=static_collision_rate,
+            include_header=has_header,
+        )
+        public_names.append(names[0])
+        num_functions += len(names)
         c_filename = output_dir / f"module_{i:04d}.c"
 
         with open(c_filename, "w") as f:
             f.write(c_content)
 
-        # Generate corresponding header file (only for some files)
-        if i % 2 == 0:  # Every other file gets a header
-            # Extract the first function declaration
-            func_decls = []
-            for line in c_content.split("\n"):
-                if "FUNC(" in line and not line.strip().startswith("/*"):
-                    if ";" in line:
-                        func_decls.append(line.strip())
-                        break
-
-            if func_decls:
-                h_content = generate_header_content(i, func_decls)
-                h_filename = output_dir / f"module_{i:04d}.h"
-                with open(h_filename, "w") as f:
-                    f.write(h_content)
-
-        if (i + 1) % 100 == 0:
+        if has_header:
+            h_content = generate_header_content(i, [public_decl])
+            h_filename = output_dir / f"module_{i:04d}.h"
+            with open(h_filename, "w") as f:
+                f.write(h_content)
+
+        if verbose and (i + 1) % 100 == 0:
             print(f"  Generated {i + 1}/{num_files} files...")
 
+    return num_functions
+
+
+def main():
+    """Generate the demo files."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("--files", type=int, default=1000)
+    arg_parser.add_argument("--output-dir", default="demo/large_scale")
+    arg_parser.add_argument("--fan-out", type=int, default=1)
+    arg_parser.add_argument("--static-collisions", type=float, default=0.0)
+    arg_parser.add_argument("--seed", type=int, default=42)
+    args = arg_parser.parse_args()
+
+    output_dir = Path(args.output_dir)
+    num_files = args.files
+    num_functions = generate_corpus(
+        output_dir,
+        num_files,
+        fan_out=args.fan_out,
+        static_collision_rate=args.static_collisions,
+        seed=args.seed,
+    )
+
     print(f"\n✓ Successfully generated {num_files} demo files!")
+    print(f"  Functions: {num_functions}")
     print(f"  Location: {output_dir.absolute()}")
     print(f"\nTest the database builder with:")
-    print(f"  calltree --list-functions --source-dir demo/large_scale")
+    print(f"  calltree --list-functions --source-dir {output_dir}")
 
 
 if __name__ == "__main__":
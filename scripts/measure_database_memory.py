@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""
+Measure the memory held by a FunctionDatabase.
+
+Builds the database of a corpus without cache, saves the cache, then loads
+it in a fresh database, and reports the traced Python memory retained by
+each database, the size of the cache files and the load time.
+
+Usage:
+    python scripts/generate_large_demo.py
+    python scripts/measure_database_memory.py [corpus_dir] [--jobs N]
+"""
+
+import argparse
+import contextlib
+import gc
+import io
+import sys
+import tempfile
+import time
+import tracemalloc
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+
+from autosar_calltree.database.function_database import FunctionDatabase
+
+
+def measure(label: str, build) -> FunctionDatabase:
+    """Run build() and print the memory it retains and its duration."""
+    gc.collect()
+    tracemalloc.start()
+    start = time.perf_counter()
+    with contextlib.redirect_stdout(io.StringIO()):
+        db = build()
+    elapsed = time.perf_counter() - start
+    gc.collect()
+    retained, _ = tracemalloc.get_traced_memory()
+    tracemalloc.stop()
+    print(f"  {label:<16} {retained / (1024 * 1024):9.1f} MB   {elapsed:7.2f} s")
+    return db
+
+
+def main() -> int:
+    """Run the measurement."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("corpus_dir", nargs="?", default="demo/large_scale")
+    arg_parser.add_argument("--jobs", type=int, default=1)
+    args = arg_parser.parse_args()
+
+    corpus_dir = Path(args.corpus_dir)
+    if not any(corpus_dir.rglob("*.c")):
+        print(f"No .c files in {corpus_dir}, run scripts/generate_large_demo.py first")
+        return 1
+
+    with tempfile.TemporaryDirectory() as cache_dir:
+
+        def build() -> FunctionDatabase:
+            db = FunctionDatabase(str(corpus_dir), cache_dir=cache_dir, jobs=args.jobs)
+            db.build_database(use_cache=False)
+            db._save_to_cache()
+            return db
+
+        def load() -> FunctionDatabase:
+            db = FunctionDatabase(str(corpus_dir), cache_dir=cache_dir, jobs=args.jobs)
+            db.build_database(use_cache=True)
+            return db
+
+        built = measure("build + save", build)
+        cache_size = sum(
+            path.stat().st_size
+            for path in (built.cache_file, built.binary_cache_file)
+        )
+        del built
+        loaded = measure("load from cache", load)
+
+    print(f"  {'functions':<16} {loaded.total_functions_found:9d}")
+    print(f"  {'cache files':<16} {cache_size / (1024 * 1024):9.1f} MB")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
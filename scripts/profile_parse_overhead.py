@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+"""
+Profile the fixed per-file overhead of CParser.parse_file().
+
+Parses many tiny files (alternating one AUTOSAR and one traditional C
+function per file) with a single CParser, so the measured time is
+dominated by per-file setup rather than by the size of the code.
+
+Usage:
+    python scripts/profile_parse_overhead.py [--files N] [--profile]
+"""
+
+import argparse
+import cProfile
+import pstats
+import sys
+import tempfile
+import time
+from pathlib import Path
+
+sys.path.insert(0, str(Path(__file__).parent.parent / "src"))
+
+from autosar_calltree.parsers.c_parser import CParser
+
+TINY_FILES = (
+    """\
+FUNC(void, RTE_CODE) Tiny_Run_{index}(VAR(uint8, AUTOMATIC) mode)
+{{
+    Tiny_Step_{index}(mode);
+}}
+""",
+    """\
+static uint8 Tiny_Step_{index}(uint8 mode)
+{{
+    return Tiny_Helper(mode);
+}}
+""",
+)
+
+
+def main() -> int:
+    """Run the profile."""
+    arg_parser = argparse.ArgumentParser(description=__doc__.split("\n")[1])
+    arg_parser.add_argument("--files", type=int, default=500)
+    arg_parser.add_argument("--repeat", type=int, default=5)
+    arg_parser.add_argument(
+        "--profile", action="store_true", help="Print the top cProfile entries"
+    )
+    args = arg_parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as tmp:
+        files = []
+        for index in range(args.files):
+            file_path = Path(tmp) / f"tiny_{index:04d}.c"
+            file_path.write_text(TINY_FILES[index % 2].format(index=index))
+            files.append(file_path)
+
+        start = time.perf_counter()
+        parser = CParser()
+        setup = time.perf_counter() - start
+
+        elapsed = float("inf")
+        for _ in range(args.repeat):
+            start = time.perf_counter()
+            functions = sum(len(parser.parse_file(f)) for f in files)
+            elapsed = min(elapsed, time.perf_counter() - start)
+
+        profiler = cProfile.Profile()
+        if args.profile:
+            profiler.runcall(lambda: [parser.parse_file(f) for f in files])
+
+    print(f"Parser setup:      {setup * 1000:8.2f} ms (once per process)")
+    print(f"Files parsed:      {len(files):8d} ({functions} functions)")
+    print(f"Per-file overhead: {elapsed / len(files) * 1000:8.3f} ms")
+
+    if args.profile:
+        pstats.Stats(profiler).sort_stats("cumulative").print_stats(15)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,24 @@
+"""
+Build script of the optional native lexer extension (SWR_PARSER_00050).
+
+All package metadata is in pyproject.toml. The extension is optional: if
+it cannot be compiled (e.g. no C compiler), the package is installed
+without it and the pure-Python implementations are used. Set
+AUTOSAR_CALLTREE_NO_NATIVE=1 to skip building it.
+"""
+
+import os
+
+from setuptools import Extension, setup
+
+ext_modules = []
+if not os.environ.get("AUTOSAR_CALLTREE_NO_NATIVE"):
+    ext_modules.append(
+        Extension(
+            "autosar_calltree.parsers._lexer",
+            sources=["src/autosar_calltree/parsers/_lexer.c"],
+            optional=True,
+        )
+    )
+
+setup(ext_modules=ext_modules)
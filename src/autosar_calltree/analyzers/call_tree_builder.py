@@ -3,21 +3,52 @@ Call tree analyzer module.
 
 This module builds call trees by performing depth-first traversal
 of function calls, detecting cycles, and collecting statistics.
+
+Requirements:
+- SWR_ANALYZER_00016: Shared Subtree Expansion
+- SWR_ANALYZER_00017: Resolved Call Graph Traversal
+- SWR_ANALYZER_00018: Caller Tree
+- SWR_ANALYZER_00019: Lazy Database Traversal
+- SWR_ANALYZER_00020: Tree Build Budgets
+- SWR_ANALYZER_00021: Breadth-First Refinement
 """
 
+import time
+from dataclasses import dataclass
 from pathlib import Path
-from typing import List, Set
+from typing import Dict, FrozenSet, Iterator, List, Optional, Set, Tuple, Union
 
+from ..database.call_graph import UNRESOLVED, CallGraph
 from ..database.function_database import FunctionDatabase
 from ..database.models import (
     AnalysisResult,
     AnalysisStatistics,
     CallTreeNode,
     CircularDependency,
+    FunctionCall,
     FunctionInfo,
+    TreeTruncation,
 )
 from ..utils.tree_formatter import TreeFormatter
 
+# Identity of a function for the subtree cache: its call graph ID, or
+# (resolved file path, name) without one. Qualified names are only
+# file_stem::name, so same-named functions in same-stem files share them.
+_SubtreeKey = Union[int, Tuple[str, str]]
+
+
+@dataclass
+class _SharedSubtree:
+    """Expanded subtree that can be reused at the same depth."""
+
+    node: CallTreeNode
+    logical_nodes: int  # Nodes the subtree stands for when fully expanded
+    max_depth: int
+    # Qualified names of all nodes in the subtree: cycles are detected by
+    # qualified name, so these decide whether the subtree fits a call stack
+    functions: FrozenSet[str]
+    cycles: List[CircularDependency]
+
 
 class CallTreeBuilder:
     """
@@ -41,6 +72,18 @@ class CallTreeBuilder:
         self.circular_dependencies: List[CircularDependency] = []
         self.max_depth_reached = 0
         self.total_nodes = 0
+        self.physical_nodes = 0
+        self.share_subtrees = True
+        self._subtree_cache: Dict[Tuple[_SubtreeKey, int], _SharedSubtree] = {}
+        self._subtree_functions: List[Set[str]] = []
+        self.call_graph: Optional[CallGraph] = None
+        self.callers_mode = False
+        self.max_nodes: Optional[int] = None
+        self._deadline: Optional[float] = None
+        self._budget_reason: Optional[str] = None
+        self.truncated_functions: List[str] = []
+        # Leaves at the depth limit, for marking them in breadth-first mode
+        self._depth_limited: List[Tuple[CallTreeNode, Optional[int]]] = []
 
     def build_tree(
         self,
@@ -49,29 +92,227 @@ class CallTreeBuilder:
         verbose: bool = False,
         enable_loops: bool = False,
         enable_conditionals: bool = False,
+        share_subtrees: bool = True,
+        max_nodes: Optional[int] = None,
+        time_budget: Optional[float] = None,
     ) -> AnalysisResult:
         """
         Build a call tree starting from a function.
 
+        Implements: SWR_ANALYZER_00016 (Shared Subtree Expansion),
+        SWR_ANALYZER_00020 (Tree Build Budgets)
+
         Args:
             start_function: Name of the function to start from
             max_depth: Maximum depth to traverse
             verbose: Print progress information
             enable_loops: Enable loop detection and representation
             enable_conditionals: Enable if-else conditional detection and representation
+            share_subtrees: Reuse already expanded subtrees of a function at the
+                            same depth instead of expanding them again
+            max_nodes: Stop expanding calls when the tree has this many nodes
+            time_budget: Stop expanding calls after this many seconds
+
+        Returns:
+            AnalysisResult containing the call tree and metadata; its
+            truncation tells what a budget left out
+        """
+        return self._build(
+            start_function,
+            max_depth,
+            verbose,
+            enable_loops,
+            enable_conditionals,
+            share_subtrees,
+            callers=False,
+            max_nodes=max_nodes,
+            time_budget=time_budget,
+        )
+
+    def build_caller_tree(
+        self,
+        target_function: str,
+        max_depth: int = 3,
+        verbose: bool = False,
+        enable_loops: bool = False,
+        enable_conditionals: bool = False,
+        share_subtrees: bool = True,
+        max_nodes: Optional[int] = None,
+        time_budget: Optional[float] = None,
+    ) -> AnalysisResult:
+        """
+        Build the inverted call tree of everything that calls a function.
+
+        The children of a node are the functions calling it, found in the
+        reverse index of the call graph, so the tree is built in one
+        traversal bounded by max_depth. A caller appears once per function
+        it calls; its first call decides the optional and loop flags.
+        Paths from the leaves to the root are the call chains from the
+        entry points down to target_function.
+
+        Implements: SWR_ANALYZER_00018 (Caller Tree)
+
+        Args:
+            target_function: Name of the called function at the root
+            max_depth: Maximum number of caller levels to traverse
+            verbose: Print progress information
+            enable_loops: Mark callers that call their child inside a loop
+            enable_conditionals: Mark callers that call their child conditionally
+            share_subtrees: Reuse already expanded caller subtrees of a
+                            function at the same depth
+            max_nodes: Stop expanding callers when the tree has this many nodes
+            time_budget: Stop expanding callers after this many seconds
 
         Returns:
-            AnalysisResult containing the call tree and metadata
+            AnalysisResult containing the caller tree (is_caller_tree set)
+        """
+        return self._build(
+            target_function,
+            max_depth,
+            verbose,
+            enable_loops,
+            enable_conditionals,
+            share_subtrees,
+            callers=True,
+            max_nodes=max_nodes,
+            time_budget=time_budget,
+        )
+
+    def iter_tree_levels(
+        self,
+        start_function: str,
+        max_depth: int = 3,
+        verbose: bool = False,
+        enable_loops: bool = False,
+        enable_conditionals: bool = False,
+        share_subtrees: bool = True,
+        callers: bool = False,
+        max_nodes: Optional[int] = None,
+        time_budget: Optional[float] = None,
+    ) -> Iterator[AnalysisResult]:
+        """
+        Build a call or caller tree breadth-first, one more level at a time.
+
+        The tree is built to depth 1, 2, ... max_depth (iterative
+        deepening), so the top levels are available first and each result
+        refines the one before. The budgets hold for all levels together:
+        when a level runs out of budget, the last complete level is
+        yielded once more as the final result, with its depth-limited
+        leaves that have calls marked as truncated. Only if the first
+        level already runs out, its partial tree is yielded.
+
+        Implements: SWR_ANALYZER_00021 (Breadth-First Refinement)
+
+        Args:
+            start_function: Name of the function at the root
+            max_depth: Depth of the last level
+            verbose: Print progress information
+            enable_loops: Enable loop detection and representation
+            enable_conditionals: Enable if-else conditional detection
+            share_subtrees: Reuse already expanded subtrees (see build_tree())
+            callers: Build the caller tree (see build_caller_tree())
+            max_nodes: Node budget of every level
+            time_budget: Seconds for all levels together
+
+        Yields:
+            AnalysisResult of each complete level; the last one is final
+        """
+        deadline = _deadline(time_budget)
+        previous: Optional[AnalysisResult] = None
+        previous_leaves: List[Tuple[CallTreeNode, Optional[int]]] = []
+        for depth in range(min(1, max_depth), max_depth + 1):
+            result = self._build(
+                start_function,
+                depth,
+                verbose,
+                enable_loops,
+                enable_conditionals,
+                share_subtrees,
+                callers=callers,
+                max_nodes=max_nodes,
+                time_budget=time_budget,
+                deadline=deadline,
+            )
+            if result.truncation is None or previous is None:
+                yield result
+                if result.truncation is not None or result.call_tree is None:
+                    return
+                previous, previous_leaves = result, self._depth_limited[:]
+                continue
+
+            # The level did not fit: the previous one is the final result
+            truncation = result.truncation
+            truncation.complete_depth = depth - 1
+            truncation.truncated_functions = []
+            for leaf, leaf_id in previous_leaves:
+                if not leaf.is_truncated and self._has_children(leaf, leaf_id):
+                    leaf.is_truncated = True
+                    truncation.truncated_functions.append(
+                        self._qualified_name(leaf.function_info, leaf_id)
+                    )
+            previous.truncation = truncation
+            yield previous
+            return
+
+    def _build(
+        self,
+        start_function: str,
+        max_depth: int,
+        verbose: bool,
+        enable_loops: bool,
+        enable_conditionals: bool,
+        share_subtrees: bool,
+        callers: bool,
+        max_nodes: Optional[int] = None,
+        time_budget: Optional[float] = None,
+        deadline: Optional[float] = None,
+    ) -> AnalysisResult:
+        """
+        Build a call tree or caller tree (see build_tree()).
+
+        A lazy database has no complete call graph while files are still
+        parsed on demand; calls are then looked up by name, which parses
+        the files defining the callees. A caller tree needs all callers,
+        so all pending files are parsed first.
+
+        Implements: SWR_ANALYZER_00019 (Lazy Database Traversal)
+
+        Args:
+            callers: Follow the callers of each function instead of its calls
+            max_nodes: Node budget, or None
+            time_budget: Time budget in seconds, or None
+            deadline: time.perf_counter() value after which expansion stops;
+                      derived from time_budget if None
+
+        Returns:
+            AnalysisResult containing the tree and metadata
         """
         # Reset state
         self.visited_functions.clear()
         self.call_stack.clear()
-        self.circular_dependencies.clear()
+        # A new list, earlier results keep theirs (see iter_tree_levels())
+        self.circular_dependencies = []
         self.max_depth_reached = 0
         self.total_nodes = 0
+        self.physical_nodes = 0
+        self.share_subtrees = share_subtrees
+        self._subtree_cache.clear()
+        self._subtree_functions.clear()
+        self.max_nodes = max_nodes
+        self._deadline = deadline if deadline is not None else _deadline(time_budget)
+        self._budget_reason = None
+        self.truncated_functions = []
+        self._depth_limited = []
+        if callers:
+            self.function_db.parse_pending_files()
+        self.call_graph = (
+            None if self.function_db.is_lazy else self.function_db.get_call_graph()
+        )
+        self.callers_mode = callers
 
         if verbose:
-            print(f"Building call tree for: {start_function}")
+            kind = "caller tree" if callers else "call tree"
+            print(f"Building {kind} for: {start_function}")
             print(f"Max depth: {max_depth}")
             print(f"Enable loops: {enable_loops}")
             print(f"Enable conditionals: {enable_conditionals}")
@@ -95,6 +336,7 @@ class CallTreeBuilder:
                     unique_functions=0,
                 ),
                 errors=[f"Function '{start_function}' not found"],
+                is_caller_tree=callers,
             )
 
         # Use first match (or disambiguate if multiple found)
@@ -125,14 +367,31 @@ class CallTreeBuilder:
             max_depth_reached=self.max_depth_reached,
             circular_dependencies_found=len(self.circular_dependencies),
             unique_functions=unique_functions,
+            physical_nodes=self.physical_nodes,
         )
 
+        # Shared subtrees are only valid for this build
+        self._subtree_cache.clear()
+
+        truncation = None
+        if self._budget_reason is not None:
+            truncation = TreeTruncation(
+                reason=self._budget_reason,
+                limit=float(
+                    max_nodes if self._budget_reason == "max_nodes" else time_budget
+                ),
+                truncated_functions=list(self.truncated_functions),
+            )
+
         if verbose:
             print("\nAnalysis complete:")
             print(f"  - Total nodes: {self.total_nodes}")
+            print(f"  - Physical nodes: {self.physical_nodes}")
             print(f"  - Unique functions: {unique_functions}")
             print(f"  - Max depth reached: {self.max_depth_reached}")
             print(f"  - Circular dependencies: {len(self.circular_dependencies)}")
+            if truncation is not None:
+                print(f"  - Truncated: {truncation.describe()}")
 
         return AnalysisResult(
             root_function=start_function,
@@ -140,6 +399,8 @@ class CallTreeBuilder:
             circular_dependencies=self.circular_dependencies,
             statistics=statistics,
             errors=[],
+            is_caller_tree=callers,
+            truncation=truncation,
         )
 
     def _build_tree_recursive(
@@ -154,6 +415,16 @@ class CallTreeBuilder:
         """
         Recursively build call tree using depth-first search.
 
+        A subtree only depends on the function, its depth and which of its
+        functions are on the call stack. An expanded subtree is therefore
+        cached under (function, depth) when none of its functions are
+        ancestors, and reused while that still holds. The function is
+        identified by its call graph ID (or file path and name), not by
+        its qualified name, which same-named functions in files of the
+        same stem share. A reused subtree gets
+        a new node sharing the cached children list, so per-call flags
+        (optional, loop) stay per edge.
+
         Args:
             func_info: Current function information
             current_depth: Current depth in the tree
@@ -165,14 +436,35 @@ class CallTreeBuilder:
         Returns:
             CallTreeNode for current function
         """
+        # Create qualified name for cycle detection
+        graph = self.call_graph
+        func_id = graph.get_id(func_info) if graph is not None else None
+        qualified_name = self._qualified_name(func_info, func_id)
+        cache_key = (self._subtree_key(func_info, func_id), current_depth)
+
+        if self.share_subtrees:
+            shared = self._subtree_cache.get(cache_key)
+            if (
+                shared is not None
+                and shared.functions.isdisjoint(self.call_stack)
+                and (
+                    self.max_nodes is None
+                    or self.total_nodes + shared.logical_nodes <= self.max_nodes
+                )
+            ):
+                if verbose:
+                    print(f"{'  ' * current_depth}{func_info.name} (shared subtree)")
+                return self._reuse_subtree(func_info, shared)
+
         self.total_nodes += 1
+        self.physical_nodes += 1
 
         # Track maximum depth
         if current_depth > self.max_depth_reached:
             self.max_depth_reached = current_depth
 
-        # Create qualified name for cycle detection
-        qualified_name = self._get_qualified_name(func_info)
+        if self._subtree_functions:
+            self._subtree_functions[-1].add(qualified_name)
 
         # Check for circular dependency
         if qualified_name in self.call_stack:
@@ -203,12 +495,14 @@ class CallTreeBuilder:
                 print(f"  {'  ' * current_depth}{func_info.name} (max depth reached)")
 
             self.call_stack.pop()
-            return CallTreeNode(
+            leaf = CallTreeNode(
                 function_info=func_info,
                 depth=current_depth,
                 children=[],
                 is_recursive=False,
             )
+            self._depth_limited.append((leaf, func_id))
+            return leaf
 
         if verbose:
             indent = "  " * current_depth
@@ -216,20 +510,27 @@ class CallTreeBuilder:
                 f"{indent}{func_info.name} ({func_info.file_path}:{func_info.line_number})"
             )
 
+        # Collect what the subtree contributes, for caching it afterwards
+        nodes_before = self.total_nodes - 1
+        cycles_before = len(self.circular_dependencies)
+        outer_max_depth = self.max_depth_reached
+        self.max_depth_reached = current_depth
+        self._subtree_functions.append({qualified_name})
+
+        # Parse the files of all callees at once in lazy mode
+        if graph is None and not self.callers_mode and self.function_db.is_lazy:
+            self.function_db.ensure_parsed(call.name for call in func_info.calls)
+
         # Build children nodes
         children = []
+        truncated = False
 
-        for func_call in func_info.calls:
+        for func_call, called_func_info in self._child_calls(func_info, func_id):
             called_func_name = func_call.name
             is_conditional = func_call.is_conditional
             is_loop = func_call.is_loop
 
-            # Lookup called function
-            called_funcs = self.function_db.lookup_function(
-                called_func_name, context_file=str(func_info.file_path)
-            )
-
-            if not called_funcs:
+            if called_func_info is None:
                 # Function not found - might be external or library function
                 if verbose:
                     print(
@@ -237,8 +538,9 @@ class CallTreeBuilder:
                     )
                 continue
 
-            # Use first match (prefer function from same file for static functions)
-            called_func_info = called_funcs[0]
+            if self._out_of_budget():
+                truncated = True
+                break
 
             # Recursively build child node
             child_node = self._build_tree_recursive(
@@ -265,11 +567,173 @@ class CallTreeBuilder:
         # Remove from call stack
         self.call_stack.pop()
 
-        return CallTreeNode(
+        node = CallTreeNode(
             function_info=func_info,
             depth=current_depth,
             children=children,
             is_recursive=False,
+            is_truncated=truncated,
+        )
+        if truncated:
+            self.truncated_functions.append(qualified_name)
+            if verbose:
+                print(f"  {'  ' * current_depth}{func_info.name} (budget reached)")
+
+        subtree_functions = self._subtree_functions.pop()
+        subtree_max_depth = self.max_depth_reached
+        self.max_depth_reached = max(outer_max_depth, subtree_max_depth)
+        if self._subtree_functions:
+            self._subtree_functions[-1].update(subtree_functions)
+
+        # Cycles back to an ancestor make the subtree depend on the call stack;
+        # a subtree built while a budget ran out may be incomplete
+        if (
+            self.share_subtrees
+            and self._budget_reason is None
+            and subtree_functions.isdisjoint(self.call_stack)
+        ):
+            self._subtree_cache[cache_key] = _SharedSubtree(
+                node=node,
+                logical_nodes=self.total_nodes - nodes_before,
+                max_depth=subtree_max_depth,
+                functions=frozenset(subtree_functions),
+                cycles=self.circular_dependencies[cycles_before:],
+            )
+
+        return node
+
+    def _out_of_budget(self) -> bool:
+        """
+        Check whether the node or time budget of the build has run out.
+
+        Once a budget has run out, it stays so for the rest of the build.
+
+        Implements: SWR_ANALYZER_00020 (Tree Build Budgets)
+
+        Returns:
+            True if no further node may be expanded
+        """
+        if self._budget_reason is None:
+            if self.max_nodes is not None and self.total_nodes >= self.max_nodes:
+                self._budget_reason = "max_nodes"
+            elif self._deadline is not None and time.perf_counter() >= self._deadline:
+                self._budget_reason = "time_budget"
+        return self._budget_reason is not None
+
+    def _has_children(self, node: CallTreeNode, func_id: Optional[int]) -> bool:
+        """Check whether a depth-limited leaf would get children at a deeper level."""
+        return any(
+            callee is not None
+            for _, callee in self._child_calls(node.function_info, func_id)
+        )
+
+    def _qualified_name(self, func_info: FunctionInfo, func_id: Optional[int]) -> str:
+        """Get the qualified name of a function, from the call graph if it has it."""
+        if self.call_graph is not None and func_id is not None:
+            return self.call_graph.qualified_name(func_id)
+        return self._get_qualified_name(func_info)
+
+    def _subtree_key(
+        self, func_info: FunctionInfo, func_id: Optional[int]
+    ) -> _SubtreeKey:
+        """Get the identity of a function in the subtree cache."""
+        if func_id is not None:
+            return func_id
+        return str(Path(func_info.file_path).resolve()), func_info.name
+
+    def _child_calls(
+        self, func_info: FunctionInfo, func_id: Optional[int]
+    ) -> Iterator[Tuple[FunctionCall, Optional[FunctionInfo]]]:
+        """
+        Get the calls that lead to the children of a node.
+
+        For a call tree these are the calls of the function with their
+        callees (None if not found). For a caller tree these are the first
+        call of every caller of the function, with the caller.
+
+        Implements: SWR_ANALYZER_00018 (Caller Tree)
+
+        Args:
+            func_info: Function of the node
+            func_id: Call graph ID of the function, or None
+
+        Yields:
+            (call, function of the child node) pairs
+        """
+        if not self.callers_mode:
+            for call_index, func_call in enumerate(func_info.calls):
+                yield func_call, self._resolve_call(func_info, func_id, call_index)
+            return
+
+        if func_id is None or self.call_graph is None:
+            return
+        seen_callers: Set[int] = set()
+        for caller_id, call_index in self.call_graph.callers(func_id):
+            if caller_id in seen_callers:
+                continue
+            seen_callers.add(caller_id)
+            caller = self.call_graph.function(caller_id)
+            yield caller.calls[call_index], caller
+
+    def _resolve_call(
+        self, func_info: FunctionInfo, func_id: Optional[int], call_index: int
+    ) -> Optional[FunctionInfo]:
+        """
+        Get the function called by one call of a function.
+
+        Uses the pre-resolved call graph when the function is part of it,
+        otherwise looks the callee up in the database.
+
+        Implements: SWR_ANALYZER_00017 (Resolved Call Graph Traversal)
+
+        Args:
+            func_info: Calling function
+            func_id: Call graph ID of the calling function, or None
+            call_index: Index of the call in func_info.calls
+
+        Returns:
+            Called FunctionInfo, or None if it is not in the database
+        """
+        if func_id is not None and self.call_graph is not None:
+            callee_id = self.call_graph.callee(func_id, call_index)
+            if callee_id == UNRESOLVED:
+                return None
+            return self.call_graph.function(callee_id)
+
+        # Use first match (prefer function from same file for static functions)
+        called_funcs = self.function_db.lookup_function(
+            func_info.calls[call_index].name, context_file=str(func_info.file_path)
+        )
+        return called_funcs[0] if called_funcs else None
+
+    def _reuse_subtree(
+        self, func_info: FunctionInfo, shared: _SharedSubtree
+    ) -> CallTreeNode:
+        """
+        Account for a cached subtree and return a node sharing its children.
+
+        Implements: SWR_ANALYZER_00016 (Shared Subtree Expansion)
+
+        Args:
+            func_info: Function at the root of the subtree
+            shared: Cached subtree
+
+        Returns:
+            New CallTreeNode whose children list is the cached one
+        """
+        self.total_nodes += shared.logical_nodes
+        self.physical_nodes += 1
+        self.max_depth_reached = max(self.max_depth_reached, shared.max_depth)
+        self.visited_functions.update(shared.functions)
+        self.circular_dependencies.extend(shared.cycles)
+        if self._subtree_functions:
+            self._subtree_functions[-1].update(shared.functions)
+
+        return CallTreeNode(
+            function_info=func_info,
+            depth=shared.node.depth,
+            children=shared.node.children,
+            is_recursive=False,
         )
 
     def _get_qualified_name(self, func_info: FunctionInfo) -> str:
@@ -361,3 +825,8 @@ class CallTreeBuilder:
             Text representation as string
         """
         return TreeFormatter.format_tree(root, show_file=show_file, show_line=show_file)
+
+
+def _deadline(time_budget: Optional[float]) -> Optional[float]:
+    """Get the time.perf_counter() deadline of a time budget in seconds."""
+    return None if time_budget is None else time.perf_counter() + time_budget
@@ -0,0 +1,316 @@
+"""
+Batch analysis for the command-line interface.
+
+This module builds call trees for many start functions from one loaded
+FunctionDatabase and writes one Mermaid or XMI file per root function.
+
+Requirements:
+- SWR_CLI_00026: Batch Analysis Mode
+- SWR_CLI_00035: Skip Unchanged Batch Outputs
+"""
+
+import hashlib
+import multiprocessing
+import re
+from concurrent.futures import ProcessPoolExecutor
+from concurrent.futures.process import BrokenProcessPool
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from typing import Iterable, List, Optional
+
+from ..analyzers.call_tree_builder import CallTreeBuilder
+from ..database.function_database import FunctionDatabase
+from ..generators.mermaid_generator import MermaidGenerator
+from ..generators.rhapsody_generator import RhapsodyXmiGenerator
+from ..version import __version__
+
+# Fingerprint line of Mermaid metadata and of the XMI tool comment
+_FINGERPRINT_PATTERN = re.compile(r"Fingerprint(?:\*\*)?: `?([0-9a-f]{32})")
+# Both are written near the start of the document
+_FINGERPRINT_SEARCH_SIZE = 64 * 1024
+
+
+@dataclass
+class BatchOptions:
+    """Settings shared by all trees of a batch run."""
+
+    output_dir: Path
+    format: str = "mermaid"
+    max_depth: int = 3
+    max_nodes: Optional[int] = None
+    time_budget: Optional[float] = None
+    enable_loops: bool = False
+    enable_conditionals: bool = False
+    abbreviate_rte: bool = True
+    use_module_names: bool = False
+    max_messages: Optional[int] = None
+    split_by: str = "subtree"
+    rhapsody_package_path: Optional[str] = None
+    rhapsody_model_name: Optional[str] = None
+    rhapsody_deterministic_ids: bool = False
+    skip_unchanged: bool = False
+
+
+@dataclass
+class BatchResult:
+    """Outcome of one root function of a batch run."""
+
+    root_function: str
+    output_file: Optional[Path] = None
+    total_functions: int = 0
+    circular_dependencies: int = 0
+    errors: List[str] = field(default_factory=list)
+    skipped: bool = False  # Output file was up to date
+
+
+# Database and options of the current worker process, set by _init_batch_worker
+_worker_db: Optional[FunctionDatabase] = None
+_worker_options: Optional[BatchOptions] = None
+
+
+def _init_batch_worker(db: FunctionDatabase, options: BatchOptions) -> None:
+    """
+    Store the (fork-inherited) database and options in a worker process.
+
+    Args:
+        db: Loaded function database
+        options: Batch options
+    """
+    global _worker_db, _worker_options
+    _worker_db = db
+    _worker_options = options
+
+
+def _analyze_in_worker(root_function: str) -> BatchResult:
+    """
+    Analyze one root function in a worker process.
+
+    Args:
+        root_function: Name of the start function
+
+    Returns:
+        BatchResult for the root function
+    """
+    assert _worker_db is not None and _worker_options is not None
+    return analyze_root(_worker_db, root_function, _worker_options)
+
+
+def collect_start_functions(
+    db: FunctionDatabase,
+    names: Iterable[str] = (),
+    names_file: Optional[Path] = None,
+    pattern: Optional[str] = None,
+) -> List[str]:
+    """
+    Collect the root functions of a batch run.
+
+    Args:
+        db: Loaded function database
+        names: Function names given directly
+        names_file: File with one function name per line ('#' starts a comment)
+        pattern: Regular expression selecting function names from the database
+
+    Returns:
+        Function names in the given order, without duplicates
+
+    Raises:
+        ValueError: If the pattern is not a valid regular expression
+    """
+    roots: List[str] = list(names)
+
+    if names_file:
+        for line in names_file.read_text(encoding="utf-8").splitlines():
+            name = line.split("#", 1)[0].strip()
+            if name:
+                roots.append(name)
+
+    if pattern:
+        try:
+            re.compile(pattern)
+        except re.error as e:
+            raise ValueError(f"Invalid start function pattern '{pattern}': {e}")
+        roots.extend(sorted(db.search_function_names(pattern, mode="regex")))
+
+    return list(dict.fromkeys(roots))
+
+
+def get_output_file(root_function: str, options: BatchOptions) -> Path:
+    """
+    Get the output file of a root function.
+
+    Args:
+        root_function: Name of the start function
+        options: Batch options
+
+    Returns:
+        <output_dir>/<root>.md for Mermaid, <output_dir>/<root>.xmi for Rhapsody
+    """
+    suffix = ".xmi" if options.format == "rhapsody" else ".md"
+    return options.output_dir / f"{root_function}{suffix}"
+
+
+def tree_fingerprint(
+    db: FunctionDatabase, root_function: str, options: BatchOptions
+) -> Optional[str]:
+    """
+    Fingerprint everything the output file of a root function depends on.
+
+    That is the reachable function set of the root (SWR_DB_00047), the
+    batch options except the output directory, and the tool version.
+
+    Implements: SWR_CLI_00035 (Skip Unchanged Batch Outputs)
+
+    Args:
+        db: Loaded function database
+        root_function: Name of the start function
+        options: Batch options
+
+    Returns:
+        32 hex characters, or None if the root is unknown or the tree
+        depends on a time budget
+    """
+    if options.time_budget is not None:
+        return None
+    reachable = db.get_reachable_fingerprint(root_function, options.max_depth)
+    if reachable is None:
+        return None
+    settings = {
+        name: value
+        for name, value in asdict(options).items()
+        if name not in ("output_dir", "skip_unchanged")
+    }
+    key = repr((__version__, root_function, sorted(settings.items()), reachable))
+    return hashlib.blake2b(key.encode("utf-8"), digest_size=16).hexdigest()
+
+
+def read_output_fingerprint(output_file: Path) -> Optional[str]:
+    """
+    Read the fingerprint recorded in an output file.
+
+    Args:
+        output_file: Mermaid or XMI file written by a batch run
+
+    Returns:
+        Fingerprint, or None if the file is missing or has none
+    """
+    try:
+        with open(output_file, encoding="utf-8", errors="replace") as f:
+            head = f.read(_FINGERPRINT_SEARCH_SIZE)
+    except OSError:
+        return None
+    match = _FINGERPRINT_PATTERN.search(head)
+    return match.group(1) if match else None
+
+
+def analyze_root(
+    db: FunctionDatabase, root_function: str, options: BatchOptions
+) -> BatchResult:
+    """
+    Build the call tree of one root function and write its output file.
+
+    Errors are collected in the result so one bad root does not stop the batch.
+
+    Args:
+        db: Loaded function database
+        root_function: Name of the start function
+        options: Batch options
+
+    Returns:
+        BatchResult for the root function
+    """
+    batch_result = BatchResult(root_function=root_function)
+
+    try:
+        output_file = get_output_file(root_function, options)
+        fingerprint = tree_fingerprint(db, root_function, options)
+        if (
+            options.skip_unchanged
+            and fingerprint is not None
+            and read_output_fingerprint(output_file) == fingerprint
+        ):
+            batch_result.output_file = output_file
+            batch_result.skipped = True
+            return batch_result
+
+        result = CallTreeBuilder(db).build_tree(
+            start_function=root_function,
+            max_depth=options.max_depth,
+            enable_loops=options.enable_loops,
+            enable_conditionals=options.enable_conditionals,
+            max_nodes=options.max_nodes,
+            time_budget=options.time_budget,
+        )
+        if result.errors:
+            batch_result.errors = list(result.errors)
+            return batch_result
+
+        result.fingerprint = fingerprint
+        if options.format == "rhapsody":
+            RhapsodyXmiGenerator(
+                use_module_names=options.use_module_names,
+                package_path=options.rhapsody_package_path,
+                model_name=options.rhapsody_model_name,
+                deterministic_ids=options.rhapsody_deterministic_ids,
+            ).generate(result, str(output_file))
+        else:
+            MermaidGenerator(
+                abbreviate_rte=options.abbreviate_rte,
+                use_module_names=options.use_module_names,
+                max_messages=options.max_messages,
+                split_by=options.split_by,
+            ).generate(result, str(output_file))
+
+        batch_result.output_file = output_file
+        batch_result.total_functions = result.statistics.total_functions
+        batch_result.circular_dependencies = len(result.circular_dependencies)
+    except Exception as e:
+        batch_result.errors.append(str(e))
+
+    return batch_result
+
+
+def run_batch(
+    db: FunctionDatabase,
+    roots: List[str],
+    options: BatchOptions,
+    jobs: int = 1,
+) -> List[BatchResult]:
+    """
+    Analyze all root functions against one loaded database.
+
+    With jobs > 1 the trees are built in worker processes that inherit the
+    database by fork, so it is neither reloaded nor pickled; a background
+    cache write of the database is finished before forking. Platforms
+    without fork, or where no worker can be started, run the batch in
+    this process.
+
+    Implements: SWR_CLI_00026 (Batch Analysis Mode)
+
+    Args:
+        db: Loaded function database
+        roots: Root function names
+        options: Batch options
+        jobs: Number of worker processes
+
+    Returns:
+        BatchResult per root, in the order of roots
+    """
+    # Resolve the call graph once, before workers inherit the database
+    db.get_call_graph()
+
+    can_fork = "fork" in multiprocessing.get_all_start_methods()
+    if jobs > 1 and len(roots) > 1 and can_fork:
+        # Fork copies the locks and state of a background cache writer
+        db.wait_for_cache_write()
+        try:
+            with ProcessPoolExecutor(
+                max_workers=min(jobs, len(roots)),
+                mp_context=multiprocessing.get_context("fork"),
+                initializer=_init_batch_worker,
+                initargs=(db, options),
+            ) as executor:
+                return list(executor.map(_analyze_in_worker, roots))
+        except (OSError, BrokenProcessPool):
+            pass
+
+    return [analyze_root(db, root_function, options) for root_function in roots]
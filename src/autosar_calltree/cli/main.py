@@ -6,7 +6,7 @@ This module provides the main CLI entry point using Click.
 
 import sys
 from pathlib import Path
-from typing import Optional
+from typing import List, Optional, Tuple
 
 import click
 from rich.console import Console
@@ -16,10 +16,18 @@ from rich.table import Table
 from ..analyzers.call_tree_builder import CallTreeBuilder
 from ..config import PreprocessorConfig
 from ..config.module_config import ModuleConfig
+from ..database.cache_file import COMPRESSIONS
 from ..database.function_database import FunctionDatabase
-from ..generators.mermaid_generator import MermaidGenerator
+from ..database.graph_export import GRAPH_FORMATS, export_call_graph
+from ..database.name_index import SEARCH_MODES
+from ..database.sharding import ShardSpec, find_shard_fragments
+from ..generators.mermaid_generator import SPLIT_MODES, MermaidGenerator
 from ..generators.rhapsody_generator import RhapsodyXmiGenerator
+from ..server.analysis_server import AnalysisServer, AnalysisService
+from ..utils.parallel import resolve_jobs
+from ..utils.profiler import Profiler
 from ..version import __version__
+from .batch import BatchOptions, collect_start_functions, run_batch
 
 console = Console(record=True)
 
@@ -30,8 +38,10 @@ def _generate_mermaid_output(
     format,
     no_abbreviate_rte,
     use_module_names,
-) -> None:
-    """Generate Mermaid diagram output."""
+    max_messages=None,
+    split_by="subtree",
+) -> Path:
+    """Generate Mermaid diagram output and return the written file."""
     with Progress(
         SpinnerColumn(),
         TextColumn("[progress.description]{task.description}"),
@@ -49,6 +59,8 @@ def _generate_mermaid_output(
         generator = MermaidGenerator(
             abbreviate_rte=not no_abbreviate_rte,
             use_module_names=use_module_names,
+            max_messages=max_messages,
+            split_by=split_by,
         )
         generator.generate(result, str(mermaid_output))
 
@@ -57,10 +69,11 @@ def _generate_mermaid_output(
     console.print(
         f"[green]Generated[/green] Mermaid diagram: [cyan]{mermaid_output}[/cyan]"
     )
+    return mermaid_output
 
 
-def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_package_path=None, rhapsody_model_name=None) -> None:
-    """Generate Rhapsody-compatible XMI output."""
+def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_package_path=None, rhapsody_model_name=None, rhapsody_deterministic_ids=False) -> Path:
+    """Generate Rhapsody-compatible XMI output and return the written file."""
     with Progress(
         SpinnerColumn(),
         TextColumn("[progress.description]{task.description}"),
@@ -75,7 +88,7 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
             else output_path
         )
 
-        generator = RhapsodyXmiGenerator(use_module_names=use_module_names, package_path=rhapsody_package_path, model_name=rhapsody_model_name)
+        generator = RhapsodyXmiGenerator(use_module_names=use_module_names, package_path=rhapsody_package_path, model_name=rhapsody_model_name, deterministic_ids=rhapsody_deterministic_ids)
         generator.generate(result, str(rhapsody_output))
 
         progress.update(task, completed=True)
@@ -83,14 +96,123 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
     console.print(
         f"[green]Generated[/green] Rhapsody XMI: [cyan]{rhapsody_output}[/cyan]"
     )
+    return rhapsody_output
+
+
+def _run_batch_mode(db, roots: List[str], options: BatchOptions, jobs: int) -> None:
+    """Build and write the call trees of all batch roots (SWR_CLI_00026)."""
+    console.print(
+        f"[bold]Batch analysis of {len(roots)} start functions[/bold] "
+        f"(output: [cyan]{options.output_dir}[/cyan])"
+    )
+
+    results = run_batch(db, roots, options, jobs=jobs)
+
+    failed = 0
+    skipped = 0
+    for batch_result in results:
+        if batch_result.errors:
+            failed += 1
+            console.print(
+                f"  [red]FAILED[/red] {batch_result.root_function}: "
+                f"{'; '.join(batch_result.errors)}"
+            )
+        elif batch_result.skipped:
+            skipped += 1
+            console.print(
+                f"  [cyan]UNCHANGED[/cyan] {batch_result.root_function}: "
+                f"[cyan]{batch_result.output_file}[/cyan]"
+            )
+        else:
+            console.print(
+                f"  [green]OK[/green] {batch_result.root_function}: "
+                f"{batch_result.total_functions} functions -> "
+                f"[cyan]{batch_result.output_file}[/cyan]"
+            )
+
+    summary = f"Generated {len(results) - failed - skipped} of {len(results)} diagrams"
+    if skipped:
+        summary += f", {skipped} unchanged"
+    console.print(f"\n[bold]{summary}[/bold]")
+    if failed:
+        sys.exit(1)
+
+
+def _parse_shard(
+    ctx: click.Context, param: click.Parameter, value: Optional[str]
+) -> Optional[ShardSpec]:
+    """Convert --shard i/N into a ShardSpec (SWR_CLI_00034)."""
+    if value is None:
+        return None
+    try:
+        return ShardSpec.parse(value)
+    except ValueError as e:
+        raise click.BadParameter(str(e)) from e
+
+
+def _print_profile(
+    profiler: Profiler, top: int, profile_output: Optional[str]
+) -> None:
+    """Print the profile report and write the trace file (SWR_CLI_00030)."""
+    console.print("\n[bold]Profile:[/bold]")
+    console.print(
+        profiler.format_report(top), markup=False, highlight=False, soft_wrap=True
+    )
+    if profile_output:
+        profiler.write(Path(profile_output))
+        console.print(f"[green]Wrote profile trace:[/green] {profile_output}")
+
+
+def _run_server(
+    service: AnalysisService, port: int, watch_interval: float, verbose: bool
+) -> None:
+    """Serve queries from the warm database until interrupted (SWR_SERVER_00001)."""
+    server = AnalysisServer(service, port=port, verbose=verbose)
+    host, bound_port = server.server_address[:2]
+
+    if watch_interval > 0:
+        service.start_watching(watch_interval)
+
+    console.print(
+        f"[bold green]Serving[/bold green] {service.db.total_functions_found} "
+        f"functions on [cyan]http://{host}:{bound_port}[/cyan] (Ctrl+C to stop)"
+    )
+    console.print("  Endpoints: /status, /functions, /search?pattern=, /tree?start=")
+
+    try:
+        server.serve_forever()
+    finally:
+        service.stop()
+        server.server_close()
 
 
 @click.command()
 @click.option(
     "--start-function",
     "-s",
+    multiple=True,
     required=False,  # Not required if --list-functions or --search is used
-    help="Name of the function to start call tree from",
+    help="Name of the function to start call tree from (repeat for batch mode)",
+)
+@click.option(
+    "--start-functions-file",
+    type=click.Path(exists=True, file_okay=True, dir_okay=False),
+    help="Batch mode: file with one start function per line ('#' comments allowed)",
+)
+@click.option(
+    "--start-pattern",
+    type=str,
+    help="Batch mode: regular expression selecting start functions by name",
+)
+@click.option(
+    "--output-dir",
+    type=click.Path(file_okay=False, dir_okay=True),
+    help="Batch mode: directory for one output file per start function (default: directory of --output)",
+)
+@click.option(
+    "--skip-unchanged",
+    is_flag=True,
+    help="Batch mode: keep output files whose recorded fingerprint matches the current call tree inputs",
 )
 @click.option(
     "--max-depth",
@@ -99,6 +221,23 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
     type=int,
     help="Maximum depth to traverse (default: 3)",
 )
+@click.option(
+    "--max-nodes",
+    type=click.IntRange(min=1),
+    default=None,
+    help="Stop expanding the tree after this many nodes and mark the rest as truncated",
+)
+@click.option(
+    "--time-budget",
+    type=click.FloatRange(min=0),
+    default=None,
+    help="Stop expanding the tree after this many seconds and mark the rest as truncated",
+)
+@click.option(
+    "--breadth-first",
+    is_flag=True,
+    help="Build the tree one level at a time and rewrite the output after each level",
+)
 @click.option(
     "--source-dir",
     "-i",
@@ -127,6 +266,17 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
 )
 @click.option("--no-cache", is_flag=True, help="Disable cache usage")
 @click.option("--rebuild-cache", is_flag=True, help="Force rebuild of cache")
+@click.option(
+    "--cache-compression",
+    type=click.Choice(COMPRESSIONS),
+    default="none",
+    help="Compress the cache files (zstd and lz4 need autosar-calltree[compression]; default: none)",
+)
+@click.option(
+    "--background-cache-write",
+    is_flag=True,
+    help="Write the cache in a background thread while the results are generated",
+)
 @click.option("--verbose", "-v", is_flag=True, help="Enable verbose output")
 @click.option(
     "--list-functions", "-l", is_flag=True, help="List all available functions and exit"
@@ -134,6 +284,29 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
 @click.option(
     "--search", type=str, help="Search for functions matching pattern and exit"
 )
+@click.option(
+    "--search-mode",
+    type=click.Choice(SEARCH_MODES),
+    default="substring",
+    help="How --search matches names: case-insensitive substring or prefix, or a regular expression (default: substring)",
+)
+@click.option(
+    "--search-limit",
+    type=click.IntRange(min=1),
+    default=None,
+    help="Show at most N --search results (default: all)",
+)
+@click.option(
+    "--export-graph",
+    type=click.Path(dir_okay=False),
+    help="Export the whole call graph (all functions and calls) to a file and exit",
+)
+@click.option(
+    "--graph-format",
+    type=click.Choice(GRAPH_FORMATS),
+    default=None,
+    help="Format of --export-graph: compact binary columns, GraphML or JSON Lines (default: from the file suffix, binary otherwise)",
+)
 @click.option(
     "--no-abbreviate-rte",
     is_flag=True,
@@ -149,6 +322,30 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
     default=True,
     help="Use SW module names as Mermaid participants (default: True, requires --module-config)",
 )
+@click.option(
+    "--module-graph",
+    is_flag=True,
+    default=False,
+    help="Write a module-level diagram of the whole codebase (module to module calls) to --output and exit (mermaid format only, requires --module-config)",
+)
+@click.option(
+    "--max-messages",
+    type=click.IntRange(min=1),
+    default=None,
+    help="Split Mermaid sequence diagrams with more than N messages into linked parts (default: never split)",
+)
+@click.option(
+    "--split-by",
+    type=click.Choice(SPLIT_MODES),
+    default="subtree",
+    help="Calls that may start a part of a split diagram: any call (subtree) or calls into another SW module (module) (default: subtree)",
+)
+@click.option(
+    "--callers",
+    is_flag=True,
+    default=False,
+    help="Build the inverted tree of all functions calling --start-function, up to --max-depth caller levels (mermaid format only)",
+)
 @click.option(
     "--enable-loops",
     is_flag=True,
@@ -173,6 +370,12 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
     default=None,
     help="Custom name for the UML model in Rhapsody XMI output (default: CallTree_{root_function})",
 )
+@click.option(
+    "--rhapsody-deterministic-ids",
+    is_flag=True,
+    default=False,
+    help="Derive Rhapsody XMI element IDs from the call tree instead of random UUIDs, so that repeated exports are identical (default: False)",
+)
 @click.option(
     "--cpp-config",
     type=click.Path(exists=True),
@@ -181,7 +384,7 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
 @click.option(
     "--keep-temp",
     is_flag=True,
-    help="Keep preprocessed files for debugging (default: clean up)",
+    help="Write preprocessed .i files and keep them for debugging (default: cpp output is streamed into the parser)",
 )
 @click.option(
     "--temp-dir",
@@ -193,30 +396,120 @@ def _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_pa
     is_flag=True,
     help="Run only preprocessing stage (for debugging preprocessing issues)",
 )
+@click.option(
+    "--jobs",
+    "-j",
+    type=click.IntRange(min=1),
+    default=None,
+    help="Number of parallel workers for preprocessing, parsing and batch analysis (default: CPU count)",
+)
+@click.option(
+    "--shard",
+    callback=_parse_shard,
+    metavar="I/N",
+    help="Parse only shard I of N of the source files and write its cache fragment to --cache-dir",
+)
+@click.option(
+    "--merge-shards",
+    type=click.Path(exists=True, file_okay=False, dir_okay=True),
+    help="Merge the cache fragments of all --shard builds in this directory into the cache",
+)
+@click.option(
+    "--serve",
+    is_flag=True,
+    help="Keep the database in memory and answer queries over local HTTP",
+)
+@click.option(
+    "--port",
+    type=click.IntRange(min=0, max=65535),
+    default=8765,
+    help="Port for --serve on 127.0.0.1 (default: 8765)",
+)
+@click.option(
+    "--watch-interval",
+    type=click.FloatRange(min=0),
+    default=2.0,
+    help="Seconds between source directory polls in --serve mode, 0 disables watching (default: 2.0)",
+)
+@click.option(
+    "--lazy",
+    is_flag=True,
+    help="Parse only the files defining functions reachable from --start-function",
+)
+@click.option(
+    "--fast-parse",
+    is_flag=True,
+    help="Take traditional C definitions from the lexical scanner instead of pycparser (faster; not with --enable-loops/--enable-conditionals)",
+)
+@click.option(
+    "--profile",
+    is_flag=True,
+    help="Print wall time, CPU time and bytes of every stage and the slowest files",
+)
+@click.option(
+    "--profile-output",
+    type=click.Path(dir_okay=False),
+    help="Write the profile as a Chrome trace JSON file (implies --profile)",
+)
+@click.option(
+    "--profile-top",
+    type=click.IntRange(min=1),
+    default=10,
+    help="Number of slowest files in the profile report (default: 10)",
+)
 @click.version_option(version=__version__, prog_name="autosar-calltree")
 def cli(
-    start_function: str,
+    start_function: Tuple[str, ...],
+    start_functions_file: Optional[str],
+    start_pattern: Optional[str],
+    output_dir: Optional[str],
+    skip_unchanged: bool,
     max_depth: int,
+    max_nodes: Optional[int],
+    time_budget: Optional[float],
+    breadth_first: bool,
     source_dir: str,
     output: str,
     format: str,
     cache_dir: Optional[str],
     no_cache: bool,
     rebuild_cache: bool,
+    cache_compression: str,
+    background_cache_write: bool,
     verbose: bool,
     list_functions: bool,
     search: Optional[str],
+    search_mode: str,
+    search_limit: Optional[int],
+    export_graph: Optional[str],
+    graph_format: Optional[str],
     no_abbreviate_rte: bool,
     module_config: Optional[str],
     use_module_names: bool,
+    module_graph: bool,
+    max_messages: Optional[int],
+    split_by: str,
+    callers: bool,
     enable_loops: bool,
     enable_conditionals: bool,
     rhapsody_package_path: Optional[str],
     rhapsody_model_name: Optional[str],
+    rhapsody_deterministic_ids: bool,
     cpp_config: Optional[str],
     keep_temp: bool,
     temp_dir: Optional[str],
     preprocess_only: bool,
+    jobs: Optional[int],
+    shard: Optional[ShardSpec],
+    merge_shards: Optional[str],
+    serve: bool,
+    port: int,
+    watch_interval: float,
+    lazy: bool,
+    fast_parse: bool,
+    profile: bool,
+    profile_output: Optional[str],
+    profile_top: int,
 ):
     """
     AUTOSAR Call Tree Analyzer
@@ -224,6 +517,8 @@ def cli(
     Analyzes C/AUTOSAR codebases and generates function call trees
     with Mermaid sequence diagrams or XMI output.
     """
+    profiler = Profiler(enabled=profile or bool(profile_output))
+    db: Optional[FunctionDatabase] = None
     try:
         # Print banner
         if not verbose:
@@ -291,6 +586,47 @@ def cli(
                 console.print(f"[bold red]Error loading preprocessor config:[/bold red] {e}")
                 sys.exit(1)
 
+        # What the database is built for
+        batch_mode = bool(
+            len(start_function) > 1 or start_functions_file or start_pattern
+        )
+        database_query = bool(
+            list_functions or search or export_graph or module_graph or serve
+        )
+        builds_cache_only = bool(preprocess_only or shard or merge_shards)
+
+        # Lazy parsing only serves a single call tree
+        single_call_tree = len(start_function) == 1 and not (
+            batch_mode or database_query or callers
+        )
+        lazy_tree = lazy and single_call_tree and not builds_cache_only
+        if lazy and not lazy_tree:
+            console.print(
+                "[yellow]Warning:[/yellow] --lazy applies only to a single "
+                "--start-function call tree; building the full database"
+            )
+
+        # Conditional and loop tracking is reserved for the pycparser AST
+        needs_full_parse = not fast_parse or enable_loops or enable_conditionals
+        if fast_parse and needs_full_parse:
+            console.print(
+                "[yellow]Warning:[/yellow] --fast-parse is ignored with "
+                "--enable-loops/--enable-conditionals; parsing with pycparser"
+            )
+
+        if max_messages is not None and format != "mermaid":
+            console.print(
+                "[yellow]Warning:[/yellow] --max-messages applies only to the "
+                "mermaid format"
+            )
+
+        if shard and merge_shards:
+            console.print(
+                "[bold red]Error:[/bold red] --shard and --merge-shards cannot be "
+                "combined"
+            )
+            sys.exit(1)
+
         # Initialize database
         use_cache = not no_cache
 
@@ -310,16 +646,49 @@ def cli(
                 preprocessor_config=preprocessor_cfg,
                 temp_dir=temp_dir,
                 keep_temp=keep_temp,
+                jobs=jobs,
+                profiler=profiler,
+                full_parse=needs_full_parse,
+                cache_compression=cache_compression,
+                background_cache_write=background_cache_write,
             )
-            db.build_database(
-                use_cache=use_cache,
-                rebuild_cache=rebuild_cache,
-                verbose=verbose,
-                preprocess_only=preprocess_only,
-            )
+            if shard:
+                fragment_file = db.build_shard(shard, verbose=verbose)
+            elif merge_shards:
+                db.merge_shards(
+                    find_shard_fragments(Path(merge_shards)), verbose=verbose
+                )
+            else:
+                db.build_database(
+                    use_cache=use_cache,
+                    rebuild_cache=rebuild_cache,
+                    verbose=verbose,
+                    preprocess_only=preprocess_only,
+                    lazy=lazy_tree,
+                )
 
             progress.update(task, completed=True)
 
+        # Shard builds only write their fragment
+        if shard:
+            console.print(
+                f"[green]Wrote shard {shard} fragment:[/green] {fragment_file} "
+                f"({db.total_files_scanned} files, "
+                f"{db.total_functions_found} functions)"
+            )
+            return
+
+        # A merge may be followed by any query of the merged database
+        if merge_shards:
+            console.print(
+                f"[green]Merged shard fragments into:[/green] {db.cache_file} "
+                f"({db.total_files_scanned} files, {db.total_functions_found} "
+                f"functions, {len(db.parse_errors)} parse errors)"
+            )
+            has_query = bool(start_function) or batch_mode or database_query
+            if not has_query:
+                return
+
         # If preprocess-only mode, exit after preprocessing
         if preprocess_only:
             console.print("\n[bold green]Preprocessing complete![/bold green]")
@@ -351,6 +720,69 @@ def cli(
                     console.print(f"  {module}: {count} functions")
             console.print()
 
+        # Server mode: answer queries from the warm database
+        if serve:
+
+            def rebuild_database() -> FunctionDatabase:
+                new_db = FunctionDatabase(
+                    source_dir,
+                    cache_dir=cache_dir,
+                    module_config=config,
+                    preprocessor_config=preprocessor_cfg,
+                    temp_dir=temp_dir,
+                    keep_temp=keep_temp,
+                    jobs=jobs,
+                    full_parse=needs_full_parse,
+                    cache_compression=cache_compression,
+                )
+                new_db.build_database(use_cache=use_cache, verbose=verbose)
+                return new_db
+
+            service = AnalysisService(
+                db,
+                rebuild_database,
+                use_module_names=use_module_names,
+                abbreviate_rte=not no_abbreviate_rte,
+            )
+            _run_server(service, port, watch_interval, verbose)
+            return
+
+        # Handle call graph export
+        if export_graph:
+            with profiler.stage("export_graph") as stage:
+                export_stats = export_call_graph(db, Path(export_graph), graph_format)
+                stage.bytes = Path(export_graph).stat().st_size
+            console.print(
+                f"[green]Exported call graph:[/green] {export_graph} "
+                f"({export_stats.nodes} nodes, {export_stats.edges} edges, "
+                f"{export_stats.unresolved_edges} unresolved)"
+            )
+            return
+
+        # Module-level diagram from the aggregated module graph
+        if module_graph:
+            if format != "mermaid":
+                console.print(
+                    "[bold red]Error:[/bold red] --module-graph supports the "
+                    "mermaid format only"
+                )
+                sys.exit(1)
+            if not config:
+                console.print(
+                    "[bold red]Error:[/bold red] --module-graph requires "
+                    "--module-config"
+                )
+                sys.exit(1)
+            with profiler.stage("module_graph_output"):
+                graph = db.get_module_graph()
+                MermaidGenerator().generate_module_graph(graph, output)
+            console.print(
+                f"[green]Generated module graph:[/green] {output} "
+                f"({len(graph.modules)} modules, "
+                f"{len(graph.dependencies())} module dependencies)"
+            )
+            return
+
         # Handle list functions
         if list_functions:
             console.print("[bold]Available Functions:[/bold]\n")
@@ -364,7 +796,7 @@ def cli(
         if search:
             console.print()
             console.print(f"[bold]Search Results for '{search}':[/bold]\n")
-            results = db.search_functions(search)
+            results = db.search_functions(search, mode=search_mode, limit=search_limit)
             if results:
                 for func_info in results:
                     file_name = Path(func_info.file_path).name
@@ -372,40 +804,165 @@ def cli(
                         f"  [cyan]{func_info.name}[/cyan] "
                         f"({file_name}:{func_info.line_number})"
                     )
-                console.print(f"\n[cyan]Found {len(results)} matches[/cyan]")
+                if len(results) == search_limit:
+                    console.print(
+                        f"\n[cyan]Showing the first {len(results)} matches[/cyan]"
+                    )
+                else:
+                    console.print(f"\n[cyan]Found {len(results)} matches[/cyan]")
             else:
                 console.print(
                     f"[yellow]No functions found matching '{search}'[/yellow]"
                 )
             return
 
+        # Batch mode: several start functions against one loaded database
+        if batch_mode:
+            if callers:
+                console.print(
+                    "[bold red]Error:[/bold red] --callers takes a single "
+                    "--start-function"
+                )
+                sys.exit(1)
+            roots = collect_start_functions(
+                db,
+                names=start_function,
+                names_file=Path(start_functions_file) if start_functions_file else None,
+                pattern=start_pattern,
+            )
+            if not roots:
+                console.print("[bold red]Error:[/bold red] No start functions selected")
+                sys.exit(1)
+
+            batch_options = BatchOptions(
+                output_dir=Path(output_dir) if output_dir else Path(output).parent,
+                format=format,
+                max_depth=max_depth,
+                max_nodes=max_nodes,
+                time_budget=time_budget,
+                enable_loops=enable_loops,
+                enable_conditionals=enable_conditionals,
+                abbreviate_rte=not no_abbreviate_rte,
+                use_module_names=use_module_names,
+                max_messages=max_messages,
+                split_by=split_by,
+                rhapsody_package_path=rhapsody_package_path,
+                rhapsody_model_name=rhapsody_model_name,
+                rhapsody_deterministic_ids=rhapsody_deterministic_ids,
+                skip_unchanged=skip_unchanged,
+            )
+            with profiler.stage("batch"):
+                _run_batch_mode(db, roots, batch_options, resolve_jobs(jobs))
+            return
+
+        root_function = start_function[0] if start_function else None
+        if skip_unchanged:
+            console.print(
+                "[yellow]Warning:[/yellow] --skip-unchanged applies only to "
+                "batch mode"
+            )
+
         # Validate start_function is provided if not using list/search
-        if not start_function:
+        if not root_function:
             console.print("[bold red]Error:[/bold red] --start-function is required")
             console.print("Use --list-functions to see available functions")
             sys.exit(1)
 
-        # Build call tree
-        with Progress(
-            SpinnerColumn(),
-            TextColumn("[progress.description]{task.description}"),
-            console=console,
-            transient=True,
-        ) as progress:
-            task = progress.add_task(
-                f"Building call tree for {start_function}...", total=None
+        if callers and format != "mermaid":
+            console.print(
+                "[bold red]Error:[/bold red] --callers supports only the mermaid format"
             )
+            sys.exit(1)
 
-            builder = CallTreeBuilder(db)
-            result = builder.build_tree(
-                start_function=start_function,
-                max_depth=max_depth,
-                verbose=verbose,
-                enable_loops=enable_loops,
-                enable_conditionals=enable_conditionals,
+        output_path = Path(output)
+
+        def write_output(tree_result) -> None:
+            if format == "mermaid":
+                with profiler.stage("mermaid") as stage:
+                    written = _generate_mermaid_output(
+                        tree_result,
+                        output_path,
+                        format,
+                        no_abbreviate_rte,
+                        use_module_names,
+                        max_messages,
+                        split_by,
+                    )
+                    stage.bytes = written.stat().st_size
+
+            if format == "rhapsody":
+                with profiler.stage("rhapsody") as stage:
+                    written = _generate_rhapsody_output(
+                        tree_result,
+                        output_path,
+                        use_module_names,
+                        rhapsody_package_path,
+                        rhapsody_model_name,
+                        rhapsody_deterministic_ids,
+                    )
+                    stage.bytes = written.stat().st_size
+
+        builder = CallTreeBuilder(db)
+        tree_options = dict(
+            max_depth=max_depth,
+            verbose=verbose,
+            enable_loops=enable_loops,
+            enable_conditionals=enable_conditionals,
+            max_nodes=max_nodes,
+            time_budget=time_budget,
+        )
+        if breadth_first:
+            # Write every complete level, so the top of the tree is usable
+            # while the deeper levels are still being built
+            levels = builder.iter_tree_levels(
+                root_function, callers=callers, **tree_options
             )
+            level = 0
+            while True:
+                with profiler.stage("build_tree"):
+                    level_result = next(levels, None)
+                if level_result is None:
+                    break
+                result = level_result
+                if result.errors:
+                    break
+                if result.truncation is None:
+                    level += 1
+                    console.print(
+                        f"[cyan]Level {level}:[/cyan] "
+                        f"{result.statistics.total_functions} functions"
+                    )
+                else:
+                    console.print(
+                        "[yellow]Final level:[/yellow] "
+                        f"{result.truncation.describe()}"
+                    )
+                write_output(result)
+        else:
+            # Build call tree
+            with Progress(
+                SpinnerColumn(),
+                TextColumn("[progress.description]{task.description}"),
+                console=console,
+                transient=True,
+            ) as progress:
+                tree_kind = "caller tree" if callers else "call tree"
+                task = progress.add_task(
+                    f"Building {tree_kind} for {root_function}...", total=None
+                )
 
-            progress.update(task, completed=True)
+                build = builder.build_caller_tree if callers else builder.build_tree
+                with profiler.stage("build_tree"):
+                    result = build(root_function, **tree_options)
+
+                progress.update(task, completed=True)
+
+        if lazy_tree:
+            db.save_lazy_cache(verbose)
+            if verbose:
+                console.print(
+                    f"[cyan]Parsed {db.lazy_files_parsed} files on demand[/cyan]"
+                )
 
         # Check for errors
         if result.errors:
@@ -423,6 +980,9 @@ def cli(
             console.print(
                 f"  - Unique functions: [cyan]{result.statistics.unique_functions}[/cyan]"
             )
+            if result.statistics.physical_nodes < result.statistics.total_functions:
+                physical_nodes = result.statistics.physical_nodes
+                console.print(f"  - Shared tree nodes: [cyan]{physical_nodes}[/cyan]")
             console.print(
                 f"  - Max depth: [cyan]{result.statistics.max_depth_reached}[/cyan]"
             )
@@ -431,18 +991,14 @@ def cli(
                     f"  - Circular dependencies: "
                     f"[yellow]{result.statistics.circular_dependencies_found}[/yellow]"
                 )
+            if result.truncation:
+                console.print(
+                    f"  - Truncated: [yellow]{result.truncation.describe()}[/yellow]"
+                )
             console.print()
 
-        # Generate output
-        output_path = Path(output)
-
-        if format == "mermaid":
-            _generate_mermaid_output(
-                result, output_path, format, no_abbreviate_rte, use_module_names
-            )
-
-        if format == "rhapsody":
-            _generate_rhapsody_output(result, output_path, use_module_names, rhapsody_package_path, rhapsody_model_name)
+        if not breadth_first:
+            write_output(result)
 
         # Print warnings for circular dependencies
         if result.circular_dependencies:
@@ -465,6 +1021,12 @@ def cli(
         if verbose:
             console.print_exception()
         sys.exit(1)
+    finally:
+        # A background cache write finishes after the results are output
+        if db is not None:
+            db.wait_for_cache_write(verbose)
+        if profiler.enabled:
+            _print_profile(profiler, profile_top, profile_output)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,545 @@
+"""
+Memory-mapped binary cache.
+
+This module writes the columnar function store, the lookup indexes, the
+name search index and the resolved call graph with its reverse index
+into one versioned binary file, and maps it back into memory on load.
+Columns and indexes are used in place as memoryviews of the mapping:
+strings are decoded and functions are materialized only when a lookup
+reaches them, so startup does not depend on the database size.
+
+File layout (native byte order, sections aligned to 8 bytes):
+
+    magic (8 bytes) | header offset (u64) | header length (u64)
+    section data ...
+    header (JSON: version, token, section table, called_by)
+
+A compressed binary cache is this layout inside a cache container
+(cache_file.py); it is decompressed into memory instead of being mapped.
+
+Requirements:
+- SWR_DB_00040: Memory-Mapped Binary Cache
+- SWR_DB_00041: Indexed Name Search
+- SWR_DB_00042: Reverse Call Graph Index
+- SWR_DB_00049: Versioned Compressed Cache Files
+"""
+
+import json
+import mmap
+import struct
+import sys
+import uuid
+import zlib
+from array import array
+from dataclasses import dataclass
+from pathlib import Path
+from typing import (
+    BinaryIO,
+    Dict,
+    Iterator,
+    List,
+    Mapping,
+    Optional,
+    Sequence,
+    Tuple,
+    Union,
+)
+
+from .cache_file import (
+    CacheFormatError,
+    CacheSchema,
+    atomic_write,
+    compress_file,
+    read_compressed_file,
+)
+from .call_graph import CallGraph
+from .function_store import STORE_COLUMNS, FunctionStore, StringTable
+from .name_index import NameSearchIndex
+
+BINARY_CACHE_MAGIC = b"ACTSTORE"
+
+# Increment when the layout of the file changes
+BINARY_CACHE_VERSION = 3
+
+# Preamble and section alignment of the layout, shared with graph_export.py
+SECTION_PREAMBLE = struct.Struct("<8sQQ")
+SECTION_ALIGNMENT = 8
+_EMPTY_SLOT = -1
+
+# Indexes stored in the file; values are lists of function IDs, except for
+# the qualified index, which maps every key to a single function ID
+INDEX_NAMES = ("functions", "qualified_functions", "functions_by_file")
+_SINGLE_VALUE_INDEXES = ("qualified_functions",)
+
+# Integer sequences of NameSearchIndex; its names are the keys of "functions"
+_NAME_SEARCH_SECTIONS = (
+    "sorted_positions",
+    "trigram_keys",
+    "trigram_offsets",
+    "trigram_postings",
+)
+
+# Call graph sections, in the order of the CallGraph constructor arguments
+_CALL_GRAPH_SECTIONS = ("callee_ids", "caller_offsets", "caller_rows")
+
+
+class BinaryCacheError(Exception):
+    """The binary cache file is missing, damaged or does not match."""
+
+
+class MappedStringTable(StringTable):
+    """
+    String table read in place from a memory-mapped cache.
+
+    Strings are UTF-8 slices of one blob; a string is decoded on first
+    access. find() uses an open-addressing hash table of the file (CRC32,
+    linear probing), so looking up a name does not decode the other
+    strings. The first intern() decodes all strings into a regular table.
+
+    Implements: SWR_DB_00040 (Memory-Mapped Binary Cache)
+    """
+
+    def __init__(
+        self, blob: memoryview, offsets: memoryview, hash_slots: memoryview
+    ):
+        """
+        Initialize the table over mapped sections.
+
+        Args:
+            blob: Concatenated UTF-8 strings
+            offsets: Start offset of every string in blob, plus the end
+            hash_slots: String IDs by hash slot (_EMPTY_SLOT for free slots)
+        """
+        super().__init__()
+        self._blob: Optional[memoryview] = blob
+        self._offsets = offsets
+        self._hash_slots = hash_slots
+        self._decoded: Dict[int, str] = {}
+
+    def __len__(self) -> int:
+        """Number of strings."""
+        if self._blob is None:
+            return len(self.strings)
+        return len(self._offsets) - 1
+
+    def __getitem__(self, string_id: int) -> str:
+        """Get a string by ID, decoding it on first access."""
+        if self._blob is None:
+            return self.strings[string_id]
+        value = self._decoded.get(string_id)
+        if value is None:
+            if string_id < 0:
+                raise IndexError(string_id)
+            value = self._decoded[string_id] = str(
+                self._blob[
+                    self._offsets[string_id] : self._offsets[string_id + 1]
+                ],
+                "utf-8",
+            )
+        return value
+
+    def find(self, value: str) -> Optional[int]:
+        """
+        Get the ID of a string using the hash table of the file.
+
+        Args:
+            value: String to look up
+
+        Returns:
+            String ID, or None if the string is not in the table
+        """
+        if self._blob is None:
+            return super().find(value)
+        encoded = value.encode("utf-8")
+        mask = len(self._hash_slots) - 1
+        slot = zlib.crc32(encoded) & mask
+        while True:
+            string_id = self._hash_slots[slot]
+            if string_id == _EMPTY_SLOT:
+                return None
+            start = self._offsets[string_id]
+            if self._blob[start : self._offsets[string_id + 1]] == encoded:
+                return string_id
+            slot = (slot + 1) & mask
+
+    def intern(self, value: Optional[str]) -> int:
+        """Get the ID of a string, adding it if needed."""
+        if self._blob is not None and value is not None:
+            self._unmap()
+        return super().intern(value)
+
+    def __getstate__(self) -> Dict[str, List[str]]:
+        """Pickle all strings; the mapping itself cannot be pickled."""
+        return {"strings": [self[string_id] for string_id in range(len(self))]}
+
+    def __setstate__(self, state: Dict[str, List[str]]) -> None:
+        """Restore a pickled table as a regular in-memory table."""
+        super().__setstate__(state)
+        self._blob = None
+        self._decoded = {}
+
+    def _unmap(self) -> None:
+        """Decode all strings into the regular table before adding one."""
+        self.strings = [self[string_id] for string_id in range(len(self))]
+        self._ids = {string: index for index, string in enumerate(self.strings)}
+        self._blob = None
+        self._decoded = {}
+
+
+class MappedIdIndex(Mapping[str, Union[Sequence[int], int]]):
+    """
+    Read-only index of the cache: key -> function IDs, without a dictionary.
+
+    Keys are string IDs in insertion order; key_slots maps a string ID to
+    its position among the keys (-1 if the string is no key), and the
+    values of key number k are values[offsets[k]:offsets[k + 1]].
+
+    Implements: SWR_DB_00040 (Memory-Mapped Binary Cache)
+    """
+
+    def __init__(
+        self,
+        strings: StringTable,
+        keys: Sequence[int],
+        key_slots: Sequence[int],
+        offsets: Sequence[int],
+        values: Sequence[int],
+        single: bool = False,
+    ):
+        """
+        Initialize the index over mapped sections.
+
+        Args:
+            strings: String table of the cache
+            keys: String IDs of the keys, in insertion order
+            key_slots: Key position by string ID
+            offsets: Start of the values of every key, plus the end
+            values: Function IDs of all keys
+            single: Return one function ID per key instead of a sequence
+        """
+        self.strings = strings
+        self.key_ids = keys
+        self.key_slots = key_slots
+        self.offsets = offsets
+        self.values = values
+        self.single = single
+
+    def _slot(self, key: object) -> int:
+        """Get the key position of a key, or -1."""
+        if not isinstance(key, str):
+            return -1
+        string_id = self.strings.find(key)
+        if string_id is None or string_id >= len(self.key_slots):
+            return -1
+        return self.key_slots[string_id]
+
+    def __getitem__(self, key: str) -> Union[Sequence[int], int]:
+        """Get the function IDs (or the single function ID) of a key."""
+        slot = self._slot(key)
+        if slot < 0:
+            raise KeyError(key)
+        if self.single:
+            return self.values[self.offsets[slot]]
+        return self.values[self.offsets[slot] : self.offsets[slot + 1]]
+
+    def __contains__(self, key: object) -> bool:
+        """Check for a key without decoding other keys."""
+        return self._slot(key) >= 0
+
+    def __iter__(self) -> Iterator[str]:
+        """Iterate over the keys in insertion order."""
+        strings = self.strings
+        return (strings[string_id] for string_id in self.key_ids)
+
+    def __len__(self) -> int:
+        """Number of keys."""
+        return len(self.key_ids)
+
+    def key_sequence(self) -> Sequence[str]:
+        """Get the keys as a sequence indexed by key position."""
+        return _KeySequence(self.strings, self.key_ids)
+
+
+class _KeySequence(Sequence[str]):
+    """Keys of a MappedIdIndex by position, decoded on access."""
+
+    def __init__(self, strings: StringTable, key_ids: Sequence[int]):
+        self.strings = strings
+        self.key_ids = key_ids
+
+    def __getitem__(self, position):  # type: ignore[override]
+        """Get the key at a position."""
+        if isinstance(position, slice):
+            return [self.strings[string_id] for string_id in self.key_ids[position]]
+        return self.strings[self.key_ids[position]]
+
+    def __len__(self) -> int:
+        """Number of keys."""
+        return len(self.key_ids)
+
+
+@dataclass
+class MappedCache:
+    """Content of a binary cache file, used in place."""
+
+    store: FunctionStore
+    indexes: Dict[str, MappedIdIndex]
+    name_search: NameSearchIndex
+    call_graph: CallGraph
+
+
+def write_binary_cache(
+    path: Path,
+    store: FunctionStore,
+    indexes: Mapping[str, Mapping[str, Union[Sequence[int], int]]],
+    name_search: NameSearchIndex,
+    call_graph: CallGraph,
+    compression: str = "none",
+) -> str:
+    """
+    Write the store, indexes and call graph into a binary cache file.
+
+    The file is written next to path and renamed over it, so a reader
+    never sees a partly written file.
+
+    Implements: SWR_DB_00040 (Memory-Mapped Binary Cache)
+    Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+    Args:
+        path: Binary cache file
+        store: Function store to write
+        indexes: Index name (INDEX_NAMES) -> key -> function IDs
+        name_search: Search index built from the keys of indexes["functions"]
+        call_graph: Resolved call graph of the store, with its reverse index
+        compression: Codec of the file (cache_file.COMPRESSIONS); a
+                     compressed file is not memory-mapped on load
+
+    Returns:
+        Token identifying this file; read_binary_cache() checks it
+    """
+    strings = [store.strings[string_id] for string_id in range(len(store.strings))]
+    string_ids = {string: index for index, string in enumerate(strings)}
+
+    def string_id_of(value: str) -> int:
+        string_id = string_ids.get(value)
+        if string_id is None:
+            string_id = string_ids[value] = len(strings)
+            strings.append(value)
+        return string_id
+
+    index_sections: Dict[str, Tuple[array, array, array]] = {}
+    for name in INDEX_NAMES:
+        keys, offsets, values = array("i"), array("i", [0]), array("i")
+        for key, func_ids in indexes[name].items():
+            keys.append(string_id_of(key))
+            if name in _SINGLE_VALUE_INDEXES:
+                values.append(func_ids)  # type: ignore[arg-type]
+            else:
+                values.extend(func_ids)  # type: ignore[arg-type]
+            offsets.append(len(values))
+        index_sections[name] = keys, offsets, values
+
+    encoded = [value.encode("utf-8") for value in strings]
+    string_offsets = array("q", [0])
+    position = 0
+    for value in encoded:
+        position += len(value)
+        string_offsets.append(position)
+
+    sections: List[Tuple[str, Union[bytes, array, memoryview]]] = [
+        ("string_blob", b"".join(encoded)),
+        ("string_offsets", string_offsets),
+        ("string_hash", _build_hash_slots(encoded)),
+    ]
+    sections.extend((column, getattr(store, column)) for column in STORE_COLUMNS)
+    for name, (keys, offsets, values) in index_sections.items():
+        key_slots = array("i", [-1]) * len(strings)
+        for slot, string_id in enumerate(keys):
+            key_slots[string_id] = slot
+        sections.extend(
+            [
+                (f"{name}.keys", keys),
+                (f"{name}.key_slots", key_slots),
+                (f"{name}.offsets", offsets),
+                (f"{name}.values", values),
+            ]
+        )
+    sections.extend(
+        (f"name_search.{name}", getattr(name_search, name))
+        for name in _NAME_SEARCH_SECTIONS
+    )
+    sections.extend(
+        (name, getattr(call_graph, name)) for name in _CALL_GRAPH_SECTIONS
+    )
+
+    token = uuid.uuid4().hex
+    # A compressed file is written uncompressed first and streamed into
+    # its container
+    plain_path = path
+    if compression != "none":
+        plain_path = path.with_name(f".{path.name}.{token}.plain")
+    with atomic_write(plain_path) as f:
+        f.write(SECTION_PREAMBLE.pack(BINARY_CACHE_MAGIC, 0, 0))
+        section_table = {
+            name: write_section(f, data) for name, data in sections
+        }
+        header = json.dumps(
+            {
+                "version": BINARY_CACHE_VERSION,
+                "token": token,
+                "byteorder": sys.byteorder,
+                "itemsizes": {code: array(code).itemsize for code in "iq"},
+                "sections": section_table,
+                "called_by": {
+                    str(func_id): names
+                    for func_id, names in store.called_by.items()
+                },
+            }
+        ).encode("utf-8")
+        header_offset = f.tell()
+        f.write(header)
+        f.seek(0)
+        f.write(
+            SECTION_PREAMBLE.pack(BINARY_CACHE_MAGIC, header_offset, len(header))
+        )
+    if plain_path != path:
+        try:
+            compress_file(
+                plain_path, path, CacheSchema(BINARY_CACHE_VERSION), compression
+            )
+        finally:
+            plain_path.unlink()
+    return token
+
+
+def _build_hash_slots(encoded: Sequence[bytes]) -> array:
+    """Build the open-addressing hash table of MappedStringTable.find()."""
+    size = 8
+    while size < 2 * len(encoded):
+        size *= 2
+    mask = size - 1
+    slots = array("i", [_EMPTY_SLOT]) * size
+    for string_id, value in enumerate(encoded):
+        slot = zlib.crc32(value) & mask
+        while slots[slot] != _EMPTY_SLOT:
+            slot = (slot + 1) & mask
+        slots[slot] = string_id
+    return slots
+
+
+def write_section(
+    f: BinaryIO, data: Union[bytes, array, Sequence[int]]
+) -> Tuple[int, str, int]:
+    """
+    Write one aligned section.
+
+    Returns:
+        (offset, typecode, item count) entry of the section table
+    """
+    if not isinstance(data, (bytes, array, memoryview)):
+        data = array("i", data)
+    view = memoryview(data)
+    typecode = "B" if isinstance(data, bytes) else view.format
+    f.write(b"\0" * (-f.tell() % SECTION_ALIGNMENT))
+    offset = f.tell()
+    f.write(view.cast("B") if view.format != "B" else view)
+    return offset, typecode, len(view)
+
+
+def read_binary_cache(path: Path, token: Optional[str] = None) -> MappedCache:
+    """
+    Map a binary cache file into memory.
+
+    Only the preamble and the header are read; all sections stay in the
+    mapping until they are accessed. A compressed file is decompressed
+    into memory and used the same way.
+
+    Implements: SWR_DB_00040 (Memory-Mapped Binary Cache)
+    Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+    Args:
+        path: Binary cache file
+        token: Expected token (from write_binary_cache()), or None
+
+    Returns:
+        MappedCache using the mapped sections
+
+    Raises:
+        BinaryCacheError: If the file is missing, damaged, of another
+            version or platform, or has another token
+    """
+    try:
+        content: Union[bytes, mmap.mmap, None] = read_compressed_file(path)
+    except CacheFormatError as e:
+        raise BinaryCacheError(str(e)) from e
+    if content is None:
+        try:
+            with open(path, "rb") as f:
+                content = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+        except (OSError, ValueError) as e:
+            raise BinaryCacheError(f"cannot map {path.name}: {e}") from e
+
+    view = memoryview(content)
+    try:
+        magic, header_offset, header_length = SECTION_PREAMBLE.unpack_from(view)
+        if magic != BINARY_CACHE_MAGIC:
+            raise BinaryCacheError("not a binary cache file")
+        header = json.loads(
+            str(view[header_offset : header_offset + header_length], "utf-8")
+        )
+    except (struct.error, ValueError) as e:
+        raise BinaryCacheError(f"damaged header: {e}") from e
+
+    if header.get("version") != BINARY_CACHE_VERSION:
+        raise BinaryCacheError(f"unsupported version {header.get('version')}")
+    if header.get("byteorder") != sys.byteorder or header.get("itemsizes") != {
+        code: array(code).itemsize for code in "iq"
+    }:
+        raise BinaryCacheError("written on another platform")
+    if token is not None and header.get("token") != token:
+        raise BinaryCacheError("does not belong to the cache metadata")
+
+    section_table: Dict[str, List] = header["sections"]
+
+    def section(name: str) -> memoryview:
+        offset, typecode, count = section_table[name]
+        size = count * array(typecode).itemsize
+        if offset + size > len(view):
+            raise BinaryCacheError(f"section {name} is truncated")
+        data = view[offset : offset + size]
+        return data if typecode == "B" else data.cast(typecode)
+
+    strings = MappedStringTable(
+        section("string_blob"), section("string_offsets"), section("string_hash")
+    )
+    store = FunctionStore.from_columns(
+        strings,
+        {column: section(column) for column in STORE_COLUMNS},
+        {
+            int(func_id): names
+            for func_id, names in header.get("called_by", {}).items()
+        },
+    )
+    indexes = {
+        name: MappedIdIndex(
+            strings,
+            section(f"{name}.keys"),
+            section(f"{name}.key_slots"),
+            section(f"{name}.offsets"),
+            section(f"{name}.values"),
+            single=name in _SINGLE_VALUE_INDEXES,
+        )
+        for name in INDEX_NAMES
+    }
+    name_search = NameSearchIndex(
+        indexes["functions"].key_sequence(),
+        *(section(f"name_search.{name}") for name in _NAME_SEARCH_SECTIONS),
+    )
+    return MappedCache(
+        store=store,
+        indexes=indexes,
+        name_search=name_search,
+        call_graph=CallGraph(
+            store, *(section(name) for name in _CALL_GRAPH_SECTIONS)
+        ),
+    )
@@ -0,0 +1,366 @@
+"""
+Versioned, optionally compressed cache files.
+
+The cache pickle of a FunctionDatabase is stored in a container that
+names the schema it was written with and the compression of its payload,
+so a cache of another schema is rejected with a reason instead of failing
+while it is unpickled. A compressed binary cache is stored in the same
+container; it is decompressed into memory on load instead of being
+mapped (see read_binary_cache()).
+
+File layout:
+
+    magic (8 bytes) | schema version (u32) | schema fingerprint (u32)
+    compression (8 bytes, ASCII, NUL padded) | payload
+
+All files are written to a temporary file in the target directory and
+renamed over the target, so concurrent jobs sharing a cache directory
+never read a partly written file.
+
+Requirements:
+- SWR_DB_00049: Versioned Compressed Cache Files
+"""
+
+import dataclasses
+import lzma
+import os
+import pickle
+import struct
+import uuid
+import zlib
+from contextlib import contextmanager
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Any, BinaryIO, Iterable, Iterator, List, Optional, Tuple
+
+try:
+    import zstandard
+except ImportError:  # Optional: pip install autosar-calltree[compression]
+    zstandard = None
+
+try:
+    import lz4.frame as lz4_frame
+except ImportError:  # Optional: pip install autosar-calltree[compression]
+    lz4_frame = None
+
+CACHE_FILE_MAGIC = b"ACTCACHE"
+
+# Codecs of the payload; zstd and lz4 need their optional packages
+COMPRESSIONS = ("none", "zlib", "lzma", "zstd", "lz4")
+
+_HEADER = struct.Struct("<8sII8s")
+_COPY_CHUNK = 1 << 20
+
+
+class CacheFormatError(Exception):
+    """The cache file is missing, damaged or of another schema."""
+
+
+class CacheSchemaError(CacheFormatError):
+    """The cache file is intact but was written with another schema."""
+
+
+@dataclass(frozen=True)
+class CacheSchema:
+    """
+    Schema of a cache file: a version and a fingerprint of its models.
+
+    The version is incremented by hand when the content of the file
+    changes; the fingerprint covers the field names of the pickled
+    dataclasses, so adding, removing or renaming a field changes it
+    without a version bump.
+    """
+
+    version: int
+    fingerprint: int = 0
+
+    @classmethod
+    def of(cls, version: int, types: Iterable[type]) -> "CacheSchema":
+        """
+        Get the schema of a version and the dataclasses it stores.
+
+        Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+        Args:
+            version: Schema version
+            types: Dataclasses whose fields are part of the schema
+
+        Returns:
+            CacheSchema with the CRC32 of the qualified field names
+        """
+        names = [
+            f"{cls_type.__qualname__}.{item.name}"
+            for cls_type in types
+            for item in dataclasses.fields(cls_type)
+        ]
+        return cls(version, zlib.crc32(";".join(names).encode("utf-8")))
+
+    def __str__(self) -> str:
+        return f"{self.version} ({self.fingerprint:08x})"
+
+
+def available_compressions() -> List[str]:
+    """
+    Get the compressions whose codec is installed.
+
+    Returns:
+        Names from COMPRESSIONS, in their order
+    """
+    missing = {"zstd": zstandard is None, "lz4": lz4_frame is None}
+    return [name for name in COMPRESSIONS if not missing.get(name, False)]
+
+
+def check_compression(compression: str) -> None:
+    """
+    Check that a compression is known and its codec is installed.
+
+    Args:
+        compression: Name from COMPRESSIONS
+
+    Raises:
+        ValueError: If the compression is unknown or not installed
+    """
+    if compression not in COMPRESSIONS:
+        raise ValueError(
+            f"unknown cache compression {compression!r} "
+            f"(expected one of {', '.join(COMPRESSIONS)})"
+        )
+    if compression not in available_compressions():
+        raise ValueError(
+            f"cache compression {compression!r} is not installed "
+            '(pip install "autosar-calltree[compression]")'
+        )
+
+
+class _FrameCompressor:
+    """Streaming interface of zlib.compressobj() for an LZ4 frame."""
+
+    def __init__(self) -> None:
+        self._compressor = lz4_frame.LZ4FrameCompressor()
+        self._pending = self._compressor.begin()
+
+    def compress(self, data: bytes) -> bytes:
+        chunk = self._pending + self._compressor.compress(data)
+        self._pending = b""
+        return chunk
+
+    def flush(self) -> bytes:
+        return self._pending + self._compressor.flush()
+
+
+class _PlainCompressor:
+    """Streaming interface of zlib.compressobj() without compression."""
+
+    def compress(self, data: bytes) -> bytes:
+        return bytes(data)
+
+    def flush(self) -> bytes:
+        return b""
+
+
+def _compressor(compression: str) -> Any:
+    """Create a streaming compressor with compress() and flush()."""
+    check_compression(compression)
+    if compression == "zlib":
+        return zlib.compressobj()
+    if compression == "lzma":
+        return lzma.LZMACompressor()
+    if compression == "zstd":
+        return zstandard.ZstdCompressor().compressobj()
+    if compression == "lz4":
+        return _FrameCompressor()
+    return _PlainCompressor()
+
+
+def _decompress(payload: bytes, compression: str) -> bytes:
+    """Decompress a whole payload."""
+    check_compression(compression)
+    if compression == "zlib":
+        return zlib.decompress(payload)
+    if compression == "lzma":
+        return lzma.decompress(payload)
+    if compression == "zstd":
+        # Streamed frames have no content size, so use a decompressobj
+        return zstandard.ZstdDecompressor().decompressobj().decompress(payload)
+    if compression == "lz4":
+        return lz4_frame.decompress(payload)
+    return payload
+
+
+@contextmanager
+def atomic_write(path: Path) -> Iterator[BinaryIO]:
+    """
+    Open a temporary file that is renamed over path when the block ends.
+
+    The temporary file has a unique name in the directory of path, so
+    concurrent writers do not share it; if the block raises, it is
+    deleted and path is left as it was.
+
+    Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+    Args:
+        path: File to write
+
+    Yields:
+        Binary file object of the temporary file
+    """
+    temp_path = path.with_name(f".{path.name}.{os.getpid()}.{uuid.uuid4().hex}.tmp")
+    try:
+        with open(temp_path, "wb") as f:
+            yield f
+        os.replace(temp_path, path)
+    except BaseException:
+        try:
+            temp_path.unlink()
+        except OSError:
+            pass
+        raise
+
+
+def _write_header(f: BinaryIO, schema: CacheSchema, compression: str) -> None:
+    """Write the container header."""
+    f.write(
+        _HEADER.pack(
+            CACHE_FILE_MAGIC,
+            schema.version,
+            schema.fingerprint,
+            compression.encode("ascii"),
+        )
+    )
+
+
+def write_cache_data(
+    path: Path, data: Any, schema: CacheSchema, compression: str = "none"
+) -> None:
+    """
+    Pickle data into a cache file.
+
+    Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+    Args:
+        path: Cache file
+        data: Object to pickle
+        schema: Schema of data
+        compression: Codec of the payload, from COMPRESSIONS
+    """
+    compressor = _compressor(compression)
+    payload = pickle.dumps(data, protocol=pickle.HIGHEST_PROTOCOL)
+    with atomic_write(path) as f:
+        _write_header(f, schema, compression)
+        f.write(compressor.compress(payload))
+        f.write(compressor.flush())
+
+
+def compress_file(
+    source: Path, path: Path, schema: CacheSchema, compression: str
+) -> None:
+    """
+    Write a file into a compressed cache container, in chunks.
+
+    Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+    Args:
+        source: File to compress
+        path: Cache file to write
+        schema: Schema of the content of source
+        compression: Codec of the payload, from COMPRESSIONS
+    """
+    compressor = _compressor(compression)
+    with open(source, "rb") as src, atomic_write(path) as f:
+        _write_header(f, schema, compression)
+        for chunk in iter(lambda: src.read(_COPY_CHUNK), b""):
+            f.write(compressor.compress(chunk))
+        f.write(compressor.flush())
+
+
+def _read_container(path: Path) -> Optional[Tuple[CacheSchema, str, bytes]]:
+    """
+    Read the header and payload of a cache container.
+
+    Returns:
+        (schema, compression, payload), or None if path is no container
+
+    Raises:
+        CacheFormatError: If the file cannot be read or its header is
+            truncated
+    """
+    try:
+        with open(path, "rb") as f:
+            header = f.read(_HEADER.size)
+            if not header.startswith(CACHE_FILE_MAGIC):
+                return None
+            payload = f.read()
+    except OSError as e:
+        raise CacheFormatError(f"cannot read {path.name}: {e}") from e
+    if len(header) != _HEADER.size:
+        raise CacheFormatError(f"{path.name}: truncated header")
+    _, version, fingerprint, codec = _HEADER.unpack(header)
+    compression = codec.rstrip(b"\0").decode("ascii", "replace")
+    return CacheSchema(version, fingerprint), compression, payload
+
+
+def _decompress_payload(path: Path, payload: bytes, compression: str) -> bytes:
+    """Decompress the payload of a container, as a CacheFormatError on failure."""
+    try:
+        return _decompress(payload, compression)
+    except ValueError as e:
+        raise CacheFormatError(f"{path.name}: {e}") from e
+    except Exception as e:
+        raise CacheFormatError(f"{path.name}: damaged {compression} data ({e})") from e
+
+
+def read_cache_data(path: Path, schema: CacheSchema) -> Any:
+    """
+    Load the pickled data of a cache file.
+
+    Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+    Args:
+        path: Cache file of write_cache_data()
+        schema: Expected schema
+
+    Returns:
+        Unpickled data
+
+    Raises:
+        CacheSchemaError: If the file is a pickle without container header
+            (written before schema versioning) or has another schema
+        CacheFormatError: If the file is unreadable or damaged, or its
+            compression is not installed
+    """
+    container = _read_container(path)
+    if container is None:
+        with open(path, "rb") as f:
+            is_pickle = f.read(1) == b"\x80"
+        if is_pickle:
+            raise CacheSchemaError("outdated cache format (no schema header)")
+        raise CacheFormatError(f"{path.name}: not a cache file")
+    file_schema, compression, payload = container
+    if file_schema != schema:
+        raise CacheSchemaError(f"schema version {file_schema}, expected {schema}")
+    payload = _decompress_payload(path, payload, compression)
+    try:
+        return pickle.loads(payload)
+    except Exception as e:
+        raise CacheFormatError(f"{path.name}: damaged data ({e})") from e
+
+
+def read_compressed_file(path: Path) -> Optional[bytes]:
+    """
+    Get the decompressed content of a file written by compress_file().
+
+    Args:
+        path: File to read
+
+    Returns:
+        Decompressed content, or None if path is no cache container
+
+    Raises:
+        CacheFormatError: If the file is unreadable or the payload cannot
+            be decompressed
+    """
+    container = _read_container(path)
+    if container is None:
+        return None
+    _, compression, payload = container
+    return _decompress_payload(path, payload, compression)
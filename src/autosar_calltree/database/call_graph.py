@@ -0,0 +1,294 @@
+"""
+Resolved call graph module.
+
+This module provides a call graph over the function IDs of the database's
+FunctionStore in which every function call is resolved to the ID of its
+callee once, using the same selection rules as
+FunctionDatabase.lookup_function().
+
+Requirements:
+- SWR_DB_00038: Resolved Call Graph Index
+- SWR_DB_00042: Reverse Call Graph Index
+- SWR_DB_00047: Reachable Function Fingerprint
+"""
+
+from array import array
+from bisect import bisect_right
+from typing import TYPE_CHECKING, Dict, List, Optional, Sequence, Tuple
+
+from .function_store import FunctionStore, FunctionSummary
+from .models import FunctionInfo
+
+if TYPE_CHECKING:
+    from .function_database import FunctionDatabase
+
+# Callee ID of a call whose function is not in the database
+UNRESOLVED = -1
+
+
+class CallGraph:
+    """
+    Call graph with pre-resolved callees.
+
+    callee_ids is aligned with the call rows of the store: the callee of
+    the call_index-th call of function func_id is
+    callee_ids[store.call_offsets[func_id] + call_index], or UNRESOLVED.
+
+    The reverse index lists the call rows resolved to each function: the
+    calls of func_id are caller_rows[caller_offsets[func_id]:
+    caller_offsets[func_id + 1]], in ascending row order.
+    """
+
+    def __init__(
+        self,
+        store: FunctionStore,
+        callee_ids: Sequence[int],
+        caller_offsets: Optional[Sequence[int]] = None,
+        caller_rows: Optional[Sequence[int]] = None,
+    ):
+        """
+        Initialize the call graph.
+
+        Args:
+            store: Function store the IDs refer to
+            callee_ids: Resolved callee ID per call row of the store (an
+                array, or a memoryview of the binary cache)
+            caller_offsets: Start of the caller rows of every function, plus
+                the end; derived from callee_ids if omitted
+            caller_rows: Call rows grouped by callee; derived from
+                callee_ids if omitted
+        """
+        self.store = store
+        self.callee_ids = callee_ids
+        self.size = len(store)
+        if caller_offsets is None or caller_rows is None:
+            caller_offsets, caller_rows = self._build_reverse(callee_ids, self.size)
+        self.caller_offsets = caller_offsets
+        self.caller_rows = caller_rows
+
+    def __len__(self) -> int:
+        """Number of functions in the graph."""
+        return self.size
+
+    @classmethod
+    def build(cls, function_db: "FunctionDatabase") -> "CallGraph":
+        """
+        Build the call graph from a populated function database.
+
+        Each call is resolved like lookup_function() using the caller's
+        file as context, taking the first match like CallTreeBuilder does.
+        Calls are resolved on the store's columns, so no function has to
+        be materialized.
+
+        Implements: SWR_DB_00038 (Resolved Call Graph Index)
+
+        Args:
+            function_db: Function database with final indexes
+
+        Returns:
+            CallGraph for all functions in the database
+        """
+        store = function_db.store
+        callee_ids = array("i", [UNRESOLVED]) * len(store.call_name_ids)
+
+        # Calls with equal name and caller file resolve to the same callee
+        resolved: Dict[Tuple[int, int], int] = {}
+        summaries: Dict[str, List[FunctionSummary]] = {}
+        for func_id in range(len(store)):
+            file_id = store.file_ids[func_id]
+            call_rows = range(
+                store.call_offsets[func_id], store.call_offsets[func_id + 1]
+            )
+            for row in call_rows:
+                key = (store.call_name_ids[row], file_id)
+                callee_id = resolved.get(key)
+                if callee_id is None:
+                    callee_id = cls._resolve(
+                        function_db, store.strings[key[0]], func_id, summaries
+                    )
+                    resolved[key] = callee_id
+                callee_ids[row] = callee_id
+
+        return cls(store, callee_ids)
+
+    @staticmethod
+    def _build_reverse(
+        callee_ids: Sequence[int], size: int
+    ) -> Tuple[array, array]:
+        """
+        Group the call rows by callee with a counting sort.
+
+        Implements: SWR_DB_00042 (Reverse Call Graph Index)
+
+        Args:
+            callee_ids: Resolved callee ID per call row
+            size: Number of functions
+
+        Returns:
+            (caller_offsets, caller_rows) of the reverse index
+        """
+        caller_offsets = array("i", [0]) * (size + 1)
+        for callee_id in callee_ids:
+            if callee_id != UNRESOLVED:
+                caller_offsets[callee_id + 1] += 1
+        for func_id in range(size):
+            caller_offsets[func_id + 1] += caller_offsets[func_id]
+
+        caller_rows = array("i", [0]) * caller_offsets[size]
+        next_slot = caller_offsets[:size]
+        for row, callee_id in enumerate(callee_ids):
+            if callee_id != UNRESOLVED:
+                caller_rows[next_slot[callee_id]] = row
+                next_slot[callee_id] += 1
+        return caller_offsets, caller_rows
+
+    @staticmethod
+    def _resolve(
+        function_db: "FunctionDatabase",
+        name: str,
+        caller_id: int,
+        summaries: Dict[str, List[FunctionSummary]],
+    ) -> int:
+        """
+        Resolve one called name like lookup_function() does.
+
+        A name with several definitions is resolved by the database's
+        selection strategy on FunctionSummary tuples, so no candidate has
+        to be materialized.
+
+        Args:
+            function_db: Function database with final indexes
+            name: Called function name
+            caller_id: Function ID of the caller
+            summaries: Candidate summaries per name, filled on demand
+
+        Returns:
+            Function ID of the callee, or UNRESOLVED
+        """
+        store = function_db.store
+        context_file = store.file_key(caller_id)
+        if "::" in name:
+            matches = function_db.lookup_function(name, context_file=context_file)
+            match_id = store.id_of(matches[0]) if matches else None
+            return UNRESOLVED if match_id is None else match_id
+
+        candidate_ids = function_db.functions.ids.get(name, ())
+        if len(candidate_ids) <= 1:
+            return candidate_ids[0] if candidate_ids else UNRESOLVED
+
+        candidates = summaries.get(name)
+        if candidates is None:
+            candidates = summaries[name] = [
+                store.summary(func_id) for func_id in candidate_ids
+            ]
+        best = function_db._select_best_function_match(candidates, context_file)
+        return (best or candidates[0]).func_id
+
+    def function(self, func_id: int) -> FunctionInfo:
+        """
+        Get the function with an ID.
+
+        Args:
+            func_id: Function ID
+
+        Returns:
+            FunctionInfo, materialized by the store
+        """
+        return self.store.get(func_id)
+
+    def qualified_name(self, func_id: int) -> str:
+        """
+        Get the qualified name ("file::function") of a function.
+
+        Args:
+            func_id: Function ID
+
+        Returns:
+            Qualified name
+        """
+        return self.store.qualified_key(func_id)
+
+    def callee(self, func_id: int, call_index: int) -> int:
+        """
+        Get the resolved callee of one call of a function.
+
+        Args:
+            func_id: Function ID of the caller
+            call_index: Index of the call in the caller's calls
+
+        Returns:
+            Function ID of the callee, or UNRESOLVED
+        """
+        return self.callee_ids[self.store.call_offsets[func_id] + call_index]
+
+    def reachable(self, func_id: int, max_depth: int) -> List[int]:
+        """
+        Get the functions reachable from a function within max_depth calls.
+
+        These are the functions of its call tree of depth max_depth.
+
+        Implements: SWR_DB_00047 (Reachable Function Fingerprint)
+
+        Args:
+            func_id: Function ID of the root
+            max_depth: Maximum number of calls from the root
+
+        Returns:
+            Function IDs in breadth-first order, starting with func_id
+        """
+        call_offsets = self.store.call_offsets
+        callee_ids = self.callee_ids
+        seen = {func_id}
+        reached = [func_id]
+        level = [func_id]
+        for _ in range(max_depth):
+            next_level = []
+            for caller_id in level:
+                for callee_id in callee_ids[
+                    call_offsets[caller_id] : call_offsets[caller_id + 1]
+                ]:
+                    if callee_id != UNRESOLVED and callee_id not in seen:
+                        seen.add(callee_id)
+                        next_level.append(callee_id)
+            if not next_level:
+                break
+            reached.extend(next_level)
+            level = next_level
+        return reached
+
+    def callers(self, func_id: int) -> List[Tuple[int, int]]:
+        """
+        Get the calls resolved to a function.
+
+        Implements: SWR_DB_00042 (Reverse Call Graph Index)
+
+        Args:
+            func_id: Function ID of the callee
+
+        Returns:
+            (caller ID, call index) of every call of the function, ordered
+            by caller ID and call index
+        """
+        call_offsets = self.store.call_offsets
+        calls = []
+        for row in self.caller_rows[
+            self.caller_offsets[func_id] : self.caller_offsets[func_id + 1]
+        ]:
+            caller_id = bisect_right(call_offsets, row) - 1
+            calls.append((caller_id, row - call_offsets[caller_id]))
+        return calls
+
+    def get_id(self, func_info: FunctionInfo) -> Optional[int]:
+        """
+        Get the ID of a function object of this graph.
+
+        Args:
+            func_info: Function information (must be an object of the store)
+
+        Returns:
+            Function ID, or None if the object is not part of the graph
+        """
+        func_id = self.store.id_of(func_info)
+        if func_id is None or func_id >= self.size:
+            return None
+        return func_id
@@ -10,22 +10,95 @@ Requirements:
 - SWR_CACHE_00002: Cache Status Indication
 - SWR_CACHE_00003: Cache Loading Errors
 - SWR_CACHE_00004: Performance Considerations
+- SWR_DB_00036: Incremental Per-File Cache
+- SWR_DB_00037: Stat-Based Change Detection
+- SWR_DB_00038: Resolved Call Graph Index
+- SWR_DB_00039: Columnar Function Store
+- SWR_DB_00040: Memory-Mapped Binary Cache
+- SWR_DB_00041: Indexed Name Search
+- SWR_DB_00042: Reverse Call Graph Index
+- SWR_DB_00044: Build Profiling
+- SWR_DB_00045: Demand-Driven Lazy Parsing
+- SWR_DB_00046: Sharded Database Build
+- SWR_DB_00047: Reachable Function Fingerprint
+- SWR_DB_00048: Module Call Graph
+- SWR_DB_00049: Versioned Compressed Cache Files
 """
 
 import hashlib
-import pickle
+import re
+import threading
+import time
 from dataclasses import dataclass, field
 from datetime import datetime
 from pathlib import Path
-from typing import Any, Dict, List, Optional
+from typing import (
+    Any,
+    Dict,
+    Iterable,
+    Iterator,
+    List,
+    Optional,
+    Sequence,
+    Set,
+    Tuple,
+    TypeVar,
+)
+
+try:
+    import xxhash
+except ImportError:  # Optional: pip install autosar-calltree[fast-hash]
+    xxhash = None
 
 from ..config import PreprocessorConfig
 from ..config.module_config import ModuleConfig
 from ..parsers.autosar_parser import AutosarParser
-from ..parsers.c_parser import CParser, ParseResult, ParseStatistics
-from ..preprocessing import CPPPreprocessor, PreprocessStatistics
-from ..utils.statistics import StatisticsFormatter
-from .models import FunctionInfo
+from ..parsers.c_parser import (
+    PARSE_RESULT_REVISION,
+    CParser,
+    ParseResult,
+    ParseStatistics,
+)
+from ..parsers.source_scanner import scan_function_definitions
+from ..preprocessing import (
+    CPPPreprocessor,
+    PreprocessStatistics,
+    SharedIncludePrefix,
+)
+from ..utils.parallel import resolve_jobs
+from ..utils.profiler import Profiler
+from ..utils.statistics import ProcessingResult, StatisticsFormatter
+from .binary_cache import (
+    BINARY_CACHE_VERSION,
+    BinaryCacheError,
+    read_binary_cache,
+    write_binary_cache,
+)
+from .cache_file import (
+    CacheSchema,
+    CacheSchemaError,
+    check_compression,
+    read_cache_data,
+    write_cache_data,
+)
+from .call_graph import CallGraph
+from .function_store import (
+    FunctionCandidate,
+    FunctionIndex,
+    FunctionStore,
+    QualifiedFunctionIndex,
+)
+from .models import FunctionCall, FunctionInfo, Parameter
+from .module_graph import ModuleEdge, ModuleGraph
+from .name_index import SEARCH_MODES, NameSearchIndex
+from .sharding import ShardError, ShardSpec, select_shard_files
+
+CandidateT = TypeVar("CandidateT", bound=FunctionCandidate)
+
+
+def _result_bytes(results: Sequence[ProcessingResult]) -> int:
+    """Sum the processed bytes of per-file results."""
+    return sum(result.bytes_processed for result in results)
 
 
 def _format_file_size(size_bytes: int) -> str:
@@ -52,6 +125,37 @@ class CacheMetadata:
     file_checksums: Dict[str, str] = field(default_factory=dict)
 
 
+@dataclass
+class FileCacheEntry:
+    """Cached parse result of a single source file."""
+
+    checksum: str
+    config_hash: str
+    function_ids: Sequence[int] = ()  # IDs in the FunctionStore of the cache
+    mtime_ns: int = 0
+    size: int = -1
+
+
+# Increment when the content of the cache pickle changes in a way the
+# field names of its dataclasses do not show
+CACHE_SCHEMA_VERSION = 1
+
+# Schema of the cache pickle; FunctionInfo and its parts are the models of
+# the store columns in the binary cache
+CACHE_SCHEMA = CacheSchema.of(
+    CACHE_SCHEMA_VERSION,
+    (
+        CacheMetadata,
+        FileCacheEntry,
+        ModuleGraph,
+        ModuleEdge,
+        FunctionInfo,
+        FunctionCall,
+        Parameter,
+    ),
+)
+
+
 class FunctionDatabase:
     """
     Database of all functions in the codebase.
@@ -69,6 +173,11 @@ class FunctionDatabase:
         preprocessor_config: Optional[PreprocessorConfig] = None,
         temp_dir: Optional[str] = None,
         keep_temp: bool = False,
+        jobs: Optional[int] = 1,
+        profiler: Optional[Profiler] = None,
+        full_parse: bool = True,
+        cache_compression: str = "none",
+        background_cache_write: bool = False,
     ):
         """
         Initialize the function database.
@@ -80,7 +189,19 @@ class FunctionDatabase:
             preprocessor_config: Preprocessor configuration for cpp settings
             temp_dir: Directory for temporary preprocessed files
             keep_temp: Whether to keep temporary files after processing
+            jobs: Number of parallel workers for the pipeline (None: CPU count)
+            profiler: Profiler recording the build stages (default: disabled)
+            full_parse: Parse traditional C definitions with pycparser
+                        (False: lexical parse path only, SWR_PARSER_00049)
+            cache_compression: Codec of the cache files (cache_file.COMPRESSIONS)
+            background_cache_write: Write the cache of build_database() in a
+                                    thread; see wait_for_cache_write()
+
+        Raises:
+            ValueError: If cache_compression is unknown or not installed
         """
+        check_compression(cache_compression)
+
         self.source_dir = Path(source_dir)
 
         if cache_dir:
@@ -90,22 +211,49 @@ class FunctionDatabase:
 
         self.cache_dir.mkdir(parents=True, exist_ok=True)
         self.cache_file = self.cache_dir / "function_db.pkl"
+        # Store, indexes and call graph; memory-mapped on load
+        self.binary_cache_file = self.cache_dir / "function_db.bin"
+        self.cache_compression = cache_compression
+        self.background_cache_write = background_cache_write
+        # Thread writing the cache in background mode
+        self._cache_writer: Optional[threading.Thread] = None
+
+        # All functions, stored column-wise; the indexes below hold their IDs
+        # and materialize FunctionInfo objects on access
+        self.store = FunctionStore()
 
         # Database: function_name -> List[FunctionInfo]
         # Multiple entries for functions with same name (static in different files)
-        self.functions: Dict[str, List[FunctionInfo]] = {}
+        self.functions = FunctionIndex(self.store)
 
         # Qualified function keys: "file::function" -> FunctionInfo
         # Used for resolving static functions
-        self.qualified_functions: Dict[str, FunctionInfo] = {}
+        self.qualified_functions = QualifiedFunctionIndex(self.store)
 
         # All functions by file
-        self.functions_by_file: Dict[str, List[FunctionInfo]] = {}
+        self.functions_by_file = FunctionIndex(self.store)
+
+        # Resolved call graph, built once the indexes are final
+        self.call_graph: Optional[CallGraph] = None
+
+        # Search index over the function names, valid for one version of
+        # the functions index
+        self._name_search: Optional[NameSearchIndex] = None
+        self._name_search_version = -1
+
+        # Module call graph, valid for the call graph it was built from
+        self._module_graph: Optional[ModuleGraph] = None
+        self._module_graph_source: Optional[CallGraph] = None
 
         # Parsers
         self.autosar_parser = AutosarParser()
-        self.c_parser = CParser(preprocessor_config=preprocessor_config)
-        self.parser_type = "pycparser"
+        self.c_parser = CParser(
+            preprocessor_config=preprocessor_config,
+            autosar_parser=self.autosar_parser,
+            full_parse=full_parse,
+        )
+        # Part of the cache key, so both parse paths keep their own entries
+        self.parser_type = "pycparser" if full_parse else "lexical"
 
         # Module configuration
         self.module_config = module_config
@@ -115,71 +263,569 @@ class FunctionDatabase:
         self.preprocessor_config = preprocessor_config
         self.temp_dir = Path(temp_dir) if temp_dir else None
         self.keep_temp = keep_temp
+        self.jobs = resolve_jobs(jobs)
 
         # Statistics
         self.total_files_scanned = 0
         self.total_functions_found = 0
         self.parse_errors: List[str] = []
 
+        # Incremental cache state
+        self.file_checksums: Dict[str, str] = {}
+        self.file_stats: Dict[str, Tuple[int, int]] = {}
+        self._scanned_files: Optional[List[Path]] = None
+        self._entries_refreshed = False
+        self._failed_files: Set[str] = set()
+        self._reusable_entries: Dict[str, FileCacheEntry] = {}
+        self._reusable_store: Optional[FunctionStore] = None
+
         # Two-stage pipeline statistics
         self.preprocess_stats: Optional[PreprocessStatistics] = None
         self.parse_stats: Optional[ParseStatistics] = None
 
+        # Stage and per-file timings of builds
+        self.profiler = profiler or Profiler(enabled=False)
+
+        # Lazy mode: files not parsed yet and the files defining each name
+        self._lazy_pending: Set[str] = set()
+        self._lazy_files_by_name: Dict[str, List[Path]] = {}
+        self._lazy_file_order: Dict[str, int] = {}
+        self._lazy_use_cache = False
+        self.lazy_files_parsed = 0
+
     def build_database(
         self,
         use_cache: bool = True,
         rebuild_cache: bool = False,
         verbose: bool = False,
         preprocess_only: bool = False,
+        lazy: bool = False,
     ) -> None:
         """
         Build the function database by scanning all source files.
 
+        When a cache exists but some files changed, only changed and added
+        files are parsed; results of unchanged files are taken from the cache.
+        Every stage is timed by the profiler.
+
+        In lazy mode the files to parse are only scanned for the names of
+        the functions they define; each file is parsed when a lookup asks
+        for one of its names (see lookup_function()). Call save_lazy_cache()
+        to store the files parsed on demand.
+
+        Implements: SWR_DB_00036 (Incremental Per-File Cache)
+        Implements: SWR_DB_00044 (Build Profiling)
+        Implements: SWR_DB_00045 (Demand-Driven Lazy Parsing)
+
         Args:
             use_cache: Whether to use cached data if available
             rebuild_cache: Force rebuild of cache even if valid
             verbose: Print progress information
             preprocess_only: Only run preprocessing stage (for debugging)
+            lazy: Parse files on demand instead of all at once
         """
         if verbose:
             print(f"Scanning source directory: {self.source_dir}")
             print(f"Using parser: {self.parser_type}")
 
+        # The data of a previous build is still being written
+        self.wait_for_cache_write(verbose)
+        self.file_checksums.clear()
+        self.file_stats.clear()
+        self._scanned_files = None
+        self._failed_files.clear()
+        self._reusable_entries = {}
+        self._reusable_store = None
+        self._entries_refreshed = False
+        self._lazy_pending = set()
+        self._lazy_files_by_name = {}
+        self._lazy_use_cache = use_cache and lazy
+        self.lazy_files_parsed = 0
+
         # Try to load from cache first
         if use_cache and not rebuild_cache:
-            if self._load_from_cache(verbose):
+            with self.profiler.stage("cache_load") as stage:
+                loaded = self._load_from_cache(verbose)
+                stage.bytes = self._cache_size()
+            if loaded:
                 if verbose:
                     print(f"Loaded {self.total_functions_found} functions from cache")
+                # Persist refreshed file stats so they are not hashed again
+                if self._entries_refreshed:
+                    self._save_to_cache(verbose)
                 return
 
         # Clear existing data
-        self.functions.clear()
-        self.qualified_functions.clear()
-        self.functions_by_file.clear()
+        self._reset_store(FunctionStore())
+        self.call_graph = None
         self.parse_errors.clear()
+        self.module_stats.clear()
         self.total_files_scanned = 0
         self.total_functions_found = 0
 
         # Find all C source files
-        c_files = list(self.source_dir.rglob("*.c"))
+        with self.profiler.stage("discover"):
+            c_files = self._discover_source_files()
 
         if verbose:
             print(f"Found {len(c_files)} C source files")
 
+        # Only files without a reusable cache entry need to be parsed
+        reused = {
+            str(file_path): self._reusable_entries[str(file_path)]
+            for file_path in c_files
+            if str(file_path) in self._reusable_entries
+        }
+        files_to_parse = [f for f in c_files if str(f) not in reused]
+
+        if lazy:
+            self._start_lazy_build(c_files, files_to_parse, reused, verbose)
+            return
+        self._snapshot_sources(files_to_parse)
+
         # Print build progress message before processing files
         print(f"Building function database from {self.source_dir}...")
+        if reused:
+            print(
+                f"Reusing {len(reused)} unchanged files from cache, parsing {len(files_to_parse)} files"
+            )
 
         # Use two-stage pipeline if preprocessor config is provided and enabled
         if self.preprocessor_config and self.preprocessor_config.enabled:
-            self._build_with_two_stage_pipeline(c_files, verbose, preprocess_only)
+            self._build_with_two_stage_pipeline(
+                files_to_parse, verbose, preprocess_only
+            )
         else:
             # Fall back to single-stage processing
-            self._build_with_single_stage(c_files, verbose)
+            self._build_with_single_stage(files_to_parse, verbose)
+
+        if reused:
+            with self.profiler.stage("rebuild_indexes"):
+                self._rebuild_indexes(c_files, reused)
+            self.total_files_scanned = len(c_files)
+
+        if not preprocess_only:
+            with self.profiler.stage("call_graph"):
+                self.call_graph = CallGraph.build(self)
+            with self.profiler.stage("name_index"):
+                self.get_name_search_index()
+            if self.module_config:
+                with self.profiler.stage("module_graph"):
+                    self.get_module_graph()
 
         # Save to cache
         if use_cache and not preprocess_only:
+            self._save_to_cache(verbose, profile=True)
+
+    def _start_lazy_build(
+        self,
+        c_files: List[Path],
+        files_to_parse: List[Path],
+        reused: Dict[str, FileCacheEntry],
+        verbose: bool,
+    ) -> None:
+        """
+        Index the defined names of the files to parse instead of parsing them.
+
+        Functions of reused files are taken from the cache as in a full
+        build.
+
+        Implements: SWR_DB_00045 (Demand-Driven Lazy Parsing)
+
+        Args:
+            c_files: Source files in discovery order
+            files_to_parse: Files without a reusable cache entry
+            reused: Cache entries of unchanged files
+            verbose: Print progress information
+        """
+        if reused:
+            with self.profiler.stage("rebuild_indexes"):
+                self._rebuild_indexes(c_files, reused)
+        self.total_files_scanned = len(reused)
+
+        self._lazy_file_order = {
+            str(file_path): order for order, file_path in enumerate(c_files)
+        }
+        with self.profiler.stage("definition_scan") as stage:
+            for file_path in files_to_parse:
+                try:
+                    content = file_path.read_text(encoding="utf-8", errors="ignore")
+                except OSError as e:
+                    self.parse_errors.append(f"Error reading {file_path}: {e}")
+                    continue
+                stage.bytes += len(content)
+                self._lazy_pending.add(str(file_path))
+                for name in scan_function_definitions(content):
+                    self._lazy_files_by_name.setdefault(name, []).append(file_path)
+
+        print(
+            f"Lazy mode: {len(reused)} files from cache, "
+            f"{len(self._lazy_pending)} files to parse on demand"
+        )
+        if verbose:
+            print(
+                f"Definition scan found {len(self._lazy_files_by_name)} "
+                "function names"
+            )
+
+    @property
+    def is_lazy(self) -> bool:
+        """Whether some files are only scanned and parsed on demand."""
+        return bool(self._lazy_pending)
+
+    def ensure_parsed(self, function_names: Iterable[str]) -> int:
+        """
+        Parse the pending files that define any of the given functions.
+
+        All files defining a name are parsed at once, so lookups see the
+        same definitions as after a full build. Files of one call are
+        parsed together, in parallel with jobs > 1.
+
+        Implements: SWR_DB_00045 (Demand-Driven Lazy Parsing)
+
+        Args:
+            function_names: Function names, optionally qualified
+                ("file::function")
+
+        Returns:
+            Number of files parsed
+        """
+        if not self._lazy_pending:
+            return 0
+        files: Dict[str, Path] = {}
+        for function_name in function_names:
+            name = function_name.rsplit("::", 1)[-1]
+            for file_path in self._lazy_files_by_name.pop(name, ()):
+                file_key = str(file_path)
+                if file_key in self._lazy_pending:
+                    files[file_key] = file_path
+        if not files:
+            return 0
+        self._parse_lazy_files(
+            sorted(files.values(), key=lambda f: self._lazy_file_order[str(f)])
+        )
+        return len(files)
+
+    def parse_pending_files(self) -> int:
+        """
+        Parse all files that lazy mode has not parsed yet.
+
+        Returns:
+            Number of files parsed
+        """
+        pending = sorted(
+            (Path(file_key) for file_key in self._lazy_pending),
+            key=lambda f: self._lazy_file_order[str(f)],
+        )
+        self._lazy_files_by_name = {}
+        if pending:
+            self._parse_lazy_files(pending)
+        return len(pending)
+
+    def _parse_lazy_files(self, files: List[Path]) -> None:
+        """
+        Parse files on demand and add their functions to the database.
+
+        cpp runs in stream mode when a preprocessor configuration is
+        enabled. Candidates of every added name are kept in discovery
+        order, as a full build would add them.
+
+        Args:
+            files: Files to parse, in discovery order
+        """
+        for file_path in files:
+            print(f"Parsing on demand: {file_path.name}")
+        self._snapshot_sources(files)
+
+        results: List[ParseResult]
+        if self.preprocessor_config and self.preprocessor_config.enabled:
+            preprocessor = CPPPreprocessor(
+                config=self.preprocessor_config, temp_dir=self.temp_dir, jobs=self.jobs
+            )
+            try:
+                prep_stats, parse_stats = self.c_parser.preprocess_and_parse_all(
+                    files, preprocessor, verbose=False, jobs=self.jobs
+                )
+            finally:
+                preprocessor.cleanup()
+            self.profiler.add_results("preprocess", prep_stats.results)
+            for prep_result in prep_stats.results:
+                if not prep_result.success:
+                    self._failed_files.add(str(prep_result.source_file))
+            results = parse_stats.results
+        elif self.jobs > 1 and len(files) > 1:
+            results = self.c_parser.parse_files_parallel(
+                [(file_path, None) for file_path in files], self.jobs
+            )
+        else:
+            results = [self.c_parser.parse_file_with_stats(f) for f in files]
+        self.profiler.add_results("parse", results)
+
+        names: Set[str] = set()
+        for result in results:
+            if not result.success:
+                self.parse_errors.append(
+                    f"Error parsing {result.source_file}: {result.error_message}"
+                )
+                self._failed_files.add(str(result.source_file))
+            self._register_file_functions(result.source_file, result.functions)
+            names.update(func_info.name for func_info in result.functions)
+            self._lazy_pending.discard(str(result.source_file))
+
+        # Restore discovery order of candidates and the qualified key that
+        # the last of them sets
+        order = self._lazy_file_order
+        file_key = self.store.file_key
+        for name in names:
+            func_ids = self.functions.ids[name]
+            if len(func_ids) < 2:
+                continue
+            func_ids = sorted(
+                func_ids, key=lambda func_id: (order.get(file_key(func_id), -1), func_id)
+            )
+            self.functions.set_ids(name, func_ids)
+            for func_id in func_ids:
+                self.qualified_functions.set_id(
+                    self.store.qualified_key(func_id), func_id
+                )
+
+        self.total_files_scanned += len(files)
+        self.lazy_files_parsed += len(files)
+
+    def save_lazy_cache(self, verbose: bool = False) -> None:
+        """
+        Save the files parsed so far to the incremental cache.
+
+        Files that were not parsed get no cache entry, so a later build
+        parses them and reuses all others.
+
+        Implements: SWR_DB_00045 (Demand-Driven Lazy Parsing)
+
+        Args:
+            verbose: Print progress information
+        """
+        if self._lazy_use_cache and self.lazy_files_parsed:
             self._save_to_cache(verbose)
 
+    def build_shard(self, shard: ShardSpec, verbose: bool = False) -> Path:
+        """
+        Parse one shard of the source files and write its cache fragment.
+
+        Every shard of a build selects its files from the same sorted file
+        list (select_shard_files()), so the shards of all nodes together
+        cover each file once. The fragment is a cache of the shard's files
+        in the cache directory; merge_shards() combines the fragments.
+
+        Implements: SWR_DB_00046 (Sharded Database Build)
+
+        Args:
+            shard: Shard to build
+            verbose: Print progress information
+
+        Returns:
+            Fragment pickle; its binary cache file has the suffix .bin
+        """
+        self.wait_for_cache_write(verbose)
+        self.file_checksums.clear()
+        self.file_stats.clear()
+        self._scanned_files = None
+        self._failed_files.clear()
+        self._reset_store(FunctionStore())
+        self.call_graph = None
+        self.parse_errors.clear()
+        self.module_stats.clear()
+        self.total_files_scanned = 0
+        self.total_functions_found = 0
+
+        with self.profiler.stage("discover"):
+            c_files = self._discover_source_files()
+            shard_files = select_shard_files(
+                c_files, shard, lambda path: (self._get_file_stat(path) or (0, 0))[1]
+            )
+
+        print(
+            f"Building shard {shard} of the function database from "
+            f"{self.source_dir} ({len(shard_files)} of {len(c_files)} files)..."
+        )
+        self._snapshot_sources(shard_files)
+        if self.preprocessor_config and self.preprocessor_config.enabled:
+            self._build_with_two_stage_pipeline(shard_files, verbose, False)
+        else:
+            self._build_with_single_stage(shard_files, verbose)
+
+        # The fragment has entries for the files of this shard only
+        self._scanned_files = shard_files
+        fragment_file = self.cache_dir / shard.fragment_name
+        with self.profiler.stage("call_graph"):
+            self.call_graph = CallGraph.build(self)
+        with self.profiler.stage("cache_save") as stage:
+            self._write_cache(
+                fragment_file,
+                fragment_file.with_suffix(".bin"),
+                extra={
+                    "shard": {
+                        "index": shard.index,
+                        "count": shard.count,
+                        "file_count": len(c_files),
+                        "config_hash": self._compute_config_hash(),
+                        "failed_files": sorted(self._failed_files),
+                    }
+                },
+            )
+            stage.bytes = (
+                fragment_file.stat().st_size
+                + fragment_file.with_suffix(".bin").stat().st_size
+            )
+
+        if verbose:
+            print(f"Shard fragment saved to {fragment_file}")
+        return fragment_file
+
+    def merge_shards(
+        self, fragment_files: Sequence[Path], verbose: bool = False
+    ) -> None:
+        """
+        Merge the cache fragments of all shards into this database and its cache.
+
+        The functions are copied in sorted file order, which is the order of
+        a full build, together with the parse errors of all shards. Module
+        mappings are applied with the module configuration of this
+        database. Files that failed in their shard get no cache entry, so
+        the next build parses them again.
+
+        Implements: SWR_DB_00046 (Sharded Database Build)
+
+        Args:
+            fragment_files: Fragment pickles of build_shard()
+            verbose: Print progress information
+
+        Raises:
+            ShardError: If a fragment is unreadable, belongs to another
+                        build or was built with other settings, or if
+                        shards are missing or duplicated
+        """
+        self.wait_for_cache_write(verbose)
+        if not fragment_files:
+            raise ShardError("no shard fragments found")
+
+        print(
+            f"Merging {len(fragment_files)} shard fragments into {self.cache_file}..."
+        )
+        config_hash = self._compute_config_hash()
+        shard_files: Dict[int, Path] = {}
+        shard_count = file_count = 0
+        sources: Dict[str, Tuple[FunctionStore, Sequence[int]]] = {}
+        entries: Dict[str, FileCacheEntry] = {}
+        failed_files: Set[str] = set()
+        parse_errors: List[str] = []
+
+        with self.profiler.stage("merge_shards") as stage:
+            for fragment_file in fragment_files:
+                try:
+                    cache_data = read_cache_data(fragment_file, CACHE_SCHEMA)
+                    shard = cache_data["shard"]
+                    metadata: CacheMetadata = cache_data["metadata"]
+                    binary_cache = cache_data["binary_cache"]
+                except Exception as e:
+                    raise ShardError(
+                        f"{fragment_file}: not a shard fragment ({e})"
+                    ) from e
+
+                if metadata.source_directory != str(self.source_dir):
+                    raise ShardError(
+                        f"{fragment_file}: built for source directory "
+                        f"{metadata.source_directory}"
+                    )
+                if (
+                    shard["config_hash"] != config_hash
+                    or binary_cache.get("version") != BINARY_CACHE_VERSION
+                ):
+                    raise ShardError(
+                        f"{fragment_file}: built with other parser, preprocessor "
+                        "or cache format settings"
+                    )
+                if not shard_files:
+                    shard_count, file_count = shard["count"], shard["file_count"]
+                elif (shard["count"], shard["file_count"]) != (shard_count, file_count):
+                    raise ShardError(
+                        f"{fragment_file}: belongs to another build "
+                        f"({shard['count']} shards of {shard['file_count']} files)"
+                    )
+                if shard["index"] in shard_files:
+                    raise ShardError(
+                        f"shard {shard['index']}/{shard_count} found twice: "
+                        f"{shard_files[shard['index']]}, {fragment_file}"
+                    )
+                shard_files[shard["index"]] = fragment_file
+
+                try:
+                    mapped = read_binary_cache(
+                        fragment_file.with_suffix(".bin"), binary_cache.get("token")
+                    )
+                except BinaryCacheError as e:
+                    raise ShardError(f"{fragment_file}: binary cache {e}") from e
+                fragment_keys = list(cache_data["file_entries"]) + shard["failed_files"]
+                for file_key in fragment_keys:
+                    if file_key in entries or file_key in failed_files:
+                        raise ShardError(f"{file_key} is in more than one shard")
+                for file_key, entry in cache_data["file_entries"].items():
+                    sources[file_key] = (mapped.store, entry.function_ids)
+                    entries[file_key] = entry
+                failed_files.update(shard["failed_files"])
+                parse_errors.extend(cache_data.get("parse_errors", []))
+                stage.bytes += fragment_file.stat().st_size
+
+                if verbose:
+                    print(
+                        f"  Shard {shard['index']}/{shard_count}: "
+                        f"{len(fragment_keys)} files from {fragment_file}"
+                    )
+
+            missing = sorted(set(range(1, shard_count + 1)) - set(shard_files))
+            if missing:
+                raise ShardError(
+                    "missing shard fragments: "
+                    + ", ".join(f"{index}/{shard_count}" for index in missing)
+                )
+            file_keys = set(entries) | failed_files
+            if len(file_keys) != file_count:
+                raise ShardError(
+                    f"fragments cover {len(file_keys)} of {file_count} files"
+                )
+
+            c_files = sorted(Path(file_key) for file_key in file_keys)
+            self._copy_file_functions(c_files, sources)
+
+        self.call_graph = None
+        self.parse_errors = parse_errors
+        self.total_files_scanned = len(c_files)
+        self._scanned_files = c_files
+        self._failed_files = failed_files
+        self._lazy_pending = set()
+        # Checksums and stats of the shard nodes; the next build compares them
+        self.file_checksums = {key: entry.checksum for key, entry in entries.items()}
+        self.file_stats = {
+            key: (entry.mtime_ns, entry.size) for key, entry in entries.items()
+        }
+
+        with self.profiler.stage("call_graph"):
+            self.call_graph = CallGraph.build(self)
+        with self.profiler.stage("name_index"):
+            self.get_name_search_index()
+        if self.module_config:
+            with self.profiler.stage("module_graph"):
+                self.get_module_graph()
+        with self.profiler.stage("cache_save") as stage:
+            self._write_cache(self.cache_file, self.binary_cache_file)
+            stage.bytes = self._cache_size()
+
+        if verbose:
+            print(
+                f"Merged {shard_count} shards: {self.total_files_scanned} files, "
+                f"{self.total_functions_found} functions, "
+                f"{len(self.parse_errors)} parse errors"
+            )
+
     def _build_with_two_stage_pipeline(
         self,
         c_files: List[Path],
@@ -194,14 +840,24 @@ class FunctionDatabase:
             verbose: Print progress information
             preprocess_only: Only run preprocessing stage
         """
-        # Stage 1: Preprocess all files
         preprocessor = CPPPreprocessor(
             config=self.preprocessor_config,
             temp_dir=self.temp_dir,
             keep_temp=self.keep_temp,
+            jobs=self.jobs,
         )
 
-        self.preprocess_stats = preprocessor.preprocess_all(c_files, verbose=verbose)
+        if not self.keep_temp and not preprocess_only:
+            self._build_with_streaming_pipeline(c_files, preprocessor, verbose)
+            return
+
+        # Stage 1: Preprocess all files
+        with self.profiler.stage("preprocess") as stage:
+            self.preprocess_stats = preprocessor.preprocess_all(
+                c_files, verbose=verbose
+            )
+            stage.bytes = _result_bytes(self.preprocess_stats.results)
+        self.profiler.add_results("preprocess", self.preprocess_stats.results)
 
         print(self.c_parser.get_statistics_summary(
             self._convert_prep_stats_to_parse_format(self.preprocess_stats)
@@ -211,6 +867,8 @@ class FunctionDatabase:
             print("\nPreprocessing only mode - skipping parsing stage")
             return
 
+        self._use_shared_prefix(self.preprocess_stats.shared_prefix, verbose)
+
         # Build mapping of source files to preprocessed files
         preprocessed_files: Dict[Path, Path] = {}
         for result in self.preprocess_stats.results:
@@ -218,24 +876,18 @@ class FunctionDatabase:
                 preprocessed_files[result.source_file] = result.output_file
 
         # Stage 2: Parse preprocessed files
-        self.parse_stats = self.c_parser.parse_all(
-            source_files=c_files,
-            verbose=verbose,
-            preprocessed_files=preprocessed_files,
-        )
-
-        # Add functions from parse results to database
-        parse_results: List[ParseResult] = self.parse_stats.results
-        for parse_result in parse_results:
-            for func_info in parse_result.functions:
-                self._add_function(func_info)
+        with self.profiler.stage("parse") as stage:
+            self.parse_stats = self.c_parser.parse_all(
+                source_files=c_files,
+                verbose=verbose,
+                preprocessed_files=preprocessed_files,
+                jobs=self.jobs,
+            )
+            stage.bytes = _result_bytes(self.parse_stats.results)
+        self.profiler.add_results("parse", self.parse_stats.results)
 
-            # Track functions by file
-            if parse_result.functions:
-                file_key = str(parse_result.source_file)
-                self.functions_by_file[file_key] = parse_result.functions
-
-        self.total_files_scanned = len(c_files)
+        with self.profiler.stage("index"):
+            self._register_pipeline_results(c_files)
 
         # Clean up temp files if not keeping them
         if not self.keep_temp:
@@ -245,31 +897,109 @@ class FunctionDatabase:
         print("\n=== Summary ===")
         print(self._get_pipeline_summary())
 
-    def _build_with_single_stage(
+    def _build_with_streaming_pipeline(
         self,
         c_files: List[Path],
+        preprocessor: CPPPreprocessor,
         verbose: bool,
     ) -> None:
         """
-        Build database using single-stage processing (fallback).
+        Build database by parsing cpp output straight from the pipe.
+
+        No .i files are written; each file is preprocessed and parsed in
+        one fused step. Used unless --keep-temp or --preprocess-only asks
+        for the preprocessed files on disk.
+
+        Implements: SWR_PARSER_00046 (Fused Streaming Preprocess and Parse)
 
         Args:
             c_files: List of C source files to process
+            preprocessor: Preprocessor running cpp in stream mode
             verbose: Print progress information
         """
-        # Parse each file
-        for idx, file_path in enumerate(c_files, 1):
-            print(
-                f"Processing: [{idx}/{len(c_files)}] {file_path.name} (Size: {_format_file_size(file_path.stat().st_size)})"
+        with self.profiler.stage("shared_prefix"):
+            shared_prefix = preprocessor.preprocess_shared_prefix(c_files)
+            if verbose and shared_prefix:
+                print(
+                    f"Shared include prefix: {len(shared_prefix.includes)} "
+                    f"include(s), {len(shared_prefix.header_files)} header(s)"
+                )
+            self._use_shared_prefix(shared_prefix, verbose)
+
+        with self.profiler.stage("preprocess_and_parse") as stage:
+            self.preprocess_stats, self.parse_stats = (
+                self.c_parser.preprocess_and_parse_all(
+                    c_files, preprocessor, verbose=verbose, jobs=self.jobs
+                )
             )
+            stage.bytes = _result_bytes(self.parse_stats.results)
+        self.preprocess_stats.shared_prefix = shared_prefix
+        self.profiler.add_results("preprocess", self.preprocess_stats.results)
+        self.profiler.add_results("parse", self.parse_stats.results)
 
-            try:
-                self._parse_file(file_path)
-            except Exception as e:
-                error_msg = f"Error parsing {file_path}: {e}"
-                self.parse_errors.append(error_msg)
-                if verbose:
-                    print(f"Warning: {error_msg}")
+        with self.profiler.stage("index"):
+            self._register_pipeline_results(c_files)
+        preprocessor.cleanup()
+
+        print("\n=== Summary ===")
+        print(self._get_pipeline_summary())
+
+    def _use_shared_prefix(
+        self, shared_prefix: Optional[SharedIncludePrefix], verbose: bool
+    ) -> None:
+        """
+        Parse the shared include prefix once; its headers are then skipped
+        in every preprocessed file.
+
+        Args:
+            shared_prefix: Preprocessed shared include prefix, if any
+            verbose: Print progress information
+        """
+        if shared_prefix and self.c_parser.use_shared_prefix(shared_prefix):
+            if verbose:
+                print(
+                    f"Skipping {len(shared_prefix.header_files)} shared header(s) "
+                    f"({len(shared_prefix.typedef_names)} typedefs declared once)"
+                )
+
+    def _register_pipeline_results(self, c_files: List[Path]) -> None:
+        """
+        Add the functions of both pipeline stages' results to the database.
+
+        Args:
+            c_files: List of C source files that were processed
+        """
+        assert self.preprocess_stats is not None and self.parse_stats is not None
+        parse_results: List[ParseResult] = self.parse_stats.results
+        for prep_result in self.preprocess_stats.results:
+            if not prep_result.success:
+                self._failed_files.add(str(prep_result.source_file))
+        for parse_result in parse_results:
+            if not parse_result.success:
+                self._failed_files.add(str(parse_result.source_file))
+            self._register_file_functions(
+                parse_result.source_file, parse_result.functions
+            )
+
+        self.total_files_scanned = len(c_files)
+        self.c_parser.shared_prefix = None
+
+    def _build_with_single_stage(
+        self,
+        c_files: List[Path],
+        verbose: bool,
+    ) -> None:
+        """
+        Build database using single-stage processing (fallback).
+
+        Args:
+            c_files: List of C source files to process
+            verbose: Print progress information
+        """
+        if self.jobs > 1 and len(c_files) > 1:
+            self._parse_files_in_parallel(c_files, verbose)
+        else:
+            self._parse_files_serially(c_files, verbose)
 
         self.total_files_scanned = len(c_files)
 
@@ -280,6 +1010,63 @@ class FunctionDatabase:
             print(f"  - Unique function names: {len(self.functions)}")
             print(f"  - Parse errors: {len(self.parse_errors)}")
 
+    def _parse_files_serially(self, c_files: List[Path], verbose: bool) -> None:
+        """
+        Parse files one by one in this process.
+
+        Args:
+            c_files: List of C source files to process
+            verbose: Print progress information
+        """
+        with self.profiler.stage("parse") as stage:
+            for idx, file_path in enumerate(c_files, 1):
+                print(
+                    f"Processing: [{idx}/{len(c_files)}] {file_path.name} (Size: {_format_file_size(file_path.stat().st_size)})"
+                )
+
+                try:
+                    self._parse_file(file_path)
+                    stage.bytes += self.c_parser.last_bytes
+                except Exception as e:
+                    error_msg = f"Error parsing {file_path}: {e}"
+                    self.parse_errors.append(error_msg)
+                    self._failed_files.add(str(file_path))
+                    if verbose:
+                        print(f"Warning: {error_msg}")
+
+    def _parse_files_in_parallel(self, c_files: List[Path], verbose: bool) -> None:
+        """
+        Parse files in a process pool and merge the results in input order.
+
+        Implements: SWR_PARSER_00041 (Multi-Process Parsing)
+
+        Args:
+            c_files: List of C source files to process
+            verbose: Print progress information
+        """
+        with self.profiler.stage("parse") as stage:
+            results = self.c_parser.parse_files_parallel(
+                [(file_path, None) for file_path in c_files], self.jobs
+            )
+            stage.bytes = _result_bytes(results)
+        self.profiler.add_results("parse", results)
+
+        with self.profiler.stage("index"):
+            for idx, result in enumerate(results, 1):
+                file_path = result.source_file
+                print(
+                    f"Processing: [{idx}/{len(c_files)}] {file_path.name} (Size: {_format_file_size(file_path.stat().st_size)})"
+                )
+
+                if result.success:
+                    self._register_file_functions(file_path, result.functions)
+                else:
+                    error_msg = f"Error parsing {file_path}: {result.error_message}"
+                    self.parse_errors.append(error_msg)
+                    self._failed_files.add(str(file_path))
+                    if verbose:
+                        print(f"Warning: {error_msg}")
+
     def _convert_prep_stats_to_parse_format(
         self, prep_stats: PreprocessStatistics
     ) -> ParseStatistics:
@@ -315,6 +1102,10 @@ class FunctionDatabase:
             lines.append(f"  Traditional:   {self.parse_stats.traditional_functions}")
             lines.append(f"  Total:         {self.parse_stats.total_functions}")
             lines.append("")
+            lines.append("Parse paths:")
+            lines.append(f"  Lexical scan:  {self.parse_stats.lexical_files} files")
+            lines.append(f"  pycparser:     {self.parse_stats.pycparser_files} files")
+            lines.append("")
             lines.append(f"Correctness Ratio: {self.parse_stats.correctness_ratio:.1f}%")
 
             if self.parse_stats.failed > 0:
@@ -336,46 +1127,220 @@ class FunctionDatabase:
             file_path: Path to source file
         """
         # Use C parser which handles both traditional C and AUTOSAR via pycparser
+        start_time = time.time()
         functions = self.c_parser.parse_file(file_path)
+        start = time.perf_counter()
+        self._register_file_functions(file_path, functions)
 
-        # Add functions to database
-        for func_info in functions:
-            self._add_function(func_info)
+        timings = self.c_parser.last_timings
+        timings["index"] = time.perf_counter() - start
+        self.profiler.add_file(
+            "parse", file_path, start_time, timings, self.c_parser.last_bytes
+        )
 
-        # Track functions by file
-        if functions:
-            file_key = str(file_path)
-            self.functions_by_file[file_key] = functions
+    def _register_file_functions(
+        self, file_path: Path, functions: List[FunctionInfo]
+    ) -> None:
+        """
+        Add the functions parsed from one file to the database.
+
+        Args:
+            file_path: Path to source file
+            functions: Functions extracted from the file
+        """
+        func_ids = [self._add_function(func_info) for func_info in functions]
 
-    def _add_function(self, func_info: FunctionInfo) -> None:
+        # Track functions by file; IDs of one file are consecutive
+        if func_ids:
+            self.functions_by_file.set_ids(
+                str(file_path), range(func_ids[0], func_ids[-1] + 1)
+            )
+
+    def _add_function(self, func_info: FunctionInfo) -> int:
         """
         Add a function to the database.
 
+        The function is copied into the store; lookups return a
+        materialized copy.
+
         Args:
             func_info: Function information to add
+
+        Returns:
+            Function ID in the store
         """
         # Apply module mapping if configuration is available
         if self.module_config:
             func_info.sw_module = self.module_config.get_module_for_file(
                 func_info.file_path
             )
-            if func_info.sw_module:
-                self.module_stats[func_info.sw_module] = (
-                    self.module_stats.get(func_info.sw_module, 0) + 1
-                )
+
+        func_id = self.store.add(func_info)
+        self._index_function(func_id)
+        return func_id
+
+    def _index_function(self, func_id: int) -> None:
+        """
+        Add a function of the store to the name and qualified indexes.
+
+        Args:
+            func_id: Function ID in the store
+        """
+        if self.module_config:
+            sw_module = self.store.sw_module(func_id)
+            if sw_module:
+                self.module_stats[sw_module] = self.module_stats.get(sw_module, 0) + 1
 
         # Add to main functions dictionary
-        if func_info.name not in self.functions:
-            self.functions[func_info.name] = []
-        self.functions[func_info.name].append(func_info)
+        name = self.store.name(func_id)
+        self.functions.add_id(name, func_id)
 
         # Add to qualified functions for static function resolution
-        file_stem = Path(func_info.file_path).stem
-        qualified_key = f"{file_stem}::{func_info.name}"
-        self.qualified_functions[qualified_key] = func_info
+        self.qualified_functions.set_id(self.store.qualified_key(func_id), func_id)
 
         self.total_functions_found += 1
 
+        # Call resolution may change with the new function
+        self.call_graph = None
+
+    def _cache_size(self) -> int:
+        """
+        Get the size of the cache files.
+
+        Returns:
+            Bytes of the pickle and binary cache files that exist
+        """
+        size = 0
+        for cache_file in (self.cache_file, self.binary_cache_file):
+            try:
+                size += cache_file.stat().st_size
+            except OSError:
+                pass
+        return size
+
+    def _reset_store(self, store: FunctionStore) -> None:
+        """
+        Replace the store and start with empty indexes on top of it.
+
+        Args:
+            store: New function store
+        """
+        self.store = store
+        self.functions = FunctionIndex(store)
+        self.qualified_functions = QualifiedFunctionIndex(store)
+        self.functions_by_file = FunctionIndex(store)
+        self._name_search = None
+
+    def get_call_graph(self) -> CallGraph:
+        """
+        Get the resolved call graph, building it if needed.
+
+        Implements: SWR_DB_00038 (Resolved Call Graph Index)
+
+        Returns:
+            CallGraph of the current database content
+        """
+        if self.call_graph is None:
+            self.call_graph = CallGraph.build(self)
+        return self.call_graph
+
+    def get_name_search_index(self) -> NameSearchIndex:
+        """
+        Get the search index of the function names, building it if needed.
+
+        Implements: SWR_DB_00041 (Indexed Name Search)
+
+        Returns:
+            NameSearchIndex of the current keys of functions
+        """
+        if (
+            self._name_search is None
+            or self._name_search_version != self.functions.version
+        ):
+            self._name_search = NameSearchIndex.build(list(self.functions.ids))
+            self._name_search_version = self.functions.version
+        return self._name_search
+
+    def get_module_graph(self) -> ModuleGraph:
+        """
+        Get the call graph between SW modules, building it if needed.
+
+        Implements: SWR_DB_00048 (Module Call Graph)
+
+        Returns:
+            ModuleGraph of the current call graph
+        """
+        call_graph = self.get_call_graph()
+        if self._module_graph is None or self._module_graph_source is not call_graph:
+            self._module_graph = ModuleGraph.build(call_graph)
+            self._module_graph_source = call_graph
+        return self._module_graph
+
+    def _rebuild_indexes(
+        self, c_files: List[Path], reused: Dict[str, FileCacheEntry]
+    ) -> None:
+        """
+        Rebuild the store and indexes from newly parsed and reused files.
+
+        Functions are copied in source file order, column by column, so
+        that an incremental build produces the same store and indexes as a
+        full build. Reused files are copied from the store of the cache.
+
+        Args:
+            c_files: Source files in discovery order
+            reused: Cache entries of unchanged files
+        """
+        parsed_store = self.store
+        parsed_ids = self.functions_by_file.ids
+        sources: Dict[str, Tuple[FunctionStore, Sequence[int]]] = {}
+        for file_path in c_files:
+            file_key = str(file_path)
+            if file_key in parsed_ids:
+                sources[file_key] = (parsed_store, parsed_ids[file_key])
+            elif file_key in reused and self._reusable_store is not None:
+                sources[file_key] = (
+                    self._reusable_store,
+                    reused[file_key].function_ids,
+                )
+        self._copy_file_functions(c_files, sources)
+        self._reusable_store = None
+
+    def _copy_file_functions(
+        self,
+        c_files: List[Path],
+        sources: Dict[str, Tuple[FunctionStore, Sequence[int]]],
+    ) -> None:
+        """
+        Rebuild the store and indexes from the functions of other stores.
+
+        Args:
+            c_files: Source files in the order of the new store
+            sources: File path -> store holding its functions and their IDs
+        """
+        self._reset_store(FunctionStore())
+        self.module_stats.clear()
+        self.total_functions_found = 0
+
+        for file_path in c_files:
+            file_key = str(file_path)
+            if file_key not in sources:
+                continue
+            source, source_ids = sources[file_key]
+            if not source_ids:
+                continue
+
+            func_ids = self.store.copy_functions(source, source_ids)
+            for func_id in func_ids:
+                if self.module_config:
+                    self.store.set_sw_module(
+                        func_id,
+                        self.module_config.get_module_for_file(
+                            self.store.file_path(func_id)
+                        ),
+                    )
+                self._index_function(func_id)
+            self.functions_by_file.set_ids(file_key, func_ids)
+
     def lookup_function(
         self, function_name: str, context_file: Optional[str] = None
     ) -> List[FunctionInfo]:
@@ -389,6 +1354,10 @@ class FunctionDatabase:
         Returns:
             List of FunctionInfo objects matching the name
         """
+        # In lazy mode, parse the files defining the function first
+        if self._lazy_pending:
+            self.ensure_parsed([function_name])
+
         # If context file is provided and function is qualified, try qualified lookup
         if context_file and "::" in function_name:
             qualified_info = self.qualified_functions.get(function_name)
@@ -410,8 +1379,8 @@ class FunctionDatabase:
         return []
 
     def _select_best_function_match(
-        self, candidates: List[FunctionInfo], context_file: Optional[str] = None
-    ) -> Optional[FunctionInfo]:
+        self, candidates: Sequence[CandidateT], context_file: Optional[str] = None
+    ) -> Optional[CandidateT]:
         """
         Select the best function from multiple candidates.
 
@@ -423,6 +1392,9 @@ class FunctionDatabase:
         3. Cross-module: Avoid the calling file for cross-module calls
         4. Module assignment: Prefer functions with assigned modules
 
+        Candidates are FunctionInfo objects, or FunctionSummary tuples of
+        the store when resolving the call graph.
+
         Args:
             candidates: List of FunctionInfo objects to choose from
             context_file: File path of the calling function (optional)
@@ -470,6 +1442,35 @@ class FunctionDatabase:
 
         return candidates[0]
 
+    def lookup_callers(
+        self, function_name: str, context_file: Optional[str] = None
+    ) -> List[FunctionInfo]:
+        """
+        Get the functions that call a function.
+
+        The definitions of the function are looked up like
+        lookup_function(); a caller is listed once, however many of its
+        calls resolve to one of them.
+
+        Implements: SWR_DB_00042 (Reverse Call Graph Index)
+
+        Args:
+            function_name: Name of the called function
+            context_file: File path for context (helps resolve static functions)
+
+        Returns:
+            Calling functions, in database order
+        """
+        # Callers may be in any file, so lazy mode parses all of them
+        self.parse_pending_files()
+        graph = self.get_call_graph()
+        caller_ids = set()
+        for func_info in self.lookup_function(function_name, context_file):
+            func_id = graph.get_id(func_info)
+            if func_id is not None:
+                caller_ids.update(caller_id for caller_id, _ in graph.callers(func_id))
+        return [graph.function(caller_id) for caller_id in sorted(caller_ids)]
+
     def get_function_by_qualified_name(
         self, qualified_name: str
     ) -> Optional[FunctionInfo]:
@@ -484,6 +1485,56 @@ class FunctionDatabase:
         """
         return self.qualified_functions.get(qualified_name)
 
+    def get_reachable_fingerprint(
+        self, function_name: str, max_depth: int
+    ) -> Optional[str]:
+        """
+        Fingerprint the functions reachable from a function.
+
+        The fingerprint covers the qualified key, file, SW module and file
+        checksum of every function within max_depth calls of the first
+        match of function_name, and the parse settings. It changes when any
+        of these functions or their files change, or when a call of them
+        resolves to another function; the call tree is not built.
+
+        Implements: SWR_DB_00047 (Reachable Function Fingerprint)
+
+        Args:
+            function_name: Name of the root function
+            max_depth: Maximum number of calls from the root
+
+        Returns:
+            32 hex characters, or None if the function is not found
+        """
+        functions = self.lookup_function(function_name)
+        if not functions:
+            return None
+        call_graph = self.get_call_graph()
+        root_id = call_graph.get_id(functions[0])
+        if root_id is None:
+            return None
+
+        entries = []
+        for func_id in call_graph.reachable(root_id, max_depth):
+            file_path = self.store.file_path(func_id)
+            entries.append(
+                "\0".join(
+                    (
+                        self.store.qualified_key(func_id),
+                        str(file_path),
+                        self.store.sw_module(func_id) or "",
+                        self._get_file_checksum(file_path),
+                    )
+                )
+            )
+
+        hasher = hashlib.blake2b(digest_size=16)
+        hasher.update(self._compute_config_hash().encode("utf-8"))
+        for entry in sorted(entries):
+            hasher.update(b"\n")
+            hasher.update(entry.encode("utf-8"))
+        return hasher.hexdigest()
+
     def get_all_function_names(self) -> List[str]:
         """
         Get all unique function names in the database.
@@ -505,24 +1556,101 @@ class FunctionDatabase:
         """
         return self.functions_by_file.get(file_path, [])
 
-    def search_functions(self, pattern: str) -> List[FunctionInfo]:
+    def search_function_names(
+        self, pattern: str, mode: str = "substring", limit: Optional[int] = None
+    ) -> List[str]:
+        """
+        Search for function names matching a pattern.
+
+        Implements: SWR_DB_00041 (Indexed Name Search)
+
+        Args:
+            pattern: Search pattern
+            mode: "substring" (case-insensitive), "prefix" (case-insensitive)
+                or "regex" (re.search, case-sensitive)
+            limit: Maximum number of names to return (None: all)
+
+        Returns:
+            Matching names in database order
+
+        Raises:
+            ValueError: If the mode is unknown or the regex is invalid
+        """
+        names: List[str] = []
+        if limit is None or limit > 0:
+            for name in self._matching_names(pattern, mode):
+                names.append(name)
+                if len(names) == limit:
+                    break
+        return names
+
+    def search_functions(
+        self, pattern: str, mode: str = "substring", limit: Optional[int] = None
+    ) -> List[FunctionInfo]:
         """
         Search for functions matching a pattern.
 
+        Only the names the search index yields as candidates are compared,
+        and only returned functions are materialized.
+
+        Implements: SWR_DB_00041 (Indexed Name Search)
+
         Args:
-            pattern: Search pattern (substring match)
+            pattern: Search pattern (substring match by default)
+            mode: "substring", "prefix" or "regex" (see search_function_names)
+            limit: Maximum number of functions to return (None: all)
 
         Returns:
             List of matching FunctionInfo objects
+
+        Raises:
+            ValueError: If the mode is unknown or the regex is invalid
         """
-        results = []
-        pattern_lower = pattern.lower()
+        results: List[FunctionInfo] = []
+        if limit is not None and limit <= 0:
+            return results
+        for name in self._matching_names(pattern, mode):
+            for func_id in self.functions.ids[name]:
+                results.append(self.store.get(func_id))
+                if len(results) == limit:
+                    return results
+        return results
 
-        for func_name, func_list in self.functions.items():
-            if pattern_lower in func_name.lower():
-                results.extend(func_list)
+    def _matching_names(self, pattern: str, mode: str) -> Iterator[str]:
+        """
+        Yield the names matching a pattern, in database order.
 
-        return results
+        Args:
+            pattern: Search pattern
+            mode: One of SEARCH_MODES
+
+        Raises:
+            ValueError: If the mode is unknown or the regex is invalid
+        """
+        if mode not in SEARCH_MODES:
+            raise ValueError(
+                f"Unknown search mode '{mode}' (use {', '.join(SEARCH_MODES)})"
+            )
+        regex = None
+        if mode == "regex":
+            try:
+                regex = re.compile(pattern)
+            except re.error as e:
+                raise ValueError(f"Invalid search pattern '{pattern}': {e}")
+        pattern_lower = pattern.lower()
+
+        index = self.get_name_search_index()
+        names = index.names
+        for position in index.candidates(pattern, mode):
+            name = names[position]
+            if regex is not None:
+                matched = regex.search(name) is not None
+            elif mode == "prefix":
+                matched = name.lower().startswith(pattern_lower)
+            else:
+                matched = pattern_lower in name.lower()
+            if matched:
+                yield name
 
     def get_statistics(self) -> Dict[str, Any]:
         """
@@ -531,12 +1659,7 @@ class FunctionDatabase:
         Returns:
             Dictionary with statistics
         """
-        static_count = sum(
-            1
-            for funcs in self.functions.values()
-            for func in funcs
-            if func.function_type.name == "STATIC"
-        )
+        static_count = self.store.count_function_type("STATIC")
 
         return {
             "parser_type": self.parser_type,
@@ -553,51 +1676,189 @@ class FunctionDatabase:
         """
         Compute checksum of a file.
 
+        Uses the non-cryptographic xxh3_128 hash when the optional xxhash
+        package is installed, otherwise 128-bit BLAKE2b. Both are faster
+        than MD5 and give 32 hex characters.
+
+        Implements: SWR_DB_00037 (Stat-Based Change Detection)
+
         Args:
             file_path: Path to file
 
         Returns:
-            MD5 checksum as hex string
+            Checksum as hex string ("" if the file cannot be read)
         """
-        md5 = hashlib.md5()
+        hasher = xxhash.xxh3_128() if xxhash else hashlib.blake2b(digest_size=16)
         try:
             with open(file_path, "rb") as f:
-                for chunk in iter(lambda: f.read(8192), b""):
-                    md5.update(chunk)
-            return md5.hexdigest()
+                for chunk in iter(lambda: f.read(1024 * 1024), b""):
+                    hasher.update(chunk)
+            return hasher.hexdigest()
         except Exception:
             return ""
 
-    def _save_to_cache(self, verbose: bool = False) -> None:
+    def _discover_source_files(self) -> List[Path]:
+        """
+        Find all C source files, walking the source directory once per build.
+
+        The files are sorted, so builds on different hosts process them in
+        the same order (SWR_DB_00046).
+
+        Returns:
+            List of C source files
+        """
+        if self._scanned_files is None:
+            self._scanned_files = sorted(self.source_dir.rglob("*.c"))
+        return self._scanned_files
+
+    def _get_file_stat(self, file_path: Path) -> Optional[Tuple[int, int]]:
+        """
+        Get (st_mtime_ns, st_size) of a file, reading it at most once per build.
+
+        Args:
+            file_path: Path to file
+
+        Returns:
+            Tuple of modification time in nanoseconds and size, or None on error
+        """
+        file_key = str(file_path)
+        if file_key not in self.file_stats:
+            try:
+                stat_result = file_path.stat()
+            except OSError:
+                return None
+            self.file_stats[file_key] = (stat_result.st_mtime_ns, stat_result.st_size)
+        return self.file_stats[file_key]
+
+    def _get_file_checksum(self, file_path: Path) -> str:
+        """
+        Get the checksum of a file, computing it at most once per build.
+
+        Args:
+            file_path: Path to file
+
+        Returns:
+            Checksum as hex string
+        """
+        file_key = str(file_path)
+        if file_key not in self.file_checksums:
+            self.file_checksums[file_key] = self._compute_file_checksum(file_path)
+        return self.file_checksums[file_key]
+
+    def _snapshot_sources(self, files: List[Path]) -> None:
+        """
+        Record the stats and checksums of files before they are read for parsing.
+
+        The cache entries of the files are built from these values. Taken
+        when the cache is saved, they would describe a file edited during
+        the build by its new content, next to functions parsed from the
+        old one; taken before the read, such an edit makes the entry stale.
+        The stat is taken first: one recorded after the edit would let the
+        next run take the file as unchanged without hashing it.
+
+        Implements: SWR_DB_00036 (Incremental Per-File Cache),
+        SWR_DB_00037 (Stat-Based Change Detection)
+
+        Args:
+            files: Files about to be parsed
+        """
+        with self.profiler.stage("checksum"):
+            for file_path in files:
+                self._get_file_stat(file_path)
+                self._get_file_checksum(file_path)
+
+    def _compute_config_hash(self) -> str:
+        """
+        Compute a hash of the settings that influence parse results.
+
+        Cached file entries are only reused when this hash matches.
+
+        Returns:
+            MD5 hash of parser type, parser revision and preprocessor
+            settings as hex string
+        """
+        parts = [self.parser_type, str(PARSE_RESULT_REVISION)]
+        if self.preprocessor_config:
+            parts.append(str(self.preprocessor_config.enabled))
+            parts.extend(self.preprocessor_config.get_compiler_args())
+        return hashlib.md5("\0".join(parts).encode("utf-8")).hexdigest()
+
+    def _build_file_entries(self) -> Dict[str, FileCacheEntry]:
+        """
+        Build per-file cache entries for all successfully parsed files.
+
+        Files that failed to preprocess or parse, or that lazy mode has not
+        parsed yet, get no entry, so they are parsed on the next run.
+
+        Returns:
+            Dictionary mapping file path to FileCacheEntry
+        """
+        config_hash = self._compute_config_hash()
+        entries: Dict[str, FileCacheEntry] = {}
+        for file_path in self._scanned_files or []:
+            file_key = str(file_path)
+            if file_key in self._failed_files or file_key in self._lazy_pending:
+                continue
+            file_stat = self._get_file_stat(file_path)
+            checksum = self._get_file_checksum(file_path)
+            if not checksum or file_stat is None:
+                continue
+            # IDs of one file are consecutive; a range pickles in constant size
+            func_ids = self.functions_by_file.ids.get(file_key, ())
+            entries[file_key] = FileCacheEntry(
+                checksum=checksum,
+                config_hash=config_hash,
+                function_ids=range(func_ids[0], func_ids[-1] + 1) if func_ids else (),
+                mtime_ns=file_stat[0],
+                size=file_stat[1],
+            )
+        return entries
+
+    def _save_to_cache(self, verbose: bool = False, profile: bool = False) -> None:
         """
         Save database to cache file.
 
+        The pickle holds the metadata and per-file entries only; the store,
+        indexes and call graph go into the binary cache file, which the
+        pickle refers to by its token.
+
+        With background_cache_write the files are written by a thread and
+        this method returns at once. The database must not change until
+        wait_for_cache_write() returns; lookups are fine.
+
+        Implements: SWR_DB_00036 (Incremental Per-File Cache)
+        Implements: SWR_DB_00040 (Memory-Mapped Binary Cache)
+        Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
         Args:
             verbose: Print progress information
+            profile: Record the write as the "cache_save" profiler stage
         """
-        try:
-            # Create metadata
-            metadata = CacheMetadata(
-                created_at=datetime.now(),
-                source_directory=str(self.source_dir),
-                file_count=self.total_files_scanned,
-                parser_type=self.parser_type,
-            )
+        self.wait_for_cache_write(verbose)
+        if not self.background_cache_write:
+            self._save_cache_files(verbose, profile)
+            return
+        # Lazily built parts are built here, so the thread only reads
+        self.get_call_graph()
+        self.get_name_search_index()
+        if self.module_config:
+            self.get_module_graph()
+        self._cache_writer = threading.Thread(
+            target=self._save_cache_files,
+            args=(verbose, profile),
+            name="cache-writer",
+        )
+        self._cache_writer.start()
 
-            # Create cache data
-            cache_data = {
-                "metadata": metadata,
-                "functions": self.functions,
-                "qualified_functions": self.qualified_functions,
-                "functions_by_file": self.functions_by_file,
-                "total_files_scanned": self.total_files_scanned,
-                "total_functions_found": self.total_functions_found,
-                "parse_errors": self.parse_errors,
-            }
-
-            # Save to pickle
-            with open(self.cache_file, "wb") as f:
-                pickle.dump(cache_data, f, protocol=pickle.HIGHEST_PROTOCOL)
+    def _save_cache_files(self, verbose: bool, profile: bool) -> None:
+        """Write the cache files, reporting errors as a warning."""
+        try:
+            if profile:
+                with self.profiler.stage("cache_save") as stage:
+                    self._write_cache(self.cache_file, self.binary_cache_file)
+                    stage.bytes = self._cache_size()
+            else:
+                self._write_cache(self.cache_file, self.binary_cache_file)
 
             if verbose:
                 print(f"Cache saved to {self.cache_file}")
@@ -606,6 +1867,82 @@ class FunctionDatabase:
             if verbose:
                 print(f"Warning: Failed to save cache: {e}")
 
+    def wait_for_cache_write(self, verbose: bool = False) -> None:
+        """
+        Wait until a cache write in the background has finished.
+
+        Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+        Args:
+            verbose: Print a message if there is a write to wait for
+        """
+        writer, self._cache_writer = self._cache_writer, None
+        if writer is None:
+            return
+        if verbose and writer.is_alive():
+            print("Waiting for the cache to be written...")
+        writer.join()
+
+    def _write_cache(
+        self,
+        cache_file: Path,
+        binary_cache_file: Path,
+        extra: Optional[Dict[str, Any]] = None,
+    ) -> None:
+        """
+        Write the database as a cache pickle and binary cache file.
+
+        Both files are compressed with cache_compression and replaced
+        atomically. The pickle is written last and names its binary cache
+        by token, so a pickle whose binary cache was replaced by another
+        job is rejected on load instead of being read with it.
+
+        Args:
+            cache_file: Pickle with the metadata and per-file entries
+            binary_cache_file: Binary cache file with store and indexes
+            extra: Additional entries of the pickle
+        """
+        file_entries = self._build_file_entries()
+
+        # Create metadata
+        metadata = CacheMetadata(
+            created_at=datetime.now(),
+            source_directory=str(self.source_dir),
+            file_count=self.total_files_scanned,
+            parser_type=self.parser_type,
+            file_checksums={
+                file_key: entry.checksum for file_key, entry in file_entries.items()
+            },
+        )
+
+        token = write_binary_cache(
+            binary_cache_file,
+            self.store,
+            {
+                "functions": self.functions.ids,
+                "qualified_functions": self.qualified_functions.ids,
+                "functions_by_file": self.functions_by_file.ids,
+            },
+            self.get_name_search_index(),
+            self.get_call_graph(),
+            compression=self.cache_compression,
+        )
+
+        # Create cache data
+        cache_data = {
+            "metadata": metadata,
+            "binary_cache": {"version": BINARY_CACHE_VERSION, "token": token},
+            "total_files_scanned": self.total_files_scanned,
+            "total_functions_found": self.total_functions_found,
+            "parse_errors": self.parse_errors,
+            "module_stats": self.module_stats,
+            "module_graph": self.get_module_graph() if self.module_config else None,
+            "file_entries": file_entries,
+        }
+        cache_data.update(extra or {})
+
+        write_cache_data(cache_file, cache_data, CACHE_SCHEMA, self.cache_compression)
+
     def _load_from_cache(self, verbose: bool = False) -> bool:
         """
         Load database from cache file.
@@ -613,6 +1950,17 @@ class FunctionDatabase:
         Implements: SWR_CACHE_00001 (File-by-File Cache Loading Progress)
         Implements: SWR_CACHE_00002 (Cache Status Indication)
         Implements: SWR_CACHE_00003 (Cache Loading Errors)
+        Implements: SWR_DB_00036 (Incremental Per-File Cache)
+        Implements: SWR_DB_00040 (Memory-Mapped Binary Cache)
+        Implements: SWR_DB_00049 (Versioned Compressed Cache Files)
+
+        The binary cache file is memory-mapped, not read: functions are
+        materialized only when a lookup returns them. Caches of another
+        schema version are not loaded.
+
+        If the cache holds per-file entries and any source file was changed,
+        added or removed, the cache is not loaded. The entries of unchanged
+        files are kept so that build_database() only parses the others.
 
         Args:
             verbose: Print progress information
@@ -624,8 +1972,12 @@ class FunctionDatabase:
             return False
 
         try:
-            with open(self.cache_file, "rb") as f:
-                cache_data = pickle.load(f)
+            try:
+                cache_data = read_cache_data(self.cache_file, CACHE_SCHEMA)
+            except CacheSchemaError as e:
+                if verbose:
+                    print(f"Cache invalid: {e}")
+                return False
 
             # Validate metadata
             metadata: CacheMetadata = cache_data.get("metadata")
@@ -652,22 +2004,60 @@ class FunctionDatabase:
                     )
                 return False
 
+            # Caches written before the binary cache format are parsed again
+            binary_cache = cache_data.get("binary_cache")
+            if (
+                not isinstance(binary_cache, dict)
+                or binary_cache.get("version") != BINARY_CACHE_VERSION
+            ):
+                if verbose:
+                    print("Cache invalid: outdated cache format")
+                return False
+            try:
+                mapped = read_binary_cache(
+                    self.binary_cache_file, binary_cache.get("token")
+                )
+            except BinaryCacheError as e:
+                if verbose:
+                    print(f"Cache invalid: binary cache {e}")
+                return False
+            store = mapped.store
+
+            # Caches written before per-file entries existed are loaded as is
+            file_entries = cache_data.get("file_entries")
+            if file_entries is not None and not self._validate_file_entries(
+                file_entries, verbose
+            ):
+                self._reusable_store = store
+                return False
+
             # Load data
-            self.functions = cache_data.get("functions", {})
-            self.qualified_functions = cache_data.get("qualified_functions", {})
-            self.functions_by_file = cache_data.get("functions_by_file", {})
+            self._reset_store(store)
+            self.functions.ids = mapped.indexes["functions"]
+            self.qualified_functions.ids = mapped.indexes["qualified_functions"]
+            self.functions_by_file.ids = mapped.indexes["functions_by_file"]
+            self._name_search = mapped.name_search
+            self._name_search_version = self.functions.version
             self.total_files_scanned = cache_data.get("total_files_scanned", 0)
             self.total_functions_found = cache_data.get("total_functions_found", 0)
             self.parse_errors = cache_data.get("parse_errors", [])
+            self.module_stats = dict(cache_data.get("module_stats", {}))
+            self.call_graph = mapped.call_graph
+            module_graph = cache_data.get("module_graph")
+            if self.module_config and self._refresh_sw_modules():
+                module_graph = None
+            if module_graph is not None:
+                self._module_graph = module_graph
+                self._module_graph_source = self.call_graph
 
             # Show file-by-file progress in verbose mode
             if verbose:
                 print(f"Loading {self.total_files_scanned} files from cache...")
-                for idx, (file_path, functions) in enumerate(
-                    self.functions_by_file.items(), 1
+                for idx, (file_path, func_ids) in enumerate(
+                    self.functions_by_file.ids.items(), 1
                 ):
                     file_name = Path(file_path).name
-                    func_count = len(functions)
+                    func_count = len(func_ids)
                     print(
                         f"  [{idx}/{self.total_files_scanned}] {file_name}: {func_count} functions"
                     )
@@ -679,7 +2069,105 @@ class FunctionDatabase:
                 print(f"Warning: Failed to load cache: {e}")
             return False
 
+    def _refresh_sw_modules(self) -> bool:
+        """
+        Apply the module configuration to the functions loaded from cache.
+
+        The cache keeps the SW modules of the configuration it was built
+        with; files whose module differs in the current configuration are
+        assigned again and the module statistics are recounted.
+
+        Implements: SWR_DB_00048 (Module Call Graph)
+
+        Returns:
+            True if any function changed its module
+        """
+        changed = False
+        for file_key, func_ids in self.functions_by_file.ids.items():
+            if not func_ids:
+                continue
+            sw_module = self.module_config.get_module_for_file(Path(file_key))
+            if self.store.sw_module(func_ids[0]) == sw_module:
+                continue
+            for func_id in func_ids:
+                self.store.set_sw_module(func_id, sw_module)
+            changed = True
+
+        if changed:
+            self.module_stats.clear()
+            for func_id in range(len(self.store)):
+                sw_module = self.store.sw_module(func_id)
+                if sw_module:
+                    self.module_stats[sw_module] = (
+                        self.module_stats.get(sw_module, 0) + 1
+                    )
+        return changed
+
+    def _validate_file_entries(
+        self, file_entries: Dict[str, FileCacheEntry], verbose: bool
+    ) -> bool:
+        """
+        Compare cached file entries against the current source files.
+
+        A file whose (st_mtime_ns, st_size) equals the cached values is
+        taken as unchanged without reading it; only files whose stat changed
+        are hashed. Entries of unchanged files are stored in
+        _reusable_entries for an incremental rebuild.
+
+        Implements: SWR_DB_00037 (Stat-Based Change Detection)
+
+        Args:
+            file_entries: Per-file entries loaded from the cache
+            verbose: Print progress information
+
+        Returns:
+            True if no file was changed, added or removed, False otherwise
+        """
+        config_hash = self._compute_config_hash()
+        current_files = self._discover_source_files()
+        current_keys = {str(file_path) for file_path in current_files}
+
+        reusable: Dict[str, FileCacheEntry] = {}
+        changed = 0
+        added = 0
+        for file_path in current_files:
+            file_key = str(file_path)
+            entry = file_entries.get(file_key)
+            if entry is None:
+                added += 1
+                continue
+            if entry.config_hash != config_hash:
+                changed += 1
+                continue
+
+            file_stat = self._get_file_stat(file_path)
+            if file_stat == (entry.mtime_ns, entry.size):
+                # Stat unchanged: trust the cached checksum
+                self.file_checksums[file_key] = entry.checksum
+                reusable[file_key] = entry
+            elif entry.checksum == self._get_file_checksum(file_path):
+                # Touched but identical content: keep entry, refresh its stat
+                if file_stat is not None:
+                    entry.mtime_ns, entry.size = file_stat
+                    self._entries_refreshed = True
+                reusable[file_key] = entry
+            else:
+                changed += 1
+        removed = sum(1 for file_key in file_entries if file_key not in current_keys)
+
+        if changed == 0 and added == 0 and removed == 0:
+            return True
+
+        self._reusable_entries = reusable
+        if verbose:
+            print(
+                f"Cache stale: {changed} changed, {added} added, {removed} removed files"
+            )
+        return False
+
     def clear_cache(self) -> None:
-        """Delete the cache file if it exists."""
-        if self.cache_file.exists():
-            self.cache_file.unlink()
+        """Delete the cache files if they exist."""
+        self.wait_for_cache_write()
+        for cache_file in (self.cache_file, self.binary_cache_file):
+            if cache_file.exists():
+                cache_file.unlink()
@@ -0,0 +1,774 @@
+"""
+Columnar function store.
+
+This module keeps all functions of a database in flat integer arrays that
+refer to one table of unique strings, and materializes FunctionInfo
+objects only when they are accessed. The indexes of FunctionDatabase hold
+function IDs into the store.
+
+Requirements:
+- SWR_DB_00039: Columnar Function Store
+"""
+
+from array import array
+from pathlib import Path
+from typing import (
+    Dict,
+    Iterator,
+    List,
+    Mapping,
+    MutableMapping,
+    NamedTuple,
+    Optional,
+    Protocol,
+    Sequence,
+    Sized,
+    Tuple,
+)
+
+from .models import FunctionCall, FunctionInfo, FunctionType, Parameter
+
+# String ID of None
+NO_STRING = -1
+
+# Target ID of a string that was not remapped yet
+_UNMAPPED = -2
+
+# Function types by their code in the function_types column
+FUNCTION_TYPES: List[FunctionType] = list(FunctionType)
+_FUNCTION_TYPE_IDS: Dict[FunctionType, int] = {
+    function_type: index for index, function_type in enumerate(FUNCTION_TYPES)
+}
+
+# Flag bits of the function_flags, param_flags and call_flags columns
+FUNCTION_STATIC = 1
+_POINTER = 1
+_CONST = 2
+CALL_CONDITIONAL = 1
+CALL_LOOP = 2
+
+# Column names per row kind; string columns hold IDs into the string table
+_FUNCTION_STRING_COLUMNS = (
+    "name_ids",
+    "return_type_ids",
+    "file_ids",
+    "memory_class_ids",
+    "macro_type_ids",
+    "qualified_name_ids",
+    "sw_module_ids",
+)
+_FUNCTION_INT_COLUMNS = ("line_numbers", "function_flags", "function_types")
+_PARAM_STRING_COLUMNS = (
+    "param_name_ids",
+    "param_type_ids",
+    "param_memory_class_ids",
+)
+_PARAM_INT_COLUMNS = ("param_flags",)
+_CALL_STRING_COLUMNS = (
+    "call_name_ids",
+    "call_condition_ids",
+    "call_loop_condition_ids",
+)
+_CALL_INT_COLUMNS = ("call_flags", "call_line_numbers")
+
+# All integer columns of a FunctionStore, including the row offsets
+STORE_COLUMNS = (
+    _FUNCTION_STRING_COLUMNS
+    + _FUNCTION_INT_COLUMNS
+    + _PARAM_STRING_COLUMNS
+    + _PARAM_INT_COLUMNS
+    + _CALL_STRING_COLUMNS
+    + _CALL_INT_COLUMNS
+    + ("param_offsets", "call_offsets")
+)
+
+
+class FunctionCandidate(Protocol):
+    """Fields used to choose between functions with the same name."""
+
+    @property
+    def name(self) -> str:
+        """Function name."""
+
+    @property
+    def file_path(self) -> Path:
+        """Defining file."""
+
+    @property
+    def sw_module(self) -> Optional[str]:
+        """Assigned SW module."""
+
+    @property
+    def calls(self) -> Sized:
+        """Calls of the function (only their number is used)."""
+
+
+class FunctionSummary(NamedTuple):
+    """Selection fields of a stored function, read without materializing it."""
+
+    func_id: int
+    name: str
+    file_path: Path
+    sw_module: Optional[str]
+    calls: range  # One entry per call of the function
+
+
+class StringTable:
+    """Unique strings, each stored once and referred to by its ID."""
+
+    def __init__(self) -> None:
+        """Initialize an empty string table."""
+        self.strings: List[str] = []
+        self._ids: Dict[str, int] = {}
+
+    def __len__(self) -> int:
+        """Number of strings."""
+        return len(self.strings)
+
+    def __getitem__(self, string_id: int) -> str:
+        """Get a string by ID."""
+        return self.strings[string_id]
+
+    def intern(self, value: Optional[str]) -> int:
+        """
+        Get the ID of a string, adding it if needed.
+
+        Args:
+            value: String, or None
+
+        Returns:
+            String ID (NO_STRING for None)
+        """
+        if value is None:
+            return NO_STRING
+        if len(self._ids) != len(self.strings):
+            # Index dropped on pickling, rebuild before the first addition
+            self._ids = {string: index for index, string in enumerate(self.strings)}
+        string_id = self._ids.get(value)
+        if string_id is None:
+            string_id = len(self.strings)
+            self.strings.append(value)
+            self._ids[value] = string_id
+        return string_id
+
+    def get(self, string_id: int) -> Optional[str]:
+        """
+        Get a string by ID.
+
+        Args:
+            string_id: String ID
+
+        Returns:
+            String, or None for NO_STRING
+        """
+        return self[string_id] if string_id >= 0 else None
+
+    def find(self, value: str) -> Optional[int]:
+        """
+        Get the ID of a string without adding it.
+
+        Args:
+            value: String to look up
+
+        Returns:
+            String ID, or None if the string is not in the table
+        """
+        if len(self._ids) != len(self.strings):
+            self._ids = {string: index for index, string in enumerate(self.strings)}
+        return self._ids.get(value)
+
+    def __getstate__(self) -> Dict[str, List[str]]:
+        """Only the strings are pickled; the index is rebuilt on demand."""
+        return {"strings": self.strings}
+
+    def __setstate__(self, state: Dict[str, List[str]]) -> None:
+        """Restore the strings of a pickled table."""
+        self.strings = state["strings"]
+        self._ids = {}
+
+
+class FunctionStore:
+    """
+    All functions of a database in flat columns.
+
+    Function func_id owns the parameter rows
+    param_offsets[func_id]:param_offsets[func_id + 1] and the call rows
+    call_offsets[func_id]:call_offsets[func_id + 1]. Strings (names, types,
+    file paths, conditions) are IDs into one StringTable.
+
+    Functions are copied into the columns by add(); get() materializes a
+    FunctionInfo on first access and returns the same object afterwards,
+    so only functions that are actually used exist as objects.
+
+    Implements: SWR_DB_00039 (Columnar Function Store)
+    """
+
+    def __init__(self) -> None:
+        """Initialize an empty store."""
+        self.strings: StringTable = StringTable()
+        for column in STORE_COLUMNS:
+            setattr(self, column, array("i"))
+        self.param_offsets.append(0)
+        self.call_offsets.append(0)
+        self.called_by: Dict[int, List[int]] = {}  # Rare; only non-empty sets
+        self._mapped = False
+        self._init_caches()
+
+    @classmethod
+    def from_columns(
+        cls,
+        strings: StringTable,
+        columns: Mapping[str, Sequence[int]],
+        called_by: Dict[int, List[int]],
+    ) -> "FunctionStore":
+        """
+        Create a read-only store over existing columns.
+
+        The columns (e.g. memoryviews of a memory-mapped cache file) are
+        used in place; they are copied into arrays only when the store is
+        modified.
+
+        Implements: SWR_DB_00040 (Memory-Mapped Binary Cache)
+
+        Args:
+            strings: String table the string columns refer to
+            columns: Column name -> integer sequence, for all STORE_COLUMNS
+            called_by: Function ID -> string IDs of its callers
+
+        Returns:
+            FunctionStore using the given columns
+        """
+        store = cls.__new__(cls)
+        store.strings = strings
+        for column in STORE_COLUMNS:
+            setattr(store, column, columns[column])
+        store.called_by = called_by
+        store._mapped = True
+        store._init_caches()
+        return store
+
+    def _ensure_writable(self) -> None:
+        """Copy columns used in place into arrays before modifying them."""
+        if not self._mapped:
+            return
+        for column in STORE_COLUMNS:
+            values = array("i")
+            values.frombytes(memoryview(getattr(self, column)).cast("B"))
+            setattr(self, column, values)
+        self._mapped = False
+
+    def _init_caches(self) -> None:
+        """Create the caches of materialized objects."""
+        self._objects: Dict[int, FunctionInfo] = {}
+        self._object_ids: Dict[int, int] = {}  # id(FunctionInfo) -> func_id
+        self._paths: Dict[int, Path] = {}
+        self._stems: Dict[int, str] = {}
+
+    def __len__(self) -> int:
+        """Number of functions."""
+        return len(self.name_ids)
+
+    def add(self, func_info: FunctionInfo, keep_object: bool = False) -> int:
+        """
+        Copy a function into the store.
+
+        Later changes to func_info are not seen by the store.
+
+        Args:
+            func_info: Function to add
+            keep_object: Return func_info itself from get() for the new ID
+
+        Returns:
+            Function ID of the added function
+        """
+        self._ensure_writable()
+        intern = self.strings.intern
+        func_id = len(self)
+
+        self.name_ids.append(intern(func_info.name))
+        self.return_type_ids.append(intern(func_info.return_type))
+        self.file_ids.append(intern(str(func_info.file_path)))
+        self.memory_class_ids.append(intern(func_info.memory_class))
+        self.macro_type_ids.append(intern(func_info.macro_type))
+        self.qualified_name_ids.append(intern(func_info.qualified_name))
+        self.sw_module_ids.append(intern(func_info.sw_module))
+        self.line_numbers.append(func_info.line_number)
+        self.function_flags.append(FUNCTION_STATIC if func_info.is_static else 0)
+        self.function_types.append(_FUNCTION_TYPE_IDS[func_info.function_type])
+
+        for param in func_info.parameters:
+            self.param_name_ids.append(intern(param.name))
+            self.param_type_ids.append(intern(param.param_type))
+            self.param_memory_class_ids.append(intern(param.memory_class))
+            self.param_flags.append(
+                (_POINTER if param.is_pointer else 0)
+                | (_CONST if param.is_const else 0)
+            )
+        self.param_offsets.append(len(self.param_name_ids))
+
+        for func_call in func_info.calls:
+            self.call_name_ids.append(intern(func_call.name))
+            self.call_condition_ids.append(intern(func_call.condition))
+            self.call_loop_condition_ids.append(intern(func_call.loop_condition))
+            self.call_flags.append(
+                (CALL_CONDITIONAL if func_call.is_conditional else 0)
+                | (CALL_LOOP if func_call.is_loop else 0)
+            )
+            line_number = func_call.line_number
+            self.call_line_numbers.append(-1 if line_number is None else line_number)
+        self.call_offsets.append(len(self.call_name_ids))
+
+        if func_info.called_by:
+            self.called_by[func_id] = [
+                intern(name) for name in sorted(func_info.called_by)
+            ]
+
+        if keep_object:
+            self._objects[func_id] = func_info
+            self._object_ids[id(func_info)] = func_id
+        return func_id
+
+    def copy_functions(
+        self, source: "FunctionStore", func_ids: Sequence[int]
+    ) -> range:
+        """
+        Copy functions of another store, column by column.
+
+        Contiguous IDs are copied as array slices; no FunctionInfo objects
+        are created.
+
+        Args:
+            source: Store to copy from
+            func_ids: IDs of the functions in source
+
+        Returns:
+            IDs of the copies in this store (contiguous)
+        """
+        self._ensure_writable()
+        first = len(self)
+        remap = _StringRemap(source.strings, self.strings)
+        for start, stop in _contiguous_runs(func_ids):
+            self._copy_rows(source, start, stop, remap)
+        return range(first, len(self))
+
+    def _copy_rows(
+        self,
+        source: "FunctionStore",
+        start: int,
+        stop: int,
+        remap: "_StringRemap",
+    ) -> None:
+        """Copy the functions start:stop of source with their rows."""
+        first = len(self)
+        for column in _FUNCTION_STRING_COLUMNS:
+            getattr(self, column).extend(
+                remap.column(getattr(source, column)[start:stop])
+            )
+        for column in _FUNCTION_INT_COLUMNS:
+            getattr(self, column).extend(getattr(source, column)[start:stop])
+
+        for offsets_name, string_columns, int_columns in (
+            ("param_offsets", _PARAM_STRING_COLUMNS, _PARAM_INT_COLUMNS),
+            ("call_offsets", _CALL_STRING_COLUMNS, _CALL_INT_COLUMNS),
+        ):
+            source_offsets = getattr(source, offsets_name)
+            row_start, row_stop = source_offsets[start], source_offsets[stop]
+            for column in string_columns:
+                getattr(self, column).extend(
+                    remap.column(getattr(source, column)[row_start:row_stop])
+                )
+            for column in int_columns:
+                getattr(self, column).extend(
+                    getattr(source, column)[row_start:row_stop]
+                )
+            offsets = getattr(self, offsets_name)
+            shift = offsets[-1] - row_start
+            offsets.extend(
+                array(
+                    "i",
+                    (offset + shift for offset in source_offsets[start + 1 : stop + 1]),
+                )
+            )
+
+        for func_id in range(start, stop):
+            names = source.called_by.get(func_id)
+            if names:
+                self.called_by[first + func_id - start] = list(remap.column(names))
+
+    def get(self, func_id: int) -> FunctionInfo:
+        """
+        Get the function with an ID, materializing it on first access.
+
+        Args:
+            func_id: Function ID
+
+        Returns:
+            FunctionInfo (the same object on every call)
+        """
+        func_info = self._objects.get(func_id)
+        if func_info is None:
+            func_info = self._objects.setdefault(func_id, self._materialize(func_id))
+            self._object_ids[id(func_info)] = func_id
+        return func_info
+
+    def id_of(self, func_info: FunctionInfo) -> Optional[int]:
+        """
+        Get the ID of a function object returned by get().
+
+        Args:
+            func_info: Function information
+
+        Returns:
+            Function ID, or None if the object did not come from this store
+        """
+        return self._object_ids.get(id(func_info))
+
+    def _materialize(self, func_id: int) -> FunctionInfo:
+        """Create the FunctionInfo object of a function."""
+        get = self.strings.get
+        strings = self.strings
+
+        parameters = [
+            Parameter(
+                name=strings[self.param_name_ids[row]],
+                param_type=strings[self.param_type_ids[row]],
+                is_pointer=bool(self.param_flags[row] & _POINTER),
+                is_const=bool(self.param_flags[row] & _CONST),
+                memory_class=get(self.param_memory_class_ids[row]),
+            )
+            for row in range(
+                self.param_offsets[func_id], self.param_offsets[func_id + 1]
+            )
+        ]
+        calls = [
+            FunctionCall(
+                name=strings[self.call_name_ids[row]],
+                is_conditional=bool(self.call_flags[row] & CALL_CONDITIONAL),
+                condition=get(self.call_condition_ids[row]),
+                is_loop=bool(self.call_flags[row] & CALL_LOOP),
+                loop_condition=get(self.call_loop_condition_ids[row]),
+                line_number=(
+                    None
+                    if self.call_line_numbers[row] < 0
+                    else self.call_line_numbers[row]
+                ),
+            )
+            for row in range(
+                self.call_offsets[func_id], self.call_offsets[func_id + 1]
+            )
+        ]
+
+        return FunctionInfo(
+            name=strings[self.name_ids[func_id]],
+            return_type=strings[self.return_type_ids[func_id]],
+            file_path=self.file_path(func_id),
+            line_number=self.line_numbers[func_id],
+            is_static=bool(self.function_flags[func_id] & FUNCTION_STATIC),
+            function_type=FUNCTION_TYPES[self.function_types[func_id]],
+            memory_class=get(self.memory_class_ids[func_id]),
+            parameters=parameters,
+            calls=calls,
+            called_by={strings[i] for i in self.called_by.get(func_id, ())},
+            macro_type=get(self.macro_type_ids[func_id]),
+            qualified_name=get(self.qualified_name_ids[func_id]),
+            sw_module=get(self.sw_module_ids[func_id]),
+        )
+
+    def summary(self, func_id: int) -> FunctionSummary:
+        """
+        Get the selection fields of a function without materializing it.
+
+        Args:
+            func_id: Function ID
+
+        Returns:
+            FunctionSummary of the function
+        """
+        return FunctionSummary(
+            func_id=func_id,
+            name=self.name(func_id),
+            file_path=self.file_path(func_id),
+            sw_module=self.sw_module(func_id),
+            calls=range(self.call_offsets[func_id], self.call_offsets[func_id + 1]),
+        )
+
+    def name(self, func_id: int) -> str:
+        """Get the name of a function without materializing it."""
+        return self.strings[self.name_ids[func_id]]
+
+    def file_key(self, func_id: int) -> str:
+        """Get the file path of a function as string."""
+        return self.strings[self.file_ids[func_id]]
+
+    def file_path(self, func_id: int) -> Path:
+        """Get the file path of a function; one Path object per file."""
+        file_id = self.file_ids[func_id]
+        path = self._paths.get(file_id)
+        if path is None:
+            path = self._paths[file_id] = Path(self.strings[file_id])
+        return path
+
+    def qualified_key(self, func_id: int) -> str:
+        """
+        Get the qualified key ("file_stem::function") of a function.
+
+        Args:
+            func_id: Function ID
+
+        Returns:
+            Key used by FunctionDatabase.qualified_functions
+        """
+        file_id = self.file_ids[func_id]
+        stem = self._stems.get(file_id)
+        if stem is None:
+            stem = self._stems[file_id] = self.file_path(func_id).stem
+        return f"{stem}::{self.name(func_id)}"
+
+    def sw_module(self, func_id: int) -> Optional[str]:
+        """Get the SW module of a function."""
+        return self.strings.get(self.sw_module_ids[func_id])
+
+    def set_sw_module(self, func_id: int, sw_module: Optional[str]) -> None:
+        """
+        Assign a function to a SW module.
+
+        Args:
+            func_id: Function ID
+            sw_module: SW module name, or None
+        """
+        self._ensure_writable()
+        self.sw_module_ids[func_id] = self.strings.intern(sw_module)
+        func_info = self._objects.get(func_id)
+        if func_info is not None:
+            func_info.sw_module = sw_module
+
+    def count_function_type(self, type_name: str) -> int:
+        """
+        Count the functions whose FunctionType has a given name.
+
+        Args:
+            type_name: FunctionType member name
+
+        Returns:
+            Number of matching functions (0 for unknown names)
+        """
+        type_ids = {
+            index
+            for index, function_type in enumerate(FUNCTION_TYPES)
+            if function_type.name == type_name
+        }
+        if not type_ids:
+            return 0
+        return sum(1 for type_id in self.function_types if type_id in type_ids)
+
+    def __getstate__(self) -> Dict[str, object]:
+        """Drop the caches of materialized objects before pickling."""
+        self._ensure_writable()
+        state = self.__dict__.copy()
+        for cache in ("_objects", "_object_ids", "_paths", "_stems"):
+            del state[cache]
+        return state
+
+    def __setstate__(self, state: Dict[str, object]) -> None:
+        """Restore the columns and start with empty caches."""
+        self.__dict__.update(state)
+        self._init_caches()
+
+
+class _StringRemap:
+    """Maps string IDs of one StringTable to another, interning on demand."""
+
+    def __init__(self, source: StringTable, target: StringTable):
+        self.source = source
+        self.target = target
+        self.same = source is target
+        self.ids: List[int] = [_UNMAPPED] * len(source)
+
+    def column(self, string_ids: Sequence[int]) -> Sequence[int]:
+        """Remap a column slice of string IDs."""
+        if self.same:
+            return string_ids
+        ids = self.ids
+        remapped = array("i")
+        for string_id in string_ids:
+            if string_id == NO_STRING:
+                remapped.append(NO_STRING)
+                continue
+            target_id = ids[string_id]
+            if target_id == _UNMAPPED:
+                target_id = ids[string_id] = self.target.intern(
+                    self.source[string_id]
+                )
+            remapped.append(target_id)
+        return remapped
+
+
+def _contiguous_runs(func_ids: Sequence[int]) -> Iterator[Tuple[int, int]]:
+    """Split function IDs into (start, stop) runs of consecutive IDs."""
+    if isinstance(func_ids, range) and func_ids.step == 1:
+        if len(func_ids):
+            yield func_ids.start, func_ids.stop
+        return
+    start = stop = -1
+    for func_id in func_ids:
+        if func_id == stop:
+            stop += 1
+            continue
+        if start >= 0:
+            yield start, stop
+        start, stop = func_id, func_id + 1
+    if start >= 0:
+        yield start, stop
+
+
+class FunctionIndex(MutableMapping[str, List[FunctionInfo]]):
+    """
+    Mapping of keys to function lists that holds function IDs.
+
+    The lists are materialized from the store on access. ids is the
+    underlying key -> function IDs mapping; a read-only mapping (e.g. of a
+    memory-mapped cache) is copied into a dictionary on the first change.
+    version counts the changes, so derived indexes can detect them.
+    """
+
+    def __init__(self, store: FunctionStore):
+        """
+        Initialize an empty index.
+
+        Args:
+            store: Store the function IDs refer to
+        """
+        self.store = store
+        self.ids: Mapping[str, Sequence[int]] = {}
+        self.version = 0
+
+    def _writable_ids(self) -> Dict[str, Sequence[int]]:
+        """Get ids as a dictionary that may be modified."""
+        self.version += 1
+        if not isinstance(self.ids, dict):
+            self.ids = {key: list(func_ids) for key, func_ids in self.ids.items()}
+        return self.ids
+
+    def add_id(self, key: str, func_id: int) -> None:
+        """
+        Append a function ID to a key.
+
+        Args:
+            key: Index key
+            func_id: Function ID in the store
+        """
+        ids = self._writable_ids()
+        ids[key] = [*ids.get(key, ()), func_id]
+
+    def set_ids(self, key: str, func_ids: Sequence[int]) -> None:
+        """
+        Set the function IDs of a key.
+
+        Args:
+            key: Index key
+            func_ids: Function IDs in the store
+        """
+        self._writable_ids()[key] = func_ids
+
+    def __getitem__(self, key: str) -> List[FunctionInfo]:
+        """Get the functions of a key."""
+        get = self.store.get
+        return [get(func_id) for func_id in self.ids[key]]
+
+    def __setitem__(self, key: str, functions: List[FunctionInfo]) -> None:
+        """Set the functions of a key; new objects are added to the store."""
+        self.set_ids(
+            key, [_store_id(self.store, func_info) for func_info in functions]
+        )
+
+    def __delitem__(self, key: str) -> None:
+        """Remove a key."""
+        del self._writable_ids()[key]
+
+    def __contains__(self, key: object) -> bool:
+        """Check for a key without materializing its functions."""
+        return key in self.ids
+
+    def __iter__(self) -> Iterator[str]:
+        """Iterate over the keys."""
+        return iter(self.ids)
+
+    def __len__(self) -> int:
+        """Number of keys."""
+        return len(self.ids)
+
+    def clear(self) -> None:
+        """Remove all keys."""
+        self.ids = {}
+        self.version += 1
+
+
+class QualifiedFunctionIndex(MutableMapping[str, FunctionInfo]):
+    """
+    Mapping of qualified keys to single functions that holds function IDs.
+
+    Like FunctionIndex, a read-only ids mapping is copied on the first change.
+    """
+
+    def __init__(self, store: FunctionStore):
+        """
+        Initialize an empty index.
+
+        Args:
+            store: Store the function IDs refer to
+        """
+        self.store = store
+        self.ids: Mapping[str, int] = {}
+
+    def _writable_ids(self) -> Dict[str, int]:
+        """Get ids as a dictionary that may be modified."""
+        if not isinstance(self.ids, dict):
+            self.ids = dict(self.ids.items())
+        return self.ids
+
+    def set_id(self, key: str, func_id: int) -> None:
+        """
+        Set the function ID of a key.
+
+        Args:
+            key: Qualified key
+            func_id: Function ID in the store
+        """
+        self._writable_ids()[key] = func_id
+
+    def __getitem__(self, key: str) -> FunctionInfo:
+        """Get the function of a key."""
+        return self.store.get(self.ids[key])
+
+    def __setitem__(self, key: str, func_info: FunctionInfo) -> None:
+        """Set the function of a key; new objects are added to the store."""
+        self.set_id(key, _store_id(self.store, func_info))
+
+    def __delitem__(self, key: str) -> None:
+        """Remove a key."""
+        del self._writable_ids()[key]
+
+    def __contains__(self, key: object) -> bool:
+        """Check for a key without materializing its function."""
+        return key in self.ids
+
+    def __iter__(self) -> Iterator[str]:
+        """Iterate over the keys."""
+        return iter(self.ids)
+
+    def __len__(self) -> int:
+        """Number of keys."""
+        return len(self.ids)
+
+    def clear(self) -> None:
+        """Remove all keys."""
+        self.ids = {}
+
+
+def _store_id(store: FunctionStore, func_info: FunctionInfo) -> int:
+    """Get the ID of a function object, adding it to the store if needed."""
+    func_id = store.id_of(func_info)
+    if func_id is None:
+        func_id = store.add(func_info, keep_object=True)
+    return func_id
+
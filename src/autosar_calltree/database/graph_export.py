@@ -0,0 +1,509 @@
+"""
+Whole-codebase call graph export.
+
+This module writes the resolved call graph of a FunctionDatabase for
+external analysis tools: every function once as a node, with its file
+and SW module, and every call once as an edge, with its conditional and
+loop flags, instead of the per-root trees of the generators, which repeat
+shared subtrees. Nodes and edges are read from the columns of the
+FunctionStore and the CallGraph, so no FunctionInfo is materialized, and
+the text formats are written record by record.
+
+Formats:
+    binary   Node and edge columns plus a string table, in the section
+             layout of the binary cache (magic ACTGRAPH, little-endian)
+    graphml  GraphML document for graph tools (yEd, Gephi, networkx)
+    jsonl    One JSON object per node, then one per edge
+
+Requirements:
+- SWR_DB_00043: Call Graph Export
+"""
+
+import io
+import json
+import struct
+import sys
+from array import array
+from dataclasses import dataclass
+from pathlib import Path
+from typing import (
+    IO,
+    TYPE_CHECKING,
+    Dict,
+    Iterator,
+    List,
+    Optional,
+    Sequence,
+    Tuple,
+)
+from xml.sax.saxutils import escape, quoteattr
+
+from .binary_cache import SECTION_ALIGNMENT, SECTION_PREAMBLE, write_section
+from .cache_file import atomic_write
+from .call_graph import UNRESOLVED, CallGraph
+from .function_store import (
+    CALL_CONDITIONAL,
+    CALL_LOOP,
+    FUNCTION_STATIC,
+    FUNCTION_TYPES,
+    NO_STRING,
+    FunctionStore,
+)
+
+if TYPE_CHECKING:
+    from .function_database import FunctionDatabase
+
+# Supported export formats
+GRAPH_FORMATS = ("binary", "graphml", "jsonl")
+
+GRAPH_EXPORT_MAGIC = b"ACTGRAPH"
+
+# Increment when the layout of the binary export changes
+GRAPH_EXPORT_VERSION = 1
+
+# Binary sections: store column (string columns are remapped) per section
+_NODE_SECTIONS = (
+    ("node.name", "name_ids"),
+    ("node.file", "file_ids"),
+    ("node.sw_module", "sw_module_ids"),
+    ("node.line", "line_numbers"),
+    ("node.flags", "function_flags"),
+    ("node.function_type", "function_types"),
+)
+_EDGE_SECTIONS = (
+    ("edge.callee_name", "call_name_ids"),
+    ("edge.flags", "call_flags"),
+    ("edge.line", "call_line_numbers"),
+    ("edge.condition", "call_condition_ids"),
+    ("edge.loop_condition", "call_loop_condition_ids"),
+)
+_STRING_SECTIONS = (
+    "node.name",
+    "node.file",
+    "node.sw_module",
+    "edge.callee_name",
+    "edge.condition",
+    "edge.loop_condition",
+)
+
+# Edges per chunk of the binary edge.source section
+_CHUNK_ROWS = 1 << 16
+
+# GraphML attributes: (key, element, name, type)
+_GRAPHML_KEYS = (
+    ("n_name", "node", "name", "string"),
+    ("n_file", "node", "file", "string"),
+    ("n_line", "node", "line", "int"),
+    ("n_module", "node", "sw_module", "string"),
+    ("n_type", "node", "function_type", "string"),
+    ("n_static", "node", "is_static", "boolean"),
+    ("n_external", "node", "external", "boolean"),
+    ("e_line", "edge", "line", "int"),
+    ("e_conditional", "edge", "is_conditional", "boolean"),
+    ("e_condition", "edge", "condition", "string"),
+    ("e_loop", "edge", "is_loop", "boolean"),
+    ("e_loop_condition", "edge", "loop_condition", "string"),
+)
+
+
+class GraphExportError(Exception):
+    """A graph export file cannot be written or read."""
+
+
+@dataclass
+class GraphExportStats:
+    """Size of an exported call graph."""
+
+    nodes: int = 0
+    edges: int = 0
+    unresolved_edges: int = 0
+
+
+@dataclass
+class BinaryGraph:
+    """
+    Content of a binary graph export.
+
+    Node i is described by element i of every nodes column and edge j by
+    element j of every edges column; string columns hold indexes into
+    strings (-1 for none), and edges["target"] is -1 for calls of
+    functions that are not in the database.
+    """
+
+    strings: List[str]
+    nodes: Dict[str, array]
+    edges: Dict[str, array]
+    header: Dict[str, object]
+
+
+def graph_format_for_path(path: Path) -> str:
+    """
+    Get the export format of an output file from its suffix.
+
+    Args:
+        path: Output file
+
+    Returns:
+        "graphml" for .graphml, "jsonl" for .jsonl/.ndjson, else "binary"
+    """
+    suffix = path.suffix.lower()
+    if suffix == ".graphml":
+        return "graphml"
+    if suffix in (".jsonl", ".ndjson"):
+        return "jsonl"
+    return "binary"
+
+
+def export_call_graph(
+    function_db: "FunctionDatabase",
+    path: Path,
+    graph_format: Optional[str] = None,
+) -> GraphExportStats:
+    """
+    Export the resolved call graph of a database to a file.
+
+    Implements: SWR_DB_00043 (Call Graph Export)
+
+    Args:
+        function_db: Function database with final indexes
+        path: Output file; its directory is created if needed
+        graph_format: One of GRAPH_FORMATS, or None to use the suffix of path
+
+    Returns:
+        GraphExportStats of the exported graph
+
+    Raises:
+        ValueError: If the format is unknown
+    """
+    graph_format = graph_format or graph_format_for_path(path)
+    if graph_format not in GRAPH_FORMATS:
+        raise ValueError(
+            f"Unknown graph format '{graph_format}' "
+            f"(expected one of {', '.join(GRAPH_FORMATS)})"
+        )
+
+    call_graph = function_db.get_call_graph()
+    path.parent.mkdir(parents=True, exist_ok=True)
+    if graph_format == "binary":
+        return _write_binary(path, call_graph)
+
+    with atomic_write(path) as binary:
+        f = io.TextIOWrapper(binary, encoding="utf-8", newline="\n")
+        try:
+            if graph_format == "graphml":
+                return _write_graphml(f, call_graph)
+            return _write_jsonl(f, call_graph)
+        finally:
+            # atomic_write() closes and renames the binary file
+            f.flush()
+            f.detach()
+
+
+def _edge_rows(
+    call_graph: CallGraph,
+) -> Iterator[Tuple[int, int, int]]:
+    """Iterate over (source ID, call row, target ID) of all calls."""
+    call_offsets = call_graph.store.call_offsets
+    callee_ids = call_graph.callee_ids
+    for func_id in range(len(call_graph)):
+        for row in range(call_offsets[func_id], call_offsets[func_id + 1]):
+            yield func_id, row, callee_ids[row]
+
+
+def _write_jsonl(f: IO[str], call_graph: CallGraph) -> GraphExportStats:
+    """Write one JSON object per node, then one per edge."""
+    store = call_graph.store
+    strings = store.strings
+    stats = GraphExportStats(nodes=len(call_graph))
+
+    for func_id in range(len(call_graph)):
+        record = {
+            "type": "node",
+            "id": func_id,
+            "name": store.name(func_id),
+            "qualified_name": store.qualified_key(func_id),
+            "file": store.file_key(func_id),
+            "line": store.line_numbers[func_id],
+            "sw_module": store.sw_module(func_id),
+            "function_type": FUNCTION_TYPES[store.function_types[func_id]].value,
+            "is_static": bool(store.function_flags[func_id] & FUNCTION_STATIC),
+        }
+        f.write(json.dumps(record))
+        f.write("\n")
+
+    for func_id, row, callee_id in _edge_rows(call_graph):
+        flags = store.call_flags[row]
+        line = store.call_line_numbers[row]
+        record = {
+            "type": "edge",
+            "source": func_id,
+            "target": None if callee_id == UNRESOLVED else callee_id,
+            "callee": strings[store.call_name_ids[row]],
+            "line": None if line < 0 else line,
+            "is_conditional": bool(flags & CALL_CONDITIONAL),
+            "condition": strings.get(store.call_condition_ids[row]),
+            "is_loop": bool(flags & CALL_LOOP),
+            "loop_condition": strings.get(store.call_loop_condition_ids[row]),
+        }
+        f.write(json.dumps(record))
+        f.write("\n")
+        stats.edges += 1
+        stats.unresolved_edges += callee_id == UNRESOLVED
+    return stats
+
+
+def _graphml_data(key: str, value: object) -> str:
+    """Format one GraphML data element."""
+    if isinstance(value, bool):
+        value = "true" if value else "false"
+    return f'<data key="{key}">{escape(str(value))}</data>'
+
+
+def _write_graphml(f: IO[str], call_graph: CallGraph) -> GraphExportStats:
+    """
+    Write a GraphML document.
+
+    Function nodes have the IDs "f<function ID>"; calls of functions that
+    are not in the database point to one external node "x:<name>" per
+    called name, written after the edges.
+    """
+    store = call_graph.store
+    strings = store.strings
+    stats = GraphExportStats(nodes=len(call_graph))
+
+    f.write('<?xml version="1.0" encoding="UTF-8"?>\n')
+    f.write('<graphml xmlns="http://graphml.graphdrawing.org/xmlns">\n')
+    for key, element, name, value_type in _GRAPHML_KEYS:
+        f.write(
+            f'  <key id="{key}" for="{element}" attr.name="{name}" '
+            f'attr.type="{value_type}"/>\n'
+        )
+    f.write('  <graph id="calls" edgedefault="directed">\n')
+
+    for func_id in range(len(call_graph)):
+        data = [
+            _graphml_data("n_name", store.name(func_id)),
+            _graphml_data("n_file", store.file_key(func_id)),
+            _graphml_data("n_line", store.line_numbers[func_id]),
+        ]
+        sw_module = store.sw_module(func_id)
+        if sw_module is not None:
+            data.append(_graphml_data("n_module", sw_module))
+        data.append(
+            _graphml_data(
+                "n_type", FUNCTION_TYPES[store.function_types[func_id]].value
+            )
+        )
+        data.append(
+            _graphml_data(
+                "n_static", bool(store.function_flags[func_id] & FUNCTION_STATIC)
+            )
+        )
+        f.write(f'    <node id="f{func_id}">{"".join(data)}</node>\n')
+
+    external: Dict[int, str] = {}  # Called name string ID -> node ID
+    for func_id, row, callee_id in _edge_rows(call_graph):
+        if callee_id == UNRESOLVED:
+            name_id = store.call_name_ids[row]
+            target = external.get(name_id)
+            if target is None:
+                target = external[name_id] = quoteattr(f"x:{strings[name_id]}")
+            stats.unresolved_edges += 1
+        else:
+            target = f'"f{callee_id}"'
+
+        flags = store.call_flags[row]
+        data = []
+        line = store.call_line_numbers[row]
+        if line >= 0:
+            data.append(_graphml_data("e_line", line))
+        data.append(_graphml_data("e_conditional", bool(flags & CALL_CONDITIONAL)))
+        condition = strings.get(store.call_condition_ids[row])
+        if condition is not None:
+            data.append(_graphml_data("e_condition", condition))
+        data.append(_graphml_data("e_loop", bool(flags & CALL_LOOP)))
+        loop_condition = strings.get(store.call_loop_condition_ids[row])
+        if loop_condition is not None:
+            data.append(_graphml_data("e_loop_condition", loop_condition))
+        f.write(
+            f'    <edge source="f{func_id}" target={target}>{"".join(data)}</edge>\n'
+        )
+        stats.edges += 1
+
+    for name_id, node_id in external.items():
+        f.write(
+            f"    <node id={node_id}>{_graphml_data('n_name', strings[name_id])}"
+            f"{_graphml_data('n_external', True)}</node>\n"
+        )
+    f.write("  </graph>\n</graphml>\n")
+    stats.nodes += len(external)
+    return stats
+
+
+def _remap_strings(
+    store: FunctionStore, columns: Dict[str, Sequence[int]]
+) -> Tuple[List[str], Dict[str, array]]:
+    """
+    Renumber the strings used by some columns.
+
+    Args:
+        store: Store the string IDs refer to
+        columns: Section name -> column of string IDs
+
+    Returns:
+        Used strings in order of first use, and the remapped columns
+    """
+    new_ids = array("i", [NO_STRING]) * len(store.strings)
+    strings: List[str] = []
+    remapped: Dict[str, array] = {}
+    for name, column in columns.items():
+        values = array("i", column)
+        for index, string_id in enumerate(values):
+            if string_id == NO_STRING:
+                continue
+            new_id = new_ids[string_id]
+            if new_id == NO_STRING:
+                new_id = new_ids[string_id] = len(strings)
+                strings.append(store.strings[string_id])
+            values[index] = new_id
+        remapped[name] = values
+    return strings, remapped
+
+
+def _little_endian(values: array) -> array:
+    """Get an array in little-endian byte order."""
+    if sys.byteorder == "little" or values.itemsize == 1:
+        return values
+    swapped = array(values.typecode, values)
+    swapped.byteswap()
+    return swapped
+
+
+def _write_binary(path: Path, call_graph: CallGraph) -> GraphExportStats:
+    """
+    Write the binary export.
+
+    The file uses the layout of the binary cache: magic, header offset and
+    length, aligned sections, and a JSON header describing the sections
+    and the meaning of the flag bits and function type codes.
+    """
+    store = call_graph.store
+    size = len(call_graph)
+    edge_count = store.call_offsets[size]
+    columns = dict(_NODE_SECTIONS + _EDGE_SECTIONS)
+    strings, string_columns = _remap_strings(
+        store, {name: getattr(store, columns[name]) for name in _STRING_SECTIONS}
+    )
+    encoded = [value.encode("utf-8") for value in strings]
+    string_offsets = array("q", [0])
+    position = 0
+    for value in encoded:
+        position += len(value)
+        string_offsets.append(position)
+
+    stats = GraphExportStats(nodes=size, edges=edge_count)
+    with atomic_write(path) as f:
+        f.write(SECTION_PREAMBLE.pack(GRAPH_EXPORT_MAGIC, 0, 0))
+        section_table = {
+            "string_blob": write_section(f, b"".join(encoded)),
+            "string_offsets": write_section(f, _little_endian(string_offsets)),
+        }
+        for name, column in _NODE_SECTIONS + _EDGE_SECTIONS:
+            values = string_columns.get(name)
+            if values is None:
+                values = array("i", getattr(store, column))
+            section_table[name] = write_section(f, _little_endian(values))
+
+        # Sources are written in chunks; the calls are grouped by caller
+        f.write(b"\0" * (-f.tell() % SECTION_ALIGNMENT))
+        section_table["edge.source"] = (f.tell(), "i", edge_count)
+        chunk = array("i")
+        for func_id in range(size):
+            count = store.call_offsets[func_id + 1] - store.call_offsets[func_id]
+            chunk.extend([func_id] * count)
+            if len(chunk) >= _CHUNK_ROWS:
+                f.write(_little_endian(chunk).tobytes())
+                chunk = array("i")
+        f.write(_little_endian(chunk).tobytes())
+
+        targets = array("i", call_graph.callee_ids)
+        stats.unresolved_edges = targets.count(UNRESOLVED)
+        section_table["edge.target"] = write_section(f, _little_endian(targets))
+
+        header = json.dumps(
+            {
+                "version": GRAPH_EXPORT_VERSION,
+                "byteorder": "little",
+                "nodes": size,
+                "edges": edge_count,
+                "sections": section_table,
+                "node_flags": {"static": FUNCTION_STATIC},
+                "edge_flags": {"conditional": CALL_CONDITIONAL, "loop": CALL_LOOP},
+                "function_types": [
+                    function_type.value for function_type in FUNCTION_TYPES
+                ],
+            }
+        ).encode("utf-8")
+        header_offset = f.tell()
+        f.write(header)
+        f.seek(0)
+        f.write(SECTION_PREAMBLE.pack(GRAPH_EXPORT_MAGIC, header_offset, len(header)))
+    return stats
+
+
+def read_binary_graph(path: Path) -> BinaryGraph:
+    """
+    Read a binary graph export.
+
+    Implements: SWR_DB_00043 (Call Graph Export)
+
+    Args:
+        path: File written by export_call_graph() in the binary format
+
+    Returns:
+        BinaryGraph with the strings and the node and edge columns
+
+    Raises:
+        GraphExportError: If the file is not a binary graph export of
+            this version or is truncated
+    """
+    try:
+        data = path.read_bytes()
+        magic, header_offset, header_length = SECTION_PREAMBLE.unpack_from(data)
+        if magic != GRAPH_EXPORT_MAGIC:
+            raise GraphExportError("not a binary graph export")
+        header = json.loads(
+            str(data[header_offset : header_offset + header_length], "utf-8")
+        )
+    except (OSError, struct.error, ValueError) as e:
+        raise GraphExportError(f"cannot read {path.name}: {e}") from e
+    if header.get("version") != GRAPH_EXPORT_VERSION:
+        raise GraphExportError(f"unsupported version {header.get('version')}")
+
+    def section(name: str) -> array:
+        offset, typecode, count = header["sections"][name]
+        values = array(typecode)
+        size = count * values.itemsize
+        if offset + size > len(data):
+            raise GraphExportError(f"section {name} is truncated")
+        values.frombytes(data[offset : offset + size])
+        if sys.byteorder != "little" and values.itemsize > 1:
+            values.byteswap()
+        return values
+
+    blob = section("string_blob").tobytes()
+    offsets = section("string_offsets")
+    strings = [
+        str(blob[offsets[i] : offsets[i + 1]], "utf-8")
+        for i in range(len(offsets) - 1)
+    ]
+    edge_sections = [name for name, _ in _EDGE_SECTIONS]
+    return BinaryGraph(
+        strings=strings,
+        nodes={name[len("node.") :]: section(name) for name, _ in _NODE_SECTIONS},
+        edges={
+            name[len("edge.") :]: section(name)
+            for name in edge_sections + ["edge.source", "edge.target"]
+        },
+        header=header,
+    )
@@ -134,7 +134,7 @@ class CallTreeNode:
     children: List["CallTreeNode"] = field(default_factory=list)
     parent: Optional["CallTreeNode"] = None
     is_recursive: bool = False  # True if function already in call stack
-    is_truncated: bool = False  # True if depth limit reached
+    is_truncated: bool = False  # True if a build budget left calls unexpanded
     call_count: int = 1  # Number of times this function is called
     is_optional: bool = False  # True if this call is conditional (for opt blocks)
     condition: Optional[str] = (
@@ -186,6 +186,7 @@ class AnalysisStatistics:
     rte_functions: int = 0
     autosar_functions: int = 0
     circular_dependencies_found: int = 0
+    physical_nodes: int = 0  # Nodes allocated; total_functions counts logical nodes
 
     def to_dict(self) -> Dict[str, int]:
         """Convert to dictionary."""
@@ -198,9 +199,40 @@ class AnalysisStatistics:
             "rte_functions": self.rte_functions,
             "autosar_functions": self.autosar_functions,
             "circular_dependencies_found": self.circular_dependencies_found,
+            "physical_nodes": self.physical_nodes,
         }
 
 
+@dataclass
+class TreeTruncation:
+    """What a budgeted tree build left out.
+
+    SWR_ANALYZER_00020: Tree Build Budgets
+    """
+
+    reason: str  # "max_nodes" or "time_budget"
+    limit: float  # Node count or seconds of the budget that ran out
+    truncated_functions: List[str] = field(
+        default_factory=list
+    )  # Qualified names of the nodes with unexpanded calls, in build order
+    complete_depth: Optional[int] = None  # Breadth-first: deepest complete level
+
+    def describe(self) -> str:
+        """Describe the truncation in one line."""
+        if self.reason == "max_nodes":
+            budget = f"node budget of {int(self.limit)}"
+        else:
+            budget = f"time budget of {self.limit:g}s"
+        count = len(self.truncated_functions)
+        text = (
+            f"{budget} reached, {count} node{'' if count == 1 else 's'} "
+            "with unexpanded calls"
+        )
+        if self.complete_depth is not None:
+            text += f", complete to depth {self.complete_depth}"
+        return text
+
+
 @dataclass
 class AnalysisResult:
     """Complete analysis result."""
@@ -213,6 +245,9 @@ class AnalysisResult:
     timestamp: datetime = field(default_factory=datetime.now)
     source_directory: Optional[Path] = None
     max_depth_limit: int = 3
+    is_caller_tree: bool = False  # True if children are callers of their parent
+    truncation: Optional[TreeTruncation] = None  # Set if a build budget ran out
+    fingerprint: Optional[str] = None  # Inputs of a batch output (SWR_CLI_00035)
 
     def get_all_functions(self) -> Set[FunctionInfo]:
         """Get all unique functions in the call tree."""
@@ -0,0 +1,129 @@
+"""
+Module-level call graph.
+
+This module aggregates the resolved call graph of a FunctionDatabase into
+a graph of SW modules: one node per module with its function count, and
+one edge per pair of modules with calls between them, with the number of
+calls and a few example calls. Functions without a SW module belong to
+the module named after their file stem, like the participants of module
+diagrams (SWR_MERMAID_00003). The graph is read from the columns of the
+FunctionStore and the CallGraph, so no FunctionInfo is materialized.
+
+Requirements:
+- SWR_DB_00048: Module Call Graph
+"""
+
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+from .call_graph import UNRESOLVED, CallGraph
+from .function_store import NO_STRING
+
+# Example calls kept per module edge
+MAX_EXAMPLE_CALLS = 3
+
+
+@dataclass
+class ModuleEdge:
+    """Calls from the functions of one module to those of another."""
+
+    caller_module: str
+    callee_module: str
+    call_count: int = 0
+    # (caller function, callee function) of the first calls in store order
+    examples: List[Tuple[str, str]] = field(default_factory=list)
+
+
+@dataclass
+class ModuleGraph:
+    """
+    Call graph between SW modules.
+
+    modules maps every module to its number of functions, in the order of
+    the first function of each module in the store. edges lists the module
+    pairs in the order of their first call; calls within a module are
+    edges from the module to itself.
+    """
+
+    modules: Dict[str, int] = field(default_factory=dict)
+    edges: List[ModuleEdge] = field(default_factory=list)
+    unresolved_calls: int = 0
+
+    @classmethod
+    def build(
+        cls, call_graph: CallGraph, max_examples: int = MAX_EXAMPLE_CALLS
+    ) -> "ModuleGraph":
+        """
+        Aggregate a resolved call graph by SW module.
+
+        Implements: SWR_DB_00048 (Module Call Graph)
+
+        Args:
+            call_graph: Resolved call graph of the database
+            max_examples: Example calls kept per edge
+
+        Returns:
+            ModuleGraph of all functions and resolved calls
+        """
+        store = call_graph.store
+        strings = store.strings
+        graph = cls()
+
+        # Module per (sw_module string ID, file string ID)
+        module_names: Dict[Tuple[int, int], str] = {}
+        func_modules: List[str] = []
+        for func_id in range(len(store)):
+            key = (store.sw_module_ids[func_id], store.file_ids[func_id])
+            module = module_names.get(key)
+            if module is None:
+                if key[0] != NO_STRING:
+                    module = strings[key[0]]
+                else:
+                    module = Path(strings[key[1]]).stem
+                module_names[key] = module
+            func_modules.append(module)
+            graph.modules[module] = graph.modules.get(module, 0) + 1
+
+        edges: Dict[Tuple[str, str], ModuleEdge] = {}
+        call_offsets = store.call_offsets
+        callee_ids = call_graph.callee_ids
+        for func_id, caller_module in enumerate(func_modules):
+            for row in range(call_offsets[func_id], call_offsets[func_id + 1]):
+                callee_id = callee_ids[row]
+                if callee_id == UNRESOLVED:
+                    graph.unresolved_calls += 1
+                    continue
+                edge_key = (caller_module, func_modules[callee_id])
+                edge = edges.get(edge_key)
+                if edge is None:
+                    edge = edges[edge_key] = ModuleEdge(*edge_key)
+                    graph.edges.append(edge)
+                edge.call_count += 1
+                if len(edge.examples) < max_examples:
+                    edge.examples.append(
+                        (store.name(func_id), store.name(callee_id))
+                    )
+        return graph
+
+    def internal_calls(self) -> Dict[str, int]:
+        """
+        Get the number of calls within each module.
+
+        Returns:
+            Module -> calls between functions of the module
+        """
+        return {
+            edge.caller_module: edge.call_count
+            for edge in self.edges
+            if edge.caller_module == edge.callee_module
+        }
+
+    def dependencies(self) -> List[ModuleEdge]:
+        """
+        Get the edges between different modules.
+
+        Returns:
+            Edges whose caller and callee modules differ, in graph order
+        """
+        return [edge for edge in self.edges if edge.caller_module != edge.callee_module]
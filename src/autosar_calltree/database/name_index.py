@@ -0,0 +1,258 @@
+"""
+Function name search index.
+
+This module indexes the function names of a database for searching. Name
+positions sorted by lower-case name answer prefix searches by bisection,
+and trigram posting lists over the lower-case UTF-8 names narrow
+substring and regular expression searches down to the names that contain
+every trigram of the pattern (or of the literals a regex requires). Only
+these candidates are compared against the pattern.
+
+Requirements:
+- SWR_DB_00041: Indexed Name Search
+"""
+
+import re
+from array import array
+from bisect import bisect_left
+from typing import Dict, Iterable, List, Sequence, Set
+
+# Supported values of the search mode
+SEARCH_MODES = ("substring", "prefix", "regex")
+
+# Inline flags such as (?i) that apply to the whole regular expression
+_GLOBAL_FLAGS_PATTERN = re.compile(r"\(\?[aiLmsux]+\)")
+
+# Counted quantifiers {n}, {m,n}, {m,} and {,n}
+_COUNTED_QUANTIFIER = re.compile(r"\{\d*(?:,\d*)?\}")
+
+# Posting lists this many times longer than the candidate set are not
+# intersected; the remaining candidates are compared directly
+_INTERSECT_RATIO = 16
+
+
+def _trigrams(encoded: bytes) -> Set[int]:
+    """Get the trigrams of a UTF-8 string as 24-bit integers."""
+    return {
+        encoded[i] << 16 | encoded[i + 1] << 8 | encoded[i + 2]
+        for i in range(len(encoded) - 2)
+    }
+
+
+def required_literals(pattern: str) -> List[str]:
+    """
+    Get literal substrings that every match of a regular expression contains.
+
+    The extraction is conservative: only runs of plain characters outside
+    groups and character classes are taken, a character followed by an
+    optional or counted quantifier is dropped, and patterns with top-level
+    alternation, global inline flags or a brace that is no quantifier
+    yield no literals.
+
+    Args:
+        pattern: Regular expression
+
+    Returns:
+        Required literal substrings (possibly empty)
+    """
+    if _GLOBAL_FLAGS_PATTERN.search(pattern):
+        return []
+
+    literals: List[str] = []
+    run: List[str] = []
+
+    def flush() -> None:
+        if run:
+            literals.append("".join(run))
+            run.clear()
+
+    depth = 0
+    i = 0
+    while i < len(pattern):
+        char = pattern[i]
+        if char == "\\":
+            flush()
+            i += 2
+            continue
+        if char == "[":
+            flush()
+            i += 1
+            if i < len(pattern) and pattern[i] == "^":
+                i += 1
+            if i < len(pattern) and pattern[i] == "]":
+                i += 1
+            while i < len(pattern) and pattern[i] != "]":
+                i += 2 if pattern[i] == "\\" else 1
+            i += 1
+            continue
+        if char == "{":
+            quantifier = _COUNTED_QUANTIFIER.match(pattern, i)
+            if quantifier is None:
+                return []
+            if run:
+                run.pop()  # The preceding character may occur zero times
+            flush()
+            i = quantifier.end()
+            continue
+        if char in "*?":
+            if run:
+                run.pop()  # The preceding character is optional
+            flush()
+        elif char == "(":
+            flush()
+            depth += 1
+        elif char == ")":
+            flush()
+            depth -= 1
+        elif char == "|":
+            if depth == 0:
+                return []
+        elif char in "+.^$":
+            flush()
+        elif depth == 0:
+            run.append(char)
+        i += 1
+    flush()
+    return literals
+
+
+class NameSearchIndex:
+    """
+    Search index over the keys of FunctionDatabase.functions.
+
+    A name is identified by its position in the key order it was built
+    from, and candidates are returned in that order, so searches return
+    results in the same order as a scan of the keys.
+
+    The indexes are integer sequences (arrays, or memoryviews of the
+    binary cache): sorted_positions holds the name positions ordered by
+    lower-case name; the names containing trigram trigram_keys[k] are
+    trigram_postings[trigram_offsets[k]:trigram_offsets[k + 1]].
+
+    Implements: SWR_DB_00041 (Indexed Name Search)
+    """
+
+    def __init__(
+        self,
+        names: Sequence[str],
+        sorted_positions: Sequence[int],
+        trigram_keys: Sequence[int],
+        trigram_offsets: Sequence[int],
+        trigram_postings: Sequence[int],
+    ):
+        """
+        Initialize the index over existing sequences.
+
+        Args:
+            names: Indexed names by position
+            sorted_positions: Name positions ordered by lower-case name
+            trigram_keys: Sorted trigrams (24-bit integers)
+            trigram_offsets: Start of the postings of every trigram, plus the end
+            trigram_postings: Name positions of all trigrams, ascending per trigram
+        """
+        self.names = names
+        self.sorted_positions = sorted_positions
+        self.trigram_keys = trigram_keys
+        self.trigram_offsets = trigram_offsets
+        self.trigram_postings = trigram_postings
+
+    @classmethod
+    def build(cls, names: Sequence[str]) -> "NameSearchIndex":
+        """
+        Build the index of a list of names.
+
+        Args:
+            names: Names in key order
+
+        Returns:
+            NameSearchIndex of the names
+        """
+        lowered = [name.lower() for name in names]
+        sorted_positions = array(
+            "i", sorted(range(len(lowered)), key=lowered.__getitem__)
+        )
+
+        postings: Dict[int, array] = {}
+        for position, name in enumerate(lowered):
+            for trigram in _trigrams(name.encode("utf-8")):
+                posting = postings.get(trigram)
+                if posting is None:
+                    posting = postings[trigram] = array("i")
+                posting.append(position)
+
+        trigram_keys = array("i", sorted(postings))
+        trigram_offsets = array("i", [0])
+        trigram_postings = array("i")
+        for trigram in trigram_keys:
+            trigram_postings.extend(postings[trigram])
+            trigram_offsets.append(len(trigram_postings))
+        return cls(
+            names, sorted_positions, trigram_keys, trigram_offsets, trigram_postings
+        )
+
+    def candidates(self, pattern: str, mode: str = "substring") -> Iterable[int]:
+        """
+        Get the positions of the names that may match a pattern.
+
+        Args:
+            pattern: Search pattern
+            mode: One of SEARCH_MODES
+
+        Returns:
+            Candidate name positions in ascending order; every matching name
+            is included, but candidates still need to be compared
+        """
+        if mode == "prefix":
+            return sorted(self._prefix_positions(pattern.lower()))
+
+        if mode == "regex":
+            # The index is case-folded; only ASCII literals fold safely
+            literals = [
+                literal for literal in required_literals(pattern) if literal.isascii()
+            ]
+            trigrams = set()
+            for literal in literals:
+                trigrams |= _trigrams(literal.lower().encode("utf-8"))
+        else:
+            trigrams = _trigrams(pattern.lower().encode("utf-8"))
+
+        if not trigrams:
+            return range(len(self.names))
+
+        postings = sorted((self._posting(trigram) for trigram in trigrams), key=len)
+        common = set(postings[0])
+        for posting in postings[1:]:
+            # Comparing a few candidates is cheaper than a long intersection
+            if len(common) * _INTERSECT_RATIO < len(posting):
+                break
+            common.intersection_update(posting)
+        return sorted(common)
+
+    def _posting(self, trigram: int) -> Sequence[int]:
+        """Get the name positions containing a trigram."""
+        keys = self.trigram_keys
+        low = bisect_left(keys, trigram)
+        if low == len(keys) or keys[low] != trigram:
+            return ()
+        return self.trigram_postings[
+            self.trigram_offsets[low] : self.trigram_offsets[low + 1]
+        ]
+
+    def _prefix_positions(self, prefix: str) -> Sequence[int]:
+        """Get the positions of the names starting with a lower-case prefix."""
+        names, positions = self.names, self.sorted_positions
+        length = len(prefix)
+
+        def first(predicate) -> int:
+            low, high = 0, len(positions)
+            while low < high:
+                mid = (low + high) // 2
+                if predicate(names[positions[mid]].lower()[:length]):
+                    high = mid
+                else:
+                    low = mid + 1
+            return low
+
+        start = first(lambda head: head >= prefix)
+        stop = first(lambda head: head > prefix)
+        return positions[start:stop]
@@ -0,0 +1,111 @@
+"""
+Sharded database builds.
+
+A shard build preprocesses and parses one deterministic subset of the
+source files and writes it as a cache fragment; merging all fragments of
+a build gives the cache of the full database (see
+FunctionDatabase.build_shard() and FunctionDatabase.merge_shards()).
+
+Requirements:
+- SWR_DB_00046: Sharded Database Build
+"""
+
+import heapq
+import re
+from dataclasses import dataclass
+from pathlib import Path
+from typing import Callable, List, Sequence
+
+# File names of the fragments: shard-<i>-of-<N>.pkl and shard-<i>-of-<N>.bin
+FRAGMENT_PATTERN = "shard-*-of-*.pkl"
+
+_SHARD_SPEC = re.compile(r"\s*(\d+)\s*/\s*(\d+)\s*")
+
+
+class ShardError(Exception):
+    """Raised when shard fragments cannot be merged."""
+
+
+@dataclass(frozen=True)
+class ShardSpec:
+    """One shard of a build: index (1-based) out of count shards."""
+
+    index: int
+    count: int
+
+    @classmethod
+    def parse(cls, text: str) -> "ShardSpec":
+        """
+        Parse a shard given as "i/N".
+
+        Args:
+            text: Shard index and count, e.g. "2/8"
+
+        Returns:
+            ShardSpec
+
+        Raises:
+            ValueError: If text is not "i/N" with 1 <= i <= N
+        """
+        match = _SHARD_SPEC.fullmatch(text)
+        if not match:
+            raise ValueError(f"expected i/N, got {text!r}")
+        index, count = int(match.group(1)), int(match.group(2))
+        if not 1 <= index <= count:
+            raise ValueError(f"shard index must be between 1 and {count}, got {index}")
+        return cls(index, count)
+
+    @property
+    def fragment_name(self) -> str:
+        """File name of the fragment pickle of this shard."""
+        return f"shard-{self.index}-of-{self.count}.pkl"
+
+    def __str__(self) -> str:
+        return f"{self.index}/{self.count}"
+
+
+def select_shard_files(
+    files: Sequence[Path], shard: ShardSpec, file_size: Callable[[Path], int]
+) -> List[Path]:
+    """
+    Select the files of one shard, balancing the shards by bytes.
+
+    Files are assigned largest first to the shard with the fewest bytes so
+    far (ties: lowest shard index), so every node computes the same
+    assignment from the same checkout.
+
+    Implements: SWR_DB_00046 (Sharded Database Build)
+
+    Args:
+        files: All source files of the build
+        shard: Shard to select
+        file_size: Size of a file in bytes
+
+    Returns:
+        Files of the shard, in the order of files
+    """
+    loads = [(0, index) for index in range(shard.count)]
+    selected = set()
+    for size, file_path in sorted(
+        ((file_size(file_path), file_path) for file_path in files),
+        key=lambda item: (-item[0], item[1]),
+    ):
+        load, index = heapq.heappop(loads)
+        if index == shard.index - 1:
+            selected.add(file_path)
+        # Empty files count as one byte, so they are spread too
+        heapq.heappush(loads, (load + max(size, 1), index))
+    return [file_path for file_path in files if file_path in selected]
+
+
+def find_shard_fragments(directory: Path) -> List[Path]:
+    """
+    Find the fragment pickles in a directory.
+
+    Args:
+        directory: Directory with the fragments of all shards
+
+    Returns:
+        Sorted fragment pickle paths
+    """
+    return sorted(directory.glob(FRAGMENT_PATTERN))
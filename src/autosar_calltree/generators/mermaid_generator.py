@@ -8,14 +8,53 @@ Requirements:
 - SWR_MERMAID_00001: Module-Based Participants
 - SWR_MERMAID_00002: Module Column in Function Table
 - SWR_MERMAID_00003: Fallback Behavior
+- SWR_MERMAID_00006: Caller Tree Diagram
+- SWR_MERMAID_00007: Streaming Document Generation
+- SWR_MERMAID_00008: Truncation Annotation
+- SWR_MERMAID_00009: Output Fingerprint
+- SWR_MERMAID_00010: Module Graph Diagram
+- SWR_MERMAID_00011: Diagram Splitting
 """
 
+import io
+import shutil
 from datetime import datetime
 from pathlib import Path
-from typing import Dict, List, Optional
+from typing import (
+    IO,
+    Callable,
+    Container,
+    Dict,
+    Iterator,
+    List,
+    Optional,
+    Set,
+    Tuple,
+)
 
 from ..database.models import AnalysisResult, CallTreeNode, FunctionInfo
+from ..database.module_graph import ModuleGraph
 from ..utils.tree_formatter import TreeFormatter
+from .spool import spool
+
+# Walk events: (entering, node, parent, text tree prefix, is last child)
+_WalkEvent = Tuple[bool, CallTreeNode, Optional[CallTreeNode], str, bool]
+
+_Write = Callable[[str], object]
+
+# Where a diagram over the message limit may be split (SWR_MERMAID_00011)
+SPLIT_MODES = ("subtree", "module")
+
+# Parts of a split diagram: (part root, parent of the call, part of the call)
+_DiagramPart = Tuple[CallTreeNode, Optional[CallTreeNode], int]
+
+
+class _TreeSections:
+    """Sections of a document written during one walk of the tree."""
+
+    def __init__(self) -> None:
+        self.participants: List[str] = []
+        self.functions: List[FunctionInfo] = []  # First function of every name
 
 
 class MermaidGenerator:
@@ -24,6 +63,8 @@ class MermaidGenerator:
 
     This class converts call tree structures into Mermaid diagram syntax,
     creates markdown documents with metadata, and handles formatting options.
+    Documents are streamed: the tree is walked iteratively once, writing
+    the diagram and text tree while collecting participants and table rows.
     """
 
     def __init__(
@@ -31,6 +72,8 @@ class MermaidGenerator:
         abbreviate_rte: bool = True,
         use_module_names: bool = False,
         include_returns: bool = False,
+        max_messages: Optional[int] = None,
+        split_by: str = "subtree",
     ):
         """
         Initialize the Mermaid generator.
@@ -39,10 +82,23 @@ class MermaidGenerator:
             abbreviate_rte: Whether to abbreviate long RTE function names
             use_module_names: Use SW module names as participants instead of function names
             include_returns: Whether to include return statements in the sequence diagram (default: False)
+            max_messages: Split sequence diagrams with more messages into
+                linked parts (default: never split)
+            split_by: Calls that may start a part: any call ("subtree") or
+                calls into another SW module ("module")
+
+        Raises:
+            ValueError: If max_messages is below 1 or split_by is unknown
         """
+        if max_messages is not None and max_messages < 1:
+            raise ValueError(f"max_messages must be at least 1, got {max_messages}")
+        if split_by not in SPLIT_MODES:
+            raise ValueError(f"split_by must be one of {SPLIT_MODES}, got {split_by!r}")
         self.abbreviate_rte = abbreviate_rte
         self.use_module_names = use_module_names
         self.include_returns = include_returns
+        self.max_messages = max_messages
+        self.split_by = split_by
         self.participant_map: Dict[str, str] = {}  # Map full names to abbreviated names
         self.next_participant_id = 1
 
@@ -67,46 +123,134 @@ class MermaidGenerator:
         if not result.call_tree:
             raise ValueError("Cannot generate diagram: call tree is None")
 
-        # Build content sections
-        content = []
+        output_file = Path(output_path)
+        output_file.parent.mkdir(parents=True, exist_ok=True)
+        with open(output_file, "w", encoding="utf-8") as out:
+            self.write_document(
+                result,
+                out,
+                include_metadata=include_metadata,
+                include_function_table=include_function_table,
+                include_text_tree=include_text_tree,
+            )
 
-        # Add title
-        content.append(f"# Call Tree: {result.root_function}\n")
+    def generate_to_string(self, result: AnalysisResult) -> str:
+        """
+        Generate Mermaid diagram as string without writing to file.
 
-        # Add metadata
-        if include_metadata:
-            content.append(self._generate_metadata(result))
+        Args:
+            result: Analysis result
 
-        # Add sequence diagram
-        content.append("## Sequence Diagram\n")
-        diagram = self._generate_mermaid_diagram(result.call_tree)
-        content.append("```mermaid")
-        content.append(diagram)
-        content.append("```\n")
+        Returns:
+            Complete markdown document as string
+        """
+        if not result.call_tree:
+            raise ValueError("Cannot generate diagram: call tree is None")
 
-        # Add function details table
-        if include_function_table:
-            content.append(self._generate_function_table(result.call_tree))
+        out = io.StringIO()
+        self.write_document(result, out)
+        return out.getvalue()
 
-        # Add text tree
-        if include_text_tree:
-            content.append(self._generate_text_tree(result.call_tree))
+    def write_document(
+        self,
+        result: AnalysisResult,
+        out: IO[str],
+        include_metadata: bool = True,
+        include_function_table: bool = True,
+        include_text_tree: bool = True,
+    ) -> None:
+        """
+        Write the markdown document of a result to a text stream.
+
+        The tree is walked once without recursion. Participant declarations
+        precede the diagram but are only known after the walk, so the
+        diagram body and the text tree are written to spooled temporary
+        files (in memory while small) and copied into the stream after it.
+
+        A tree with more than max_messages diagram messages is written as
+        several linked diagrams instead (see _plan_parts()).
+
+        Implements: SWR_MERMAID_00007 (Streaming Document Generation)
+        Implements: SWR_MERMAID_00011 (Diagram Splitting)
+
+        Args:
+            result: Analysis result containing call tree
+            out: Text stream to write to
+            include_metadata: Include metadata section
+            include_function_table: Include function details table
+            include_text_tree: Include text-based tree representation
+        """
+        if not result.call_tree:
+            raise ValueError("Cannot generate diagram: call tree is None")
+
+        root = result.call_tree
+        inverted = result.is_caller_tree
+        parts = self._plan_parts(root, inverted)
+        with spool() as diagram, spool() as text_tree:
+            sections = self._walk_sections(
+                root,
+                inverted,
+                diagram=diagram if parts is None else None,
+                text_tree=text_tree if include_text_tree else None,
+            )
+
+            # Sections are separated by a newline
+            out.write(f"# {self._get_title(result)}: {result.root_function}\n")
+            if include_metadata:
+                out.write("\n")
+                out.write(
+                    self._generate_metadata(
+                        result, len(parts[0]) if parts is not None else None
+                    )
+                )
+
+            if parts is None:
+                out.write("\n## Sequence Diagram\n\n```mermaid\n")
+                out.write(self._diagram_header(sections.participants))
+                diagram.seek(0)
+                shutil.copyfileobj(diagram, out)
+                out.write("\n```\n")
+            else:
+                self._write_parts(parts[0], parts[1], inverted, out)
+
+            if include_function_table:
+                out.write("\n")
+                out.write(self._format_function_table(sections.functions))
+
+            if include_text_tree:
+                out.write("\n")
+                out.write(f"## {self._get_tree_heading(inverted)} (Text)\n\n```\n")
+                text_tree.seek(0)
+                shutil.copyfileobj(text_tree, out)
+                out.write("\n```\n")
 
-        # Add circular dependencies if any
         if result.circular_dependencies:
-            content.append(self._generate_circular_deps_section(result))
+            out.write("\n")
+            out.write(self._generate_circular_deps_section(result))
 
-        # Write to file
-        output_file = Path(output_path)
-        output_file.parent.mkdir(parents=True, exist_ok=True)
-        output_file.write_text("\n".join(content), encoding="utf-8")
+    def _get_title(self, result: AnalysisResult) -> str:
+        """
+        Get the document title for a result.
+
+        Implements: SWR_MERMAID_00006 (Caller Tree Diagram)
+
+        Args:
+            result: Analysis result
 
-    def _generate_metadata(self, result: AnalysisResult) -> str:
+        Returns:
+            Title without the root function
+        """
+        return "Callers of" if result.is_caller_tree else "Call Tree"
+
+    def _generate_metadata(
+        self, result: AnalysisResult, diagram_parts: Optional[int] = None
+    ) -> str:
         """
         Generate metadata section.
 
         Args:
             result: Analysis result
+            diagram_parts: Number of parts of a split diagram, or None
 
         Returns:
             Markdown formatted metadata
@@ -119,26 +263,469 @@ class MermaidGenerator:
             f"- **Unique Functions**: {result.statistics.unique_functions}",
             f"- **Max Depth**: {result.statistics.max_depth_reached}",
             f"- **Circular Dependencies**: {result.statistics.circular_dependencies_found}",
-            "",
         ]
+        if result.truncation is not None:
+            lines.append(f"- **Truncated**: {result.truncation.describe()}")
+        # SWR_MERMAID_00009: Output Fingerprint
+        if result.fingerprint is not None:
+            lines.append(f"- **Fingerprint**: `{result.fingerprint}`")
+        # SWR_MERMAID_00011: Diagram Splitting
+        if diagram_parts is not None:
+            lines.append(
+                f"- **Diagram Parts**: {diagram_parts} (split by {self.split_by} "
+                f"above {self.max_messages} messages)"
+            )
+        lines.append("")
         return "\n".join(lines)
 
-    def _generate_mermaid_diagram(self, root: CallTreeNode) -> str:
+    def _get_tree_heading(self, inverted: bool) -> str:
+        """Get the heading of the text tree section."""
+        return "Caller Tree" if inverted else "Call Tree"
+
+    def _message_weight(self, node: CallTreeNode) -> int:
+        """Diagram messages of the call of a node: arrow, return and note."""
+        weight = 1
+        if self.include_returns and not node.is_recursive:
+            weight += 1
+        if node.is_truncated:
+            weight += 1
+        return weight
+
+    def _module_of(self, node: CallTreeNode) -> str:
+        """SW module of a node, or its file stem (SWR_MERMAID_00003)."""
+        func_info = node.function_info
+        return func_info.sw_module or Path(func_info.file_path).stem
+
+    def _plan_parts(
+        self, root: CallTreeNode, inverted: bool
+    ) -> Optional[Tuple[List[_DiagramPart], Dict[int, int]]]:
         """
-        Generate Mermaid sequence diagram syntax.
+        Split a tree whose diagram has more than max_messages messages.
+
+        Message counts are computed bottom-up once per node object. When
+        the messages kept in the part of a node exceed max_messages, its
+        children with the most messages become roots of their own parts
+        until the rest fits; a child that starts a part costs one note in
+        the diagram of its parent. With split_by "module" only calls into
+        another SW module may start a part, so a part can stay larger.
+        Shared subtrees are one part wherever they appear.
+
+        Implements: SWR_MERMAID_00011 (Diagram Splitting)
 
         Args:
-            root: Root node of call tree
+            root: Root node of the tree
+            inverted: The children of a node are its callers (caller tree)
 
         Returns:
-            Mermaid diagram as string
+            (parts, part_links): parts in part number order, starting with
+            the root, and the part number of every node starting a part;
+            None if the diagram is not split
         """
-        lines = ["sequenceDiagram"]
+        limit = self.max_messages
+        if limit is None:
+            return None
+
+        kept: Dict[int, int] = {}  # id(node) -> messages left in its part
+        cuts: Set[int] = set()
+        stack: List[Tuple[CallTreeNode, bool]] = [(root, False)]
+        while stack:
+            node, children_done = stack.pop()
+            key = id(node)
+            if key in kept:
+                continue
+            if not children_done:
+                stack.append((node, True))
+                stack.extend((child, False) for child in node.children)
+                continue
+
+            total = 0
+            candidates = []
+            for child in node.children:
+                child_key = id(child)
+                total += self._message_weight(child)
+                if child_key in cuts:
+                    total += 1
+                    continue
+                total += kept[child_key]
+                # A part of one message would not make the parent smaller
+                if kept[child_key] > 1 and (
+                    self.split_by == "subtree"
+                    or self._module_of(child) != self._module_of(node)
+                ):
+                    candidates.append(child)
+            if total > limit:
+                candidates.sort(key=lambda child: -kept[id(child)])
+                for child in candidates:
+                    if total <= limit:
+                        break
+                    if id(child) not in cuts:
+                        cuts.add(id(child))
+                        total -= kept[id(child)] - 1
+            kept[key] = total
+
+        if not cuts:
+            return None
+
+        # Number the parts in the order their calls appear, part by part
+        parts: List[_DiagramPart] = [(root, None, 0)]
+        part_links: Dict[int, int] = {}
+        index = 0
+        while index < len(parts):
+            part_root = parts[index][0]
+            index += 1
+            for entering, node, parent, _, _ in self._walk(part_root, cuts):
+                if entering and parent is not None and id(node) in cuts:
+                    if id(node) not in part_links:
+                        parts.append((node, parent, index))
+                        part_links[id(node)] = len(parts)
+        return parts, part_links
+
+    def _write_parts(
+        self,
+        parts: List[_DiagramPart],
+        part_links: Dict[int, int],
+        inverted: bool,
+        out: IO[str],
+    ) -> None:
+        """
+        Write the diagram parts of a split tree with their index.
+
+        Every part is a complete sequence diagram. A part of a call tree
+        starts with the call that leads to it, inside the loop and opt
+        blocks of that call; calls continued in other parts end with a
+        note naming the part.
+
+        Implements: SWR_MERMAID_00011 (Diagram Splitting)
+
+        Args:
+            parts: Parts from _plan_parts()
+            part_links: Part number of every node starting a part
+            inverted: The children of a node are its callers (caller tree)
+            out: Text stream to write to
+        """
+        out.write(
+            "\n## Sequence Diagram\n\n"
+            f"The diagram is split into {len(parts)} parts.\n\n"
+            "| Part | Function | Called From |\n"
+            "|------|----------|-------------|\n"
+        )
+        for number, (part_root, parent, parent_part) in enumerate(parts, 1):
+            called_from = "-"
+            if parent is not None:
+                called_from = (
+                    f"[Part {parent_part}](#part-{parent_part}) "
+                    f"`{parent.function_info.name}`"
+                )
+            out.write(
+                f"| [Part {number}](#part-{number}) | "
+                f"`{part_root.function_info.name}` | {called_from} |\n"
+            )
+
+        for number, (part_root, parent, _) in enumerate(parts, 1):
+            with spool() as body:
+                caller = None
+                if parent is not None and not inverted:
+                    caller = self._get_participant_from_node(parent)
+                    self._write_block_starts(part_root, body.write)
+                sections = self._walk_sections(
+                    part_root,
+                    inverted,
+                    diagram=body,
+                    caller=caller,
+                    part_links=part_links,
+                )
+                participants = sections.participants
+                if caller is not None:
+                    self._write_block_ends(part_root, body.write)
+                    participants = [caller] + [
+                        name for name in participants if name != caller
+                    ]
+
+                out.write(
+                    f'\n<a id="part-{number}"></a>\n\n'
+                    f"### Part {number}: {part_root.function_info.name}\n\n"
+                    "```mermaid\n"
+                )
+                out.write(self._diagram_header(participants))
+                body.seek(0)
+                shutil.copyfileobj(body, out)
+                out.write("\n```\n")
+
+    @staticmethod
+    def _walk(
+        root: CallTreeNode, stops: Container[int] = ()
+    ) -> Iterator[_WalkEvent]:
+        """
+        Walk a tree depth-first without recursion.
+
+        Every node is entered before and exited after its children, like a
+        recursive traversal; shared subtrees are walked at every place they
+        appear.
+
+        Implements: SWR_MERMAID_00007 (Streaming Document Generation)
+
+        Args:
+            root: Root node of the tree
+            stops: id() of nodes below the root whose children are not
+                walked (the roots of other parts of a split diagram)
+
+        Yields:
+            (entering, node, parent, prefix, is_last) events; prefix is the
+            text tree prefix of the node and is_last tells whether it is the
+            last child of its parent
+        """
+        yield True, root, None, "", True
+        # Frames: [node, parent, next child index, prefix, is last, child prefix]
+        stack: List[list] = [[root, None, 0, "", True, ""]]
+        while stack:
+            frame = stack[-1]
+            node, index = frame[0], frame[2]
+            children = node.children
+            if index < len(children):
+                frame[2] = index + 1
+                child = children[index]
+                is_last = index == len(children) - 1
+                prefix = frame[5]
+                yield True, child, node, prefix, is_last
+                if id(child) in stops:
+                    yield False, child, node, prefix, is_last
+                    continue
+                stack.append(
+                    [
+                        child,
+                        node,
+                        0,
+                        prefix,
+                        is_last,
+                        prefix + ("    " if is_last else "│   "),
+                    ]
+                )
+            else:
+                stack.pop()
+                yield False, node, frame[1], frame[3], frame[4]
+
+    def _walk_sections(
+        self,
+        root: CallTreeNode,
+        inverted: bool,
+        diagram: Optional[IO[str]] = None,
+        text_tree: Optional[IO[str]] = None,
+        caller: Optional[str] = None,
+        part_links: Optional[Dict[int, int]] = None,
+    ) -> _TreeSections:
+        """
+        Write the diagram body and text tree in one walk of the tree.
+
+        Diagram lines are written with a leading newline, so the body
+        follows the header of _diagram_header() directly. Participants
+        and the functions of the table are collected on the way; node
+        texts are computed once per function, which keeps shared subtrees
+        cheap.
+
+        Implements: SWR_MERMAID_00007 (Streaming Document Generation)
+
+        Args:
+            root: Root node of the tree
+            inverted: The children of a node are its callers (caller tree)
+            diagram: Stream for the sequence calls, or None
+            text_tree: Stream for the text tree, or None
+            caller: Participant calling the root of a call tree, or None
+            part_links: id() of the nodes continued in another part of a
+                split diagram -> part number; their children are not walked
+
+        Returns:
+            Participants in diagram order and the functions of the tree
+        """
+        part_links = part_links or {}
+        sections = _TreeSections()
+        seen_participants = set()
+        seen_names = set()
+        # id(FunctionInfo) -> (participant, call label, text tree label)
+        texts: Dict[int, Tuple[str, str, str]] = {}
+
+        def node_texts(node: CallTreeNode) -> Tuple[str, str, str]:
+            key = id(node.function_info)
+            entry = texts.get(key)
+            if entry is None:
+                entry = texts[key] = (
+                    self._get_participant_from_node(node),
+                    self._get_call_label(node),
+                    TreeFormatter.format_function(node.function_info),
+                )
+            return entry
+
+        def add_participant(participant: str) -> None:
+            if participant not in seen_participants:
+                seen_participants.add(participant)
+                sections.participants.append(participant)
+
+        write_call = diagram.write if diagram is not None else None
+        for entering, node, parent, prefix, is_last in self._walk(root, part_links):
+            participant, call_label, tree_label = node_texts(node)
+            # Calls of a node continued in another part are noted there
+            part_link = part_links.get(id(node)) if parent is not None else None
+            parent_participant = (
+                node_texts(parent)[0] if parent is not None else caller
+            )
+
+            if entering:
+                if text_tree is not None:
+                    if parent is None:
+                        text_tree.write(tree_label)
+                    else:
+                        connector = "└── " if is_last else "├── "
+                        text_tree.write(f"\n{prefix}{connector}{tree_label}")
+                    if node.is_recursive:
+                        text_tree.write(" [RECURSIVE]")
+                    if node.is_truncated:
+                        text_tree.write(" [TRUNCATED]")
+
+                name = node.function_info.name
+                if name not in seen_names:
+                    seen_names.add(name)
+                    sections.functions.append(node.function_info)
+
+                if not inverted:
+                    add_participant(participant)
+                    if write_call is not None and parent_participant:
+                        if parent is not None:
+                            self._write_block_starts(node, write_call)
+                        self._write_call(
+                            participant,
+                            parent_participant,
+                            call_label,
+                            node,
+                            write_call,
+                        )
+                continue
+
+            if inverted:
+                # Callers are declared before the functions they call
+                add_participant(participant)
+                if write_call is not None and node.is_truncated and not part_link:
+                    self._write_truncation_note(participant, inverted, write_call)
+                if write_call is not None and parent is not None:
+                    if part_link:
+                        self._write_part_link_note(
+                            participant, part_link, inverted, write_call
+                        )
+                    self._write_block_starts(node, write_call)
+                    callee_participant, callee_label, _ = node_texts(parent)
+                    self._write_call(
+                        callee_participant, participant, callee_label, node, write_call
+                    )
+                    if self.include_returns and not node.is_recursive:
+                        write_call(
+                            f"\n    {callee_participant}-->>{participant}: return"
+                        )
+                    self._write_block_ends(node, write_call)
+            elif write_call is not None and parent_participant:
+                if node.is_truncated and not part_link:
+                    self._write_truncation_note(participant, inverted, write_call)
+                if part_link:
+                    self._write_part_link_note(
+                        participant, part_link, inverted, write_call
+                    )
+                if self.include_returns and not node.is_recursive:
+                    write_call(f"\n    {participant}-->>{parent_participant}: return")
+                if parent is not None:
+                    self._write_block_ends(node, write_call)
+
+        return sections
+
+    def _write_call(
+        self,
+        callee: str,
+        caller: str,
+        call_label: str,
+        node: CallTreeNode,
+        write: _Write,
+    ) -> None:
+        """
+        Write the arrow of one call.
 
-        # Collect all participants
-        participants = self._collect_participants(root)
+        Implements: SWR_MERMAID_00001 (Module-Based Participants with function names on arrows)
+
+        Args:
+            callee: Participant receiving the call
+            caller: Participant making the call
+            call_label: Label of the called function
+            node: Node whose edge the call is; a recursive node gets the
+                  recursive arrow
+            write: Write function of the diagram stream
+        """
+        if node.is_recursive:
+            label = (
+                f"{call_label} [recursive]"
+                if self.use_module_names
+                else "recursive call"
+            )
+            write(f"\n    {caller}-->>x{callee}: {label}")
+        else:
+            write(f"\n    {caller}->>{callee}: {call_label}")
 
-        # Add participant declarations
+    @staticmethod
+    def _write_truncation_note(participant: str, inverted: bool, write: _Write) -> None:
+        """
+        Write the note of a node whose calls a build budget left unexpanded.
+
+        Implements: SWR_MERMAID_00008 (Truncation Annotation)
+
+        Args:
+            participant: Participant of the truncated node
+            inverted: The children of the node are its callers
+            write: Write function of the diagram stream
+        """
+        what = "callers" if inverted else "calls"
+        write(f"\n    Note over {participant}: further {what} not expanded")
+
+    @staticmethod
+    def _write_part_link_note(
+        participant: str, part: int, inverted: bool, write: _Write
+    ) -> None:
+        """
+        Write the note of a node whose calls continue in another part.
+
+        Implements: SWR_MERMAID_00011 (Diagram Splitting)
+
+        Args:
+            participant: Participant of the node
+            part: Number of the part rooted at the node
+            inverted: The children of the node are its callers
+            write: Write function of the diagram stream
+        """
+        what = "callers" if inverted else "calls"
+        write(f"\n    Note over {participant}: {what} continued in Part {part}")
+
+    @staticmethod
+    def _write_block_starts(node: CallTreeNode, write: _Write) -> None:
+        """Open the loop and opt blocks of a call (SWR_MERMAID_00004/00005)."""
+        if node.is_loop:
+            loop_text = node.loop_condition if node.loop_condition else "Loop"
+            write(f"\n    loop {loop_text}")
+        if node.is_optional:
+            condition_text = node.condition if node.condition else "Optional call"
+            write(f"\n    opt {condition_text}")
+
+    @staticmethod
+    def _write_block_ends(node: CallTreeNode, write: _Write) -> None:
+        """Close the blocks opened by _write_block_starts()."""
+        if node.is_optional:
+            write("\n    end")
+        if node.is_loop:
+            write("\n    end")
+
+    def _diagram_header(self, participants: List[str]) -> str:
+        """
+        Get the diagram start with the participant declarations.
+
+        Args:
+            participants: Participants in diagram order
+
+        Returns:
+            Diagram text up to the blank line before the calls
+        """
+        lines = ["sequenceDiagram"]
         for participant in participants:
             if self.abbreviate_rte and participant.startswith("Rte_"):
                 abbrev = self._abbreviate_rte_name(participant)
@@ -146,15 +733,29 @@ class MermaidGenerator:
                 lines.append(f"    participant {abbrev} as {participant}")
             else:
                 lines.append(f"    participant {participant}")
-
         lines.append("")
+        return "\n".join(lines)
 
-        # Generate sequence calls
-        self._generate_sequence_calls(root, lines)
+    def _generate_mermaid_diagram(
+        self, root: CallTreeNode, inverted: bool = False
+    ) -> str:
+        """
+        Generate Mermaid sequence diagram syntax.
 
-        return "\n".join(lines)
+        Args:
+            root: Root node of call tree
+            inverted: The children of a node are its callers (caller tree)
+
+        Returns:
+            Mermaid diagram as string
+        """
+        body = io.StringIO()
+        sections = self._walk_sections(root, inverted, diagram=body)
+        return self._diagram_header(sections.participants) + body.getvalue()
 
-    def _collect_participants(self, root: CallTreeNode) -> List[str]:
+    def _collect_participants(
+        self, root: CallTreeNode, callers_first: bool = False
+    ) -> List[str]:
         """
         Collect all unique participants (functions or modules) in tree.
 
@@ -162,86 +763,50 @@ class MermaidGenerator:
 
         Args:
             root: Root node of call tree
+            callers_first: Visit the children of a node before the node, so
+                           the callers of a caller tree come first
 
         Returns:
             List of participant names in the order they are first encountered
         """
-        participants = []
-
-        def traverse(node: CallTreeNode):
-            # Use module name if enabled, otherwise use function name
-            if self.use_module_names:
-                # Use module name if available, otherwise fallback to filename
-                participant = (
-                    node.function_info.sw_module
-                    or Path(node.function_info.file_path).stem
-                )
-            else:
-                participant = node.function_info.name
-
-            # Add participant only if not already in the list
-            if participant not in participants:
-                participants.append(participant)
-
-            for child in node.children:
-                traverse(child)
-
-        traverse(root)
-        return participants
+        return self._walk_sections(root, callers_first).participants
 
     def _generate_sequence_calls(
         self, node: CallTreeNode, lines: List[str], caller: Optional[str] = None
     ) -> None:
         """
-        Generate sequence call statements recursively.
+        Generate sequence call statements.
 
         Implements: SWR_MERMAID_00001 (Module-Based Participants with function names on arrows)
 
         Args:
-            node: Current node in call tree
+            node: Root node of the calls
             lines: List of lines to append to
             caller: Name of calling function or module (None for root)
         """
-        current_participant = self._get_participant_from_node(node)
-        call_label = self._get_call_label(node)
-
-        # Generate call from caller to current
-        if caller:
-            if node.is_recursive:
-                label = (
-                    f"{call_label} [recursive]"
-                    if self.use_module_names
-                    else "recursive call"
-                )
-                lines.append(f"    {caller}-->>x{current_participant}: {label}")
-            else:
-                lines.append(f"    {caller}->>{current_participant}: {call_label}")
-
-        # Generate calls to children
-        for child in node.children:
-            # Start loop block for loop calls - SWR_MERMAID_00005: Loop Block Generation
-            if child.is_loop:
-                loop_text = child.loop_condition if child.loop_condition else "Loop"
-                lines.append(f"    loop {loop_text}")
+        body = io.StringIO()
+        self._walk_sections(node, False, diagram=body, caller=caller)
+        lines.extend(body.getvalue().split("\n")[1:])
 
-            # Start opt block for optional calls - SWR_MERMAID_00004: Opt Block Generation
-            if child.is_optional:
-                condition_text = child.condition if child.condition else "Optional call"
-                lines.append(f"    opt {condition_text}")
-
-            self._generate_sequence_calls(child, lines, current_participant)
+    def _generate_caller_sequence_calls(
+        self, node: CallTreeNode, lines: List[str]
+    ) -> None:
+        """
+        Generate the sequence calls of a caller tree.
 
-            # End opt block for optional calls - SWR_MERMAID_00004
-            if child.is_optional:
-                lines.append("    end")
+        The call chains leading to a caller are generated before the
+        caller's own call, so every chain reads from its entry point down
+        to the root function.
 
-            # End loop block for loop calls - SWR_MERMAID_00005
-            if child.is_loop:
-                lines.append("    end")
+        Implements: SWR_MERMAID_00006 (Caller Tree Diagram)
 
-        # Generate return from current to caller (only if include_returns is True)
-        if caller and not node.is_recursive and self.include_returns:
-            lines.append(f"    {current_participant}-->>{caller}: return")
+        Args:
+            node: Root node of the caller tree (the called function)
+            lines: List of lines to append to
+        """
+        body = io.StringIO()
+        self._walk_sections(node, True, diagram=body)
+        lines.extend(body.getvalue().split("\n")[1:])
 
     def _get_participant_name(self, function_name: str) -> str:
         """
@@ -321,6 +886,20 @@ class MermaidGenerator:
         Args:
             root: Root node of call tree
 
+        Returns:
+            Markdown formatted table
+        """
+        return self._format_function_table(self._walk_sections(root, False).functions)
+
+    def _format_function_table(self, functions: List[FunctionInfo]) -> str:
+        """
+        Format the markdown table of function details.
+
+        Implements: SWR_MERMAID_00002 (Module Column in Function Table)
+
+        Args:
+            functions: Unique functions of the tree
+
         Returns:
             Markdown formatted table
         """
@@ -338,24 +917,8 @@ class MermaidGenerator:
                 "|----------|------|------|-------------|------------|",
             ]
 
-        # Collect all unique functions
-        functions = []
-        seen = set()
-
-        def traverse(node: CallTreeNode):
-            if node.function_info.name not in seen:
-                seen.add(node.function_info.name)
-                functions.append(node.function_info)
-            for child in node.children:
-                traverse(child)
-
-        traverse(root)
-
-        # Sort by function name
-        functions.sort(key=lambda f: f.name)
-
-        # Add table rows
-        for func in functions:
+        # Add table rows sorted by function name
+        for func in sorted(functions, key=lambda f: f.name):
             file_name = Path(func.file_path).name
             params = self._format_parameters(func)
 
@@ -424,18 +987,21 @@ class MermaidGenerator:
 
         return ", ".join(param_strs)
 
-    def _generate_text_tree(self, root: CallTreeNode) -> str:
+    def _generate_text_tree(self, root: CallTreeNode, inverted: bool = False) -> str:
         """
         Generate text-based tree representation.
 
         Args:
             root: Root node of call tree
+            inverted: The children of a node are its callers (caller tree)
 
         Returns:
             Markdown formatted text tree
         """
-        lines = ["## Call Tree (Text)\n", "```"]
-        lines.append(TreeFormatter.format_tree(root, show_file=True, show_line=True))
+        text_tree = io.StringIO()
+        self._walk_sections(root, inverted, text_tree=text_tree)
+        lines = [f"## {self._get_tree_heading(inverted)} (Text)\n", "```"]
+        lines.append(text_tree.getvalue())
         lines.append("```\n")
         return "\n".join(lines)
 
@@ -461,42 +1027,82 @@ class MermaidGenerator:
         lines.append("")
         return "\n".join(lines)
 
-    def generate_to_string(self, result: AnalysisResult) -> str:
+    def generate_module_graph(self, graph: ModuleGraph, output_path: str) -> None:
         """
-        Generate Mermaid diagram as string without writing to file.
+        Generate the module diagram of a module call graph and save it.
 
         Args:
-            result: Analysis result
-
-        Returns:
-            Complete markdown document as string
+            graph: Module call graph of the database
+            output_path: Path to output markdown file
         """
-        if not result.call_tree:
-            raise ValueError("Cannot generate diagram: call tree is None")
-
-        content = []
-
-        # Add title
-        content.append(f"# Call Tree: {result.root_function}\n")
-
-        # Add metadata
-        content.append(self._generate_metadata(result))
+        output_file = Path(output_path)
+        output_file.parent.mkdir(parents=True, exist_ok=True)
+        with open(output_file, "w", encoding="utf-8") as out:
+            self.write_module_graph(graph, out)
 
-        # Add sequence diagram
-        content.append("## Sequence Diagram\n")
-        diagram = self._generate_mermaid_diagram(result.call_tree)
-        content.append("```mermaid")
-        content.append(diagram)
-        content.append("```\n")
+    def write_module_graph(self, graph: ModuleGraph, out: IO[str]) -> None:
+        """
+        Write the markdown document of a module call graph.
 
-        # Add function table
-        content.append(self._generate_function_table(result.call_tree))
+        The diagram is rendered from the aggregated graph: one node per
+        module and one edge per pair of modules, labelled with the number
+        of calls. Calls within a module are only counted in the module
+        table.
 
-        # Add text tree
-        content.append(self._generate_text_tree(result.call_tree))
+        Implements: SWR_MERMAID_00010 (Module Graph Diagram)
 
-        # Add circular dependencies
-        if result.circular_dependencies:
-            content.append(self._generate_circular_deps_section(result))
+        Args:
+            graph: Module call graph of the database
+            out: Text stream to write to
+        """
+        dependencies = graph.dependencies()
+        node_ids = {
+            module: f"M{index}" for index, module in enumerate(graph.modules, 1)
+        }
+
+        out.write("# Module Graph\n\n## Metadata\n\n")
+        out.write(f"- **Generated**: {datetime.now().strftime('%Y-%m-%d %H:%M:%S')}\n")
+        out.write(f"- **Modules**: {len(graph.modules)}\n")
+        out.write(f"- **Module Dependencies**: {len(dependencies)}\n")
+        out.write(
+            f"- **Cross-Module Calls**: "
+            f"{sum(edge.call_count for edge in dependencies)}\n"
+        )
+        out.write(f"- **Unresolved Calls**: {graph.unresolved_calls}\n")
+
+        out.write("\n## Module Diagram\n\n```mermaid\nflowchart LR\n")
+        for module, node_id in node_ids.items():
+            label = module.replace('"', "#quot;")
+            out.write(f'    {node_id}["{label}"]\n')
+        for edge in dependencies:
+            calls = "call" if edge.call_count == 1 else "calls"
+            out.write(
+                f"    {node_ids[edge.caller_module]} -->|{edge.call_count} {calls}| "
+                f"{node_ids[edge.callee_module]}\n"
+            )
+        out.write("```\n")
+
+        out.write(
+            "\n## Module Dependencies\n\n"
+            "| Caller Module | Callee Module | Calls | Example Calls |\n"
+            "|---------------|---------------|-------|---------------|\n"
+        )
+        for edge in dependencies:
+            examples = ", ".join(
+                f"`{caller} → {callee}`" for caller, callee in edge.examples
+            )
+            out.write(
+                f"| {edge.caller_module} | {edge.callee_module} | "
+                f"{edge.call_count} | {examples} |\n"
+            )
 
-        return "\n".join(content)
+        out.write(
+            "\n## Modules\n\n"
+            "| Module | Functions | Internal Calls |\n"
+            "|--------|-----------|----------------|\n"
+        )
+        internal_calls = graph.internal_calls()
+        for module, function_count in graph.modules.items():
+            out.write(
+                f"| {module} | {function_count} | {internal_calls.get(module, 0)} |\n"
+            )
@@ -13,10 +13,15 @@ Requirements:
 - SWR_RH_00003: AUTOSAR Stereotype Support
 - SWR_RH_00004: UUID-based Element IDs (GUID+ format)
 - SWR_RH_00005: Rhapsody-specific Metadata
+- SWR_GEN_00026: Streaming XMI Generation
+- SWR_GEN_00027: Deterministic Element IDs
 """
 
+import hashlib
+import io
+import re
 from pathlib import Path
-from typing import TYPE_CHECKING, Dict, List, Optional
+from typing import IO, TYPE_CHECKING, Dict, List, Optional, TextIO, Tuple
 from uuid import uuid4
 
 from lxml import etree
@@ -27,6 +32,8 @@ from autosar_calltree.database.models import (
     FunctionInfo,
 )
 
+from .spool import spool
+
 if TYPE_CHECKING:
     from lxml.etree import _Element as Element
 else:
@@ -34,6 +41,37 @@ else:
 
 SubElement = etree.SubElement
 
+# Comment marking the position of the message section in the document head
+_MESSAGES_MARKER = "autosar-calltree-messages"
+
+# Attribute value characters escaped by lxml, and their escapes
+_ATTRIBUTE_SPECIAL = re.compile(r'[&<>"\n\r\t]')
+_ATTRIBUTE_ESCAPES = str.maketrans(
+    {
+        "&": "&amp;",
+        "<": "&lt;",
+        ">": "&gt;",
+        '"': "&quot;",
+        "\n": "&#10;",
+        "\r": "&#13;",
+        "\t": "&#9;",
+    }
+)
+
+
+def _escape_attribute(value: str) -> str:
+    """Escape an attribute value like lxml does."""
+    if _ATTRIBUTE_SPECIAL.search(value):
+        return value.translate(_ATTRIBUTE_ESCAPES)
+    return value
+
+
+def _empty_element(tag: str, attributes: List[Tuple[str, str]]) -> str:
+    """Serialize an element without children from escaped attribute values."""
+    return "<{} {}/>".format(
+        tag, " ".join(f'{name}="{value}"' for name, value in attributes)
+    )
+
 
 class RhapsodyXmiGenerator:
     """
@@ -74,7 +112,7 @@ class RhapsodyXmiGenerator:
     MAX_PACKAGE_DEPTH = 30
     MAX_PACKAGE_NAME_LENGTH = 50
 
-    def __init__(self, use_module_names: bool = False, package_path: Optional[str] = None, model_name: Optional[str] = None):
+    def __init__(self, use_module_names: bool = False, package_path: Optional[str] = None, model_name: Optional[str] = None, deterministic_ids: bool = False):
         """
         Initialize the Rhapsody XMI generator.
 
@@ -82,6 +120,8 @@ class RhapsodyXmiGenerator:
             use_module_names: Use SW module names as participants instead of function names
             package_path: Package path for nested packages (e.g., 'Package1/Package2/Package3')
             model_name: Custom name for the UML model (default: CallTree_{root_function})
+            deterministic_ids: Derive element IDs from the document content instead of
+                random UUIDs, so that the same tree always gives the same document
 
         Raises:
             ValueError: If package path exceeds maximum depth or contains invalid package names
@@ -89,6 +129,9 @@ class RhapsodyXmiGenerator:
         self.use_module_names = use_module_names
         self.package_path = self._validate_package_path(package_path) if package_path else None
         self.model_name = model_name
+        self.deterministic_ids = deterministic_ids
+        # Prefix of the keys of deterministic IDs, set per document
+        self._id_seed = ""
 
     def _validate_package_path(self, package_path: str) -> str:
         """
@@ -154,17 +197,13 @@ class RhapsodyXmiGenerator:
         if result.call_tree is None:
             raise ValueError("call tree is None, cannot generate XMI")
 
-        # Generate XMI document
-        root = self._generate_xmi_document(result, result.call_tree)
-
         # Ensure output directory exists
         output_file = Path(output_path)
         output_file.parent.mkdir(parents=True, exist_ok=True)
 
-        # Write to file with proper encoding
-        xml_string = self._element_to_string(root)
+        # Stream the document into the file with proper encoding
         with open(output_file, "w", encoding="utf-8") as f:
-            f.write(xml_string)
+            self.write_document(result, f)
 
     def generate_to_string(self, result: AnalysisResult) -> str:
         """
@@ -182,8 +221,69 @@ class RhapsodyXmiGenerator:
         if result.call_tree is None:
             raise ValueError("call tree is None, cannot generate XMI")
 
-        root = self._generate_xmi_document(result, result.call_tree)
-        return self._element_to_string(root)
+        out = io.StringIO()
+        self.write_document(result, out)
+        return out.getvalue()
+
+    def write_document(self, result: AnalysisResult, out: TextIO) -> None:
+        """
+        Write the XMI document of an analysis result to a text stream.
+
+        The messages are written to a spooled temporary file while the call
+        tree is walked, because the lifelines before them list the message
+        occurrences covering them. The rest of the document is built with
+        lxml and written around the message section, so only the document
+        head and the coveredBy lists are held in memory.
+
+        Implements: SWR_GEN_00026 (Streaming XMI Generation)
+
+        Args:
+            result: Analysis result containing call tree and metadata
+            out: Text stream to write the document to
+
+        Raises:
+            ValueError: If call tree is None
+        """
+        if result.call_tree is None:
+            raise ValueError("call tree is None, cannot generate XMI")
+
+        self._id_seed = (
+            f"{self.model_name or f'CallTree_{result.root_function}'}/"
+            f"{result.root_function}"
+        )
+        root, interaction, lifeline_elements = self._generate_xmi_document(
+            result, result.call_tree
+        )
+
+        with spool() as messages:
+            lifeline_occurrences = self._write_messages(
+                messages,
+                result.call_tree,
+                interaction.get(f"{{{self.XMI_NAMESPACE}}}id"),
+                {
+                    name: lifeline.get(f"{{{self.XMI_NAMESPACE}}}id")
+                    for name, lifeline in lifeline_elements.items()
+                },
+            )
+
+            # Update coveredBy attributes on lifelines
+            for name, occurrences in lifeline_occurrences.items():
+                if occurrences:
+                    lifeline_elements[name].set("coveredBy", " ".join(occurrences))
+
+            # Mark where the messages go and write the head around them
+            interaction.append(etree.Comment(_MESSAGES_MARKER))
+            head = self._element_to_string(root)
+            marker = head.index(f"<!--{_MESSAGES_MARKER}-->")
+            line_start = head.rindex("\n", 0, marker) + 1
+            indent = head[line_start:marker]
+
+            out.write(head[:line_start])
+            messages.seek(0)
+            for line in messages:
+                out.write(indent)
+                out.write(line)
+            out.write(head[head.index("\n", marker) + 1 :])
 
     def _element_to_string(self, element: Element) -> str:
         """
@@ -201,30 +301,46 @@ class RhapsodyXmiGenerator:
         # Add XML declaration
         return f'<?xml version="1.0" encoding="UTF-8"?>\n{xml_str}'
 
-    def _generate_id(self) -> str:
+    def _generate_id(self, key: str = "") -> str:
         """
         Generate Rhapsody-compatible UUID-based IDs.
 
-        Rhapsody uses GUID+<UUID> format for element IDs.
+        Rhapsody uses GUID+<UUID> format for element IDs. With deterministic
+        IDs, the UUID is a hash of the document seed and a key that is unique
+        within the document, e.g. the path of a message in the call tree.
+
+        Implements: SWR_GEN_00027 (Deterministic Element IDs)
+
+        Args:
+            key: Key of the element, used with deterministic IDs
 
         Returns:
             Unique identifier string with GUID+<UUID> format
         """
         # SWR_RH_00004: UUID-based Element IDs (GUID+ format)
-        return f"GUID+{uuid4()}"
+        if not self.deterministic_ids:
+            return f"GUID+{uuid4()}"
+        digest = hashlib.blake2b(
+            f"{self._id_seed}/{key}".encode("utf-8"), digest_size=16
+        ).hexdigest()
+        return (
+            f"GUID+{digest[:8]}-{digest[8:12]}-{digest[12:16]}-"
+            f"{digest[16:20]}-{digest[20:]}"
+        )
 
     def _generate_xmi_document(
         self, result: AnalysisResult, call_tree: CallTreeNode
-    ) -> Element:
+    ) -> Tuple[Element, Element, Dict[str, Element]]:
         """
-        Generate the root XMI document element.
+        Generate the XMI document up to the lifelines of the interaction.
 
         Args:
             result: Analysis result containing metadata
             call_tree: Root node of the call tree
 
         Returns:
-            Root XMI element with complete document structure
+            Root XMI element, interaction element and lifeline elements by
+            participant name; the messages are written by _write_messages()
         """
         # SWR_RH_00001: XMI 2.1 Compatibility
         # Create namespace map for lxml
@@ -245,7 +361,7 @@ class RhapsodyXmiGenerator:
         # Create UML model - use prefixed form to force xmlns:uml declaration
         model = SubElement(root, "{http://www.omg.org/spec/UML/20090901}Model")
         model.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Model")
-        model.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+        model.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id("Model"))
         model.set("name", self.model_name if self.model_name else f"CallTree_{result.root_function}")
 
         # Add element imports
@@ -254,7 +370,7 @@ class RhapsodyXmiGenerator:
         # Add model constraint
         constraint = SubElement(model, "ownedRule")
         constraint.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Constraint")
-        constraint.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+        constraint.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id("Model1"))
         constraint.set("name", "Model1")
         constraint.set("context", model.get(f"{{{self.XMI_NAMESPACE}}}id"))
 
@@ -269,34 +385,42 @@ class RhapsodyXmiGenerator:
             # Create nested packages based on package_path
             packages = self.package_path.strip().split('/')
             current_package = model
+            package_key = "Package"
 
             for pkg_name in packages:
                 pkg_name = pkg_name.strip()
                 if not pkg_name:
                     continue
 
+                package_key = f"{package_key}/{pkg_name}"
                 pkg = SubElement(current_package, "packagedElement")
                 pkg.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Package")
-                pkg.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+                pkg.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id(package_key))
                 pkg.set("name", pkg_name)
                 current_package = pkg
 
             # The sequence diagram package is the last one
             package = SubElement(current_package, "packagedElement")
             package.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Package")
-            package.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+            package.set(
+                f"{{{self.XMI_NAMESPACE}}}id",
+                self._generate_id(f"{package_key}/Sequence_Diagram"),
+            )
             package.set("name", "Sequence_Diagram")
         else:
             # Use flat package structure (current implementation)
             package = SubElement(model, "packagedElement")
             package.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Package")
-            package.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+            package.set(
+                f"{{{self.XMI_NAMESPACE}}}id",
+                self._generate_id("Package/Sequence_Diagram"),
+            )
             package.set("name", "Sequence_Diagram")
 
         # Create interaction
         interaction = SubElement(package, "packagedElement")
         interaction.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Interaction")
-        interaction.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+        interaction.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id("Interaction"))
         interaction.set("name", f"seq_{result.root_function}")
 
         # Collect participants (lifelines)
@@ -308,10 +432,7 @@ class RhapsodyXmiGenerator:
         # Create lifelines
         lifeline_elements = self._create_lifelines(interaction, participants, role_ids)
 
-        # Create messages and message occurrences
-        self._create_messages(interaction, call_tree, lifeline_elements)
-
-        return root  # type: ignore[no-any-return]
+        return root, interaction, lifeline_elements
 
     def _collect_participants(self, call_tree: CallTreeNode) -> Dict[str, str]:
         """
@@ -323,27 +444,26 @@ class RhapsodyXmiGenerator:
         Returns:
             Dictionary mapping participant names to their display names
         """
-        participants = {}
+        participants: Dict[str, str] = {}
 
-        def traverse(node: CallTreeNode):
-            if node.is_recursive:
-                return
-
-            # Determine participant name
-            if self.use_module_names and node.function_info.sw_module:
-                name = f":{node.function_info.sw_module}"
-            else:
-                name = node.function_info.name
+        # Pre-order walk with an explicit stack; a shared subtree (visited
+        # before) adds no new participants
+        visited = set()
+        stack = [call_tree]
+        while stack:
+            node = stack.pop()
+            if node.is_recursive or id(node) in visited:
+                continue
+            visited.add(id(node))
 
             # Store first occurrence of each participant
+            name = self._get_participant_name(node.function_info)
             if name not in participants:
                 participants[name] = name
 
             # Traverse children
-            for child in node.children:
-                traverse(child)
+            stack.extend(reversed(node.children))
 
-        traverse(call_tree)
         return participants
 
     def _create_role_definitions(
@@ -365,10 +485,11 @@ class RhapsodyXmiGenerator:
             # Create role definition
             role = SubElement(interaction, "ownedAttribute")
             role.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Property")
-            role.set(f"{{{self.XMI_NAMESPACE}}}id", f"{self._generate_id()}_Role")
+            role_id = f"{self._generate_id(f'Role/{name}')}_Role"
+            role.set(f"{{{self.XMI_NAMESPACE}}}id", role_id)
             role.set("name", f"{name}Role")
 
-            role_ids[name] = role.get(f"{{{self.XMI_NAMESPACE}}}id")
+            role_ids[name] = role_id
 
         return role_ids
 
@@ -395,7 +516,9 @@ class RhapsodyXmiGenerator:
             # Create lifeline
             lifeline = SubElement(interaction, "lifeline")
             lifeline.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Lifeline")
-            lifeline.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+            lifeline.set(
+                f"{{{self.XMI_NAMESPACE}}}id", self._generate_id(f"Lifeline/{name}")
+            )
             lifeline.set("name", name)
 
             # Reference role
@@ -404,132 +527,126 @@ class RhapsodyXmiGenerator:
             # Reference interaction
             lifeline.set("interaction", interaction.get(f"{{{self.XMI_NAMESPACE}}}id"))
 
-            # Initialize coveredBy (will be updated later)
+            # Initialize coveredBy (updated after the messages are written)
             lifeline.set("coveredBy", "")
 
             lifeline_elements[name] = lifeline
 
         return lifeline_elements
 
-    def _create_messages(
+    def _write_messages(
         self,
-        interaction: Element,
+        out: IO[str],
         call_tree: CallTreeNode,
-        lifeline_elements: Dict[str, Element],
-    ) -> None:
+        interaction_id: str,
+        lifeline_ids: Dict[str, str],
+    ) -> Dict[str, List[str]]:
         """
-        Create message elements and message occurrence specifications.
+        Write the message occurrences, messages and combined fragments.
+
+        The tree is walked in pre-order with an explicit stack, so its depth
+        is not limited by the recursion limit. Every element is written on
+        its own line without the indentation of the interaction.
+
+        Implements: SWR_GEN_00026 (Streaming XMI Generation)
 
         Args:
-            interaction: Interaction element
+            out: Text stream to write the elements to
             call_tree: Root node of the call tree
-            lifeline_elements: Dictionary of lifeline elements
+            interaction_id: ID of the interaction element
+            lifeline_ids: Lifeline IDs by participant name
+
+        Returns:
+            Message occurrence IDs covering each lifeline, by participant name
         """
         # Collect message occurrences for each lifeline
         lifeline_occurrences: Dict[str, List[str]] = {
-            name: [] for name in lifeline_elements.keys()
+            name: [] for name in lifeline_ids
         }
+        if call_tree.is_recursive:
+            return lifeline_occurrences
 
-        # Track message index for sequencing
-        message_index = 0
-
-        def traverse(node: CallTreeNode, depth: int):
-            nonlocal message_index
-
-            if node.is_recursive:
-                return
-
-            # Determine source participant
-            source_name = self._get_participant_name(node.function_info)
-
-            # Process each child call
-            for child in node.children:
-                if child.is_recursive:
-                    continue
-
-                # Determine target participant
-                target_name = self._get_participant_name(child.function_info)
-
-                # Generate message ID
-                message_id = self._generate_id()
-
-                # Create message occurrence specifications
-                source_occ_id = f"{message_id}_source_MessageOccurrenceSpecification"
-                target_occ_id = f"{message_id}_target_MessageOccurrenceSpecification"
-
-                # Create source occurrence
-                source_occ = SubElement(interaction, "fragment")
-                source_occ.set(
-                    f"{{{self.XMI_NAMESPACE}}}type",
-                    "uml:MessageOccurrenceSpecification",
-                )
-                source_occ.set(f"{{{self.XMI_NAMESPACE}}}id", source_occ_id)
-                source_occ.set(
-                    "covered",
-                    lifeline_elements[source_name].get(f"{{{self.XMI_NAMESPACE}}}id"),
-                )
-                source_occ.set(
-                    "enclosingInteraction",
-                    interaction.get(f"{{{self.XMI_NAMESPACE}}}id"),
-                )
-                source_occ.set("message", message_id)
+        # Participant and escaped name and signature of every called function
+        labels: Dict[int, Tuple[str, str, str]] = {}
 
-                # Create target occurrence
-                target_occ = SubElement(interaction, "fragment")
-                target_occ.set(
-                    f"{{{self.XMI_NAMESPACE}}}type",
-                    "uml:MessageOccurrenceSpecification",
-                )
-                target_occ.set(f"{{{self.XMI_NAMESPACE}}}id", target_occ_id)
-                target_occ.set(
-                    "covered",
-                    lifeline_elements[target_name].get(f"{{{self.XMI_NAMESPACE}}}id"),
-                )
-                target_occ.set(
-                    "enclosingInteraction",
-                    interaction.get(f"{{{self.XMI_NAMESPACE}}}id"),
-                )
-                target_occ.set("message", message_id)
-
-                # Track occurrences for coveredBy update
-                lifeline_occurrences[source_name].append(source_occ_id)
-                lifeline_occurrences[target_name].append(target_occ_id)
-
-                # Create message element
-                message = SubElement(interaction, "message")
-                message.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Message")
-                message.set(f"{{{self.XMI_NAMESPACE}}}id", message_id)
-                message.set("name", child.function_info.name)
-                message.set("receiveEvent", target_occ_id)
-                message.set("sendEvent", source_occ_id)
-                message.set(
-                    "interaction", interaction.get(f"{{{self.XMI_NAMESPACE}}}id")
+        # Stack of (source participant, parent message ID, remaining children)
+        stack = [
+            (
+                self._get_participant_name(call_tree.function_info),
+                "",
+                iter(enumerate(call_tree.children)),
+            )
+        ]
+        while stack:
+            source_name, parent_id, children = stack[-1]
+            for index, child in children:
+                if not child.is_recursive:
+                    break
+            else:
+                stack.pop()
+                continue
+
+            function_info = child.function_info
+            label = labels.get(id(function_info))
+            if label is None:
+                label = labels[id(function_info)] = (
+                    self._get_participant_name(function_info),
+                    _escape_attribute(function_info.name),
+                    _escape_attribute(self._format_message_signature(function_info)),
                 )
-                message.set("messageSort", "synchCall")
-
-                # Add signature if available
-                signature = self._format_message_signature(child.function_info)
-                if signature:
-                    message.set("signature", signature)
-
-                message_index += 1
-
-                # Handle conditional blocks (opt/loop/alt)
-                if child.is_optional or child.is_loop:
-                    self._create_combined_fragment(
-                        interaction, child, message, message_index, lifeline_elements
+            target_name, message_name, signature = label
+
+            # The key of a message is its path in the call tree
+            message_id = self._generate_id(f"{parent_id}/{index}/{message_name}")
+            source_occ_id = f"{message_id}_source_MessageOccurrenceSpecification"
+            target_occ_id = f"{message_id}_target_MessageOccurrenceSpecification"
+
+            # Create source and target occurrences
+            for occ_id, name in (
+                (source_occ_id, source_name),
+                (target_occ_id, target_name),
+            ):
+                out.write(
+                    _empty_element(
+                        "fragment",
+                        [
+                            ("xmi:type", "uml:MessageOccurrenceSpecification"),
+                            ("xmi:id", occ_id),
+                            ("covered", lifeline_ids[name]),
+                            ("enclosingInteraction", interaction_id),
+                            ("message", message_id),
+                        ],
                     )
-                    message_index += 1
-
-                # Recursively process children
-                traverse(child, depth + 1)
+                )
+                out.write("\n")
+                lifeline_occurrences[name].append(occ_id)
+
+            # Create message element
+            attributes = [
+                ("xmi:type", "uml:Message"),
+                ("xmi:id", message_id),
+                ("name", message_name),
+                ("receiveEvent", target_occ_id),
+                ("sendEvent", source_occ_id),
+                ("interaction", interaction_id),
+                ("messageSort", "synchCall"),
+            ]
+            # Add signature if available
+            if signature:
+                attributes.append(("signature", signature))
+            message = _empty_element("message", attributes)
+
+            # Handle conditional blocks (opt/loop/alt)
+            if child.is_optional or child.is_loop:
+                self._write_combined_fragment(out, child, message, message_id)
+            else:
+                out.write(message)
+                out.write("\n")
 
-        traverse(call_tree, 0)
+            # Process the children of the call before its siblings
+            stack.append((target_name, message_id, iter(enumerate(child.children))))
 
-        # Update coveredBy attributes on lifelines
-        for name, occurrences in lifeline_occurrences.items():
-            if name in lifeline_elements and occurrences:
-                lifeline_elements[name].set("coveredBy", " ".join(occurrences))
+        return lifeline_occurrences
 
     def _get_participant_name(self, function_info: FunctionInfo) -> str:
         """
@@ -558,23 +675,17 @@ class RhapsodyXmiGenerator:
         params = ", ".join(p.name for p in function_info.parameters)
         return f"{function_info.name}({params})"
 
-    def _create_combined_fragment(
-        self,
-        interaction: Element,
-        node: CallTreeNode,
-        message: Element,
-        index: int,
-        lifeline_elements: Dict[str, Element],
+    def _write_combined_fragment(
+        self, out: IO[str], node: CallTreeNode, message: str, message_id: str
     ) -> None:
         """
-        Create combined fragment for conditional or loop blocks.
+        Write a combined fragment for a conditional or loop call.
 
         Args:
-            interaction: Interaction element
+            out: Text stream to write the fragment to
             node: Call tree node with conditional/loop flag
-            message: Message element to wrap
-            index: Message index
-            lifeline_elements: Dictionary of lifeline elements
+            message: Serialized message element to wrap
+            message_id: ID of the message
         """
         # Determine operator
         if node.is_loop:
@@ -584,20 +695,24 @@ class RhapsodyXmiGenerator:
             operator = "opt"
             condition = node.condition or "condition"
 
-        # Create combined fragment
-        fragment = SubElement(interaction, "fragment")
-        fragment.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:CombinedFragment")
-        fragment.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
-        fragment.set("interactionOperator", operator)
-
-        # Create operand
-        operand = SubElement(fragment, "operand")
-        operand.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
-        operand.set("name", condition)
-
-        # Add message to operand (reparent from interaction)
-        interaction.remove(message)
-        operand.append(message)
+        fragment = _empty_element(
+            "fragment",
+            [
+                ("xmi:type", "uml:CombinedFragment"),
+                ("xmi:id", self._generate_id(f"{message_id}/Fragment")),
+                ("interactionOperator", operator),
+            ],
+        )
+        operand = _empty_element(
+            "operand",
+            [
+                ("xmi:id", self._generate_id(f"{message_id}/Operand")),
+                ("name", _escape_attribute(condition)),
+            ],
+        )
+        # The message is the only content of the operand
+        out.write(f"{fragment[:-2]}>\n  {operand[:-2]}>\n    {message}\n")
+        out.write("  </operand>\n</fragment>\n")
 
     def _add_element_imports(self, model: Element) -> None:
         """
@@ -616,7 +731,10 @@ class RhapsodyXmiGenerator:
         for elem_id, name in imports:
             elem_import = SubElement(model, "elementImport")
             elem_import.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:ElementImport")
-            elem_import.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+            elem_import.set(
+                f"{{{self.XMI_NAMESPACE}}}id",
+                self._generate_id(f"ElementImport/{name}"),
+            )
             elem_import.set("importedElement", elem_id)
             elem_import.set(
                 "importingNamespace", model.get(f"{{{self.XMI_NAMESPACE}}}id")
@@ -680,7 +798,7 @@ class RhapsodyXmiGenerator:
         # Add tool comment
         comment = SubElement(model, "ownedComment")
         comment.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Comment")
-        comment.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+        comment.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id("Comment/Tool"))
 
         body = SubElement(comment, "body")
         body.text = (
@@ -689,11 +807,19 @@ class RhapsodyXmiGenerator:
             f"Analysis: {result.root_function}\n"
             f"Depth: {result.statistics.max_depth_reached}"
         )
+        # SWR_MERMAID_00008: Truncation Annotation
+        if result.truncation is not None:
+            body.text += f"\nTruncated: {result.truncation.describe()}"
+        # SWR_MERMAID_00009: Output Fingerprint
+        if result.fingerprint is not None:
+            body.text += f"\nFingerprint: {result.fingerprint}"
 
         # Add Rhapsody settings comment
         settings = SubElement(model, "ownedComment")
         settings.set(f"{{{self.XMI_NAMESPACE}}}type", "uml:Comment")
-        settings.set(f"{{{self.XMI_NAMESPACE}}}id", self._generate_id())
+        settings.set(
+            f"{{{self.XMI_NAMESPACE}}}id", self._generate_id("Comment/Settings")
+        )
 
         settings_body = SubElement(settings, "body")
         settings_body.text = (
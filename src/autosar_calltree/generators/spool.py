@@ -0,0 +1,33 @@
+"""
+Spooled text buffers shared by the generators.
+
+Sections that are written before the text around them is known (the
+diagram and text tree of a Mermaid document, the message section of a
+Rhapsody XMI file) are buffered in memory and move to a temporary file
+when they grow large, so huge call trees do not have to fit in memory.
+
+Requirements:
+- SWR_MERMAID_00007: Streaming Document Generation
+- SWR_GEN_00026: Streaming XMI Generation
+"""
+
+import tempfile
+from typing import IO
+
+# Spooled sections are kept in memory up to this many characters
+SPOOL_MAX_SIZE = 4 * 1024 * 1024
+
+
+def spool() -> IO[str]:
+    """
+    Create a text buffer that moves to a temporary file when large.
+
+    Implements: SWR_MERMAID_00007 (Streaming Document Generation),
+    SWR_GEN_00026 (Streaming XMI Generation)
+
+    Returns:
+        Text file object, read back after seek(0)
+    """
+    return tempfile.SpooledTemporaryFile(  # type: ignore[return-value]
+        max_size=SPOOL_MAX_SIZE, mode="w+", encoding="utf-8", newline=""
+    )
@@ -0,0 +1,793 @@
+/*
+ * Native accelerator for the lexical hot loops of the parsers.
+ *
+ * Every function here reimplements a pure-Python loop of source_scanner.py
+ * or c_parser.py character by character and returns exactly what the
+ * Python version returns. The content is read in place from the internal
+ * buffer of the str object (1, 2 or 4 bytes per character), so no encoded
+ * or sliced copy of a file is made and all offsets are str offsets.
+ *
+ * The module is optional: when it is not built, the Python implementations
+ * are used.
+ *
+ * Requirements:
+ * - SWR_PARSER_00050: Native Lexer Accelerator
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+/* Characters of a str object, read in place */
+typedef struct {
+    int kind;
+    const void *data;
+    Py_ssize_t length;
+} Text;
+
+#define CH(text, i) PyUnicode_READ((text)->kind, (text)->data, (i))
+
+static int
+text_init(Text *text, PyObject *content)
+{
+    if (!PyUnicode_Check(content)) {
+        PyErr_SetString(PyExc_TypeError, "content must be str");
+        return -1;
+    }
+#if PY_VERSION_HEX < 0x030C0000
+    if (PyUnicode_READY(content) < 0) {
+        return -1;
+    }
+#endif
+    text->kind = PyUnicode_KIND(content);
+    text->data = PyUnicode_DATA(content);
+    text->length = PyUnicode_GET_LENGTH(content);
+    return 0;
+}
+
+/* \w of str patterns */
+static int
+is_word(Py_UCS4 c)
+{
+    return c == '_' || Py_UNICODE_ISALNUM(c);
+}
+
+/* [A-Za-z_] */
+static int
+is_identifier_start(Py_UCS4 c)
+{
+    return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/* [a-zA-Z0-9_] */
+static int
+is_ascii_word(Py_UCS4 c)
+{
+    return is_identifier_start(c) || (c >= '0' && c <= '9');
+}
+
+/* Whether [start, end) equals an ASCII word */
+static int
+equals_ascii(const Text *text, Py_ssize_t start, Py_ssize_t end, const char *word)
+{
+    for (; start < end && *word; start++, word++) {
+        if (CH(text, start) != (Py_UCS4)(unsigned char)*word) {
+            return 0;
+        }
+    }
+    return start == end && *word == '\0';
+}
+
+/* ^ of MULTILINE patterns */
+static int
+at_line_start(const Text *text, Py_ssize_t i)
+{
+    return i == 0 || CH(text, i - 1) == '\n';
+}
+
+/*
+ * "(?:[^"\\\n]|\\.)*" and the char literal form.
+ * Returns the end of the literal, or -1 if it is not closed on its line.
+ */
+static Py_ssize_t
+match_quoted(const Text *text, Py_ssize_t i, Py_ssize_t end)
+{
+    Py_UCS4 quote = CH(text, i);
+    for (i++; i < end; i++) {
+        Py_UCS4 c = CH(text, i);
+        if (c == quote) {
+            return i + 1;
+        }
+        if (c == '\\') {
+            if (i + 1 >= end) {
+                return -1;
+            }
+            i++;
+        }
+        else if (c == '\n') {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+/*
+ * /\*.*?(?:\*\/|\Z) and //[^\n]* at a '/'.
+ * Returns the end of the comment, or -1 if there is none.
+ */
+static Py_ssize_t
+match_comment(const Text *text, Py_ssize_t i, Py_ssize_t end)
+{
+    Py_UCS4 next;
+    if (i + 1 >= end) {
+        return -1;
+    }
+    next = CH(text, i + 1);
+    if (next == '*') {
+        for (i += 2; i + 1 < end; i++) {
+            if (CH(text, i) == '*' && CH(text, i + 1) == '/') {
+                return i + 2;
+            }
+        }
+        return end;
+    }
+    if (next == '/') {
+        for (i += 2; i < end && CH(text, i) != '\n'; i++) {
+        }
+        return i;
+    }
+    return -1;
+}
+
+/*
+ * ^[ \t]*#(?:[^\n\\]|\\.)* at a line start.
+ * Returns the end of the directive, or -1 if the line is no directive.
+ */
+static Py_ssize_t
+match_directive(const Text *text, Py_ssize_t i, Py_ssize_t end)
+{
+    while (i < end && (CH(text, i) == ' ' || CH(text, i) == '\t')) {
+        i++;
+    }
+    if (i >= end || CH(text, i) != '#') {
+        return -1;
+    }
+    for (i++; i < end; i++) {
+        Py_UCS4 c = CH(text, i);
+        if (c == '\n') {
+            break;
+        }
+        if (c == '\\') {
+            if (i + 1 >= end) {
+                break;
+            }
+            i++;
+        }
+    }
+    return i;
+}
+
+/*
+ * Skip a literal or comment at i (SRE order: string, char, comments).
+ * Returns its end, or -1 if there is none at i.
+ */
+static Py_ssize_t
+match_literal_or_comment(const Text *text, Py_ssize_t i, Py_ssize_t end)
+{
+    Py_UCS4 c = CH(text, i);
+    if (c == '"' || c == '\'') {
+        return match_quoted(text, i, end);
+    }
+    if (c == '/') {
+        return match_comment(text, i, end);
+    }
+    return -1;
+}
+
+/* Skip a literal, comment or directive at i; -1 if there is none */
+static Py_ssize_t
+match_noise(const Text *text, Py_ssize_t i, Py_ssize_t end)
+{
+    Py_UCS4 c = CH(text, i);
+    Py_ssize_t j = match_literal_or_comment(text, i, end);
+    if (j < 0 && (c == ' ' || c == '\t' || c == '#') && at_line_start(text, i)) {
+        j = match_directive(text, i, end);
+    }
+    return j;
+}
+
+/* Python: source_scanner._skip_block() */
+static Py_ssize_t
+skip_block(const Text *text, Py_ssize_t i)
+{
+    Py_ssize_t depth = 1;
+    Py_ssize_t end = text->length;
+    while (i < end) {
+        Py_UCS4 c = CH(text, i);
+        Py_ssize_t j = match_noise(text, i, end);
+        if (j >= 0) {
+            i = j;
+            continue;
+        }
+        if (c == '{') {
+            depth++;
+        }
+        else if (c == '}') {
+            depth--;
+            if (depth == 0) {
+                return i + 1;
+            }
+        }
+        i++;
+    }
+    return end;
+}
+
+static int
+append_ssize(PyObject *list, Py_ssize_t value)
+{
+    PyObject *item = PyLong_FromSsize_t(value);
+    int result;
+    if (item == NULL) {
+        return -1;
+    }
+    result = PyList_Append(list, item);
+    Py_DECREF(item);
+    return result;
+}
+
+PyDoc_STRVAR(scan_braces_doc,
+"scan_braces(content) -> (line_offsets, brace_spans)\n\n"
+"Line offsets and matched braces of SourceScanner.");
+
+static PyObject *
+scan_braces(PyObject *module, PyObject *content)
+{
+    Text text;
+    PyObject *line_offsets = NULL;
+    PyObject *brace_spans = NULL;
+    Py_ssize_t *open_braces = NULL;
+    Py_ssize_t open_count = 0;
+    Py_ssize_t capacity = 64;
+    Py_ssize_t i;
+
+    (void)module;
+
+    if (text_init(&text, content) < 0) {
+        return NULL;
+    }
+    line_offsets = PyList_New(0);
+    brace_spans = PyDict_New();
+    open_braces = PyMem_New(Py_ssize_t, capacity);
+    if (line_offsets == NULL || brace_spans == NULL || open_braces == NULL) {
+        PyErr_NoMemory();
+        goto error;
+    }
+    if (append_ssize(line_offsets, 0) < 0) {
+        goto error;
+    }
+    for (i = 0; i < text.length; i++) {
+        if (CH(&text, i) == '\n' && append_ssize(line_offsets, i + 1) < 0) {
+            goto error;
+        }
+    }
+
+    i = 0;
+    while (i < text.length) {
+        Py_UCS4 c = CH(&text, i);
+        Py_ssize_t j = match_literal_or_comment(&text, i, text.length);
+        if (j >= 0) {
+            i = j;
+            continue;
+        }
+        if (c == '{') {
+            if (open_count == capacity) {
+                Py_ssize_t *grown = PyMem_Realloc(
+                    open_braces, sizeof(Py_ssize_t) * capacity * 2
+                );
+                if (grown == NULL) {
+                    PyErr_NoMemory();
+                    goto error;
+                }
+                open_braces = grown;
+                capacity *= 2;
+            }
+            open_braces[open_count++] = i;
+        }
+        else if (c == '}' && open_count > 0) {
+            PyObject *key = PyLong_FromSsize_t(open_braces[--open_count]);
+            PyObject *value = PyLong_FromSsize_t(i + 1);
+            int result = -1;
+            if (key != NULL && value != NULL) {
+                result = PyDict_SetItem(brace_spans, key, value);
+            }
+            Py_XDECREF(key);
+            Py_XDECREF(value);
+            if (result < 0) {
+                goto error;
+            }
+        }
+        i++;
+    }
+
+    PyMem_Free(open_braces);
+    return Py_BuildValue("(NN)", line_offsets, brace_spans);
+
+error:
+    PyMem_Free(open_braces);
+    Py_XDECREF(line_offsets);
+    Py_XDECREF(brace_spans);
+    return NULL;
+}
+
+PyDoc_STRVAR(function_definitions_doc,
+"function_definitions(content) -> list\n\n"
+"(name, decl_start, name_start, params_start, params_end, body_start,\n"
+"body_end) of every definition, as iter_function_definitions() yields.");
+
+static PyObject *
+function_definitions(PyObject *module, PyObject *content)
+{
+    Text text;
+    PyObject *definitions;
+    /* Identifier before the open "(", or none */
+    Py_ssize_t candidate_start = -1, candidate_end = -1;
+    /* Candidate whose parameter list closed */
+    int defined = 0;
+    Py_ssize_t name_start = 0, name_end = 0;
+    Py_ssize_t params_start = 0, params_end = 0;
+    Py_ssize_t decl_start = 0;
+    /* Previous token: none, identifier or punctuation */
+    int previous_identifier = 0;
+    int previous_extern = 0;
+    Py_ssize_t previous_start = 0, previous_end = 0;
+    Py_ssize_t paren_depth = 0;
+    Py_ssize_t i = 0;
+
+    (void)module;
+
+    if (text_init(&text, content) < 0) {
+        return NULL;
+    }
+    definitions = PyList_New(0);
+    if (definitions == NULL) {
+        return NULL;
+    }
+
+    while (i < text.length) {
+        Py_UCS4 c = CH(&text, i);
+        Py_ssize_t token_start = i;
+        Py_ssize_t j = match_literal_or_comment(&text, i, text.length);
+        if (j >= 0) {
+            i = j;
+            continue;
+        }
+        if ((c == ' ' || c == '\t' || c == '#') && at_line_start(&text, i)) {
+            j = match_directive(&text, i, text.length);
+            if (j >= 0) {
+                i = j;
+                if (paren_depth == 0 && !defined) {
+                    decl_start = i;
+                }
+                continue;
+            }
+        }
+
+        if (is_identifier_start(c)) {
+            for (i++; i < text.length && is_word(CH(&text, i)); i++) {
+            }
+            if (paren_depth == 0) {
+                defined = 0;
+            }
+            previous_identifier = 1;
+            previous_extern = equals_ascii(&text, token_start, i, "extern");
+            previous_start = token_start;
+            previous_end = i;
+            continue;
+        }
+
+        i++;
+        if (c == '(') {
+            if (paren_depth == 0) {
+                if (previous_identifier) {
+                    candidate_start = previous_start;
+                    candidate_end = previous_end;
+                }
+                else {
+                    candidate_start = -1;
+                }
+                params_start = token_start;
+                defined = 0;
+            }
+            paren_depth++;
+        }
+        else if (c == ')') {
+            if (paren_depth > 0) {
+                paren_depth--;
+                if (paren_depth == 0) {
+                    defined = candidate_start >= 0;
+                    name_start = candidate_start;
+                    name_end = candidate_end;
+                    params_end = i;
+                }
+            }
+        }
+        else if (c == '{') {
+            Py_ssize_t body_start = token_start;
+            /* The block of extern "C" { ... } is still file scope */
+            if (!previous_extern) {
+                i = skip_block(&text, i);
+            }
+            if (paren_depth == 0 && defined) {
+                PyObject *name = PyUnicode_Substring(content, name_start, name_end);
+                PyObject *item;
+                int result;
+                if (name == NULL) {
+                    goto error;
+                }
+                item = Py_BuildValue(
+                    "(Nnnnnnn)", name, decl_start, name_start, params_start,
+                    params_end, body_start, i
+                );
+                if (item == NULL) {
+                    goto error;
+                }
+                result = PyList_Append(definitions, item);
+                Py_DECREF(item);
+                if (result < 0) {
+                    goto error;
+                }
+            }
+            defined = 0;
+            candidate_start = -1;
+            decl_start = i;
+        }
+        else if (c == '}' || c == ';' || c == '=' || c == ',') {
+            if (paren_depth == 0) {
+                defined = 0;
+                decl_start = i;
+            }
+        }
+        else {
+            /* Not a token */
+            continue;
+        }
+        previous_identifier = 0;
+        previous_extern = 0;
+    }
+    return definitions;
+
+error:
+    Py_DECREF(definitions);
+    return NULL;
+}
+
+/*
+ * Append a call name found at [start, end) unless it was seen or is
+ * excluded. Returns -1 on error.
+ */
+static int
+add_call(PyObject *content, Py_ssize_t start, Py_ssize_t end,
+         PyObject *excluded, PyObject *seen, PyObject *calls)
+{
+    PyObject *name = PyUnicode_Substring(content, start, end);
+    int found;
+    if (name == NULL) {
+        return -1;
+    }
+    found = PySet_Contains(seen, name);
+    if (found == 0) {
+        found = PySequence_Contains(excluded, name);
+    }
+    if (found == 0) {
+        if (PySet_Add(seen, name) < 0 || PyList_Append(calls, name) < 0) {
+            found = -1;
+        }
+    }
+    Py_DECREF(name);
+    return found < 0 ? -1 : 0;
+}
+
+/* Clamp start and end like the pos and endpos of re.finditer() */
+static void
+clamp_span(const Text *text, Py_ssize_t *start, Py_ssize_t *end)
+{
+    if (*end > text->length) {
+        *end = text->length;
+    }
+    if (*end < 0) {
+        *end = 0;
+    }
+    if (*start < 0) {
+        *start = 0;
+    }
+}
+
+/* Skip \s* and match "(" at i; returns the end of the match or -1 */
+static Py_ssize_t
+match_open_paren(const Text *text, Py_ssize_t i, Py_ssize_t end)
+{
+    while (i < end && Py_UNICODE_ISSPACE(CH(text, i))) {
+        i++;
+    }
+    if (i < end && CH(text, i) == '(') {
+        return i + 1;
+    }
+    return -1;
+}
+
+PyDoc_STRVAR(find_calls_doc,
+"find_calls(content, start, end, excluded) -> list\n\n"
+"Names of _CALL_PATTERN matches in content[start:end], once each in order\n"
+"of appearance, without the names in excluded.");
+
+static PyObject *
+find_calls(PyObject *module, PyObject *args)
+{
+    PyObject *content, *excluded, *seen, *calls;
+    Py_ssize_t start, end, i;
+    Text text;
+
+    (void)module;
+
+    if (!PyArg_ParseTuple(args, "UnnO:find_calls", &content, &start, &end,
+                          &excluded)) {
+        return NULL;
+    }
+    if (text_init(&text, content) < 0) {
+        return NULL;
+    }
+    clamp_span(&text, &start, &end);
+    seen = PySet_New(NULL);
+    calls = PyList_New(0);
+    if (seen == NULL || calls == NULL) {
+        goto error;
+    }
+
+    /* \b([a-zA-Z_][a-zA-Z0-9_]*)\s*\( */
+    i = start;
+    while (i < end) {
+        Py_ssize_t j, k;
+        if (!is_identifier_start(CH(&text, i))
+            || (i > 0 && is_word(CH(&text, i - 1)))) {
+            i++;
+            continue;
+        }
+        for (j = i + 1; j < end && is_ascii_word(CH(&text, j)); j++) {
+        }
+        k = match_open_paren(&text, j, end);
+        if (k < 0) {
+            i++;
+            continue;
+        }
+        if (add_call(content, i, j, excluded, seen, calls) < 0) {
+            goto error;
+        }
+        i = k;
+    }
+    Py_DECREF(seen);
+    return calls;
+
+error:
+    Py_XDECREF(seen);
+    Py_XDECREF(calls);
+    return NULL;
+}
+
+PyDoc_STRVAR(find_body_calls_doc,
+"find_body_calls(content, start, end, excluded) -> list\n\n"
+"Names of _BODY_CALL_PATTERN call matches in content[start:end], once\n"
+"each in order of appearance, without the names in excluded.");
+
+static PyObject *
+find_body_calls(PyObject *module, PyObject *args)
+{
+    PyObject *content, *excluded, *seen, *calls;
+    Py_ssize_t start, end, i;
+    Text text;
+
+    (void)module;
+
+    if (!PyArg_ParseTuple(args, "UnnO:find_body_calls", &content, &start, &end,
+                          &excluded)) {
+        return NULL;
+    }
+    if (text_init(&text, content) < 0) {
+        return NULL;
+    }
+    clamp_span(&text, &start, &end);
+    seen = PySet_New(NULL);
+    calls = PyList_New(0);
+    if (seen == NULL || calls == NULL) {
+        goto error;
+    }
+
+    /* Literals, comments and directives, or (?<!->)(?<![\w.])([A-Za-z_]\w*)\s*\( */
+    i = start;
+    while (i < end) {
+        Py_UCS4 c = CH(&text, i);
+        Py_ssize_t j = match_noise(&text, i, end), k;
+        if (j >= 0) {
+            i = j;
+            continue;
+        }
+        if (!is_identifier_start(c)
+            || (i > 0 && (is_word(CH(&text, i - 1)) || CH(&text, i - 1) == '.'))
+            || (i > 1 && CH(&text, i - 2) == '-' && CH(&text, i - 1) == '>')) {
+            i++;
+            continue;
+        }
+        for (j = i + 1; j < end && is_word(CH(&text, j)); j++) {
+        }
+        k = match_open_paren(&text, j, end);
+        if (k < 0) {
+            i++;
+            continue;
+        }
+        if (add_call(content, i, j, excluded, seen, calls) < 0) {
+            goto error;
+        }
+        i = k;
+    }
+    Py_DECREF(seen);
+    return calls;
+
+error:
+    Py_XDECREF(seen);
+    Py_XDECREF(calls);
+    return NULL;
+}
+
+/* Whether [start, end) starts with an AUTOSAR FUNC(_P2\w+)?\s*\( macro */
+static int
+starts_with_func_macro(const Text *text, Py_ssize_t start, Py_ssize_t end)
+{
+    Py_ssize_t i;
+    if (end - start < 4 || CH(text, start) != 'F' || CH(text, start + 1) != 'U'
+        || CH(text, start + 2) != 'N' || CH(text, start + 3) != 'C') {
+        return 0;
+    }
+    i = start + 4;
+    if (i + 3 < end && CH(text, i) == '_' && CH(text, i + 1) == 'P'
+        && CH(text, i + 2) == '2' && is_word(CH(text, i + 3))) {
+        Py_ssize_t j;
+        for (j = i + 4; j < end && is_word(CH(text, j)); j++) {
+        }
+        if (match_open_paren(text, j, end) >= 0) {
+            return 1;
+        }
+    }
+    return match_open_paren(text, i, end) >= 0;
+}
+
+/* Offset of c in [start, end), or -1 */
+static Py_ssize_t
+find_char(const Text *text, Py_ssize_t start, Py_ssize_t end, Py_UCS4 c)
+{
+    for (; start < end; start++) {
+        if (CH(text, start) == c) {
+            return start;
+        }
+    }
+    return -1;
+}
+
+static int
+append_substring(PyObject *list, PyObject *content, Py_ssize_t start,
+                 Py_ssize_t end)
+{
+    PyObject *piece = PyUnicode_Substring(content, start, end);
+    int result;
+    if (piece == NULL) {
+        return -1;
+    }
+    result = PyList_Append(list, piece);
+    Py_DECREF(piece);
+    return result;
+}
+
+PyDoc_STRVAR(remove_autosar_functions_doc,
+"remove_autosar_functions(content) -> str\n\n"
+"CParser._remove_autosar_functions() without splitting the content.");
+
+static PyObject *
+remove_autosar_functions(PyObject *module, PyObject *content)
+{
+    Text text;
+    PyObject *lines, *separator, *result;
+    Py_ssize_t line_start = 0;
+    int in_autosar_func = 0;
+
+    (void)module;
+
+    if (text_init(&text, content) < 0) {
+        return NULL;
+    }
+    lines = PyList_New(0);
+    if (lines == NULL) {
+        return NULL;
+    }
+
+    while (line_start <= text.length) {
+        Py_ssize_t line_end = find_char(&text, line_start, text.length, '\n');
+        Py_ssize_t first, last;
+        int keeps_line = 0;
+        if (line_end < 0) {
+            line_end = text.length;
+        }
+        /* line.strip() */
+        first = line_start;
+        last = line_end;
+        while (first < last && Py_UNICODE_ISSPACE(CH(&text, first))) {
+            first++;
+        }
+        while (last > first && Py_UNICODE_ISSPACE(CH(&text, last - 1))) {
+            last--;
+        }
+
+        if (in_autosar_func || starts_with_func_macro(&text, first, last)) {
+            Py_ssize_t brace = find_char(&text, first, last, '{');
+            if (brace >= 0 || find_char(&text, first, last, ';') >= 0) {
+                in_autosar_func = 0;
+                /* Keep the body (everything after {) */
+                if (brace >= 0
+                    && append_substring(lines, content, brace, last) < 0) {
+                    goto error;
+                }
+            }
+            else {
+                /* Multi-line declaration (start) */
+                in_autosar_func = 1;
+            }
+        }
+        else {
+            keeps_line = 1;
+        }
+        if (keeps_line
+            && append_substring(lines, content, line_start, line_end) < 0) {
+            goto error;
+        }
+        line_start = line_end + 1;
+    }
+
+    separator = PyUnicode_FromString("\n");
+    if (separator == NULL) {
+        goto error;
+    }
+    result = PyUnicode_Join(separator, lines);
+    Py_DECREF(separator);
+    Py_DECREF(lines);
+    return result;
+
+error:
+    Py_DECREF(lines);
+    return NULL;
+}
+
+static PyMethodDef lexer_methods[] = {
+    {"scan_braces", scan_braces, METH_O, scan_braces_doc},
+    {"function_definitions", function_definitions, METH_O,
+     function_definitions_doc},
+    {"find_calls", find_calls, METH_VARARGS, find_calls_doc},
+    {"find_body_calls", find_body_calls, METH_VARARGS, find_body_calls_doc},
+    {"remove_autosar_functions", remove_autosar_functions, METH_O,
+     remove_autosar_functions_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef lexer_module = {
+    PyModuleDef_HEAD_INIT,
+    "_lexer",
+    "Native accelerator for the lexical loops of the parsers.",
+    -1,
+    lexer_methods,
+    NULL, /* m_slots */
+    NULL, /* m_traverse */
+    NULL, /* m_clear */
+    NULL, /* m_free */
+};
+
+PyMODINIT_FUNC
+PyInit__lexer(void)
+{
+    return PyModule_Create(&lexer_module);
+}
@@ -10,45 +10,222 @@ Example usage:
 
     parser = CParser(preprocessor_config=PreprocessorConfig())
     functions = parser.parse_file(Path("example.c"))
+
+Requirements:
+- SWR_PARSER_00041: Multi-process parsing with picklable results
+- SWR_PARSER_00042: Single-pass body extraction
+- SWR_PARSER_00043: Single-pass AUTOSAR macro lowering
+- SWR_PARSER_00044: Reused parser state across files
+- SWR_PARSER_00045: Shared header skipping in preprocessed files
+- SWR_PARSER_00046: Fused streaming preprocess and parse
+- SWR_PARSER_00047: Per-file parse step timings
+- SWR_PARSER_00049: Lexical parse path
+- SWR_PARSER_00050: Native lexer accelerator
 """
 
+import bisect
 import re
 import subprocess
+import time
+from concurrent.futures import ProcessPoolExecutor
+from concurrent.futures.process import BrokenProcessPool
 from dataclasses import dataclass, field
 from pathlib import Path
-from typing import Dict, List, Optional
+from typing import Any, Dict, FrozenSet, Iterable, List, Optional, Set, Tuple
 
-from pycparser import c_parser
+from pycparser import c_ast, c_parser
 
 from ..config import PreprocessorConfig
 from ..database.models import FunctionCall, FunctionInfo, FunctionType
+from ..preprocessing.cpp_preprocessor import (
+    LINE_MARKER_PATTERN,
+    CPPPreprocessor,
+    PreprocessResult,
+    PreprocessStatistics,
+    SharedIncludePrefix,
+    resolve_marker_path,
+)
+from ..utils.statistics import ProcessingResult, ProcessingStatistics
+from .autosar_parser import AutosarParser
 from .function_visitor import FunctionVisitor
+from .source_scanner import SourceScanner, iter_function_definitions
+
+try:
+    from . import _lexer  # type: ignore[attr-defined]
+except ImportError:  # Optional: built from _lexer.c when a C compiler is found
+    _lexer = None
+
+# Typedefs for AUTOSAR platform types. They are not prepended to each file;
+# their names are declared up front in the scope of AutosarTypedefCParser.
+AUTOSAR_TYPEDEFS = """typedef unsigned char uint8;
+typedef unsigned short uint16;
+typedef unsigned int uint32;
+typedef unsigned long long uint64;
+typedef signed char sint8;
+typedef short sint16;
+typedef int sint32;
+typedef long long sint64;
+typedef unsigned char uchar;
+typedef unsigned short ushort;
+typedef unsigned int uint;
+typedef unsigned long ulong;
+"""
+
+# Bumped whenever parse results change for unchanged input, so cached
+# per-file entries of older versions are parsed again
+PARSE_RESULT_REVISION = 6
+
+AUTOSAR_TYPEDEF_NAMES = tuple(re.findall(r"(\w+);$", AUTOSAR_TYPEDEFS, re.MULTILINE))
+
+# Calls in AUTOSAR function bodies: identifier(
+_CALL_PATTERN = re.compile(r"\b([a-zA-Z_][a-zA-Z0-9_]*)\s*\(")
+
+# Calls in traditional function bodies on the lexical path. Literals,
+# comments and directives are matched first so nothing inside them counts;
+# member calls (s.f(), p->f()) are skipped like in FunctionVisitor.
+_BODY_CALL_PATTERN = re.compile(
+    r'"(?:[^"\\\n]|\\.)*"'
+    r"|'(?:[^'\\\n]|\\.)*'"
+    r"|/\*.*?(?:\*/|\Z)"
+    r"|//[^\n]*"
+    r"|^[ \t]*#(?:[^\n\\]|\\.)*"
+    r"|(?<!->)(?<![\w.])([A-Za-z_]\w*)\s*\(",
+    re.DOTALL | re.MULTILINE,
+)
+
+# Comments and directives in declaration text on the lexical path
+_DECLARATION_NOISE_PATTERN = re.compile(
+    r"/\*.*?(?:\*/|\Z)|//[^\n]*|^[ \t]*#[^\n]*", re.DOTALL | re.MULTILINE
+)
+
+# Identifiers and pointer stars of a declaration
+_DECLARATION_TOKEN_PATTERN = re.compile(r"[A-Za-z_]\w*|\*")
+
+# Line marker of cpp output with its line number: # 12 "file.c"
+_MARKER_LINE_PATTERN = re.compile(r'^#\s*(\d+)\s+"', re.MULTILINE)
+
+# Storage class and function specifiers, not part of the return type
+_STORAGE_SPECIFIERS = frozenset(
+    ("static", "extern", "inline", "__inline", "__inline__", "register", "auto")
+)
+
+# Parse path of a file (ParseResult.parse_path, SWR_PARSER_00049):
+# pycparser ran on it, or its definitions came from the lexical scanners only
+PARSE_PATH_PYCPARSER = "pycparser"
+PARSE_PATH_LEXICAL = "lexical"
+
+# One alternation over everything _preprocess_content() rewrites. String and
+# char literals are matched so that comments and macros inside them are kept;
+# the longer macro names come first so P2VAR is never lowered as VAR.
+_LOWERING_PATTERN = re.compile(
+    r'(?P<string>"(?:[^"\\]|\\.)*")'
+    r"|(?P<char>'(?:[^'\\]|\\.)*')"
+    r"|(?P<comment>(?s:/\*.*?\*/)|//[^\n]*)"
+    r"|\bFUNC_P2\w+\s*\(\s*(?P<func_p2>[^,]+)\s*,\s*[^,)]+(?:,\s*[^)]+)?\)\s*"
+    r"|\bFUNC\s*\(\s*(?P<func>[^,]+)\s*,\s*[^)]+\)\s*"
+    r"|\bP2VAR\s*\(\s*(?P<p2var>[^,]+)\s*,\s*[^,]+,\s*[^)]+\)"
+    r"|\bP2CONST\s*\(\s*(?P<p2const>[^,]+)\s*,\s*[^,]+,\s*[^)]+\)"
+    r"|\bVAR\s*\(\s*(?P<var>[^,]+)\s*,\s*[^)]+\)"
+    r"|\bCONST\s*\(\s*(?P<const>[^,]+)\s*,\s*[^)]+\)"
+    r"|(?P<directive>(?m:^#\s*(?:pragma|line|error|warning).*$))"
+)
+
+# Replacement per named group of _LOWERING_PATTERN ({} is the type argument)
+_LOWERING_TEMPLATES = {
+    "func_p2": "{}* ",
+    "func": "{} ",
+    "p2var": "{}*",
+    "p2const": "const {}*",
+    "var": "{}",
+    "const": "const {}",
+}
+
+
+class AutosarTypedefCParser(c_parser.CParser):
+    """
+    pycparser parser that knows the AUTOSAR typedef names in advance.
+
+    The typedef names are seeded into the file scope on every parse, which
+    has the same effect as prepending AUTOSAR_TYPEDEFS without lexing and
+    parsing those lines again for each file. Seeding uses the internals of
+    the PLY-based parser of pycparser 2.x; without them the typedefs are
+    prepended to the text instead.
+    """
+
+    def __init__(self) -> None:
+        """Build the pycparser tables once for this instance."""
+        super().__init__()
+        self._typedef_scope = dict.fromkeys(AUTOSAR_TYPEDEF_NAMES, True)
+
+    def parse(
+        self,
+        text: str,
+        filename: str = "",
+        debug: bool = False,
+        typedef_names: Iterable[str] = (),
+    ) -> Any:
+        """
+        Parse C code with the AUTOSAR typedef names in scope.
+
+        Mirrors pycparser's CParser.parse(), with a pre-filled file scope.
+        If the parser has no PLY internals, the public parse() is called
+        with the typedefs prepended on one line, followed by a line marker
+        so that line numbers refer to text.
+
+        Args:
+            text: C source code
+            filename: Name of the file being parsed (for error messages)
+            debug: Debug flag to YACC
+            typedef_names: Additional typedef names declared outside of text
+
+        Returns:
+            pycparser FileAST
+        """
+        if not (hasattr(self, "cparser") and hasattr(self, "clex")):
+            prelude = " ".join(AUTOSAR_TYPEDEFS.split())
+            prelude += "".join(f" typedef int {name};" for name in typedef_names)
+            marker = f'# 1 "{filename}"' if filename else "# 1"
+            return super().parse(f"{prelude}\n{marker}\n{text}", filename)
+
+        scope = dict(self._typedef_scope)
+        scope.update(dict.fromkeys(typedef_names, True))
+        self.clex.filename = filename
+        self.clex.reset_lineno()
+        self._scope_stack = [scope]
+        self._last_yielded_token = None
+        return self.cparser.parse(input=text, lexer=self.clex, debug=debug)
 
 
 @dataclass
-class ParseResult:
-    """Result of parsing a single file."""
+class ParseResult(ProcessingResult):
+    """
+    Result of parsing a single file.
+
+    timings holds the seconds of the steps "read", "autosar" (AUTOSAR
+    declaration scan), "lowering" (macro lowering), "scan" (lexical
+    definition scan), "pycparser" and "visitor" (SWR_PARSER_00047).
+    parse_path tells whether pycparser ran on the file (SWR_PARSER_00049).
+    """
 
-    source_file: Path
-    preprocessed_file: Optional[Path]
-    functions: List[FunctionInfo] = field(default_factory=list)
     success: bool = True
-    error_message: Optional[str] = None
+    preprocessed_file: Optional[Path] = None
+    functions: List[FunctionInfo] = field(default_factory=list)
     autosar_functions: int = 0
     traditional_functions: int = 0
+    parse_path: str = PARSE_PATH_LEXICAL
 
 
 @dataclass
-class ParseStatistics:
+class ParseStatistics(ProcessingStatistics):
     """Statistics for parsing stage."""
 
-    total_files: int = 0
-    successful: int = 0
-    failed: int = 0
     autosar_functions: int = 0
     traditional_functions: int = 0
     total_functions: int = 0
-    results: List[ParseResult] = field(default_factory=list)
+    # Successfully parsed files per parse path (SWR_PARSER_00049)
+    lexical_files: int = 0
+    pycparser_files: int = 0
+    results: List[ParseResult] = field(default_factory=list)  # type: ignore[assignment]
 
     @property
     def correctness_ratio(self) -> float:
@@ -58,6 +235,75 @@ class ParseStatistics:
         return (self.successful / self.total_files) * 100.0
 
 
+# Parser owned by the current worker process, created by _init_parse_worker
+_worker_parser: Optional["CParser"] = None
+
+# Preprocessor of a streaming worker process, set by _init_parse_worker
+_worker_preprocessor: Optional[CPPPreprocessor] = None
+
+
+def _init_parse_worker(
+    preprocessor_config: Optional[PreprocessorConfig],
+    shared_prefix: Optional[SharedIncludePrefix] = None,
+    preprocessor: Optional[CPPPreprocessor] = None,
+    full_parse: bool = True,
+) -> None:
+    """
+    Create the per-process CParser used by parse workers.
+
+    Each worker process gets its own pycparser instance so that parser
+    tables and state are never shared between processes.
+
+    Args:
+        preprocessor_config: PreprocessorConfig of the parent parser
+        shared_prefix: Shared include prefix already loaded by the parent
+        preprocessor: Preprocessor for streaming workers (runs cpp per file)
+        full_parse: full_parse setting of the parent parser
+    """
+    global _worker_parser, _worker_preprocessor
+    _worker_parser = CParser(
+        preprocessor_config=preprocessor_config, full_parse=full_parse
+    )
+    _worker_parser.shared_prefix = shared_prefix
+    _worker_preprocessor = preprocessor
+
+
+def _parse_task_in_worker(task: Tuple[Path, Optional[Path]]) -> ParseResult:
+    """
+    Parse one (source_file, preprocessed_file) task in a worker process.
+
+    Only the ParseResult (FunctionInfo/FunctionCall lists) is sent back to
+    the parent process; the pycparser AST stays in the worker.
+
+    Args:
+        task: Tuple of source file and optional preprocessed file
+
+    Returns:
+        ParseResult for the task
+    """
+    if _worker_parser is None:
+        _init_parse_worker(None)
+    assert _worker_parser is not None
+    source_file, preprocessed_file = task
+    return _worker_parser.parse_file_with_stats(source_file, preprocessed_file)
+
+
+def _stream_task_in_worker(
+    source_file: Path,
+) -> Tuple[PreprocessResult, ParseResult]:
+    """
+    Preprocess and parse one file in a streaming worker process.
+
+    Args:
+        source_file: Path to the source file
+
+    Returns:
+        Tuple of preprocessing and parsing result
+    """
+    assert _worker_parser is not None and _worker_preprocessor is not None
+    return _worker_parser.preprocess_and_parse(source_file, _worker_preprocessor)
+
+
 class CParser:
     """C parser using pycparser library."""
 
@@ -66,23 +312,149 @@ class CParser:
     AUTOSAR_MACROS = FunctionVisitor.AUTOSAR_MACROS
     AUTOSAR_TYPES = FunctionVisitor.AUTOSAR_TYPES
 
-    def __init__(self, preprocessor_config: Optional[PreprocessorConfig] = None):
+    def __init__(
+        self,
+        preprocessor_config: Optional[PreprocessorConfig] = None,
+        autosar_parser: Optional[AutosarParser] = None,
+        full_parse: bool = True,
+    ):
         """
         Initialize the pycparser-based C parser.
 
+        The pycparser instance and the AutosarParser are created once and
+        reused for every file, so parsing a file has no setup cost.
+
+        pycparser only runs on files in which the lexical definition scan
+        finds traditional C function definitions. With full_parse=False it
+        never runs: traditional definitions are taken from the scan as
+        well, with types read from the declaration text and calls found
+        lexically. Files then parse much faster, but the results are not
+        checked by a C grammar and leave no room for call context tracking
+        (conditions, loops) on an AST.
+
+        Implements: SWR_PARSER_00044 (Reused Parser State Across Files),
+        SWR_PARSER_00049 (Lexical Parse Path)
+
         Args:
             preprocessor_config: Optional PreprocessorConfig for cpp settings.
                                  If None, uses regex-based preprocessing only.
+            autosar_parser: AutosarParser to share (e.g. the one of
+                            FunctionDatabase). If None, one is created.
+            full_parse: Parse files with traditional C definitions with
+                        pycparser (False: lexical parse path only)
         """
-        self.parser = c_parser.CParser()
+        self.parser = AutosarTypedefCParser()
+        self.autosar_parser = autosar_parser or AutosarParser()
         self.preprocessor_config = preprocessor_config
+        self.full_parse = full_parse
+        # Names that are never reported as calls
+        self._excluded_call_names = frozenset(
+            self.C_KEYWORDS | self.AUTOSAR_TYPES | self.AUTOSAR_MACROS
+        )
+        # Headers whose content is skipped in preprocessed files (see
+        # use_shared_prefix); marker file names resolve to these paths
+        self.shared_prefix: Optional[SharedIncludePrefix] = None
+        self._marker_paths: Dict[str, str] = {}
+        # Seconds per step, input size and parse path of the last parsed file
+        self.last_timings: Dict[str, float] = {}
+        self.last_bytes = 0
+        self.last_parse_path = PARSE_PATH_LEXICAL
+
+    def _end_step(self, step: str, start: float) -> float:
+        """
+        Add the time since start to a step of the last parsed file.
+
+        Implements: SWR_PARSER_00047 (Per-File Parse Step Timings)
+
+        Args:
+            step: Step name
+            start: time.perf_counter() at the start of the step
+
+        Returns:
+            time.perf_counter() now, the start of the next step
+        """
+        now = time.perf_counter()
+        self.last_timings[step] = self.last_timings.get(step, 0.0) + now - start
+        return now
+
+    def use_shared_prefix(self, shared_prefix: SharedIncludePrefix) -> bool:
+        """
+        Parse a shared include prefix once and skip its headers from now on.
+
+        The typedef names declared by the prefix are recorded, so files
+        can be parsed without the declarations of the shared headers.
+
+        Implements: SWR_PARSER_00045 (Shared Header Skipping)
+
+        Args:
+            shared_prefix: Preprocessed include prefix from CPPPreprocessor
+
+        Returns:
+            True if the prefix could be parsed and is used
+        """
+        try:
+            ast = self.parser.parse(
+                self._preprocess_content(shared_prefix.output_text),
+                filename="<shared include prefix>",
+            )
+        except Exception:
+            return False
+
+        shared_prefix.typedef_names = {
+            node.name for node in ast.ext if isinstance(node, c_ast.Typedef)
+        }
+        # The text is no longer needed; keeps worker initargs small
+        shared_prefix.output_text = ""
+        self.shared_prefix = shared_prefix
+        return True
+
+    def _strip_shared_headers(self, content: str) -> Tuple[str, bool]:
+        """
+        Remove the content of shared headers from a preprocessed file.
+
+        Line markers decide which file each line belongs to. Markers of kept
+        files stay in place, so pycparser still reports source line numbers.
+
+        Args:
+            content: Preprocessed (.i) file content
+
+        Returns:
+            Tuple of remaining content and whether anything was skipped
+        """
+        if not self.shared_prefix:
+            return content, False
+
+        header_files = self.shared_prefix.header_files
+        pieces: List[str] = []
+        skipped = False
+        keep = True
+        last_end = 0
+        for match in LINE_MARKER_PATTERN.finditer(content):
+            if keep:
+                pieces.append(content[last_end : match.start()])
+            name = match.group(1)
+            path = self._marker_paths.get(name)
+            if path is None:
+                path = self._marker_paths[name] = resolve_marker_path(name)
+            keep = path not in header_files
+            skipped = skipped or not keep
+            last_end = match.start() if keep else match.end()
+        if keep:
+            pieces.append(content[last_end:])
+
+        if not skipped:
+            return content, False
+        return "".join(pieces), True
 
     def parse_file(self, file_path: Path) -> List[FunctionInfo]:
         """
         Parse a C source file and extract all function definitions.
 
         Handles both AUTOSAR macros (via AutosarParser) and traditional C functions
-        (via pycparser AST).
+        (via pycparser AST, or the lexical scan without full_parse).
+
+        Step timings are kept in last_timings, the parse path in
+        last_parse_path.
 
         Args:
             file_path: Path to the C source file
@@ -90,23 +462,27 @@ class CParser:
         Returns:
             List of FunctionInfo objects
         """
+        self.last_timings = {}
+        self.last_bytes = 0
+        self.last_parse_path = PARSE_PATH_LEXICAL
+        start = time.perf_counter()
         try:
             content = file_path.read_text(encoding="utf-8", errors="ignore")
         except Exception:
             return []
+        self.last_bytes = len(content)
+        start = self._end_step("read", start)
 
         all_functions = []
         seen_functions = set()  # Track (name, line_number) to avoid duplicates
 
         # First, parse AUTOSAR functions if any
         if "FUNC(" in content:
-            from .autosar_parser import AutosarParser
-
-            autosar_parser = AutosarParser()
+            scanner = SourceScanner(content)
             lines = content.split("\n")
             for line_num, line in enumerate(lines, 1):
                 if "FUNC" in line and "(" in line:
-                    autosar_func = autosar_parser.parse_function_declaration(
+                    autosar_func = self.autosar_parser.parse_function_declaration(
                         line, file_path, line_num
                     )
                     if autosar_func:
@@ -114,22 +490,25 @@ class CParser:
                         if key not in seen_functions:
                             seen_functions.add(key)
                             # Extract function body and calls
-                            line_start = content.find(line)
-                            if line_start != -1:
-                                body_start = line_start + len(line)
-                                function_body = (
-                                    self._extract_function_body_from_content(
-                                        content, body_start
+                            body_start = scanner.line_start(line_num) + len(line)
+                            body_span = scanner.body_span_after(body_start)
+                            if body_span:
+                                autosar_func.calls = (
+                                    self._extract_function_calls_from_body(
+                                        content, *body_span
                                     )
                                 )
-                                if function_body:
-                                    called_functions = (
-                                        self._extract_function_calls_from_body(
-                                            function_body
-                                        )
-                                    )
-                                    autosar_func.calls = called_functions
                             all_functions.append(autosar_func)
+        start = self._end_step("autosar", start)
+
+        use_cpp = bool(self.preprocessor_config and self.preprocessor_config.enabled)
+        if not self.full_parse and not use_cpp:
+            # Lexical path: scan the file as written, so lines are exact
+            all_functions.extend(
+                self._scan_traditional_functions(file_path, content, seen_functions)
+            )
+            self._end_step("scan", start)
+            return all_functions
 
         # Then, parse traditional C functions using pycparser
         # Remove AUTOSAR function declarations before preprocessing
@@ -137,20 +516,37 @@ class CParser:
         content_for_traditional_c = self._remove_autosar_functions(content)
 
         # Use cpp preprocessor if config is provided and enabled
-        if self.preprocessor_config and self.preprocessor_config.enabled:
+        if use_cpp:
+            start = self._end_step("lowering", start)
             preprocessed = self._preprocess_with_cpp(content_for_traditional_c, file_path)
+            start = self._end_step("cpp", start)
         else:
             preprocessed = self._preprocess_content(content_for_traditional_c)
+        start = self._end_step("lowering", start)
+
+        if not self.full_parse:
+            all_functions.extend(
+                self._scan_traditional_functions(
+                    file_path, preprocessed, seen_functions
+                )
+            )
+            self._end_step("scan", start)
+            return all_functions
 
         # Check if file contains any traditional C functions
-        if self._has_traditional_c_functions(preprocessed):
+        has_functions = self._needs_pycparser(preprocessed, seen_functions)
+        start = self._end_step("scan", start)
+        if has_functions:
+            self.last_parse_path = PARSE_PATH_PYCPARSER
             try:
                 # Parse the preprocessed code
                 ast = self.parser.parse(preprocessed, filename=str(file_path))
+                start = self._end_step("pycparser", start)
 
                 # Visit the AST to extract functions
                 visitor = FunctionVisitor(file_path, content)
                 visitor.visit(ast)
+                start = self._end_step("visitor", start)
 
                 # Add traditional C functions, avoiding duplicates
                 for func in visitor.functions:
@@ -161,7 +557,7 @@ class CParser:
 
             except Exception:
                 # Parsing failed - silently ignore and return what we have
-                pass
+                self._end_step("pycparser", start)
 
         return all_functions
 
@@ -232,9 +628,16 @@ class CParser:
         """
         Preprocess C source code for pycparser.
 
+        All rewrites happen in one tokenizer pass that writes into a single
+        output buffer, instead of one full-text substitution per macro form.
+
+        AUTOSAR types (uint8, uint16, etc.) need no typedefs in the output,
+        AutosarTypedefCParser declares them before parsing.
+
+        Implements: SWR_PARSER_00043 (Single-Pass AUTOSAR Macro Lowering)
+
         This handles:
         - AUTOSAR macros (FUNC, VAR, P2VAR, etc.) that pycparser can't handle
-        - AUTOSAR types (uint8, uint16, etc.) that need typedefs
         - Preprocessor directives
         - Other issues that would confuse pycparser
 
@@ -244,166 +647,52 @@ class CParser:
         Returns:
             Preprocessed C code suitable for pycparser
         """
-        preprocessed = content
-
-        # Step 1: Remove ALL comments FIRST (before any macro processing)
-        # This prevents comment-like content in strings from being affected
-        preprocessed = self._remove_comments(preprocessed)
-
-        # Step 2: Add typedefs for AUTOSAR types
-        autosar_typedefs = """typedef unsigned char uint8;
-typedef unsigned short uint16;
-typedef unsigned int uint32;
-typedef unsigned long long uint64;
-typedef signed char sint8;
-typedef short sint16;
-typedef int sint32;
-typedef long long sint64;
-typedef unsigned char uchar;
-typedef unsigned short ushort;
-typedef unsigned int uint;
-typedef unsigned long ulong;
-"""
-        preprocessed = autosar_typedefs + preprocessed
-
-        # Replace AUTOSAR function macros with dummy declarations
-        # Pattern: FUNC(return_type, class) func_name(params);
-        # We convert to: return_type func_name(params);
-        preprocessed = re.sub(
-            r"FUNC\s*\(\s*([^,]+)\s*,\s*[^)]+\)\s*",
-            r"\1 ",
-            preprocessed,
-        )
-
-        # Replace FUNC_P2VAR, FUNC_P2CONST, etc.
-        preprocessed = re.sub(
-            r"FUNC_P2\w+\s*\(\s*([^,]+)\s*,\s*[^,]+,\s*[^)]+\)\s*",
-            r"\1* ",
-            preprocessed,
-        )
-
-        # Remove AUTOSAR variable macros from parameter lists
-        # VAR(type, class) -> type
-        preprocessed = re.sub(
-            r"VAR\s*\(\s*([^,]+)\s*,\s*[^)]+\)",
-            r"\1",
-            preprocessed,
-        )
-
-        # P2VAR(type, class, ...) -> type*
-        preprocessed = re.sub(
-            r"P2VAR\s*\(\s*([^,]+)\s*,\s*[^,]+,\s*[^)]+\)",
-            r"\1*",
-            preprocessed,
-        )
-
-        # P2CONST(type, class, ...) -> const type*
-        preprocessed = re.sub(
-            r"P2CONST\s*\(\s*([^,]+)\s*,\s*[^,]+,\s*[^)]+\)",
-            r"const \1*",
-            preprocessed,
-        )
-
-        # CONST(type, ...) -> const type
-        preprocessed = re.sub(
-            r"CONST\s*\(\s*([^,]+)\s*,\s*[^)]+\)",
-            r"const \1",
-            preprocessed,
-        )
-
-        # Remove other problematic preprocessor directives
-        # (keep includes for now, they'll be handled by cpp if needed)
-        # Remove #pragma, #line, etc.
-        preprocessed = re.sub(
-            r"^#\s*(pragma|line|error|warning).*$", "", preprocessed, flags=re.MULTILINE
-        )
-
-        return preprocessed
-
-    def _extract_function_body_from_content(
-        self, content: str, start_pos: int
-    ) -> Optional[str]:
-        """
-        Extract function body starting from a position.
-
-        Args:
-            content: Full file content
-            start_pos: Position to start searching for body
-
-        Returns:
-            Function body string or None if not found
-        """
-        # Skip whitespace and look for opening brace
-        remaining = content[start_pos:].lstrip()
-        if not remaining.startswith("{"):
-            return None
-
-        # Match balanced braces
-        brace_count = 0
-        body_chars = []
-
-        for char in remaining:
-            body_chars.append(char)
-            if char == "{":
-                brace_count += 1
-            elif char == "}":
-                brace_count -= 1
-                if brace_count == 0:
-                    break
-
-        if brace_count == 0:
-            return "".join(body_chars)
+        # Single sweep: comments and directives are dropped, literals are
+        # copied verbatim and each AUTOSAR macro is replaced by its C form
+        pieces: List[str] = []
+        last_end = 0
+        for match in _LOWERING_PATTERN.finditer(content):
+            kind = match.lastgroup
+            if kind in ("string", "char"):
+                continue
+            pieces.append(content[last_end : match.start()])
+            if kind in _LOWERING_TEMPLATES:
+                pieces.append(_LOWERING_TEMPLATES[kind].format(match.group(kind)))
+            last_end = match.end()
+        pieces.append(content[last_end:])
 
-        return None
+        return "".join(pieces)
 
     def _extract_function_calls_from_body(
-        self, function_body: str
+        self, content: str, start: int = 0, end: Optional[int] = None
     ) -> List[FunctionCall]:
         """
         Extract function calls from a function body.
 
-        Simple regex-based extraction for AUTOSAR functions.
+        Simple regex-based extraction for AUTOSAR functions. The body is
+        given as a span of the file content so it is not copied.
+
+        Implements: SWR_PARSER_00050 (Native Lexer Accelerator)
 
         Args:
-            function_body: Function body text
+            content: Text containing the function body
+            start: Offset of the body in content
+            end: Offset just past the body (default: end of content)
 
         Returns:
             List of FunctionCall objects
         """
-        called_functions: List[FunctionCall] = []
-        seen_names = set()
-
-        # Pattern to match function calls: identifier(
-        call_pattern = re.compile(r"\b([a-zA-Z_][a-zA-Z0-9_]*)\s*\(")
-
-        for match in call_pattern.finditer(function_body):
-            function_name = match.group(1)
-
-            # Skip C keywords
-            if function_name in self.C_KEYWORDS:
-                continue
-
-            # Skip AUTOSAR types (might be casts)
-            if function_name in self.AUTOSAR_TYPES:
-                continue
-
-            # Skip AUTOSAR macros
-            if function_name in self.AUTOSAR_MACROS:
-                continue
-
-            # Track unique calls
-            if function_name not in seen_names:
-                seen_names.add(function_name)
-                called_functions.append(
-                    FunctionCall(
-                        name=function_name,
-                        is_conditional=False,  # Simple extraction, no if/else tracking
-                        condition=None,
-                        is_loop=False,  # No loop tracking
-                        loop_condition=None,
-                    )
-                )
+        if end is None:
+            end = len(content)
+        if _lexer is not None:
+            names = _lexer.find_calls(content, start, end, self._excluded_call_names)
+        else:
+            names = _python_find_calls(
+                _CALL_PATTERN, content, start, end, self._excluded_call_names
+            )
 
+        # Simple extraction, no if/else or loop tracking
+        called_functions = [FunctionCall(name=name) for name in names]
         return sorted(called_functions, key=lambda fc: fc.name)
 
     def _remove_autosar_functions(self, content: str) -> str:
@@ -413,52 +702,17 @@ typedef unsigned long ulong;
         This prevents AUTOSAR macros from being converted to traditional C
         and then parsed as traditional C functions.
 
+        Implements: SWR_PARSER_00050 (Native Lexer Accelerator)
+
         Args:
             content: Original C source code
 
         Returns:
             Content with AUTOSAR function declarations removed
         """
-        lines = content.split("\n")
-        filtered_lines = []
-        in_autosar_func = False
-
-        for line in lines:
-            stripped = line.strip()
-
-            # Check if this line starts an AUTOSAR function declaration
-            # Pattern: FUNC(...) or FUNC_P2VAR(...) etc.
-            if re.match(r"^\s*FUNC(_P2\w+)?\s*\(", stripped):
-                # Check if this is a full declaration (ends with ; or {)
-                # or a multi-line declaration
-                if ";" in stripped or "{" in stripped:
-                    # Single-line declaration - skip it
-                    in_autosar_func = False
-                    # If it ends with {, we need to skip the body too
-                    if "{" in stripped:
-                        # Keep the body (everything after {)
-                        open_brace_pos = stripped.find("{")
-                        if open_brace_pos != -1:
-                            filtered_lines.append(stripped[open_brace_pos:])
-                else:
-                    # Multi-line declaration start
-                    in_autosar_func = True
-            elif in_autosar_func:
-                # We're in a multi-line AUTOSAR declaration
-                if ";" in stripped or "{" in stripped:
-                    # End of declaration
-                    in_autosar_func = False
-                    # If it ends with {, we need to keep the body
-                    if "{" in stripped:
-                        open_brace_pos = stripped.find("{")
-                        if open_brace_pos != -1:
-                            filtered_lines.append(stripped[open_brace_pos:])
-                # Skip the declaration lines
-            else:
-                # Not an AUTOSAR function line
-                filtered_lines.append(line)
-
-        return "\n".join(filtered_lines)
+        if _lexer is not None:
+            return _lexer.remove_autosar_functions(content)
+        return _python_remove_autosar_functions(content)
 
     def _remove_comments(self, content: str) -> str:
         """
@@ -542,61 +796,369 @@ typedef unsigned long ulong;
 
         return False
 
+    def _needs_pycparser(
+        self, content: str, seen_functions: Set[Tuple[str, int]]
+    ) -> bool:
+        """
+        Check whether lowered content defines traditional C functions.
+
+        pycparser only extracts function definitions, so a file without
+        any (AUTOSAR FUNC definitions only, prototypes, data tables) is
+        not parsed. Definitions the AUTOSAR scan has extracted already do
+        not count; after lowering, e.g. "STATIC FUNC(...)" looks like a
+        traditional definition. The line heuristic of
+        _has_traditional_c_functions() rules most files out quickly; the
+        lexical definition scan decides the rest.
+
+        Implements: SWR_PARSER_00049 (Lexical Parse Path)
+
+        Args:
+            content: Lowered C source code, as it would be given to pycparser
+            seen_functions: (name, line) keys of the AUTOSAR scan
+
+        Returns:
+            True if the content has to be parsed with pycparser
+        """
+        if not self._has_traditional_c_functions(content):
+            return False
+        autosar_names = {name for name, _ in seen_functions}
+        return any(
+            definition.name not in autosar_names
+            for definition in iter_function_definitions(content)
+        )
+
+    def _scan_traditional_functions(
+        self,
+        file_path: Path,
+        content: str,
+        seen_functions: Set[Tuple[str, int]],
+    ) -> List[FunctionInfo]:
+        """
+        Extract traditional C function definitions without pycparser.
+
+        Definitions come from the lexical scan; the return type and storage
+        class are read from the text before the name, the parameters with
+        AutosarParser and the calls from the body, in order of their first
+        occurrence (like FunctionVisitor). Definitions led by an AUTOSAR
+        FUNC macro are left to the AUTOSAR scan. In cpp output, line numbers
+        follow the line markers.
+
+        Implements: SWR_PARSER_00049 (Lexical Parse Path)
+
+        Args:
+            file_path: Source file the functions are reported for
+            content: File content, as written or preprocessed by cpp
+            seen_functions: (name, line) keys already extracted; updated
+
+        Returns:
+            List of FunctionInfo objects of new definitions
+        """
+        functions: List[FunctionInfo] = []
+        line_offsets: Optional[List[int]] = None
+        markers: List[Tuple[int, int]] = []  # (marker line, line it sets)
+        for definition in iter_function_definitions(content):
+            declaration = _DECLARATION_NOISE_PATTERN.sub(
+                " ", content[definition.decl_start : definition.name_start]
+            )
+            words = _DECLARATION_TOKEN_PATTERN.findall(declaration)
+            if any(word == "FUNC" or word.startswith("FUNC_P2") for word in words):
+                continue
+
+            if line_offsets is None:
+                line_offsets = [0]
+                line_offsets.extend(m.end() for m in re.finditer("\n", content))
+                markers = [
+                    (bisect.bisect_right(line_offsets, m.start()), int(m.group(1)))
+                    for m in _MARKER_LINE_PATTERN.finditer(content)
+                ]
+            line_number = bisect.bisect_right(line_offsets, definition.name_start)
+            marker = bisect.bisect_left(markers, (line_number, 0)) - 1
+            if marker >= 0:
+                marker_line, marker_number = markers[marker]
+                line_number = marker_number + line_number - marker_line - 1
+
+            key = (definition.name, line_number)
+            if key in seen_functions:
+                continue
+            seen_functions.add(key)
+
+            parameter_text = _DECLARATION_NOISE_PATTERN.sub(
+                " ",
+                content[definition.params_start + 1 : definition.params_end - 1],
+            )
+            functions.append(
+                FunctionInfo(
+                    name=definition.name,
+                    return_type=_lexical_return_type(words),
+                    parameters=self.autosar_parser.parse_parameters(parameter_text),
+                    function_type=FunctionType.TRADITIONAL_C,
+                    file_path=file_path,
+                    line_number=line_number,
+                    calls=self._extract_calls_in_order(
+                        content, definition.body_start, definition.body_end
+                    ),
+                    is_static="static" in words,
+                )
+            )
+        return functions
+
+    def _extract_calls_in_order(
+        self, content: str, start: int, end: int
+    ) -> List[FunctionCall]:
+        """
+        Extract the calls of a traditional function body lexically.
+
+        Args:
+            content: Text containing the function body
+            start: Offset of the body in content
+            end: Offset just past the body
+
+        Returns:
+            FunctionCall objects, once per callee, in order of appearance
+        """
+        if _lexer is not None:
+            names = _lexer.find_body_calls(
+                content, start, end, self._excluded_call_names
+            )
+        else:
+            names = _python_find_calls(
+                _BODY_CALL_PATTERN, content, start, end, self._excluded_call_names
+            )
+        return [FunctionCall(name=name) for name in names]
+
     def parse_all(
         self,
         source_files: List[Path],
         verbose: bool = True,
         preprocessed_files: Optional[Dict[Path, Path]] = None,
+        jobs: int = 1,
     ) -> ParseStatistics:
         """
         Parse multiple files with statistics collection.
 
+        Implements: SWR_PARSER_00041 (Multi-Process Parsing)
+
         Args:
             source_files: List of source files to parse
             verbose: Print progress information
             preprocessed_files: Optional mapping of source_file -> preprocessed_file
+            jobs: Number of worker processes (1 parses in this process)
 
         Returns:
-            ParseStatistics with results
+            ParseStatistics with results (in the order of source_files)
         """
         stats = ParseStatistics(total_files=len(source_files))
 
         if verbose:
             print("=== Parsing Stage ===")
 
-        for idx, source_file in enumerate(source_files, 1):
-            if verbose:
-                print(f"[{idx}/{len(source_files)}] {source_file.name:<30} ", end="")
+        tasks = [
+            (
+                source_file,
+                preprocessed_files.get(source_file) if preprocessed_files else None,
+            )
+            for source_file in source_files
+        ]
+        total = len(tasks)
 
-            # Get preprocessed file path if available
-            preprocessed_file = None
-            if preprocessed_files:
-                preprocessed_file = preprocessed_files.get(source_file)
+        if jobs > 1 and total > 1:
+            for idx, result in enumerate(self.parse_files_parallel(tasks, jobs), 1):
+                if verbose:
+                    print(f"[{idx}/{total}] {result.source_file.name:<30} ", end="")
+                self._record_result(stats, result, verbose)
+            return stats
+
+        for idx, (source_file, preprocessed_file) in enumerate(tasks, 1):
+            if verbose:
+                print(f"[{idx}/{total}] {source_file.name:<30} ", end="")
 
             result = self.parse_file_with_stats(source_file, preprocessed_file)
-            stats.results.append(result)
+            self._record_result(stats, result, verbose)
 
-            if result.success:
-                stats.successful += 1
-                stats.autosar_functions += result.autosar_functions
-                stats.traditional_functions += result.traditional_functions
-                stats.total_functions += len(result.functions)
-                if verbose:
-                    func_count = len(result.functions)
-                    print(f"OK ({func_count} functions)")
+        return stats
+
+    def parse_files_parallel(
+        self,
+        tasks: List[Tuple[Path, Optional[Path]]],
+        jobs: int,
+    ) -> List[ParseResult]:
+        """
+        Parse files in a pool of worker processes.
+
+        pycparser and FunctionVisitor are pure Python and CPU-bound, so the
+        work is spread over processes rather than threads. Each worker owns
+        its own CParser; results come back as picklable ParseResult objects
+        in the order of tasks. If the pool cannot be used (e.g. process
+        creation is not permitted), the files are parsed in this process.
+
+        Implements: SWR_PARSER_00041 (Multi-Process Parsing)
+
+        Args:
+            tasks: List of (source_file, preprocessed_file or None) tuples
+            jobs: Number of worker processes
+
+        Returns:
+            List of ParseResult objects, one per task
+        """
+        # Hand out several files per round trip to keep IPC overhead low
+        chunksize = max(1, len(tasks) // (jobs * 4))
+
+        try:
+            with ProcessPoolExecutor(
+                max_workers=jobs,
+                initializer=_init_parse_worker,
+                initargs=(
+                    self.preprocessor_config,
+                    self.shared_prefix,
+                    None,
+                    self.full_parse,
+                ),
+            ) as executor:
+                return list(
+                    executor.map(_parse_task_in_worker, tasks, chunksize=chunksize)
+                )
+        except (OSError, BrokenProcessPool) as e:
+            print(f"Warning: parallel parsing unavailable ({e}), parsing serially")
+            return [
+                self.parse_file_with_stats(source_file, preprocessed_file)
+                for source_file, preprocessed_file in tasks
+            ]
+
+    def preprocess_and_parse(
+        self, source_file: Path, preprocessor: CPPPreprocessor
+    ) -> Tuple[PreprocessResult, ParseResult]:
+        """
+        Run cpp on one file and parse its output straight from the pipe.
+
+        If cpp fails, the file is parsed like in the two-stage pipeline
+        when no preprocessed file exists.
+
+        Implements: SWR_PARSER_00046 (Fused Streaming Preprocess and Parse)
+
+        Args:
+            source_file: Path to the source file
+            preprocessor: Preprocessor running cpp
+
+        Returns:
+            Tuple of preprocessing result (without its output text) and
+            parsing result
+        """
+        prep_result = preprocessor.preprocess_file(source_file, stream=True)
+        text = prep_result.output_text
+        prep_result.output_text = None
+        return prep_result, self.parse_file_with_stats(
+            source_file, preprocessed_text=text
+        )
+
+    def preprocess_and_parse_all(
+        self,
+        source_files: List[Path],
+        preprocessor: CPPPreprocessor,
+        verbose: bool = True,
+        jobs: int = 1,
+    ) -> Tuple[PreprocessStatistics, ParseStatistics]:
+        """
+        Preprocess and parse all files in one fused stage, without .i files.
+
+        Each file's cpp output is read from the pipe and parsed right away,
+        so no preprocessed file is written to or read from disk. With
+        jobs > 1, every worker process runs cpp and parses its files.
+
+        Implements: SWR_PARSER_00046 (Fused Streaming Preprocess and Parse)
+
+        Args:
+            source_files: List of source files
+            preprocessor: Preprocessor running cpp
+            verbose: Print progress information
+            jobs: Number of worker processes (1 works in this process)
+
+        Returns:
+            Tuple of preprocessing and parsing statistics (in input order)
+        """
+        prep_stats = PreprocessStatistics(total_files=len(source_files))
+        parse_stats = ParseStatistics(total_files=len(source_files))
+        total = len(source_files)
+
+        if verbose:
+            print("=== Preprocessing and Parsing Stage ===")
+
+        results: Optional[List[Tuple[PreprocessResult, ParseResult]]] = None
+        if jobs > 1 and total > 1:
+            # Resolve cpp once; workers inherit the path with the preprocessor
+            preprocessor._get_cpp_path()
+            chunksize = max(1, total // (jobs * 4))
+            try:
+                with ProcessPoolExecutor(
+                    max_workers=jobs,
+                    initializer=_init_parse_worker,
+                    initargs=(
+                        self.preprocessor_config,
+                        self.shared_prefix,
+                        preprocessor,
+                        self.full_parse,
+                    ),
+                ) as executor:
+                    results = list(
+                        executor.map(
+                            _stream_task_in_worker, source_files, chunksize=chunksize
+                        )
+                    )
+            except (OSError, BrokenProcessPool) as e:
+                print(f"Warning: parallel parsing unavailable ({e}), parsing serially")
+
+        for idx, source_file in enumerate(source_files, 1):
+            if verbose:
+                print(f"[{idx}/{total}] {source_file.name:<30} ", end="")
+            if results is not None:
+                prep_result, parse_result = results[idx - 1]
             else:
-                stats.failed += 1
-                if verbose:
-                    print("FAILED")
-                    if result.error_message:
-                        print(f"    Error: {result.error_message}")
+                prep_result, parse_result = self.preprocess_and_parse(
+                    source_file, preprocessor
+                )
+            preprocessor._record_result(prep_stats, prep_result, verbose=False)
+            self._record_result(parse_stats, parse_result, verbose)
+            if verbose and not prep_result.success:
+                print(f"    Preprocessing failed: {prep_result.error_message}")
 
-        return stats
+        return prep_stats, parse_stats
+
+    def _record_result(
+        self, stats: ParseStatistics, result: ParseResult, verbose: bool
+    ) -> None:
+        """
+        Add a parse result to the statistics and report its status.
+
+        Args:
+            stats: ParseStatistics to update
+            result: ParseResult of one file
+            verbose: Print the per-file status
+        """
+        stats.results.append(result)
+
+        if result.success:
+            stats.successful += 1
+            stats.autosar_functions += result.autosar_functions
+            stats.traditional_functions += result.traditional_functions
+            stats.total_functions += len(result.functions)
+            if result.parse_path == PARSE_PATH_PYCPARSER:
+                stats.pycparser_files += 1
+            else:
+                stats.lexical_files += 1
+            if verbose:
+                func_count = len(result.functions)
+                print(f"OK ({func_count} functions)")
+        else:
+            stats.failed += 1
+            if verbose:
+                print("FAILED")
+                if result.error_message:
+                    print(f"    Error: {result.error_message}")
 
     def parse_file_with_stats(
         self,
         source_file: Path,
         preprocessed_file: Optional[Path] = None,
+        preprocessed_text: Optional[str] = None,
     ) -> ParseResult:
         """
         Parse a single file with statistics collection.
@@ -604,13 +1166,21 @@ typedef unsigned long ulong;
         Args:
             source_file: Path to source file
             preprocessed_file: Optional path to preprocessed file
+            preprocessed_text: Optional preprocessed content (streaming mode)
 
         Returns:
-            ParseResult with outcome and functions
+            ParseResult with outcome, functions and step timings
         """
+        self.last_timings = {}
+        self.last_bytes = 0
+        start_time = time.time()
         try:
+            if preprocessed_text is not None:
+                functions = self._parse_preprocessed_content(
+                    source_file, preprocessed_text
+                )
             # If preprocessed file provided, use it
-            if preprocessed_file and preprocessed_file.exists():
+            elif preprocessed_file and preprocessed_file.exists():
                 functions = self._parse_preprocessed_file(source_file, preprocessed_file)
             else:
                 # Fall back to regular parsing
@@ -628,8 +1198,12 @@ typedef unsigned long ulong;
                 preprocessed_file=preprocessed_file,
                 functions=functions,
                 success=True,
+                start_time=start_time,
+                timings=self.last_timings,
+                bytes_processed=self.last_bytes,
                 autosar_functions=autosar_count,
                 traditional_functions=traditional_count,
+                parse_path=self.last_parse_path,
             )
 
         except Exception as e:
@@ -639,6 +1213,9 @@ typedef unsigned long ulong;
                 functions=[],
                 success=False,
                 error_message=str(e),
+                start_time=start_time,
+                timings=self.last_timings,
+                bytes_processed=self.last_bytes,
             )
 
     def _parse_preprocessed_file(
@@ -659,23 +1236,45 @@ typedef unsigned long ulong;
         Returns:
             List of FunctionInfo objects
         """
+        start = time.perf_counter()
         try:
             content = preprocessed_file.read_text(encoding="utf-8", errors="ignore")
         except Exception:
             return []
+        self._end_step("read", start)
+
+        return self._parse_preprocessed_content(source_file, content)
+
+    def _parse_preprocessed_content(
+        self,
+        source_file: Path,
+        content: str,
+    ) -> List[FunctionInfo]:
+        """
+        Parse preprocessed content, from a .i file or streamed from cpp.
+
+        Args:
+            source_file: Original source file (for file path in FunctionInfo)
+            content: Preprocessed content
+
+        Returns:
+            List of FunctionInfo objects
+        """
+        start = time.perf_counter()
+        self.last_bytes = len(content)
+        self.last_parse_path = PARSE_PATH_LEXICAL
+        full_content = content
+        content, skipped_headers = self._strip_shared_headers(content)
 
         all_functions = []
         seen_functions = set()
 
         # First, parse AUTOSAR functions if any
         if "FUNC(" in content:
-            from .autosar_parser import AutosarParser
-
-            autosar_parser = AutosarParser()
             lines = content.split("\n")
             for line_num, line in enumerate(lines, 1):
                 if "FUNC" in line and "(" in line:
-                    autosar_func = autosar_parser.parse_function_declaration(
+                    autosar_func = self.autosar_parser.parse_function_declaration(
                         line, source_file, line_num
                     )
                     if autosar_func:
@@ -683,20 +1282,36 @@ typedef unsigned long ulong;
                         if key not in seen_functions:
                             seen_functions.add(key)
                             all_functions.append(autosar_func)
+        start = self._end_step("autosar", start)
+
+        if not self.full_parse:
+            all_functions.extend(
+                self._scan_traditional_functions(source_file, content, seen_functions)
+            )
+            self._end_step("scan", start)
+            return all_functions
 
         # Remove AUTOSAR function declarations before traditional parsing
         content_for_traditional_c = self._remove_autosar_functions(content)
 
         # Apply regex preprocessing for any remaining AUTOSAR macros
         preprocessed = self._preprocess_content(content_for_traditional_c)
+        start = self._end_step("lowering", start)
 
         # Check if file contains any traditional C functions
-        if self._has_traditional_c_functions(preprocessed):
+        has_functions = self._needs_pycparser(preprocessed, seen_functions)
+        start = self._end_step("scan", start)
+        if has_functions:
+            self.last_parse_path = PARSE_PATH_PYCPARSER
             try:
-                ast = self.parser.parse(preprocessed, filename=str(source_file))
+                ast = self._parse_translation_unit(
+                    source_file, preprocessed, full_content, skipped_headers
+                )
+                start = self._end_step("pycparser", start)
 
                 visitor = FunctionVisitor(source_file, content)
                 visitor.visit(ast)
+                start = self._end_step("visitor", start)
 
                 for func in visitor.functions:
                     key = (func.name, func.line_number)
@@ -705,10 +1320,51 @@ typedef unsigned long ulong;
                         all_functions.append(func)
 
             except Exception:
-                pass
+                self._end_step("pycparser", start)
 
         return all_functions
 
+    def _parse_translation_unit(
+        self,
+        source_file: Path,
+        preprocessed: str,
+        full_content: str,
+        skipped_headers: bool,
+    ) -> Any:
+        """
+        Parse a preprocessed translation unit with pycparser.
+
+        Without shared header content, the typedef names of the shared
+        prefix are declared up front. If the file does not parse that way
+        (e.g. a header was included under different macro settings), the
+        complete file is parsed instead.
+
+        Implements: SWR_PARSER_00045 (Shared Header Skipping)
+
+        Args:
+            source_file: Original source file (for error messages)
+            preprocessed: Lowered content, shared headers removed if skipped
+            full_content: Complete preprocessed file content
+            skipped_headers: Whether shared header content was removed
+
+        Returns:
+            pycparser FileAST
+        """
+        if not skipped_headers or not self.shared_prefix:
+            return self.parser.parse(preprocessed, filename=str(source_file))
+
+        try:
+            return self.parser.parse(
+                preprocessed,
+                filename=str(source_file),
+                typedef_names=self.shared_prefix.typedef_names,
+            )
+        except Exception:
+            full = self._preprocess_content(
+                self._remove_autosar_functions(full_content)
+            )
+            return self.parser.parse(full, filename=str(source_file))
+
     def get_statistics_summary(self, stats: ParseStatistics) -> str:
         """
         Generate a human-readable summary of parsing statistics.
@@ -730,6 +1386,10 @@ typedef unsigned long ulong;
             f"  Traditional:   {stats.traditional_functions}",
             f"  Total:         {stats.total_functions}",
             "",
+            "Parse paths:",
+            f"  Lexical scan:  {stats.lexical_files} files",
+            f"  pycparser:     {stats.pycparser_files} files",
+            "",
             f"Correctness Ratio: {stats.correctness_ratio:.1f}%",
         ]
 
@@ -743,3 +1403,109 @@ typedef unsigned long ulong;
                     )
 
         return "\n".join(lines)
+
+
+def _lexical_return_type(words: List[str]) -> str:
+    """
+    Build a return type from the tokens before a function name.
+
+    Storage class and function specifiers are dropped; pointers are
+    written like FunctionVisitor does ("const uint8*", "int* const").
+
+    Args:
+        words: Identifiers and "*" tokens of the declaration
+
+    Returns:
+        Return type string ("int" if none is given)
+    """
+    type_words = [word for word in words if word not in _STORAGE_SPECIFIERS]
+    if "*" not in type_words:
+        return " ".join(type_words) or "int"
+    star = type_words.index("*")
+    base = " ".join(type_words[:star])
+    qualifiers = [word for word in type_words[star:] if word != "*"]
+    if qualifiers:
+        return f"{base}* {' '.join(qualifiers)}"
+    return f"{base}*"
+
+
+def _python_find_calls(
+    pattern: "re.Pattern[str]",
+    content: str,
+    start: int,
+    end: int,
+    excluded: FrozenSet[str],
+) -> List[str]:
+    """
+    Find the call names of a body in Python (see _lexer.find_calls()).
+
+    Args:
+        pattern: _CALL_PATTERN or _BODY_CALL_PATTERN
+        content: Text containing the function body
+        start: Offset of the body in content
+        end: Offset just past the body
+        excluded: Names that are not calls
+
+    Returns:
+        Call names, once each, in order of appearance
+    """
+    names: Dict[str, None] = {}
+    for match in pattern.finditer(content, start, end):
+        function_name = match.group(1)
+        if function_name is not None and function_name not in excluded:
+            names[function_name] = None
+    return list(names)
+
+
+def _python_remove_autosar_functions(content: str) -> str:
+    """
+    Remove AUTOSAR function declarations in Python.
+
+    See CParser._remove_autosar_functions().
+
+    Args:
+        content: Original C source code
+
+    Returns:
+        Content with AUTOSAR function declarations removed
+    """
+    lines = content.split("\n")
+    filtered_lines = []
+    in_autosar_func = False
+
+    for line in lines:
+        stripped = line.strip()
+
+        # Check if this line starts an AUTOSAR function declaration
+        # Pattern: FUNC(...) or FUNC_P2VAR(...) etc.
+        if re.match(r"^\s*FUNC(_P2\w+)?\s*\(", stripped):
+            # Check if this is a full declaration (ends with ; or {)
+            # or a multi-line declaration
+            if ";" in stripped or "{" in stripped:
+                # Single-line declaration - skip it
+                in_autosar_func = False
+                # If it ends with {, we need to skip the body too
+                if "{" in stripped:
+                    # Keep the body (everything after {)
+                    open_brace_pos = stripped.find("{")
+                    if open_brace_pos != -1:
+                        filtered_lines.append(stripped[open_brace_pos:])
+            else:
+                # Multi-line declaration start
+                in_autosar_func = True
+        elif in_autosar_func:
+            # We're in a multi-line AUTOSAR declaration
+            if ";" in stripped or "{" in stripped:
+                # End of declaration
+                in_autosar_func = False
+                # If it ends with {, we need to keep the body
+                if "{" in stripped:
+                    open_brace_pos = stripped.find("{")
+                    if open_brace_pos != -1:
+                        filtered_lines.append(stripped[open_brace_pos:])
+            # Skip the declaration lines
+        else:
+            # Not an AUTOSAR function line
+            filtered_lines.append(line)
+
+    return "\n".join(filtered_lines)
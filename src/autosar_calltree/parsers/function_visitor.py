@@ -2,14 +2,19 @@
 AST visitor for extracting function definitions from C code.
 
 This module provides the FunctionVisitor class that walks pycparser
-AST nodes to extract function definitions and calls.
+AST nodes to extract function definitions and calls. The calls of a
+function body are collected in one iterative walk together with their
+if/switch/?: conditions and loop conditions.
+
+Requirements:
+- SWR_PARSER_00051: Single-Pass Call Walker
 """
 
 import re
 from pathlib import Path
-from typing import List, Optional, Set
+from typing import Any, Callable, Dict, List, Optional, Set, Tuple
 
-from pycparser import c_ast
+from pycparser import c_ast, c_generator
 
 from ..database.models import FunctionCall, FunctionInfo, FunctionType, Parameter
 
@@ -106,6 +111,39 @@ class FunctionVisitor(c_ast.NodeVisitor):
         self.content = content
         self.functions: List[FunctionInfo] = []
         self.current_function: Optional[FunctionInfo] = None
+        # The source fallback of _extract_return_type() only finds const types
+        self._content_has_const = bool(content) and (
+            re.search("const", content, re.IGNORECASE) is not None
+        )
+        self._generator: Optional[c_generator.CGenerator] = None
+        self._calls: List[FunctionCall] = []
+        self._calls_by_name: Dict[str, FunctionCall] = {}
+        self._context = _NO_CONTEXT
+        # Node class -> handler, or the child fields of other node classes
+        self._dispatch: Dict[type, Any] = {
+            _CallContext: self._enter_context,
+            c_ast.FuncCall: self._walk_call,
+            c_ast.If: self._walk_if,
+            c_ast.Switch: self._walk_switch,
+            c_ast.For: self._walk_for,
+            c_ast.While: self._walk_while,
+            c_ast.DoWhile: self._walk_do_while,
+            c_ast.TernaryOp: self._walk_if,
+        }
+
+    def visit_FileAST(self, node: c_ast.FileAST) -> None:
+        """
+        Visit the translation unit.
+
+        Only function definitions are visited; declarations cannot contain
+        function definitions, so their subtrees are not walked.
+
+        Args:
+            node: Translation unit AST node
+        """
+        for ext in node.ext:
+            if isinstance(ext, c_ast.FuncDef):
+                self.visit_FuncDef(ext)
 
     def visit_FuncDef(self, node: c_ast.FuncDef) -> None:
         """
@@ -175,7 +213,11 @@ class FunctionVisitor(c_ast.NodeVisitor):
 
         # Workaround: pycparser doesn't preserve const qualifiers in some cases
         # Check if the original source has "const" but pycparser result doesn't
-        if "const" not in pycparser_return_type.lower() and node.coord:
+        if (
+            self._content_has_const
+            and "const" not in pycparser_return_type.lower()
+            and node.coord
+        ):
             # Try to extract the return type from source as a fallback
             source_return_type = self._extract_return_type_from_source(node)
             if source_return_type and "const" in source_return_type.lower():
@@ -332,10 +374,13 @@ class FunctionVisitor(c_ast.NodeVisitor):
             return parameters
 
         for param in decl.type.args.params:
-            # Skip void parameters (shouldn't happen but defensive)
-            if isinstance(param, c_ast.Typename) and hasattr(param.type, "names"):
-                if "void" in param.type.names:
-                    continue
+            # Skip the unnamed void of "(void)", like the lexical parse path
+            if (
+                isinstance(param, c_ast.Typename)
+                and isinstance(param.type, c_ast.TypeDecl)
+                and getattr(param.type.type, "names", None) == ["void"]
+            ):
+                continue
 
             param_info = self._extract_parameter(param)
             if param_info:
@@ -409,56 +454,246 @@ class FunctionVisitor(c_ast.NodeVisitor):
         """
         Extract function calls from function body.
 
+        The body is walked once, iteratively, with a dispatch table from
+        node class to handler; other nodes only push their child fields.
+        A change of the call context is pushed as a _CallContext before a
+        subtree and the enclosing context after it, so nodes are pushed
+        without per-node tuples. Calls in the branches of if, ?: and
+        switch statements are conditional and calls in for, while and do
+        loops are loop calls, with the innermost condition as text. Each
+        callee is listed once, in order of first occurrence; it is only
+        conditional (or in a loop) if every call of it is.
+
+        Implements: SWR_PARSER_00051 (Single-Pass Call Walker)
+
         Args:
             node: Function definition AST node
 
         Returns:
             List of FunctionCall objects
         """
-
-        # Walk the AST to find all function calls
-        class CallVisitor(c_ast.NodeVisitor):
-            def __init__(self, parent_visitor: "FunctionVisitor"):
-                self.parent = parent_visitor
-                self.calls: List[FunctionCall] = []
-                self.seen: Set[str] = set()
-
-            def visit_FuncCall(self, call_node: c_ast.FuncCall) -> None:
-                """Visit a function call node."""
-                if isinstance(call_node.name, c_ast.IdentifierType):
-                    func_name = call_node.name.names[0]
-                elif isinstance(call_node.name, c_ast.ID):
-                    func_name = call_node.name.name
+        calls: List[FunctionCall] = []
+        self._calls = calls
+        self._calls_by_name = {}
+        self._context = _NO_CONTEXT
+        dispatch = self._dispatch
+        leaves = _LEAF_CLASSES
+        stack: List[Any] = [node.body]
+        pop = stack.pop
+        push = stack.append
+        while stack:
+            current = pop()
+            entry = dispatch.get(current.__class__)
+            if entry is None:
+                entry = dispatch[current.__class__] = _child_fields(current.__class__)
+            if entry.__class__ is not tuple:
+                entry(current, push)
+                continue
+            for field_name in entry:
+                child = getattr(current, field_name)
+                if child is None or child.__class__ in leaves:
+                    continue
+                if child.__class__ is list:
+                    stack.extend(reversed(child))
                 else:
-                    # Handle other cases (e.g., function pointers)
-                    return
-
-                # Skip C keywords
-                if func_name in FunctionVisitor.C_KEYWORDS:
-                    return
-
-                # Skip AUTOSAR types (might be casts)
-                if func_name in FunctionVisitor.AUTOSAR_TYPES:
-                    return
-
-                # Skip AUTOSAR macros
-                if func_name in FunctionVisitor.AUTOSAR_MACROS:
-                    return
-
-                # Track unique calls
-                if func_name not in self.seen:
-                    self.seen.add(func_name)
-                    self.calls.append(
-                        FunctionCall(
-                            name=func_name,
-                            is_conditional=False,  # TODO: Track if/else context
-                            condition=None,
-                            is_loop=False,  # TODO: Track loop context
-                            loop_condition=None,
-                        )
-                    )
-
-        call_visitor = CallVisitor(self)
-        call_visitor.visit(node)
-
-        return call_visitor.calls
+                    push(child)
+
+        self._calls = []
+        self._calls_by_name = {}
+        return calls
+
+    def _enter_context(self, context: "_CallContext", push: Callable) -> None:
+        """Make a pushed call context the current one."""
+        self._context = context
+
+    def _walk_call(self, node: c_ast.FuncCall, push: Callable) -> None:
+        """Record a function call and walk its callee expression and arguments."""
+        if node.args is not None:
+            push(node.args)
+        name_node = node.name
+        if isinstance(name_node, c_ast.ID):
+            self._add_call(name_node.name)
+        elif isinstance(name_node, c_ast.IdentifierType):
+            self._add_call(name_node.names[0])
+        else:
+            # Function pointers, member calls: only the expression is walked
+            push(name_node)
+
+    def _add_call(self, func_name: str) -> None:
+        """Add a call of func_name, or widen the context of an earlier call."""
+        if func_name in _EXCLUDED_CALL_NAMES:
+            return
+        context = self._context
+        call = self._calls_by_name.get(func_name)
+        if call is None:
+            call = FunctionCall(
+                name=func_name,
+                is_conditional=context.condition is not None,
+                condition=self._label_text(context.condition),
+                is_loop=context.loop is not None,
+                loop_condition=self._label_text(context.loop),
+            )
+            self._calls_by_name[func_name] = call
+            self._calls.append(call)
+            return
+        # A callee is only conditional/in a loop if every call of it is
+        if call.is_conditional and context.condition is None:
+            call.is_conditional = False
+            call.condition = None
+        if call.is_loop and context.loop is None:
+            call.is_loop = False
+            call.loop_condition = None
+
+    def _walk_if(self, node: Any, push: Callable) -> None:
+        """Walk an if statement or ?: expression; its branches are conditional."""
+        context = self._context
+        push(context)
+        if node.iffalse is not None:
+            push(node.iffalse)
+            push(_CallContext(("else", node.cond), context.loop))
+        if node.iftrue is not None:
+            push(node.iftrue)
+            push(_CallContext(("if", node.cond), context.loop))
+        push(node.cond)
+
+    def _walk_switch(self, node: c_ast.Switch, push: Callable) -> None:
+        """Walk a switch statement; its cases are conditional."""
+        context = self._context
+        push(context)
+        body = node.stmt
+        items = body.block_items if isinstance(body, c_ast.Compound) else [body]
+        # (case expressions, None for default; statements) of each label
+        # group; stacked labels ("case 2: case 3:") share the statements
+        groups: List[Tuple[Optional[tuple], List[c_ast.Node]]] = []
+        stacked: List[Optional[c_ast.Node]] = []
+        for item in items or []:
+            if isinstance(item, (c_ast.Case, c_ast.Default)):
+                stacked.append(item.expr if isinstance(item, c_ast.Case) else None)
+                if item.stmts:
+                    groups.append((tuple(stacked), item.stmts))
+                    stacked = []
+            else:
+                groups.append((None, [item]))
+        for labels, statements in reversed(groups):
+            for statement in reversed(statements):
+                push(statement)
+            if labels is None:
+                push(context)
+            elif labels == (None,):
+                push(_CallContext(("default",), context.loop))
+            else:
+                push(_CallContext(("case", node.cond, labels), context.loop))
+        push(node.cond)
+
+    def _walk_for(self, node: c_ast.For, push: Callable) -> None:
+        """Walk a for loop; all but its initialization run in the loop."""
+        context = self._context
+        push(context)
+        for child in (node.stmt, node.next, node.cond):
+            if child is not None:
+                push(child)
+        push(_CallContext(context.condition, ("loop", node.cond)))
+        if node.init is not None:
+            push(node.init)
+
+    def _walk_while(self, node: c_ast.While, push: Callable) -> None:
+        """Walk a while loop; its condition and body run in the loop."""
+        context = self._context
+        push(context)
+        push(node.stmt)
+        push(node.cond)
+        push(_CallContext(context.condition, ("loop", node.cond)))
+
+    def _walk_do_while(self, node: c_ast.DoWhile, push: Callable) -> None:
+        """Walk a do loop; its body and condition run in the loop."""
+        context = self._context
+        push(context)
+        push(node.cond)
+        push(node.stmt)
+        push(_CallContext(context.condition, ("loop", node.cond)))
+
+    def _label_text(self, label: Optional[tuple]) -> Optional[str]:
+        """
+        Get the condition text of a context label.
+
+        Labels keep the AST nodes of a condition; the text is only
+        generated for the calls that get it.
+
+        Args:
+            label: ("if", cond), ("else", cond), ("case", subject, exprs),
+                   ("default",), ("loop", cond or None) or None; exprs
+                   are the stacked labels of a case, None for default
+
+        Returns:
+            Condition text, or None
+        """
+        if label is None:
+            return None
+        kind = label[0]
+        if kind == "default":
+            return "default"
+        if label[1] is None:
+            return None
+        if self._generator is None:
+            self._generator = c_generator.CGenerator()
+        text = self._generator.visit(label[1])
+        if kind == "else":
+            return f"!({text})"
+        if kind == "case":
+            generator = self._generator
+            return " || ".join(
+                "default" if expr is None else f"{text} == {generator.visit(expr)}"
+                for expr in label[2]
+            )
+        return text
+
+
+class _CallContext:
+    """Context of the calls in a subtree: enclosing condition and loop labels."""
+
+    __slots__ = ("condition", "loop")
+
+    def __init__(self, condition: Optional[tuple], loop: Optional[tuple]):
+        self.condition = condition
+        self.loop = loop
+
+
+_NO_CONTEXT = _CallContext(None, None)
+
+_EXCLUDED_CALL_NAMES = frozenset(
+    FunctionVisitor.C_KEYWORDS
+    | FunctionVisitor.AUTOSAR_TYPES
+    | FunctionVisitor.AUTOSAR_MACROS
+)
+
+# Nodes without child nodes, not pushed by the walk
+_LEAF_CLASSES = frozenset(
+    {
+        c_ast.ID,
+        c_ast.Constant,
+        c_ast.Break,
+        c_ast.Continue,
+        c_ast.Goto,
+        c_ast.EmptyStatement,
+        c_ast.Pragma,
+    }
+)
+
+# Fields holding types rather than expressions; no calls can occur in them
+_SKIPPED_FIELDS = frozenset({"type", "to_type", "coord", "__weakref__"})
+
+
+def _child_fields(node_class: type) -> Tuple[str, ...]:
+    """
+    Get the fields of an AST node class that may hold child nodes.
+
+    Args:
+        node_class: pycparser c_ast.Node subclass
+
+    Returns:
+        Field names in reverse order, so the walk pops them in order
+    """
+    skipped = _SKIPPED_FIELDS.union(getattr(node_class, "attr_names", ()))
+    return tuple(
+        name for name in reversed(node_class.__slots__) if name not in skipped
+    )
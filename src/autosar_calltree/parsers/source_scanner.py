@@ -0,0 +1,325 @@
+"""
+Single-pass source scanner.
+
+This module indexes a C source file once: it records the offset of every
+line and matches all braces over the whole file, skipping string/char
+literals and comments. Function bodies are then located as (start, end)
+offsets into the original content without copying it.
+
+scan_function_definitions() finds the names of the functions a file
+defines from its tokens alone, without preprocessing or parsing it;
+iter_function_definitions() also returns where their declarations,
+parameter lists and bodies are.
+
+Brace matching and the definition scan run in the native _lexer extension
+when it is built; the Python implementations below give the same results.
+
+Requirements:
+- SWR_PARSER_00042: Single-Pass Body Extraction
+- SWR_PARSER_00048: Lexical Definition Scan
+- SWR_PARSER_00049: Lexical Parse Path
+- SWR_PARSER_00050: Native Lexer Accelerator
+"""
+
+import re
+from dataclasses import dataclass
+from typing import Dict, Iterator, List, Optional, Tuple
+
+try:
+    from . import _lexer  # type: ignore[attr-defined]
+except ImportError:  # Optional: built from _lexer.c when a C compiler is found
+    _lexer = None
+
+# Tokens relevant to brace matching. Literals and comments are matched as a
+# whole so braces inside them are skipped; an unterminated block comment
+# extends to the end of the file.
+_BRACE_TOKEN_PATTERN = re.compile(
+    r'"(?:[^"\\\n]|\\.)*"'
+    r"|'(?:[^'\\\n]|\\.)*'"
+    r"|/\*.*?(?:\*/|\Z)"
+    r"|//[^\n]*"
+    r"|[{}]",
+    re.DOTALL,
+)
+
+_NON_WHITESPACE_PATTERN = re.compile(r"\S")
+
+# Tokens at file scope: literals, comments and preprocessor lines (with
+# continuations) are skipped as a whole; identifiers and punctuation are
+# what a function definition is recognized by.
+_FILE_SCOPE_TOKEN_PATTERN = re.compile(
+    r'"(?:[^"\\\n]|\\.)*"'
+    r"|'(?:[^'\\\n]|\\.)*'"
+    r"|/\*.*?(?:\*/|\Z)"
+    r"|//[^\n]*"
+    r"|^[ \t]*#(?:[^\n\\]|\\.)*"
+    r"|[A-Za-z_]\w*"
+    r"|[{}();=,]",
+    re.DOTALL | re.MULTILINE,
+)
+
+# Tokens inside a braced block: only braces count
+_BLOCK_TOKEN_PATTERN = re.compile(
+    r'"(?:[^"\\\n]|\\.)*"'
+    r"|'(?:[^'\\\n]|\\.)*'"
+    r"|/\*.*?(?:\*/|\Z)"
+    r"|//[^\n]*"
+    r"|^[ \t]*#(?:[^\n\\]|\\.)*"
+    r"|[{}]",
+    re.DOTALL | re.MULTILINE,
+)
+
+
+class SourceScanner:
+    """
+    Line offsets and brace matches of one source file.
+
+    brace_spans maps the offset of every matched '{' to the offset just
+    past its matching '}', so content[start:end] is the braced block.
+    """
+
+    def __init__(self, content: str):
+        """
+        Scan the content once.
+
+        Args:
+            content: Full file content
+        """
+        self.content = content
+        self.line_offsets: List[int]
+        self.brace_spans: Dict[int, int]
+        if _lexer is not None:
+            self.line_offsets, self.brace_spans = _lexer.scan_braces(content)
+        else:
+            self.line_offsets, self.brace_spans = _python_scan_braces(content)
+
+    def line_start(self, line_number: int) -> int:
+        """
+        Get the offset of a line.
+
+        Args:
+            line_number: 1-based line number
+
+        Returns:
+            Offset of the first character of the line
+        """
+        return self.line_offsets[line_number - 1]
+
+    def body_span_after(self, pos: int) -> Optional[Tuple[int, int]]:
+        """
+        Find the braced body that follows a position.
+
+        Only whitespace may separate the position from the opening brace.
+
+        Implements: SWR_PARSER_00042 (Single-Pass Body Extraction)
+
+        Args:
+            pos: Offset to start searching at (e.g. end of a declaration)
+
+        Returns:
+            (start, end) offsets of the body including its braces,
+            or None if no balanced body follows
+        """
+        match = _NON_WHITESPACE_PATTERN.search(self.content, pos)
+        if not match or match.group() != "{":
+            return None
+        end = self.brace_spans.get(match.start())
+        if end is None:
+            return None
+        return match.start(), end
+
+
+@dataclass
+class FunctionDefinition:
+    """
+    Offsets of one function definition found by iter_function_definitions().
+
+    content[decl_start:name_start] is the text before the name (storage
+    class and return type, possibly with comments), content[params_start:
+    params_end] the parameter list including its parentheses and
+    content[body_start:body_end] the body including its braces.
+    """
+
+    name: str
+    decl_start: int
+    name_start: int
+    params_start: int
+    params_end: int
+    body_start: int
+    body_end: int
+
+
+def scan_function_definitions(content: str) -> List[str]:
+    """
+    Find the names of the functions defined in a source file.
+
+    A definition is an identifier followed by a parenthesized parameter
+    list and an opening brace at file scope, so both "void Com_Init(void)
+    {" and "FUNC(void, COM_CODE) Com_Init(void) {" yield Com_Init.
+    Function bodies are skipped by brace matching. Definitions that only
+    appear after macro expansion are not found; definitions in inactive
+    conditional blocks are.
+
+    Implements: SWR_PARSER_00048 (Lexical Definition Scan)
+
+    Args:
+        content: Full file content
+
+    Returns:
+        Defined function names, once each, in file order
+    """
+    names: Dict[str, None] = {}
+    for definition in iter_function_definitions(content):
+        names[definition.name] = None
+    return list(names)
+
+
+def iter_function_definitions(content: str) -> Iterator[FunctionDefinition]:
+    """
+    Find the function definitions of a source file with their offsets.
+
+    Definitions are recognized as in scan_function_definitions(). A
+    declaration starts after the last ";", "}", "=", "," or preprocessor
+    line at file scope.
+
+    Implements: SWR_PARSER_00049 (Lexical Parse Path),
+    SWR_PARSER_00050 (Native Lexer Accelerator)
+
+    Args:
+        content: Full file content
+
+    Yields:
+        FunctionDefinition of every definition, in file order
+    """
+    if _lexer is not None:
+        for offsets in _lexer.function_definitions(content):
+            yield FunctionDefinition(*offsets)
+    else:
+        yield from _python_function_definitions(content)
+
+
+def _python_scan_braces(content: str) -> Tuple[List[int], Dict[int, int]]:
+    """
+    Find the line offsets and brace matches of SourceScanner in Python.
+
+    Args:
+        content: Full file content
+
+    Returns:
+        Tuple of line offsets and brace spans
+    """
+    line_offsets = [0]
+    line_offsets.extend(match.end() for match in re.finditer("\n", content))
+    brace_spans: Dict[int, int] = {}
+
+    open_braces: List[int] = []
+    for match in _BRACE_TOKEN_PATTERN.finditer(content):
+        token = match.group()
+        if token == "{":
+            open_braces.append(match.start())
+        elif token == "}" and open_braces:
+            brace_spans[open_braces.pop()] = match.end()
+    return line_offsets, brace_spans
+
+
+def _python_function_definitions(content: str) -> Iterator[FunctionDefinition]:
+    """
+    Find the function definitions and their offsets in Python.
+
+    Args:
+        content: Full file content
+
+    Yields:
+        FunctionDefinition of every definition, in file order
+    """
+    candidate: Optional[str] = None  # Identifier before the open "("
+    candidate_start = 0
+    params_start = 0
+    defined: Optional[str] = None  # Candidate whose parameter list closed
+    params_end = 0
+    decl_start = 0
+    previous = ""
+    previous_start = 0
+    paren_depth = 0
+    pos = 0
+    length = len(content)
+    while pos < length:
+        match = _FILE_SCOPE_TOKEN_PATTERN.search(content, pos)
+        if match is None:
+            break
+        pos = match.end()
+        token = match.group()
+        first = token[0]
+        if first in "\"'/":
+            continue
+        if first == "#" or (first in " \t" and token.lstrip()[:1] == "#"):
+            if paren_depth == 0 and defined is None:
+                decl_start = pos
+            continue
+
+        if token == "(":
+            if paren_depth == 0:
+                if _is_identifier(previous):
+                    candidate, candidate_start = previous, previous_start
+                else:
+                    candidate = None
+                params_start = match.start()
+                defined = None
+            paren_depth += 1
+        elif token == ")":
+            if paren_depth > 0:
+                paren_depth -= 1
+                if paren_depth == 0:
+                    defined = candidate
+                    params_end = pos
+        elif token == "{":
+            body_start = match.start()
+            # The block of extern "C" { ... } is still file scope
+            if previous != "extern":
+                pos = _skip_block(content, pos)
+            if paren_depth == 0 and defined is not None:
+                yield FunctionDefinition(
+                    name=defined,
+                    decl_start=decl_start,
+                    name_start=candidate_start,
+                    params_start=params_start,
+                    params_end=params_end,
+                    body_start=body_start,
+                    body_end=pos,
+                )
+            defined = candidate = None
+            decl_start = pos
+        elif paren_depth == 0:
+            defined = None
+            if token in ";},=":
+                decl_start = pos
+        previous = token
+        previous_start = match.start()
+
+
+def _is_identifier(token: str) -> bool:
+    """Check whether a file scope token is an identifier."""
+    return token[:1].isalpha() or token[:1] == "_"
+
+
+def _skip_block(content: str, pos: int) -> int:
+    """
+    Skip to the end of a braced block.
+
+    Args:
+        content: Full file content
+        pos: Offset just past the opening brace
+
+    Returns:
+        Offset just past the matching closing brace (or the end of content)
+    """
+    depth = 1
+    for match in _BLOCK_TOKEN_PATTERN.finditer(content, pos):
+        token = match.group()
+        if token == "{":
+            depth += 1
+        elif token == "}":
+            depth -= 1
+            if depth == 0:
+                return match.end()
+    return len(content)
@@ -5,6 +5,16 @@ This module provides functionality for preprocessing C source files
 using the C preprocessor (cpp) before parsing.
 """
 
-from .cpp_preprocessor import CPPPreprocessor, PreprocessResult, PreprocessStatistics
+from .cpp_preprocessor import (
+    CPPPreprocessor,
+    PreprocessResult,
+    PreprocessStatistics,
+    SharedIncludePrefix,
+)
 
-__all__ = ["CPPPreprocessor", "PreprocessResult", "PreprocessStatistics"]
+__all__ = [
+    "CPPPreprocessor",
+    "PreprocessResult",
+    "PreprocessStatistics",
+    "SharedIncludePrefix",
+]
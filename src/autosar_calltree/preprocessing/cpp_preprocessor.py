@@ -13,17 +13,27 @@ Requirements:
 - SWR_PREPROCESS_00006: Batch preprocessing with progress
 - SWR_PREPROCESS_00007: Temporary file management
 - SWR_PREPROCESS_00008: Preprocessor configuration integration
+- SWR_PREPROCESS_00009: Parallel preprocessing with bounded worker pool
+- SWR_PREPROCESS_00010: Shared include prefix
+- SWR_PREPROCESS_00011: Streaming preprocessing without temp files
+- SWR_PREPROCESS_00012: Per-file preprocessing timings
 """
 
+import hashlib
+import os
 import platform
+import re
 import shutil
 import subprocess
 import tempfile
+import time
+from concurrent.futures import ThreadPoolExecutor
 from dataclasses import dataclass, field
 from pathlib import Path
-from typing import List, Optional
+from typing import Counter, List, Optional, Sequence, Set
 
 from ..config import PreprocessorConfig
+from ..utils.parallel import resolve_jobs
 from ..utils.statistics import (
     ProcessingResult,
     ProcessingStatistics,
@@ -31,6 +41,111 @@ from ..utils.statistics import (
 )
 
 
+# Line marker emitted by cpp: # <line> "<file>" [flags]
+LINE_MARKER_PATTERN = re.compile(
+    r'^#\s*\d+\s+"((?:[^"\\]|\\.)*)".*$', re.MULTILINE
+)
+
+# Include directive at the top of a source file
+_INCLUDE_LINE_PATTERN = re.compile(r"^#\s*include\s*([<\"][^>\"]+[>\"])")
+
+# Name of the generated translation unit holding the shared include prefix
+SHARED_PREFIX_SOURCE = "__shared_include_prefix__.c"
+
+
+def resolve_marker_path(name: str) -> str:
+    """
+    Normalize a file name from a cpp line marker for comparison.
+
+    Args:
+        name: File name as written in the line marker
+
+    Returns:
+        Absolute, normalized path
+    """
+    return os.path.normcase(os.path.realpath(name.replace("\\\\", "\\")))
+
+
+def read_leading_includes(source_file: Path) -> List[str]:
+    """
+    Read the include directives that open a source file.
+
+    Blank lines and comments are skipped; the first other line ends the
+    list, so nothing that could change macro state precedes the includes.
+
+    Args:
+        source_file: Path to the C source file
+
+    Returns:
+        Include targets in order, e.g. ['"Std_Types.h"', '<string.h>']
+    """
+    try:
+        content = source_file.read_text(encoding="utf-8", errors="ignore")
+    except OSError:
+        return []
+
+    includes: List[str] = []
+    in_comment = False
+    for line in content.split("\n"):
+        if in_comment:
+            if "*/" not in line:
+                continue
+            line = line.split("*/", 1)[1]
+            in_comment = False
+        line = re.sub(r"/\*.*?\*/", "", line).split("//", 1)[0]
+        if "/*" in line:
+            line, in_comment = line.split("/*", 1)[0], True
+        line = line.strip()
+        if not line:
+            continue
+        match = _INCLUDE_LINE_PATTERN.match(line)
+        if not match:
+            break
+        includes.append(match.group(1))
+    return includes
+
+
+def find_shared_include_prefix(
+    source_files: Sequence[Path], min_share: float = 0.5
+) -> List[str]:
+    """
+    Find the longest include prefix that most source files start with.
+
+    Args:
+        source_files: C source files of the project
+        min_share: Minimum fraction of files that must share the prefix
+
+    Returns:
+        Include targets of the shared prefix (empty if there is none)
+    """
+    if len(source_files) < 2:
+        return []
+
+    counts: Counter = Counter()
+    for source_file in source_files:
+        includes = tuple(read_leading_includes(source_file))
+        for length in range(1, len(includes) + 1):
+            counts[includes[:length]] += 1
+
+    required = max(2, int(len(source_files) * min_share + 0.999))
+    shared = [prefix for prefix, count in counts.items() if count >= required]
+    return list(max(shared, key=len)) if shared else []
+
+
+@dataclass
+class SharedIncludePrefix:
+    """
+    Include prefix shared by most source files, preprocessed once.
+
+    Implements: SWR_PREPROCESS_00010 (Shared include prefix)
+    """
+
+    includes: List[str]  # Include targets, e.g. '"Std_Types.h"'
+    header_files: Set[str]  # Resolved paths of all headers of the closure
+    output_text: str = ""  # Preprocessed prefix, dropped once parsed
+    typedef_names: Set[str] = field(default_factory=set)  # Filled by the parser
+
+
 @dataclass
 class PreprocessResult(ProcessingResult):
     """
@@ -41,6 +156,7 @@ class PreprocessResult(ProcessingResult):
 
     output_file: Optional[Path] = None  # Path in temp folder, None if failed
     error_type: Optional[str] = None  # 'cpp_not_found', 'cpp_error', 'timeout'
+    output_text: Optional[str] = None  # cpp output when streamed (no file)
 
 
 @dataclass
@@ -52,6 +168,7 @@ class PreprocessStatistics(ProcessingStatistics):
     """
 
     results: List[PreprocessResult] = field(default_factory=list)  # type: ignore[assignment]
+    shared_prefix: Optional[SharedIncludePrefix] = None
 
 
 class CPPPreprocessor:
@@ -84,6 +201,7 @@ class CPPPreprocessor:
         config: Optional[PreprocessorConfig] = None,
         temp_dir: Optional[Path] = None,
         keep_temp: bool = False,
+        jobs: Optional[int] = 1,
     ):
         """
         Initialize the CPP preprocessor.
@@ -92,10 +210,12 @@ class CPPPreprocessor:
             config: Preprocessor configuration (optional)
             temp_dir: Directory for temporary files (default: system temp)
             keep_temp: Whether to keep temp files after processing
+            jobs: Number of concurrent cpp invocations (None: CPU count)
         """
         self.config = config
         self.temp_dir = temp_dir
         self.keep_temp = keep_temp
+        self.jobs = resolve_jobs(jobs)
         self._cpp_path: Optional[str] = None
         self._temp_dir_created: Optional[Path] = None
 
@@ -201,6 +321,11 @@ class CPPPreprocessor:
         Preprocess all files with progress display.
 
         Implements: SWR_PREPROCESS_00006 (Batch preprocessing with progress)
+        Implements: SWR_PREPROCESS_00009 (Parallel preprocessing)
+
+        With more than one job, cpp invocations run concurrently in a thread
+        pool (each worker blocks in subprocess.run, so threads are enough).
+        Results are still collected and reported in input order.
 
         Args:
             source_files: List of source files to preprocess
@@ -214,32 +339,208 @@ class CPPPreprocessor:
         if verbose:
             print("=== Preprocessing Stage ===")
 
+        stats.shared_prefix = self.preprocess_shared_prefix(source_files)
+        if verbose and stats.shared_prefix:
+            print(
+                f"Shared include prefix: {len(stats.shared_prefix.includes)} "
+                f"include(s), {len(stats.shared_prefix.header_files)} header(s)"
+            )
+
+        if self.jobs > 1 and len(source_files) > 1:
+            # Resolve shared state once, before workers race to create it
+            self._get_cpp_path()
+            self._get_temp_dir()
+
+            with ThreadPoolExecutor(max_workers=self.jobs) as executor:
+                results = executor.map(self.preprocess_file, source_files)
+                for idx, result in enumerate(results, 1):
+                    if verbose:
+                        print(
+                            f"[{idx}/{len(source_files)}] "
+                            f"{result.source_file.name:<30} ",
+                            end="",
+                        )
+                    self._record_result(stats, result, verbose)
+            return stats
+
         for idx, source_file in enumerate(source_files, 1):
             if verbose:
                 print(f"[{idx}/{len(source_files)}] {source_file.name:<30} ", end="")
 
             result = self.preprocess_file(source_file)
-            stats.results.append(result)
-
-            if result.success:
-                stats.successful += 1
-                if verbose:
-                    print("OK")
-            else:
-                stats.failed += 1
-                if verbose:
-                    print(f"FAILED ({result.error_type})")
-                    if result.error_message:
-                        print(f"    Error: {result.error_message}")
+            self._record_result(stats, result, verbose)
 
         return stats
 
-    def preprocess_file(self, source_file: Path) -> PreprocessResult:
+    def preprocess_shared_prefix(
+        self, source_files: List[Path]
+    ) -> Optional[SharedIncludePrefix]:
+        """
+        Preprocess the include prefix shared by most source files once.
+
+        The headers of the prefix closure are identified by the line markers
+        of its preprocessed output, so the parser can skip their content in
+        every translation unit.
+
+        Implements: SWR_PREPROCESS_00010 (Shared include prefix)
+
+        Args:
+            source_files: List of source files to preprocess
+
+        Returns:
+            SharedIncludePrefix, or None if no prefix is shared or cpp fails
+        """
+        includes = find_shared_include_prefix(source_files)
+        if not includes:
+            return None
+
+        prefix_source = self._get_temp_dir() / SHARED_PREFIX_SOURCE
+        prefix_source.write_text(
+            "".join(f"#include {include}\n" for include in includes),
+            encoding="utf-8",
+        )
+
+        # Quoted includes of the real files are found next to them
+        source_dirs = sorted({str(f.parent.resolve()) for f in source_files})
+        result = self.preprocess_file(
+            prefix_source, extra_include_dirs=source_dirs, stream=not self.keep_temp
+        )
+        content = self.read_output(result)
+        if content is None:
+            return None
+
+        prefix_path = resolve_marker_path(str(prefix_source))
+        header_files = {
+            resolve_marker_path(name)
+            for name in set(LINE_MARKER_PATTERN.findall(content))
+            if not name.startswith("<")
+        }
+        header_files.discard(prefix_path)
+        if not header_files:
+            return None
+
+        return SharedIncludePrefix(
+            includes=includes,
+            header_files=header_files,
+            output_text=content,
+        )
+
+    def _record_result(
+        self, stats: PreprocessStatistics, result: PreprocessResult, verbose: bool
+    ) -> None:
+        """
+        Add a single file result to the statistics and print its status.
+
+        Args:
+            stats: Statistics to update
+            result: Result of preprocessing one file
+            verbose: Print progress information
+        """
+        stats.results.append(result)
+
+        if result.success:
+            stats.successful += 1
+            if verbose:
+                print("OK")
+        else:
+            stats.failed += 1
+            if verbose:
+                print(f"FAILED ({result.error_type})")
+                if result.error_message:
+                    print(f"    Error: {result.error_message}")
+
+    def get_output_file(self, source_file: Path) -> Path:
+        """
+        Get the temp file path for the preprocessed output of a source file.
+
+        A hash of the resolved source path is part of the name, so files
+        with the same stem in different directories do not collide.
+
+        Args:
+            source_file: Path to source file
+
+        Returns:
+            Path of the .i file in the temp directory
+        """
+        resolved = str(source_file.resolve()).encode("utf-8")
+        path_hash = hashlib.md5(resolved).hexdigest()
+        return self._get_temp_dir() / f"{source_file.stem}_{path_hash[:8]}.i"
+
+    @staticmethod
+    def read_output(result: PreprocessResult) -> Optional[str]:
+        """
+        Get the preprocessed text of a result, streamed or from its file.
+
+        Args:
+            result: Result of preprocess_file()
+
+        Returns:
+            Preprocessed text, or None if preprocessing failed
+        """
+        if not result.success:
+            return None
+        if result.output_text is not None:
+            return result.output_text
+        if result.output_file is None:
+            return None
+        try:
+            return result.output_file.read_text(encoding="utf-8", errors="ignore")
+        except OSError:
+            return None
+
+    def preprocess_file(
+        self,
+        source_file: Path,
+        extra_include_dirs: Sequence[str] = (),
+        stream: bool = False,
+    ) -> PreprocessResult:
         """
         Preprocess a single file.
 
+        With stream=True, cpp writes to a pipe and the output is returned in
+        PreprocessResult.output_text; no file is created.
+
+        The result records the start time, the cpp wall time (step "cpp")
+        and the size of the output.
+
+        Implements: SWR_PREPROCESS_00011 (Streaming preprocessing)
+        Implements: SWR_PREPROCESS_00012 (Per-file preprocessing timings)
+
         Args:
             source_file: Path to source file
+            extra_include_dirs: Include directories searched after the configured ones
+            stream: Return the output in memory instead of writing a .i file
+
+        Returns:
+            PreprocessResult with outcome
+        """
+        start_time = time.time()
+        start = time.perf_counter()
+        result = self._run_cpp(source_file, extra_include_dirs, stream)
+        result.start_time = start_time
+        result.timings["cpp"] = time.perf_counter() - start
+        if result.output_text is not None:
+            result.bytes_processed = len(result.output_text)
+        elif result.output_file is not None:
+            try:
+                result.bytes_processed = result.output_file.stat().st_size
+            except OSError:
+                pass
+        return result
+
+    def _run_cpp(
+        self,
+        source_file: Path,
+        extra_include_dirs: Sequence[str],
+        stream: bool,
+    ) -> PreprocessResult:
+        """
+        Run cpp on a single file (see preprocess_file()).
+
+        Args:
+            source_file: Path to source file
+            extra_include_dirs: Include directories searched after the configured ones
+            stream: Return the output in memory instead of writing a .i file
 
         Returns:
             PreprocessResult with outcome
@@ -255,15 +556,14 @@ class CPPPreprocessor:
                 error_type="cpp_not_found",
             )
 
-        # Get temp directory
-        temp_dir = self._get_temp_dir()
-
         # Determine output file path
-        output_file = temp_dir / f"{source_file.stem}.i"
+        output_file = None if stream else self.get_output_file(source_file)
 
         try:
             # Build cpp command
-            cmd = self._build_command(cpp_path, source_file, output_file)
+            cmd = self._build_command(
+                cpp_path, source_file, output_file, extra_include_dirs
+            )
 
             # Run preprocessor
             result = subprocess.run(
@@ -289,6 +589,25 @@ class CPPPreprocessor:
                     error_type="cpp_error",
                 )
 
+            if output_file is None:
+                if not result.stdout:
+                    return PreprocessResult(
+                        source_file=source_file,
+                        output_file=None,
+                        success=False,
+                        error_message="Output is empty",
+                        error_type="cpp_error",
+                    )
+                return PreprocessResult(
+                    source_file=source_file,
+                    success=True,
+                    output_text=result.stdout,
+                )
+
+            # Plain cpp writes to stdout instead of -o
+            if "-o" not in cmd and result.stdout:
+                output_file.write_text(result.stdout, encoding="utf-8")
+
             # Check output file exists and has content
             if not output_file.exists():
                 return PreprocessResult(
@@ -340,7 +659,11 @@ class CPPPreprocessor:
             )
 
     def _build_command(
-        self, cpp_path: str, source_file: Path, output_file: Path
+        self,
+        cpp_path: str,
+        source_file: Path,
+        output_file: Optional[Path],
+        extra_include_dirs: Sequence[str] = (),
     ) -> List[str]:
         """
         Build the cpp command.
@@ -350,7 +673,8 @@ class CPPPreprocessor:
         Args:
             cpp_path: Path to cpp executable
             source_file: Source file to preprocess
-            output_file: Output file path
+            output_file: Output file path (None: write to stdout)
+            extra_include_dirs: Include directories added after the configured ones
 
         Returns:
             List of command arguments
@@ -358,7 +682,9 @@ class CPPPreprocessor:
         cmd = [cpp_path, "-E"]  # -E for preprocessing only
 
         # Add -o for output file (if using gcc/clang)
-        if "gcc" in cpp_path or "clang" in cpp_path or cpp_path.endswith("cc1"):
+        if output_file is not None and (
+            "gcc" in cpp_path or "clang" in cpp_path or cpp_path.endswith("cc1")
+        ):
             cmd.extend(["-o", str(output_file)])
 
         # Add include directories from config
@@ -373,6 +699,9 @@ class CPPPreprocessor:
             # Add extra flags
             cmd.extend(self.config.extra_flags)
 
+        for inc_dir in extra_include_dirs:
+            cmd.extend(["-I", inc_dir])
+
         # Add input file
         cmd.append(str(source_file))
 
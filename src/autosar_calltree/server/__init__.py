@@ -0,0 +1,5 @@
+"""Server package initialization."""
+
+from .analysis_server import AnalysisServer, AnalysisService
+
+__all__ = ["AnalysisServer", "AnalysisService"]
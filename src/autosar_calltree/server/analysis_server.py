@@ -0,0 +1,479 @@
+"""
+Analysis server module.
+
+This module keeps a FunctionDatabase warm in memory and answers call tree
+queries over a local HTTP socket. A watcher thread polls the source
+directory and swaps in an incrementally rebuilt database when files change.
+
+Requirements:
+- SWR_SERVER_00001: Warm In-Memory Database
+- SWR_SERVER_00002: HTTP Query Interface
+- SWR_SERVER_00003: Source Directory Watching
+"""
+
+import json
+import threading
+from dataclasses import asdict
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from typing import Any, Callable, Dict, List, Optional, Tuple, Union
+from urllib.parse import parse_qs, urlparse
+
+from ..analyzers.call_tree_builder import CallTreeBuilder
+from ..database.function_database import FunctionDatabase
+from ..database.models import AnalysisResult, CallTreeNode
+from ..generators.mermaid_generator import MermaidGenerator
+from ..generators.rhapsody_generator import RhapsodyXmiGenerator
+
+# Snapshot of the source tree: file path -> (st_mtime_ns, st_size)
+SourceSnapshot = Dict[str, Tuple[int, int]]
+
+
+class QueryError(Exception):
+    """Invalid query; carries the HTTP status to answer with."""
+
+    def __init__(self, status: int, message: str):
+        super().__init__(message)
+        self.status = status
+
+
+def _node_fields(node: CallTreeNode) -> Dict[str, Any]:
+    """Get the JSON fields of a call tree node, without its children."""
+    func_info = node.function_info
+    return {
+        "function": func_info.name,
+        "file": str(func_info.file_path),
+        "line": func_info.line_number,
+        "sw_module": func_info.sw_module,
+        "depth": node.depth,
+        "is_recursive": node.is_recursive,
+        "is_truncated": node.is_truncated,
+        "is_optional": node.is_optional,
+        "condition": node.condition,
+        "is_loop": node.is_loop,
+        "loop_condition": node.loop_condition,
+    }
+
+
+def tree_to_json(root: CallTreeNode) -> str:
+    """
+    Convert a call tree to a JSON object of nested nodes.
+
+    The tree is walked with an explicit stack, so its depth is not limited
+    by the recursion limit (nor is that of json.dumps(), which only gets
+    single nodes). Subtrees shared by CallTreeBuilder (SWR_ANALYZER_00016)
+    are written once: the first node with a shared children list gets a
+    "subtree_id", later ones get its "subtree_ref" and no children. The
+    response therefore grows with the physical, not the logical nodes.
+
+    Implements: SWR_SERVER_00002 (HTTP Query Interface)
+
+    Args:
+        root: Root node of the tree
+
+    Returns:
+        JSON text of the root node
+    """
+    # Number of nodes sharing each (non-empty) children list
+    users: Dict[int, int] = {}
+    pending = [root]
+    while pending:
+        node = pending.pop()
+        if node.children:
+            key = id(node.children)
+            users[key] = users.get(key, 0) + 1
+            if users[key] == 1:
+                pending.extend(node.children)
+
+    subtree_ids: Dict[int, int] = {}
+    parts: List[str] = []
+    stack: List[Union[CallTreeNode, str]] = [root]
+    while stack:
+        item = stack.pop()
+        if isinstance(item, str):
+            parts.append(item)
+            continue
+
+        fields = _node_fields(item)
+        key = id(item.children)
+        if item.children and users[key] > 1:
+            if key in subtree_ids:
+                fields["subtree_ref"] = subtree_ids[key]
+                fields["children"] = []
+                parts.append(json.dumps(fields))
+                continue
+            fields["subtree_id"] = subtree_ids[key] = len(subtree_ids)
+
+        # Open the node's object and its children list; "]}" closes both
+        parts.append(json.dumps(fields)[:-1] + ', "children": [')
+        stack.append("]}")
+        for index in range(len(item.children) - 1, -1, -1):
+            stack.append(item.children[index])
+            if index:
+                stack.append(", ")
+    return "".join(parts)
+
+
+def take_source_snapshot(db: FunctionDatabase) -> SourceSnapshot:
+    """
+    Stat all C source files of a database's source directory.
+
+    Args:
+        db: Function database
+
+    Returns:
+        SourceSnapshot of the source directory
+    """
+    snapshot: SourceSnapshot = {}
+    for file_path in db.source_dir.rglob("*.c"):
+        try:
+            stat_result = file_path.stat()
+        except OSError:
+            continue
+        snapshot[str(file_path)] = (stat_result.st_mtime_ns, stat_result.st_size)
+    return snapshot
+
+
+class AnalysisService:
+    """
+    Thread-safe query service over a warm FunctionDatabase.
+
+    Queries always run against the current database object. A refresh
+    builds a new database and replaces the reference, so queries never
+    see a half-built database and are not blocked by rebuilds.
+    """
+
+    def __init__(
+        self,
+        db: FunctionDatabase,
+        db_factory: Callable[[], FunctionDatabase],
+        use_module_names: bool = False,
+        abbreviate_rte: bool = True,
+    ):
+        """
+        Initialize the analysis service.
+
+        Args:
+            db: Already built function database
+            db_factory: Creates and builds a new database (used on refresh)
+            use_module_names: Use SW module names in generated diagrams
+            abbreviate_rte: Abbreviate RTE function names in Mermaid diagrams
+        """
+        self.db = db
+        self.db_factory = db_factory
+        self.use_module_names = use_module_names
+        self.abbreviate_rte = abbreviate_rte
+        self.snapshot = take_source_snapshot(db)
+        self.refresh_count = 0
+        self._refresh_lock = threading.Lock()
+        self._stop_event = threading.Event()
+        self._watcher: Optional[threading.Thread] = None
+
+    def list_functions(self) -> List[str]:
+        """
+        List all function names.
+
+        Returns:
+            Sorted function names
+        """
+        return self.db.get_all_function_names()
+
+    def search(
+        self, pattern: str, mode: str = "substring", limit: Optional[int] = None
+    ) -> List[Dict[str, Any]]:
+        """
+        Search functions by name.
+
+        Args:
+            pattern: Search pattern
+            mode: "substring", "prefix" or "regex"
+            limit: Maximum number of results (None: all)
+
+        Returns:
+            List of {name, file, line} dictionaries
+
+        Raises:
+            QueryError: If the mode or the regular expression is invalid
+        """
+        try:
+            results = self.db.search_functions(pattern, mode=mode, limit=limit)
+        except ValueError as e:
+            raise QueryError(400, str(e))
+        return [
+            {
+                "name": func_info.name,
+                "file": str(func_info.file_path),
+                "line": func_info.line_number,
+            }
+            for func_info in results
+        ]
+
+    def status(self) -> Dict[str, Any]:
+        """
+        Report database and watcher status.
+
+        Returns:
+            Status dictionary
+        """
+        db = self.db
+        return {
+            "source_dir": str(db.source_dir),
+            "files": db.total_files_scanned,
+            "functions": db.total_functions_found,
+            "refreshes": self.refresh_count,
+        }
+
+    def build_tree(
+        self,
+        start_function: str,
+        max_depth: int = 3,
+        output_format: str = "json",
+        enable_loops: bool = False,
+        enable_conditionals: bool = False,
+        max_nodes: Optional[int] = None,
+        time_budget: Optional[float] = None,
+    ) -> Tuple[str, str]:
+        """
+        Build a call tree and render it.
+
+        Implements: SWR_SERVER_00002 (HTTP Query Interface)
+
+        Args:
+            start_function: Name of the function to start from
+            max_depth: Maximum depth to traverse
+            output_format: "json", "mermaid" or "rhapsody"
+            enable_loops: Enable loop detection and representation
+            enable_conditionals: Enable if-else conditional detection
+            max_nodes: Node budget of the tree (SWR_ANALYZER_00020)
+            time_budget: Time budget of the tree in seconds
+
+        Returns:
+            Tuple of content type and body
+
+        Raises:
+            QueryError: If the format is unknown or the function is not found
+        """
+        if output_format not in ("json", "mermaid", "rhapsody"):
+            raise QueryError(400, f"Unknown format '{output_format}'")
+
+        result = CallTreeBuilder(self.db).build_tree(
+            start_function=start_function,
+            max_depth=max_depth,
+            enable_loops=enable_loops,
+            enable_conditionals=enable_conditionals,
+            max_nodes=max_nodes,
+            time_budget=time_budget,
+        )
+        if result.errors:
+            raise QueryError(404, "; ".join(result.errors))
+
+        if output_format == "mermaid":
+            generator = MermaidGenerator(
+                abbreviate_rte=self.abbreviate_rte,
+                use_module_names=self.use_module_names,
+            )
+            return "text/markdown; charset=utf-8", generator.generate_to_string(result)
+
+        if output_format == "rhapsody":
+            xmi = RhapsodyXmiGenerator(
+                use_module_names=self.use_module_names
+            ).generate_to_string(result)
+            return "application/xml; charset=utf-8", xmi
+
+        return "application/json", self._result_to_json(result)
+
+    def _result_to_json(self, result: AnalysisResult) -> str:
+        """Convert an analysis result to JSON, with the tree of tree_to_json()."""
+        assert result.call_tree is not None
+        head = {
+            "root_function": result.root_function,
+            "statistics": result.statistics.to_dict(),
+            "circular_dependencies": [
+                {"cycle": dep.cycle, "depth": dep.depth}
+                for dep in result.circular_dependencies
+            ],
+            "truncation": (
+                None if result.truncation is None else asdict(result.truncation)
+            ),
+        }
+        call_tree = tree_to_json(result.call_tree)
+        return f'{json.dumps(head)[:-1]}, "call_tree": {call_tree}}}'
+
+    def refresh_if_changed(self) -> bool:
+        """
+        Rebuild the database if any source file was changed, added or removed.
+
+        Changes are detected by comparing (st_mtime_ns, st_size) of all
+        source files. The rebuild goes through the incremental cache, so
+        only touched files are parsed again.
+
+        Implements: SWR_SERVER_00003 (Source Directory Watching)
+
+        Returns:
+            True if the database was replaced
+        """
+        with self._refresh_lock:
+            snapshot = take_source_snapshot(self.db)
+            if snapshot == self.snapshot:
+                return False
+
+            self.db = self.db_factory()
+            self.snapshot = snapshot
+            self.refresh_count += 1
+            return True
+
+    def start_watching(self, interval: float) -> None:
+        """
+        Start polling the source directory in a daemon thread.
+
+        Args:
+            interval: Seconds between polls
+        """
+
+        def watch() -> None:
+            while not self._stop_event.wait(interval):
+                try:
+                    self.refresh_if_changed()
+                except Exception as e:
+                    print(f"Warning: Failed to refresh database: {e}")
+
+        self._watcher = threading.Thread(target=watch, daemon=True)
+        self._watcher.start()
+
+    def stop(self) -> None:
+        """Stop the watcher thread."""
+        self._stop_event.set()
+        if self._watcher:
+            self._watcher.join()
+            self._watcher = None
+
+
+def _parse_flag(params: Dict[str, List[str]], name: str) -> bool:
+    """Read a boolean query parameter (1/true/yes)."""
+    value = params.get(name, ["0"])[0].lower()
+    return value in ("1", "true", "yes")
+
+
+class AnalysisRequestHandler(BaseHTTPRequestHandler):
+    """
+    HTTP handler for analysis queries.
+
+    Endpoints:
+        GET /status
+        GET /functions
+        GET /search?pattern=<text>&mode=substring|prefix|regex&limit=<n>
+        GET /tree?start=<function>&depth=<n>&format=json|mermaid|rhapsody
+                  &loops=1&conditionals=1
+    """
+
+    server: "AnalysisServer"
+
+    def do_GET(self) -> None:
+        """Dispatch a GET request."""
+        url = urlparse(self.path)
+        params = parse_qs(url.query)
+        service = self.server.service
+
+        try:
+            if url.path == "/status":
+                self._send_json(service.status())
+            elif url.path == "/functions":
+                self._send_json(service.list_functions())
+            elif url.path == "/search":
+                limit: Optional[int] = None
+                try:
+                    if "limit" in params:
+                        limit = int(params["limit"][0])
+                except ValueError:
+                    raise QueryError(400, "limit must be an integer")
+                self._send_json(
+                    service.search(
+                        self._require(params, "pattern"),
+                        mode=params.get("mode", ["substring"])[0],
+                        limit=limit,
+                    )
+                )
+            elif url.path == "/tree":
+                try:
+                    depth = int(params.get("depth", ["3"])[0])
+                except ValueError:
+                    raise QueryError(400, "depth must be an integer")
+                max_nodes: Optional[int] = None
+                time_budget: Optional[float] = None
+                try:
+                    if "max_nodes" in params:
+                        max_nodes = int(params["max_nodes"][0])
+                    if "time_budget" in params:
+                        time_budget = float(params["time_budget"][0])
+                except ValueError:
+                    raise QueryError(400, "max_nodes and time_budget must be numbers")
+                content_type, body = service.build_tree(
+                    start_function=self._require(params, "start"),
+                    max_depth=depth,
+                    output_format=params.get("format", ["json"])[0],
+                    enable_loops=_parse_flag(params, "loops"),
+                    enable_conditionals=_parse_flag(params, "conditionals"),
+                    max_nodes=max_nodes,
+                    time_budget=time_budget,
+                )
+                self._send(200, content_type, body)
+            else:
+                raise QueryError(404, f"Unknown endpoint '{url.path}'")
+        except QueryError as e:
+            self._send_json({"error": str(e)}, status=e.status)
+        except Exception as e:
+            self._send_json({"error": str(e)}, status=500)
+
+    def _require(self, params: Dict[str, List[str]], name: str) -> str:
+        """Get a required query parameter."""
+        values = params.get(name)
+        if not values or not values[0]:
+            raise QueryError(400, f"Missing query parameter '{name}'")
+        return values[0]
+
+    def _send_json(self, data: Any, status: int = 200) -> None:
+        """Send a JSON response."""
+        self._send(status, "application/json", json.dumps(data))
+
+    def _send(self, status: int, content_type: str, body: str) -> None:
+        """Send a response with the given body."""
+        payload = body.encode("utf-8")
+        self.send_response(status)
+        self.send_header("Content-Type", content_type)
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        self.wfile.write(payload)
+
+    def log_message(self, format: str, *args: Any) -> None:
+        """Log requests only in verbose mode."""
+        if self.server.verbose:
+            super().log_message(format, *args)
+
+
+class AnalysisServer(ThreadingHTTPServer):
+    """
+    Local HTTP server answering call tree queries from a warm database.
+
+    Implements: SWR_SERVER_00001 (Warm In-Memory Database)
+    """
+
+    daemon_threads = True
+
+    def __init__(
+        self,
+        service: AnalysisService,
+        host: str = "127.0.0.1",
+        port: int = 8765,
+        verbose: bool = False,
+    ):
+        """
+        Initialize the server.
+
+        Args:
+            service: Query service holding the database
+            host: Interface to bind to (default: localhost only)
+            port: TCP port (0 picks a free port)
+            verbose: Log each request
+        """
+        self.service = service
+        self.verbose = verbose
+        super().__init__((host, port), AnalysisRequestHandler)
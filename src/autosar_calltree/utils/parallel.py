@@ -0,0 +1,24 @@
+"""
+Parallel execution helpers.
+
+This module provides small helpers shared by the pipeline stages that
+can fan work out over a worker pool (preprocessing, parsing).
+"""
+
+import os
+from typing import Optional
+
+
+def resolve_jobs(jobs: Optional[int]) -> int:
+    """
+    Resolve a requested worker count to a concrete number of workers.
+
+    Args:
+        jobs: Requested number of workers. None or 0 means "use all CPUs".
+
+    Returns:
+        Number of workers to use (always >= 1)
+    """
+    if not jobs or jobs < 0:
+        return max(1, os.cpu_count() or 1)
+    return jobs
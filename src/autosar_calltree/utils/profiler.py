@@ -0,0 +1,323 @@
+"""
+Build profiling.
+
+This module records where the time of a run goes: wall time, CPU time
+and processed bytes of every stage (preprocessing, parsing, indexing,
+cache I/O, tree building, generators) and the per-step timings of every
+file that ProcessingResult objects carry (cpp, read, AUTOSAR scan, macro
+lowering, definition scan, pycparser, visitor). The profile is shown as a
+stage table and a table of the slowest files, and written as a Chrome trace
+(chrome://tracing, Perfetto) whose JSON also holds the raw stage and file
+records.
+
+Requirements:
+- SWR_DB_00044: Build Profiling
+"""
+
+import json
+import time
+from contextlib import contextmanager
+from dataclasses import asdict, dataclass, field
+from pathlib import Path
+from typing import Any, Dict, Iterable, Iterator, List, Optional
+
+from .statistics import ProcessingResult
+
+# Order of the per-file steps in reports and traces
+FILE_STEPS = (
+    "cpp",
+    "read",
+    "autosar",
+    "lowering",
+    "scan",
+    "pycparser",
+    "visitor",
+    "index",
+)
+
+
+@dataclass
+class ProfileEvent:
+    """Timing of one stage or of one file within a stage."""
+
+    name: str  # Stage name, or source file for file events
+    category: str  # "stage", or the stage name for file events
+    start: float  # time.time() at the start, 0.0 if unknown
+    wall: float = 0.0  # Wall time in seconds
+    cpu: Optional[float] = None  # CPU time of this process in seconds (stages)
+    bytes: int = 0  # Processed input or written output size
+    steps: Dict[str, float] = field(default_factory=dict)  # Seconds per step
+
+
+@dataclass
+class FileProfile:
+    """Time spent on one file over all stages."""
+
+    file: str
+    wall: float
+    bytes: int
+    steps: Dict[str, float]
+
+
+class Profiler:
+    """
+    Collects stage and file timings of one run.
+
+    A disabled profiler accepts all calls and records nothing, so callers
+    do not need to check whether profiling is on.
+
+    Implements: SWR_DB_00044 (Build Profiling)
+    """
+
+    def __init__(self, enabled: bool = True):
+        """
+        Initialize the profiler.
+
+        Args:
+            enabled: Whether events are recorded
+        """
+        self.enabled = enabled
+        self.stages: List[ProfileEvent] = []
+        self.files: List[ProfileEvent] = []
+
+    @contextmanager
+    def stage(self, name: str) -> Iterator[ProfileEvent]:
+        """
+        Time a stage.
+
+        The yielded event may be updated, e.g. with the bytes processed.
+        Nested stages are recorded separately; their time is also part of
+        the enclosing stage.
+
+        Args:
+            name: Stage name
+
+        Yields:
+            ProfileEvent of the stage, recorded when the block ends
+        """
+        event = ProfileEvent(name=name, category="stage", start=time.time())
+        wall_start = time.perf_counter()
+        cpu_start = time.process_time()
+        try:
+            yield event
+        finally:
+            event.wall = time.perf_counter() - wall_start
+            event.cpu = time.process_time() - cpu_start
+            if self.enabled:
+                self.stages.append(event)
+
+    def add_file(
+        self,
+        stage: str,
+        source_file: Path,
+        start: Optional[float],
+        timings: Dict[str, float],
+        size: int = 0,
+    ) -> None:
+        """
+        Record the timings of one file.
+
+        Args:
+            stage: Stage the file was processed in
+            source_file: Source file
+            start: time.time() when processing started, if known
+            timings: Seconds per step
+            size: Processed bytes
+        """
+        if not self.enabled or not timings:
+            return
+        self.files.append(
+            ProfileEvent(
+                name=str(source_file),
+                category=stage,
+                start=start if start is not None else 0.0,
+                wall=sum(timings.values()),
+                bytes=size,
+                steps=dict(timings),
+            )
+        )
+
+    def add_results(self, stage: str, results: Iterable[ProcessingResult]) -> None:
+        """
+        Record the timings carried by processing results.
+
+        Args:
+            stage: Stage the results belong to
+            results: Results with timings (e.g. ParseResult, PreprocessResult)
+        """
+        if not self.enabled:
+            return
+        for result in results:
+            self.add_file(
+                stage,
+                result.source_file,
+                result.start_time,
+                result.timings,
+                result.bytes_processed,
+            )
+
+    def slowest_files(self, count: int = 10) -> List[FileProfile]:
+        """
+        Get the files with the highest total time over all stages.
+
+        Args:
+            count: Maximum number of files
+
+        Returns:
+            FileProfile objects, slowest first
+        """
+        by_file: Dict[str, FileProfile] = {}
+        for event in self.files:
+            profile = by_file.get(event.name)
+            if profile is None:
+                profile = by_file[event.name] = FileProfile(event.name, 0.0, 0, {})
+            profile.wall += event.wall
+            profile.bytes = max(profile.bytes, event.bytes)
+            for step, seconds in event.steps.items():
+                profile.steps[step] = profile.steps.get(step, 0.0) + seconds
+        return sorted(by_file.values(), key=lambda p: p.wall, reverse=True)[:count]
+
+    def format_report(self, top: int = 10) -> str:
+        """
+        Format the stage table and the slowest files as text.
+
+        Args:
+            top: Number of slowest files to list
+
+        Returns:
+            Report text
+        """
+        lines = [
+            "Stages:",
+            f"  {'Stage':<24} {'Wall (s)':>10} {'CPU (s)':>10} {'Bytes':>12}",
+        ]
+        for event in self.stages:
+            lines.append(
+                f"  {event.name:<24} {event.wall:10.3f} "
+                f"{event.cpu or 0.0:10.3f} {event.bytes:12d}"
+            )
+
+        slowest = self.slowest_files(top)
+        if slowest:
+            steps = [s for s in FILE_STEPS if any(s in p.steps for p in slowest)]
+            lines.append("")
+            lines.append(f"Slowest {len(slowest)} files (seconds):")
+            lines.append(
+                f"  {'File':<32} {'Total':>8} "
+                + " ".join(f"{step:>9}" for step in steps)
+                + f" {'Bytes':>10}"
+            )
+            for profile in slowest:
+                name = Path(profile.file).name
+                step_times = (profile.steps.get(step, 0.0) for step in steps)
+                lines.append(
+                    f"  {name[:32]:<32} {profile.wall:8.3f} "
+                    + " ".join(f"{seconds:9.3f}" for seconds in step_times)
+                    + f" {profile.bytes:10d}"
+                )
+        return "\n".join(lines)
+
+    def to_chrome_trace(self) -> Dict[str, Any]:
+        """
+        Build a Chrome trace of the profile.
+
+        Stages are drawn on one track; files get as many tracks as were
+        processed at the same time (e.g. by worker processes), each file
+        with its steps nested in order. The stage and file records are
+        included under "stages" and "files"; trace viewers ignore them.
+
+        Returns:
+            JSON-serializable trace object
+        """
+        timed_files = sorted(
+            (event for event in self.files if event.start), key=lambda e: e.start
+        )
+        starts = [event.start for event in self.stages + timed_files]
+        origin = min(starts) if starts else 0.0
+        events: List[Dict[str, Any]] = [_thread_name(0, "stages")]
+        for event in self.stages:
+            events.append(
+                {
+                    "name": event.name,
+                    "cat": event.category,
+                    "ph": "X",
+                    "pid": 0,
+                    "tid": 0,
+                    "ts": (event.start - origin) * 1e6,
+                    "dur": event.wall * 1e6,
+                    "args": {"cpu_s": event.cpu, "bytes": event.bytes},
+                }
+            )
+
+        # Greedy track assignment of the file intervals
+        track_ends: List[float] = []
+        for event in timed_files:
+            for track, end in enumerate(track_ends):
+                if end <= event.start:
+                    break
+            else:
+                track = len(track_ends)
+                track_ends.append(0.0)
+                events.append(_thread_name(track + 1, f"files {track + 1}"))
+            track_ends[track] = event.start + event.wall
+            ts = (event.start - origin) * 1e6
+            events.append(
+                {
+                    "name": Path(event.name).name,
+                    "cat": event.category,
+                    "ph": "X",
+                    "pid": 0,
+                    "tid": track + 1,
+                    "ts": ts,
+                    "dur": event.wall * 1e6,
+                    "args": {"file": event.name, "bytes": event.bytes},
+                }
+            )
+            for step in sorted(event.steps, key=_step_order):
+                duration = event.steps[step] * 1e6
+                events.append(
+                    {
+                        "name": step,
+                        "cat": event.category,
+                        "ph": "X",
+                        "pid": 0,
+                        "tid": track + 1,
+                        "ts": ts,
+                        "dur": duration,
+                    }
+                )
+                ts += duration
+
+        return {
+            "traceEvents": events,
+            "displayTimeUnit": "ms",
+            "stages": [asdict(event) for event in self.stages],
+            "files": [asdict(event) for event in self.files],
+        }
+
+    def write(self, path: Path) -> None:
+        """
+        Write the profile as a Chrome trace JSON file.
+
+        Args:
+            path: Output file; its directory is created if needed
+        """
+        path.parent.mkdir(parents=True, exist_ok=True)
+        with open(path, "w", encoding="utf-8") as f:
+            json.dump(self.to_chrome_trace(), f)
+
+
+def _thread_name(tid: int, name: str) -> Dict[str, Any]:
+    """Build the metadata event naming a trace track."""
+    return {
+        "name": "thread_name",
+        "ph": "M",
+        "pid": 0,
+        "tid": tid,
+        "args": {"name": name},
+    }
+
+
+def _step_order(step: str) -> int:
+    """Sort key of the per-file steps (unknown steps last)."""
+    return FILE_STEPS.index(step) if step in FILE_STEPS else len(FILE_STEPS)
@@ -7,7 +7,7 @@ and displaying processing statistics across the codebase.
 
 from dataclasses import dataclass, field
 from pathlib import Path
-from typing import List, Optional
+from typing import Dict, List, Optional
 
 
 @dataclass
@@ -17,10 +17,21 @@ class ProcessingResult:
 
     Subclasses may add additional fields for their specific needs
     (e.g., ParseResult adds functions, autosar_functions, traditional_functions).
+
+    The timing fields are filled by the stages for profiling (SWR_DB_00044);
+    timings maps a step name (e.g. "cpp", "read", "pycparser") to seconds.
     """
     source_file: Path
     success: bool
     error_message: Optional[str] = None
+    start_time: Optional[float] = None  # time.time() when processing started
+    timings: Dict[str, float] = field(default_factory=dict)
+    bytes_processed: int = 0  # Size of the processed input or output
+
+    @property
+    def total_time(self) -> float:
+        """Sum of all step timings in seconds."""
+        return sum(self.timings.values())
 
 
 @dataclass
@@ -9,12 +9,34 @@ from pathlib import Path
 from typing import TYPE_CHECKING
 
 if TYPE_CHECKING:
-    from ..database.models import CallTreeNode
+    from ..database.models import CallTreeNode, FunctionInfo
 
 
 class TreeFormatter:
     """Format call trees as text-based tree diagrams."""
 
+    @staticmethod
+    def format_function(
+        func_info: "FunctionInfo", show_file: bool = True, show_line: bool = True
+    ) -> str:
+        """
+        Format the label of one function in a tree.
+
+        Args:
+            func_info: Function information
+            show_file: Include file name in output
+            show_line: Include line number in output
+
+        Returns:
+            Function name with its file:line location
+        """
+        if not show_file:
+            return func_info.name
+        file_name = Path(func_info.file_path).name
+        if show_line:
+            return f"{func_info.name} ({file_name}:{func_info.line_number})"
+        return f"{func_info.name} ({file_name})"
+
     @staticmethod
     def format_tree(
         root: "CallTreeNode",
@@ -24,6 +46,9 @@ class TreeFormatter:
         """
         Generate text-based tree representation.
 
+        The tree is walked with an explicit stack, so its depth is not
+        limited by the recursion limit.
+
         Args:
             root: Root node of call tree
             show_file: Include file name in output
@@ -34,43 +59,33 @@ class TreeFormatter:
         """
         lines = []
 
-        def format_location(node: "CallTreeNode") -> str:
-            """Format file:line location."""
-            if not show_file:
-                return ""
-            file_name = Path(node.function_info.file_path).name
-            if show_line:
-                return f" ({file_name}:{node.function_info.line_number})"
-            return f" ({file_name})"
-
-        def traverse(node: "CallTreeNode", prefix: str = "", is_last: bool = True):
-            connector = "└── " if is_last else "├── "
-
-            func_name = node.function_info.name
-            location = format_location(node)
-            line = f"{prefix}{connector}{func_name}{location}"
-
+        def format_node(node: "CallTreeNode", head: str) -> str:
+            line = head + TreeFormatter.format_function(
+                node.function_info, show_file, show_line
+            )
             if node.is_recursive:
                 line += " [RECURSIVE]"
-
-            lines.append(line)
-
-            if node.children:
-                new_prefix = prefix + ("    " if is_last else "│   ")
-                for idx, child in enumerate(node.children):
-                    is_last_child = idx == len(node.children) - 1
-                    traverse(child, new_prefix, is_last_child)
+            if node.is_truncated:
+                line += " [TRUNCATED]"
+            return line
 
         # Root node (no prefix)
-        func_name = root.function_info.name
-        location = format_location(root)
-        root_line = f"{func_name}{location}"
-        if root.is_recursive:
-            root_line += " [RECURSIVE]"
-        lines.append(root_line)
-
-        for idx, child in enumerate(root.children):
-            is_last = idx == len(root.children) - 1
-            traverse(child, "", is_last)
+        lines.append(format_node(root, ""))
+
+        # Stack of (children, next index, prefix); pushed in visiting order
+        stack = [(root.children, 0, "")]
+        while stack:
+            children, index, prefix = stack.pop()
+            if index == len(children):
+                continue
+            stack.append((children, index + 1, prefix))
+
+            is_last = index == len(children) - 1
+            child = children[index]
+            connector = "└── " if is_last else "├── "
+            lines.append(format_node(child, f"{prefix}{connector}"))
+            if child.children:
+                new_prefix = prefix + ("    " if is_last else "│   ")
+                stack.append((child.children, 0, new_prefix))
 
         return "\n".join(lines)
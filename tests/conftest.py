@@ -2,12 +2,17 @@
 Pytest configuration and fixtures.
 """
 
+import io
+from contextlib import redirect_stdout
 from pathlib import Path
 from tempfile import TemporaryDirectory
-from typing import Generator
+from typing import Callable, Generator
 
 import pytest
 
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.database.models import FunctionCall, FunctionInfo, FunctionType
+
 
 @pytest.fixture
 def test_fixtures_dir() -> Path:
@@ -24,6 +29,56 @@ def demo_dir() -> Path:
     return demo_path
 
 
+@pytest.fixture
+def make_function() -> Callable[..., FunctionInfo]:
+    """
+    Factory for FunctionInfo records that tests add to a database by hand.
+
+    Calls may be given as names or as FunctionCall objects. Keyword
+    arguments override the defaults of a plain, non-static C function.
+    """
+
+    def factory(name, file_path="module.c", calls=(), **fields) -> FunctionInfo:
+        values = {
+            "return_type": "void",
+            "line_number": 1,
+            "is_static": False,
+            "function_type": FunctionType.TRADITIONAL_C,
+        }
+        values.update(fields)
+        return FunctionInfo(
+            name=name,
+            file_path=Path(file_path),
+            calls=[
+                call if isinstance(call, FunctionCall) else FunctionCall(name=call)
+                for call in calls
+            ],
+            **values,
+        )
+
+    return factory
+
+
+@pytest.fixture
+def build_demo_db() -> Callable[..., FunctionDatabase]:
+    """
+    Factory that builds a database of the demo sources with a cache.
+
+    Build output is suppressed. Keyword arguments are passed to
+    FunctionDatabase, e.g. another source_dir or a module_config.
+    """
+
+    def factory(cache_dir, source_dir="./demo", **kwargs) -> FunctionDatabase:
+        db = FunctionDatabase(
+            source_dir=str(source_dir), cache_dir=str(cache_dir), **kwargs
+        )
+        with redirect_stdout(io.StringIO()):
+            db.build_database(use_cache=True, verbose=False)
+        return db
+
+    return factory
+
+
 @pytest.fixture
 def temp_output_dir() -> Generator[Path, None, None]:
     """
@@ -4,11 +4,14 @@ CLI integration tests.
 Tests the Click-based CLI using CliRunner.
 """
 
+import json
 from pathlib import Path
+from unittest.mock import patch
 
 from click.testing import CliRunner
 
 from autosar_calltree.cli.main import cli
+from autosar_calltree.database import cache_file
 
 
 class TestCLIBasicStructure:
@@ -436,6 +439,33 @@ class TestSearchFunctionsCommand:
                 break
 
 
+    def test_search_mode_and_limit(self, demo_dir):
+        """Test that --search-mode and --search-limit select and cap results."""
+        runner = CliRunner()
+        result = runner.invoke(
+            cli,
+            [
+                "--source-dir",
+                str(demo_dir),
+                "--search",
+                "^Demo_",
+                "--search-mode",
+                "regex",
+                "--search-limit",
+                "2",
+            ],
+        )
+        assert result.exit_code == 0
+        assert "Showing the first 2 matches" in result.output
+
+        result = runner.invoke(
+            cli,
+            ["--source-dir", str(demo_dir), "--search", "(", "--search-mode", "regex"],
+        )
+        assert result.exit_code == 1
+        assert "Invalid search pattern" in result.output
+
+
 class TestModuleConfigurationOptions:
     """Test SWR_CLI_00011: Module Configuration Options"""
 
@@ -798,6 +828,701 @@ preprocessor:
             assert "clang" in result.output
 
 
+class TestBatchMode:
+    """Test SWR_CLI_00026: Batch Analysis Mode"""
+
+    def test_batch_with_repeated_start_function(self, demo_dir):
+        """Test that repeating --start-function writes one file per root."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "-s",
+                    "Demo_Init",
+                    "-s",
+                    "Demo_Update",
+                    "--output-dir",
+                    "diagrams",
+                ],
+            )
+            assert result.exit_code == 0
+            assert "Generated 2 of 2 diagrams" in result.output
+            assert Path("diagrams/Demo_Init.md").exists()
+            assert Path("diagrams/Demo_Update.md").exists()
+
+    def test_batch_with_pattern_and_unknown_root(self, demo_dir):
+        """Test that --start-pattern selects roots and failures set exit code 1."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            Path("roots.txt").write_text("Unknown_Func\n")
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--start-pattern",
+                    "^Demo_Init$",
+                    "--start-functions-file",
+                    "roots.txt",
+                    "--output-dir",
+                    "diagrams",
+                ],
+            )
+            assert result.exit_code == 1
+            assert "FAILED" in result.output
+            assert "Unknown_Func" in result.output
+            assert Path("diagrams/Demo_Init.md").exists()
+
+    def test_batch_pattern_without_match(self, demo_dir):
+        """Test that a pattern matching nothing is an error."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                ["--source-dir", str(demo_dir), "--start-pattern", "^NoSuchPrefix_"],
+            )
+            assert result.exit_code == 1
+            assert "No start functions selected" in result.output
+
+
+class TestServeOption:
+    """Test SWR_SERVER_00001: Server Mode"""
+
+    def test_serve_starts_server_with_warm_database(self, demo_dir):
+        """Test that --serve hands the built database to the server."""
+        from unittest.mock import patch
+
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            with patch("autosar_calltree.cli.main._run_server") as run_server:
+                result = runner.invoke(
+                    cli,
+                    [
+                        "--source-dir",
+                        str(demo_dir),
+                        "--serve",
+                        "--port",
+                        "0",
+                        "--watch-interval",
+                        "0",
+                    ],
+                )
+
+            assert result.exit_code == 0
+            service, port, watch_interval, verbose = run_server.call_args[0]
+            assert port == 0
+            assert watch_interval == 0
+            assert "Demo_Init" in service.list_functions()
+
+
+class TestCallersOption:
+    """Test SWR_CLI_00027: Caller Tree Option"""
+
+    def test_callers_writes_inverted_diagram(self, demo_dir):
+        """Test that --callers writes the tree of callers of the function."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--start-function",
+                    "COM_SendLINMessage",
+                    "--callers",
+                    "--output",
+                    "callers.md",
+                ],
+            )
+            assert result.exit_code == 0
+            content = Path("callers.md").read_text(encoding="utf-8")
+            assert content.startswith("# Callers of: COM_SendLINMessage")
+            assert "Demo_Update->>COM_SendLINMessage" in content
+
+    def test_callers_rejects_rhapsody_and_batch(self, demo_dir):
+        """Test that --callers needs one start function and mermaid output."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            base = ["--source-dir", str(demo_dir), "--callers"]
+            result = runner.invoke(
+                cli, base + ["-s", "Demo_Update", "--format", "rhapsody"]
+            )
+            assert result.exit_code == 1
+            assert "only the mermaid format" in result.output
+
+            result = runner.invoke(cli, base + ["-s", "Demo_Update", "-s", "Demo_Init"])
+            assert result.exit_code == 1
+            assert "single --start-function" in result.output
+
+
+class TestRhapsodyDeterministicIdsOption:
+    """Test SWR_CLI_00028: Rhapsody Deterministic IDs Option"""
+
+    def test_repeated_exports_are_identical(self, demo_dir):
+        """Test that --rhapsody-deterministic-ids gives the same file twice."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            contents = []
+            for output in ("first.xmi", "second.xmi", "random.xmi"):
+                args = [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--start-function",
+                    "Demo_Update",
+                    "--format",
+                    "rhapsody",
+                    "--output",
+                    output,
+                ]
+                if output != "random.xmi":
+                    args.append("--rhapsody-deterministic-ids")
+                result = runner.invoke(cli, args)
+                assert result.exit_code == 0
+                contents.append(Path(output).read_text(encoding="utf-8"))
+
+            assert contents[0] == contents[1]
+            assert contents[0] != contents[2]
+
+
+class TestExportGraphOption:
+    """Test SWR_CLI_00029: Call Graph Export Option"""
+
+    def test_export_graph_formats(self, demo_dir):
+        """Test that --export-graph writes each format without a start function."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            for output, graph_format in (
+                ("calls.bin", None),
+                ("calls.graphml", None),
+                ("calls.txt", "jsonl"),
+            ):
+                args = ["--source-dir", str(demo_dir), "--export-graph", output]
+                if graph_format:
+                    args += ["--graph-format", graph_format]
+                result = runner.invoke(cli, args)
+                assert result.exit_code == 0
+                assert "Exported call graph" in result.output
+
+            assert Path("calls.bin").read_bytes().startswith(b"ACTGRAPH")
+            assert "<graphml" in Path("calls.graphml").read_text(encoding="utf-8")
+            first = Path("calls.txt").read_text(encoding="utf-8").splitlines()[0]
+            assert json.loads(first)["type"] == "node"
+
+
+class TestProfileOption:
+    """Test SWR_CLI_00030: Profile Option"""
+
+    def test_profile_report_and_trace(self, demo_dir):
+        """Test that --profile-output prints the report and writes a trace."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--start-function",
+                    "Demo_Init",
+                    "--no-cache",
+                    "--profile-output",
+                    "trace.json",
+                    "--profile-top",
+                    "2",
+                ],
+            )
+
+            assert result.exit_code == 0
+            assert "Stages:" in result.output
+            assert "Slowest 2 files" in result.output
+            trace = json.loads(Path("trace.json").read_text(encoding="utf-8"))
+            stages = [stage["name"] for stage in trace["stages"]]
+            assert "parse" in stages
+            assert stages[-2:] == ["build_tree", "mermaid"]
+
+    def test_no_profile_by_default(self, demo_dir):
+        """Test that no report is printed without --profile."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli, ["--source-dir", str(demo_dir), "--list-functions", "--no-cache"]
+            )
+
+            assert result.exit_code == 0
+            assert "Stages:" not in result.output
+
+class TestLazyOption:
+    """Test SWR_CLI_00031: Lazy Parsing Option"""
+
+    def test_lazy_tree_matches_full_build(self, demo_dir):
+        """Test that --lazy writes the same diagram and caches parsed files."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            outputs = []
+            for extra in ([], ["--lazy"], ["--lazy"]):
+                output = f"tree_{len(outputs)}.md"
+                result = runner.invoke(
+                    cli,
+                    [
+                        "--source-dir",
+                        str(demo_dir),
+                        "--start-function",
+                        "Demo_Init",
+                        "--cache-dir",
+                        f"cache{bool(extra)}",
+                        "--output",
+                        output,
+                        *extra,
+                    ],
+                )
+                assert result.exit_code == 0
+                outputs.append((result.output, Path(output).read_text()))
+
+            assert outputs[0][1] == outputs[1][1] == outputs[2][1]
+            assert "Parsing on demand" in outputs[1][0]
+            assert "Parsing on demand" not in outputs[2][0]
+
+    def test_lazy_ignored_for_list(self, demo_dir):
+        """Test that --lazy falls back to a full build for --list-functions."""
+        runner = CliRunner()
+        result = runner.invoke(
+            cli,
+            ["--source-dir", str(demo_dir), "--list-functions", "--no-cache", "--lazy"],
+        )
+
+        assert result.exit_code == 0
+        assert "--lazy applies only" in result.output
+        assert "Demo_Init" in result.output
+
+
+class TestFastParseOption:
+    """Test SWR_CLI_00032: Fast Parse Option"""
+
+    def test_fast_parse_matches_full_parse(self, demo_dir):
+        """Test that --fast-parse writes the same diagram as pycparser."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            outputs = []
+            for extra in ([], ["--fast-parse"]):
+                output = f"tree_{len(outputs)}.md"
+                result = runner.invoke(
+                    cli,
+                    [
+                        "--source-dir",
+                        str(demo_dir),
+                        "--start-function",
+                        "Demo_Init",
+                        "--no-cache",
+                        "--output",
+                        output,
+                        *extra,
+                    ],
+                )
+                assert result.exit_code == 0
+                outputs.append(Path(output).read_text())
+
+            assert outputs[0] == outputs[1]
+
+    def test_fast_parse_ignored_with_conditionals(self, demo_dir):
+        """Test that --enable-conditionals keeps the pycparser path."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--start-function",
+                    "Demo_Init",
+                    "--no-cache",
+                    "--fast-parse",
+                    "--enable-conditionals",
+                ],
+            )
+
+        assert result.exit_code == 0
+        assert "--fast-parse is ignored" in result.output
+
+
+class TestTreeBudgetOptions:
+    """Test SWR_CLI_00033: Tree Budget Options"""
+
+    def test_max_nodes_truncates_tree(self, demo_dir):
+        """Test that --max-nodes reports and annotates the truncation."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--start-function",
+                    "Demo_Init",
+                    "--max-depth",
+                    "4",
+                    "--max-nodes",
+                    "3",
+                    "--no-cache",
+                    "--output",
+                    "tree.md",
+                ],
+            )
+            content = Path("tree.md").read_text()
+
+        assert result.exit_code == 0
+        assert "Truncated: node budget of 3 reached" in result.output
+        assert "- **Truncated**: node budget of 3 reached" in content
+        assert "[TRUNCATED]" in content
+
+    def test_breadth_first_writes_every_level(self, demo_dir):
+        """Test that --breadth-first reports each level and the final result."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--start-function",
+                    "Demo_Init",
+                    "--max-depth",
+                    "3",
+                    "--breadth-first",
+                    "--no-cache",
+                    "--output",
+                    "tree.md",
+                ],
+            )
+            content = Path("tree.md").read_text()
+
+        assert result.exit_code == 0
+        assert "Level 1:" in result.output
+        assert "Level 3:" in result.output
+        assert "- **Max Depth**: 3" in content
+        assert "Truncated" not in content
+
+    def test_max_nodes_rejects_zero(self, demo_dir):
+        """Test that --max-nodes must be positive."""
+        runner = CliRunner()
+        result = runner.invoke(
+            cli,
+            ["--source-dir", str(demo_dir), "-s", "Demo_Init", "--max-nodes", "0"],
+        )
+
+        assert result.exit_code != 0
+
+
+class TestShardOptions:
+    """Test SWR_CLI_00034: Shard Build Options"""
+
+    def test_shard_and_merge(self, demo_dir, tmp_path):
+        """Test that shard fragments merge into a cache used by the next run."""
+        runner = CliRunner()
+        fragment_dir = tmp_path / "fragments"
+        fragment_dir.mkdir()
+        for index in (1, 2):
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--cache-dir",
+                    str(tmp_path / f"node{index}"),
+                    "--shard",
+                    f"{index}/2",
+                ],
+            )
+            assert result.exit_code == 0
+            assert f"Wrote shard {index}/2 fragment" in result.output
+            for fragment in (tmp_path / f"node{index}").glob("shard-*"):
+                fragment.rename(fragment_dir / fragment.name)
+
+        result = runner.invoke(
+            cli,
+            [
+                "--source-dir",
+                str(demo_dir),
+                "--cache-dir",
+                str(tmp_path / "merged"),
+                "--merge-shards",
+                str(fragment_dir),
+                "--list-functions",
+            ],
+        )
+        assert result.exit_code == 0
+        assert "Merged shard fragments into" in result.output
+        assert "Demo_Init" in result.output
+
+        result = runner.invoke(
+            cli,
+            [
+                "--source-dir",
+                str(demo_dir),
+                "--cache-dir",
+                str(tmp_path / "merged"),
+                "--list-functions",
+            ],
+        )
+        assert result.exit_code == 0
+        assert "Processing:" not in result.output
+        assert "Demo_Init" in result.output
+
+    def test_merge_reports_missing_shard(self, demo_dir, tmp_path):
+        """Test that an incomplete set of fragments is an error."""
+        runner = CliRunner()
+        result = runner.invoke(
+            cli,
+            [
+                "--source-dir",
+                str(demo_dir),
+                "--cache-dir",
+                str(tmp_path),
+                "--shard",
+                "1/2",
+            ],
+        )
+        assert result.exit_code == 0
+
+        result = runner.invoke(
+            cli,
+            [
+                "--source-dir",
+                str(demo_dir),
+                "--cache-dir",
+                str(tmp_path / "merged"),
+                "--merge-shards",
+                str(tmp_path),
+            ],
+        )
+        assert result.exit_code == 1
+        assert "missing shard fragments: 2/2" in result.output
+
+    def test_invalid_shard(self, demo_dir):
+        """Test that --shard rejects indexes outside 1..N."""
+        runner = CliRunner()
+        result = runner.invoke(cli, ["--source-dir", str(demo_dir), "--shard", "3/2"])
+
+        assert result.exit_code != 0
+        assert "shard index must be between 1 and 2" in result.output
+
+
+class TestSkipUnchanged:
+    """Test SWR_CLI_00035: Skip Unchanged Batch Outputs"""
+
+    def _run(self, runner, source_dir, *extra):
+        return runner.invoke(
+            cli,
+            [
+                "--source-dir",
+                str(source_dir),
+                "--no-cache",
+                "-s",
+                "Main",
+                "-s",
+                "Other",
+                "--output-dir",
+                "diagrams",
+                "--skip-unchanged",
+                *extra,
+            ],
+        )
+
+    def test_skip_unchanged_outputs(self, tmp_path):
+        """Test that only outputs with changed reachable functions are written."""
+        source_dir = tmp_path / "src"
+        source_dir.mkdir()
+        (source_dir / "main.c").write_text("void Main(void)\n{\n    Leaf();\n}\n")
+        (source_dir / "leaf.c").write_text("void Leaf(void)\n{\n}\n")
+        (source_dir / "other.c").write_text("void Other(void)\n{\n}\n")
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = self._run(runner, source_dir)
+            assert result.exit_code == 0
+            assert "Generated 2 of 2 diagrams" in result.output
+            assert "- **Fingerprint**: `" in Path("diagrams/Main.md").read_text()
+
+            result = self._run(runner, source_dir)
+            assert result.exit_code == 0
+            assert "Generated 0 of 2 diagrams, 2 unchanged" in result.output
+            assert "UNCHANGED Main" in result.output
+
+            (source_dir / "leaf.c").write_text("void Leaf(void)\n{\n    x();\n}\n")
+            result = self._run(runner, source_dir)
+            assert result.exit_code == 0
+            assert "Generated 1 of 2 diagrams, 1 unchanged" in result.output
+            assert "UNCHANGED Other" in result.output
+
+            result = self._run(runner, source_dir, "--max-depth", "1")
+            assert "Generated 2 of 2 diagrams" in result.output
+            assert "unchanged" not in result.output
+
+    def test_skip_unchanged_requires_batch_mode(self, demo_dir):
+        """Test that --skip-unchanged warns outside batch mode."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "-s",
+                    "Demo_Init",
+                    "--skip-unchanged",
+                ],
+            )
+            assert result.exit_code == 0
+            assert "--skip-unchanged applies only to batch mode" in result.output
+
+
+class TestModuleGraphOption:
+    """Test SWR_CLI_00036: Module Graph Output"""
+
+    def test_module_graph_written(self, demo_dir):
+        """Test that --module-graph writes the module diagram to --output."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--module-config",
+                    str(demo_dir / "module_mapping.yaml"),
+                    "--module-graph",
+                    "--no-cache",
+                    "--output",
+                    "architecture.md",
+                ],
+            )
+            assert result.exit_code == 0
+            assert "Generated module graph: architecture.md" in result.output
+            output = Path("architecture.md").read_text(encoding="utf-8")
+            assert "flowchart LR" in output
+            assert "HardwareModule" in output
+
+    def test_module_graph_requires_module_config(self, demo_dir):
+        """Test that --module-graph needs a module configuration and Mermaid."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            result = runner.invoke(
+                cli, ["--source-dir", str(demo_dir), "--module-graph"]
+            )
+            assert result.exit_code == 1
+            assert "--module-graph requires --module-config" in result.output
+
+            result = runner.invoke(
+                cli,
+                [
+                    "--source-dir",
+                    str(demo_dir),
+                    "--module-config",
+                    str(demo_dir / "module_mapping.yaml"),
+                    "--module-graph",
+                    "--format",
+                    "rhapsody",
+                ],
+            )
+            assert result.exit_code == 1
+            assert "supports the mermaid format only" in result.output
+            assert not Path("call_tree.md").exists()
+
+
+class TestSplitDiagramOptions:
+    """Test SWR_CLI_00037: Diagram Splitting Options"""
+
+    def test_max_messages_splits_diagram(self, demo_dir):
+        """Test that --max-messages writes linked parts, also in batch mode."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            for extra in (
+                ["--output", "split.md"],
+                ["-s", "Demo_Update", "--output-dir", "diagrams"],
+            ):
+                result = runner.invoke(
+                    cli,
+                    [
+                        "--source-dir",
+                        str(demo_dir),
+                        "-s",
+                        "Demo_MainFunction",
+                        "--max-depth",
+                        "5",
+                        "--max-messages",
+                        "6",
+                        "--split-by",
+                        "subtree",
+                        *extra,
+                    ],
+                )
+                assert result.exit_code == 0
+
+            for output_file in ("split.md", "diagrams/Demo_MainFunction.md"):
+                output = Path(output_file).read_text(encoding="utf-8")
+                assert "(split by subtree above 6 messages)" in output
+                assert output.count("```mermaid") > 1
+                assert "continued in Part 2" in output
+
+    def test_split_options_validated(self, demo_dir):
+        """Test that invalid split options are usage errors."""
+        runner = CliRunner()
+        for extra in (["--max-messages", "0"], ["--split-by", "depth"]):
+            result = runner.invoke(
+                cli, ["--source-dir", str(demo_dir), "-s", "Demo_Init", *extra]
+            )
+            assert result.exit_code == 2
+
+
+class TestCacheWriteOptions:
+    """Test SWR_CLI_00038: Cache Compression and Background Write Options"""
+
+    def test_compressed_background_cache(self, demo_dir):
+        """Test that a background write leaves a compressed, loadable cache."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            args = [
+                "--source-dir",
+                str(demo_dir),
+                "--start-function",
+                "Demo_Init",
+                "--cache-dir",
+                "cache",
+                "--cache-compression",
+                "zlib",
+                "--background-cache-write",
+            ]
+            result = runner.invoke(cli, args + ["--verbose"])
+            assert result.exit_code == 0
+            assert "Generated Mermaid diagram" in result.output
+            assert "Cache saved to" in result.output
+            for name in ("function_db.pkl", "function_db.bin"):
+                assert (Path("cache") / name).read_bytes().startswith(b"ACTCACHE")
+
+            result = runner.invoke(cli, args[:6] + ["--verbose"])
+            assert result.exit_code == 0
+            assert "functions from cache" in result.output
+
+    def test_missing_compression_package(self, demo_dir):
+        """Test that a codec whose package is not installed is an error."""
+        runner = CliRunner()
+        with runner.isolated_filesystem():
+            with patch.object(cache_file, "zstandard", None):
+                result = runner.invoke(
+                    cli,
+                    [
+                        "--source-dir",
+                        str(demo_dir),
+                        "--start-function",
+                        "Demo_Init",
+                        "--cache-compression",
+                        "zstd",
+                    ],
+                )
+            assert result.exit_code == 1
+            assert "is not installed" in result.output
+
+
 class TestCLICoverageGaps:
     """Additional tests to achieve 100% coverage for CLI"""
 
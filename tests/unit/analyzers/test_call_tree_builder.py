@@ -1,4 +1,4 @@
-"""Tests for analyzers/call_tree_builder.py (SWUT_ANALYZER_00001-00015)"""
+"""Tests for analyzers/call_tree_builder.py (SWUT_ANALYZER_00001-00016)"""
 
 from pathlib import Path
 
@@ -382,3 +382,374 @@ def test_verbose_logging():
     # Verify result is created
     assert result.root_function is not None
     assert result.call_tree is not None
+
+
+# SWUT_ANALYZER_00016: Shared Subtree Expansion
+
+
+def _build_graph_db(tmp_path, graph):
+    """Create a FunctionDatabase from a {caller: [callees]} mapping."""
+    from autosar_calltree.database.models import FunctionCall, FunctionInfo
+
+    db = FunctionDatabase(source_dir=tmp_path)
+    for name, callees in graph.items():
+        db._add_function(
+            FunctionInfo(
+                name=name,
+                return_type="void",
+                file_path=tmp_path / "graph.c",
+                line_number=1,
+                is_static=False,
+                calls=[
+                    FunctionCall(name=callee, is_conditional=(idx % 2 == 1), condition="x")
+                    for idx, callee in enumerate(callees)
+                ],
+            )
+        )
+    return db
+
+
+def _tree_signature(node):
+    """Flatten a call tree into comparable tuples."""
+    return (
+        node.function_info.name,
+        node.depth,
+        node.is_recursive,
+        node.is_optional,
+        tuple(_tree_signature(child) for child in node.children),
+    )
+
+
+def test_shared_subtrees_match_full_expansion(tmp_path):
+    """SWUT_ANALYZER_00016
+
+    Test that shared subtrees give the same tree as full expansion with fewer nodes.
+    """
+    # Layered graph: every function calls every function of the next layer
+    layers = [[f"L{layer}_{idx}" for idx in range(3)] for layer in range(6)]
+    graph = {"Root": layers[0]}
+    for layer, names in enumerate(layers):
+        for name in names:
+            graph[name] = layers[layer + 1] if layer + 1 < len(layers) else []
+    db = _build_graph_db(tmp_path, graph)
+
+    builder = CallTreeBuilder(db)
+    shared = builder.build_tree("Root", max_depth=6, enable_conditionals=True)
+    full = builder.build_tree(
+        "Root", max_depth=6, enable_conditionals=True, share_subtrees=False
+    )
+
+    assert _tree_signature(shared.call_tree) == _tree_signature(full.call_tree)
+    assert shared.statistics.total_functions == full.statistics.total_functions
+    assert shared.statistics.unique_functions == full.statistics.unique_functions
+    assert shared.statistics.max_depth_reached == full.statistics.max_depth_reached
+    assert full.statistics.physical_nodes == full.statistics.total_functions
+    assert shared.statistics.physical_nodes < full.statistics.physical_nodes // 10
+
+
+def test_shared_subtrees_respect_cycles(tmp_path):
+    """SWUT_ANALYZER_00016
+
+    Test that subtrees depending on the call stack are not reused incorrectly.
+    """
+    graph = {
+        "Root": ["A", "D", "B", "C"],
+        "A": ["B"],
+        "B": ["C"],
+        "C": ["A", "E"],
+        "D": ["B", "E"],
+        "E": ["F"],
+        "F": [],
+    }
+    db = _build_graph_db(tmp_path, graph)
+
+    builder = CallTreeBuilder(db)
+    shared = builder.build_tree("Root", max_depth=6)
+    full = builder.build_tree("Root", max_depth=6, share_subtrees=False)
+
+    assert _tree_signature(shared.call_tree) == _tree_signature(full.call_tree)
+    assert shared.statistics.total_functions == full.statistics.total_functions
+    assert [c.cycle for c in shared.circular_dependencies] == [
+        c.cycle for c in full.circular_dependencies
+    ]
+    assert [c.depth for c in shared.circular_dependencies] == [
+        c.depth for c in full.circular_dependencies
+    ]
+
+
+def test_shared_subtree_edge_flags_are_per_call(tmp_path):
+    """SWUT_ANALYZER_00016
+
+    Test that a reused subtree gets its own node for per-call flags.
+    """
+    graph = {"Root": ["A", "B"], "A": ["C"], "B": ["X", "C"], "C": ["D"], "D": [], "X": ["C"]}
+    db = _build_graph_db(tmp_path, graph)
+
+    builder = CallTreeBuilder(db)
+    result = builder.build_tree("Root", max_depth=5, enable_conditionals=True)
+
+    root = result.call_tree
+    c_under_a = root.children[0].children[0]
+    c_under_b = root.children[1].children[1]
+    assert c_under_a is not c_under_b
+    assert c_under_a.is_optional is False
+    assert c_under_b.is_optional is True
+    assert c_under_b.children[0].function_info.name == "D"
+
+
+def test_shared_subtrees_distinguish_same_stem_files(tmp_path):
+    """SWUT_ANALYZER_00016
+
+    Test that same-named functions in same-stem files do not share subtrees.
+    """
+    from autosar_calltree.database.models import FunctionCall, FunctionInfo
+
+    db = FunctionDatabase(source_dir=tmp_path)
+    for name, path, callees in [
+        ("Det_Report", "det.c", []),
+        ("Helper", "a/util.c", ["Det_Report"]),
+        ("Helper", "b/util.c", ["Det_Report", "Log_Write"]),
+        ("A_Run", "a/run.c", ["Helper"]),
+        ("Log_Write", "b/log.c", []),
+    ]:
+        db._add_function(
+            FunctionInfo(
+                name=name,
+                return_type="void",
+                file_path=tmp_path / path,
+                line_number=1,
+                is_static=False,
+                calls=[FunctionCall(name=callee) for callee in callees],
+            )
+        )
+
+    def callers(node):
+        return [
+            (
+                Path(child.function_info.file_path).relative_to(tmp_path).as_posix(),
+                callers(child),
+            )
+            for child in node.children
+        ]
+
+    builder = CallTreeBuilder(db)
+    shared = builder.build_caller_tree("Det_Report", max_depth=4)
+    full = builder.build_caller_tree("Det_Report", max_depth=4, share_subtrees=False)
+
+    # Helper calls resolve to the one in a/util.c, so b/util.c's has no callers
+    assert callers(shared.call_tree) == callers(full.call_tree)
+    assert callers(shared.call_tree) == [
+        ("a/util.c", [("a/run.c", [])]),
+        ("b/util.c", []),
+    ]
+
+
+# SWUT_ANALYZER_00018: Caller Tree
+
+
+def test_caller_tree_lists_callers(tmp_path):
+    """SWUT_ANALYZER_00018
+
+    Test that the children of a caller tree node are the functions calling it.
+    """
+    graph = {
+        "Task_A": ["Runnable_1", "Runnable_2"],
+        "Task_B": ["Runnable_2"],
+        "Runnable_1": ["Det_ReportError", "Det_ReportError"],
+        "Runnable_2": ["Helper"],
+        "Helper": ["Det_ReportError"],
+        "Det_ReportError": [],
+    }
+    db = _build_graph_db(tmp_path, graph)
+
+    result = CallTreeBuilder(db).build_caller_tree("Det_ReportError", max_depth=5)
+
+    assert result.is_caller_tree is True
+    assert not result.errors
+    root = result.call_tree
+    assert root.function_info.name == "Det_ReportError"
+    # Runnable_1 calls Det_ReportError twice but appears once
+    assert [child.function_info.name for child in root.children] == [
+        "Runnable_1",
+        "Helper",
+    ]
+    helper = root.children[1]
+    assert [c.function_info.name for c in helper.children] == ["Runnable_2"]
+    assert [c.function_info.name for c in helper.children[0].children] == [
+        "Task_A",
+        "Task_B",
+    ]
+    assert result.statistics.max_depth_reached == 3
+    assert result.statistics.unique_functions == 6
+
+
+def test_caller_tree_depth_flags_and_cycles(tmp_path):
+    """SWUT_ANALYZER_00018
+
+    Test depth limit, per-call flags and cycle detection of caller trees.
+    """
+    graph = {"Root": ["A", "B"], "A": ["Root", "B"], "B": []}
+    db = _build_graph_db(tmp_path, graph)
+    builder = CallTreeBuilder(db)
+
+    result = builder.build_caller_tree("B", max_depth=5, enable_conditionals=True)
+    root = result.call_tree
+    callers = {child.function_info.name: child for child in root.children}
+    assert set(callers) == {"Root", "A"}
+    # Root calls B as its second (conditional) call, A as its second call too
+    assert callers["Root"].is_optional is True
+    assert callers["A"].is_optional is True
+    assert [c.cycle for c in result.circular_dependencies] == [
+        ["graph::Root", "graph::A", "graph::Root"],
+        ["graph::A", "graph::Root", "graph::A"],
+    ]
+
+    shallow = builder.build_caller_tree("B", max_depth=1)
+    assert shallow.statistics.max_depth_reached == 1
+    assert all(not child.children for child in shallow.call_tree.children)
+
+    missing = builder.build_caller_tree("Unknown")
+    assert missing.call_tree is None
+    assert missing.is_caller_tree is True
+
+
+# SWUT_ANALYZER_00019: Lazy Database Traversal
+
+
+def test_lazy_tree_matches_full_build(tmp_path):
+    """SWUT_ANALYZER_00019
+
+    Test that a tree of a lazy database equals the full build's tree and
+    parses only the reachable files.
+    """
+    (tmp_path / "main.c").write_text(
+        "void Main(void) {\n    Step();\n    Log();\n}\n"
+        "static void Log(void) {\n}\n"
+    )
+    (tmp_path / "step.c").write_text(
+        "void Step(void) {\n    Log();\n    Main();\n}\n"
+        "static void Log(void) {\n}\n"
+    )
+    (tmp_path / "other.c").write_text("void Other(void) {\n    Main();\n}\n")
+
+    full = FunctionDatabase(source_dir=str(tmp_path), cache_dir=str(tmp_path / "f"))
+    full.build_database(use_cache=False)
+    lazy = FunctionDatabase(source_dir=str(tmp_path), cache_dir=str(tmp_path / "l"))
+    lazy.build_database(use_cache=False, lazy=True)
+
+    expected = CallTreeBuilder(full).build_tree("Main", max_depth=4)
+    result = CallTreeBuilder(lazy).build_tree("Main", max_depth=4)
+
+    assert _tree_signature(result.call_tree) == _tree_signature(expected.call_tree)
+    assert result.statistics == expected.statistics
+    assert lazy.lazy_files_parsed == 2 and lazy.is_lazy
+
+    callers = CallTreeBuilder(lazy).build_caller_tree("Main", max_depth=2)
+    assert not lazy.is_lazy
+    assert {c.function_info.name for c in callers.call_tree.children} == {
+        "Step",
+        "Other",
+    }
+
+
+
+# SWUT_ANALYZER_00020: Tree Build Budgets
+
+
+def _count_nodes(node):
+    """Count the nodes of a call tree."""
+    return 1 + sum(_count_nodes(child) for child in node.children)
+
+
+def _wide_graph():
+    """Graph with three layers of three callees per function."""
+    layers = [[f"L{layer}_{idx}" for idx in range(3)] for layer in range(3)]
+    graph = {"Root": layers[0]}
+    for layer, names in enumerate(layers):
+        for name in names:
+            graph[name] = layers[layer + 1] if layer + 1 < len(layers) else []
+    return graph
+
+
+def test_max_nodes_limits_tree(tmp_path):
+    """SWUT_ANALYZER_00020
+
+    Test that max_nodes bounds the tree and marks the nodes left unexpanded.
+    """
+    db = _build_graph_db(tmp_path, _wide_graph())
+    builder = CallTreeBuilder(db)
+
+    result = builder.build_tree("Root", max_depth=5, max_nodes=6)
+
+    assert result.statistics.total_functions <= 6
+    assert _count_nodes(result.call_tree) == result.statistics.total_functions
+    assert result.truncation.reason == "max_nodes"
+    assert result.truncation.limit == 6
+    assert result.truncation.truncated_functions
+    assert result.call_tree.is_truncated
+    assert "node budget of 6 reached" in result.truncation.describe()
+
+    full = builder.build_tree("Root", max_depth=5)
+    assert full.truncation is None
+    assert full.statistics.total_functions == 1 + 3 + 9 + 27
+    assert not full.call_tree.is_truncated
+
+
+def test_time_budget_truncates_tree(tmp_path):
+    """SWUT_ANALYZER_00020
+
+    Test that an exhausted time budget stops the expansion at the root.
+    """
+    db = _build_graph_db(tmp_path, _wide_graph())
+
+    result = CallTreeBuilder(db).build_tree("Root", max_depth=5, time_budget=0)
+
+    assert result.call_tree.children == []
+    assert result.call_tree.is_truncated
+    assert result.truncation.reason == "time_budget"
+    assert result.truncation.truncated_functions == ["graph::Root"]
+
+
+# SWUT_ANALYZER_00021: Breadth-First Refinement
+
+
+def test_tree_levels_refine_tree(tmp_path):
+    """SWUT_ANALYZER_00021
+
+    Test that each level is one deeper and the last equals build_tree().
+    """
+    db = _build_graph_db(tmp_path, _wide_graph())
+    builder = CallTreeBuilder(db)
+
+    levels = list(builder.iter_tree_levels("Root", max_depth=3))
+
+    assert [level.statistics.max_depth_reached for level in levels] == [1, 2, 3]
+    assert [level.truncation for level in levels] == [None, None, None]
+    expected = builder.build_tree("Root", max_depth=3)
+    assert _tree_signature(levels[-1].call_tree) == _tree_signature(
+        expected.call_tree
+    )
+
+
+def test_tree_levels_stop_at_budget(tmp_path):
+    """SWUT_ANALYZER_00021
+
+    Test that the last complete level is the final result when a budget ends.
+    """
+    db = _build_graph_db(tmp_path, _wide_graph())
+
+    levels = list(
+        CallTreeBuilder(db).iter_tree_levels("Root", max_depth=4, max_nodes=10)
+    )
+
+    final = levels[-1]
+    assert final is levels[-2]
+    assert final.statistics.max_depth_reached == 1
+    assert final.truncation.complete_depth == 1
+    assert sorted(final.truncation.truncated_functions) == [
+        "graph::L0_0",
+        "graph::L0_1",
+        "graph::L0_2",
+    ]
+    assert all(child.is_truncated for child in final.call_tree.children)
+    assert not final.call_tree.is_truncated
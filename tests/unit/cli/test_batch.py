@@ -0,0 +1,142 @@
+"""Tests for cli/batch.py (SWUT_CLI_00026)"""
+
+import io
+import threading
+from contextlib import redirect_stdout
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from autosar_calltree.cli import batch
+from autosar_calltree.cli.batch import (
+    BatchOptions,
+    analyze_root,
+    collect_start_functions,
+    run_batch,
+)
+from autosar_calltree.database.function_database import FunctionDatabase
+
+
+@pytest.fixture
+def demo_db(tmp_path):
+    """Function database built from the demo sources."""
+    db = FunctionDatabase(source_dir="./demo", cache_dir=str(tmp_path / "cache"))
+    with redirect_stdout(io.StringIO()):
+        db.build_database(use_cache=False, verbose=False)
+    return db
+
+
+class TestCollectStartFunctions:
+    """Tests: SWUT_CLI_00026 - Batch root selection"""
+
+    # SWUT_CLI_00026: Names, file and pattern are combined without duplicates
+    def test_names_file_and_pattern(self, demo_db, tmp_path):
+        """Test that all sources of root functions are merged in order."""
+        names_file = tmp_path / "roots.txt"
+        names_file.write_text("# runnables\nDemo_Update\n\nDemo_Init  # again\n")
+
+        roots = collect_start_functions(
+            demo_db,
+            names=["Demo_Init"],
+            names_file=names_file,
+            pattern="^Demo_(Init|Update)$",
+        )
+
+        assert roots == ["Demo_Init", "Demo_Update"]
+
+    # SWUT_CLI_00026: Invalid pattern
+    def test_invalid_pattern(self, demo_db):
+        """Test that an invalid regular expression raises ValueError."""
+        with pytest.raises(ValueError):
+            collect_start_functions(demo_db, pattern="Demo_(")
+
+
+class TestRunBatch:
+    """Tests: SWUT_CLI_00026 - Batch Analysis Mode"""
+
+    # SWUT_CLI_00026: One output file per root
+    def test_one_output_per_root(self, demo_db, tmp_path):
+        """Test that every root gets its own Mermaid file."""
+        options = BatchOptions(output_dir=tmp_path / "out", max_depth=2)
+
+        results = run_batch(demo_db, ["Demo_Init", "Demo_Update"], options)
+
+        assert [r.root_function for r in results] == ["Demo_Init", "Demo_Update"]
+        for batch_result in results:
+            assert batch_result.errors == []
+            assert batch_result.output_file == (
+                tmp_path / "out" / f"{batch_result.root_function}.md"
+            )
+            content = batch_result.output_file.read_text(encoding="utf-8")
+            assert f"# Call Tree: {batch_result.root_function}" in content
+
+    # SWUT_CLI_00026: Missing roots do not stop the batch
+    def test_missing_root_reported(self, demo_db, tmp_path):
+        """Test that an unknown root is reported and the others still run."""
+        options = BatchOptions(output_dir=tmp_path / "out")
+
+        results = run_batch(demo_db, ["Missing_Func", "Demo_Init"], options)
+
+        assert results[0].errors == ["Function 'Missing_Func' not found"]
+        assert results[0].output_file is None
+        assert results[1].errors == []
+
+    # SWUT_CLI_00026: Parallel batch equals serial batch
+    def test_parallel_matches_serial(self, demo_db, tmp_path):
+        """Test that worker processes produce the same trees as serial runs."""
+        roots = ["Demo_Init", "Demo_MainFunction", "Demo_Update"]
+        serial = run_batch(demo_db, roots, BatchOptions(output_dir=tmp_path / "s"))
+        parallel = run_batch(
+            demo_db, roots, BatchOptions(output_dir=tmp_path / "p"), jobs=2
+        )
+
+        assert [r.total_functions for r in parallel] == [
+            r.total_functions for r in serial
+        ]
+        assert all(Path(r.output_file).exists() for r in parallel)
+
+    # SWUT_CLI_00026: Workers are forked after the background cache write
+    def test_parallel_waits_for_cache_write(self, tmp_path):
+        """Test that no worker is forked while the cache writer thread runs."""
+        release = threading.Event()
+        write_cache = FunctionDatabase._write_cache
+
+        def slow_write(db, *args, **kwargs):
+            assert release.wait(10)
+            write_cache(db, *args, **kwargs)
+
+        def start_pool(*args, **kwargs):
+            assert db.cache_file.exists()
+            raise OSError("no workers")
+
+        with patch.object(FunctionDatabase, "_write_cache", slow_write):
+            db = FunctionDatabase(
+                source_dir="./demo",
+                cache_dir=str(tmp_path / "cache"),
+                background_cache_write=True,
+            )
+            with redirect_stdout(io.StringIO()):
+                db.build_database(verbose=False)
+            assert not db.cache_file.exists()
+            threading.Timer(0.2, release.set).start()
+            with patch.object(batch, "ProcessPoolExecutor", side_effect=start_pool):
+                results = run_batch(
+                    db,
+                    ["Demo_Init", "Demo_Update"],
+                    BatchOptions(output_dir=tmp_path / "out"),
+                    jobs=2,
+                )
+
+        assert [r.errors for r in results] == [[], []]
+
+    # SWUT_CLI_00026: Rhapsody output
+    def test_rhapsody_output(self, demo_db, tmp_path):
+        """Test that the rhapsody format writes one .xmi file per root."""
+        options = BatchOptions(output_dir=tmp_path / "out", format="rhapsody")
+
+        batch_result = analyze_root(demo_db, "Demo_Init", options)
+
+        assert batch_result.errors == []
+        assert batch_result.output_file == tmp_path / "out" / "Demo_Init.xmi"
+        assert batch_result.output_file.exists()
@@ -0,0 +1,177 @@
+"""Tests for database/binary_cache.py (SWUT_DB_00040)"""
+
+import io
+from contextlib import redirect_stdout
+
+import pytest
+
+from autosar_calltree.database.binary_cache import (
+    BinaryCacheError,
+    read_binary_cache,
+    write_binary_cache,
+)
+from autosar_calltree.database.call_graph import CallGraph
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.database.function_store import FunctionStore
+from autosar_calltree.database.models import FunctionCall
+from autosar_calltree.database.name_index import NameSearchIndex
+
+
+def _write_store(path, make_function):
+    store = FunctionStore()
+    calls = [FunctionCall(name=call, line_number=4) for call in ("Helper", "Missing")]
+    helper = {"line_number": 3, "called_by": {"Main"}, "sw_module": "Överwatch"}
+    functions = [
+        make_function("Main", "main.c", calls, line_number=3),
+        make_function("Helper", "main.c", **helper),
+        make_function("Helper", "util.c", **helper),
+    ]
+    for func_info in functions:
+        store.add(func_info)
+    indexes = {
+        "functions": {"Main": [0], "Helper": [1, 2]},
+        "qualified_functions": {"main::Main": 0, "main::Helper": 1, "util::Helper": 2},
+        "functions_by_file": {"main.c": range(0, 2), "util.c": range(2, 3)},
+    }
+    name_search = NameSearchIndex.build(list(indexes["functions"]))
+    call_graph = CallGraph(store, [1, -1])
+    token = write_binary_cache(path, store, indexes, name_search, call_graph)
+    return functions, indexes, token
+
+
+def _build_twice(source_dir, cache_dir):
+    with redirect_stdout(io.StringIO()):
+        built = FunctionDatabase(source_dir=source_dir, cache_dir=str(cache_dir))
+        built.build_database()
+        loaded = FunctionDatabase(source_dir=source_dir, cache_dir=str(cache_dir))
+        loaded.build_database()
+    return built, loaded
+
+
+class TestBinaryCache:
+    """Tests: SWUT_DB_00040 - Memory-Mapped Binary Cache"""
+
+    # SWUT_DB_00040: Store, indexes and call graph survive a round trip
+    def test_round_trip(self, tmp_path, make_function):
+        """Test that the mapped cache returns the written content."""
+        path = tmp_path / "db.bin"
+        functions, indexes, token = _write_store(path, make_function)
+
+        mapped = read_binary_cache(path, token)
+
+        assert [mapped.store.get(i) for i in range(3)] == functions
+        for name, index in indexes.items():
+            mapped_index = mapped.indexes[name]
+            assert list(mapped_index) == list(index)
+            for key, value in index.items():
+                if isinstance(value, int):
+                    assert mapped_index[key] == value
+                else:
+                    assert list(mapped_index[key]) == list(value)
+        assert list(mapped.call_graph.callee_ids) == [1, -1]
+        assert mapped.call_graph.callers(1) == [(0, 0)]
+        assert mapped.call_graph.callers(2) == []
+        assert "Missing" not in mapped.indexes["functions"]
+        assert "main.c" not in mapped.indexes["functions"]
+
+    # SWUT_DB_00040: Lookups decode only the strings they need
+    def test_lookup_decodes_lazily(self, tmp_path, make_function):
+        """Test that finding a key does not decode the other strings."""
+        path = tmp_path / "db.bin"
+        _, _, token = _write_store(path, make_function)
+
+        mapped = read_binary_cache(path, token)
+        func_ids = mapped.indexes["functions"]["Helper"]
+
+        assert list(func_ids) == [1, 2]
+        assert mapped.store.strings._decoded == {}
+        assert mapped.store.name(func_ids[0]) == "Helper"
+        assert list(mapped.store.strings._decoded.values()) == ["Helper"]
+
+    # SWUT_DB_00040: A mapped store is copied before it is modified
+    def test_mapped_store_is_writable(self, tmp_path, make_function):
+        """Test that adding to a mapped store copies its columns."""
+        path = tmp_path / "db.bin"
+        functions, _, token = _write_store(path, make_function)
+
+        store = read_binary_cache(path, token).store
+        func_id = store.add(make_function("Extra", "extra.c", calls=["Main"]))
+        store.set_sw_module(0, "Main_Module")
+
+        assert func_id == 3
+        assert store.get(func_id).calls[0].name == "Main"
+        assert store.get(0).sw_module == "Main_Module"
+        assert store.get(2) == functions[2]
+
+    # SWUT_DB_00040: Files that do not match are rejected
+    def test_rejects_mismatched_files(self, tmp_path, make_function):
+        """Test missing, foreign and damaged files and token mismatches."""
+        path = tmp_path / "db.bin"
+        with pytest.raises(BinaryCacheError):
+            read_binary_cache(path)
+
+        _write_store(path, make_function)
+        with pytest.raises(BinaryCacheError):
+            read_binary_cache(path, "other-token")
+
+        path.write_bytes(b"not a cache file at all")
+        with pytest.raises(BinaryCacheError):
+            read_binary_cache(path)
+
+
+class TestDatabaseOnBinaryCache:
+    """Tests: SWUT_DB_00040 - database loading from the binary cache"""
+
+    # SWUT_DB_00040: A loaded cache answers like the built database
+    def test_loaded_database_matches_built(self, tmp_path):
+        """Test lookups, search and call graph of a mapped cache."""
+        built, loaded = _build_twice("./demo", tmp_path / "cache")
+
+        assert loaded.store._objects == {}
+        assert list(loaded.functions) == list(built.functions)
+        assert list(loaded.functions_by_file) == list(built.functions_by_file)
+        assert dict(loaded.qualified_functions.ids) == built.qualified_functions.ids
+        assert [f.name for f in loaded.search_functions("Demo")] == [
+            f.name for f in built.search_functions("Demo")
+        ]
+        assert loaded.lookup_function("Demo_Init") == built.lookup_function(
+            "Demo_Init"
+        )
+        loaded_graph, built_graph = loaded.get_call_graph(), built.get_call_graph()
+        assert list(loaded_graph.callee_ids) == list(built_graph.callee_ids)
+        assert isinstance(loaded_graph.caller_rows, memoryview)
+        assert list(loaded_graph.caller_rows) == list(built_graph.caller_rows)
+        assert loaded.lookup_callers("Demo_Update") == built.lookup_callers(
+            "Demo_Update"
+        )
+
+    # SWUT_DB_00040: Only the metadata is stored in the pickle
+    def test_pickle_refers_to_binary_cache(self, tmp_path):
+        """Test that a missing binary cache invalidates the cache."""
+        cache_dir = tmp_path / "cache"
+        built, _ = _build_twice("./demo", cache_dir)
+        assert built.binary_cache_file.exists()
+        assert built.cache_file.stat().st_size < built.binary_cache_file.stat().st_size
+
+        built.binary_cache_file.unlink()
+        output = io.StringIO()
+        with redirect_stdout(output):
+            loaded = FunctionDatabase(source_dir="./demo", cache_dir=str(cache_dir))
+            assert not loaded._load_from_cache(verbose=True)
+        assert "Cache invalid: binary cache" in output.getvalue()
+
+        built.clear_cache()
+        assert not built.cache_file.exists()
+
+    # SWUT_DB_00040: A loaded database can still be extended
+    def test_add_function_after_load(self, tmp_path, make_function):
+        """Test that the mapped indexes are copied on the first change."""
+        _, loaded = _build_twice("./demo", tmp_path / "cache")
+        count = len(loaded.functions)
+
+        loaded._add_function(make_function("Demo_Init", "extra.c"))
+        loaded._add_function(make_function("Brand_New", "extra.c"))
+
+        assert len(loaded.functions) == count + 1
+        assert len(loaded.lookup_function("Demo_Init", "extra.c")) >= 1
+        assert loaded.qualified_functions["extra::Brand_New"].name == "Brand_New"
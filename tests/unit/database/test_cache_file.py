@@ -0,0 +1,198 @@
+"""Tests for database/cache_file.py (SWUT_DB_00049)"""
+
+import io
+import pickle
+import threading
+from contextlib import redirect_stdout
+from dataclasses import make_dataclass
+from unittest.mock import patch
+
+import pytest
+
+from autosar_calltree.database import cache_file, function_database
+from autosar_calltree.database.binary_cache import read_binary_cache
+from autosar_calltree.database.cache_file import (
+    CACHE_FILE_MAGIC,
+    CacheFormatError,
+    CacheSchema,
+    CacheSchemaError,
+    atomic_write,
+    available_compressions,
+    check_compression,
+    read_cache_data,
+    read_compressed_file,
+    write_cache_data,
+)
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.utils.profiler import Profiler
+
+SCHEMA = CacheSchema(1, 0x1234)
+DATA = {"entries": {f"file{index}.c": "x" * 40 for index in range(200)}}
+
+
+class TestCacheFile:
+    """Tests: SWUT_DB_00049 - Versioned Compressed Cache Files"""
+
+    # SWUT_DB_00049: Data is read back with every installed compression
+    def test_round_trip(self, tmp_path):
+        """Test that every available codec restores the data."""
+        path = tmp_path / "data.pkl"
+        sizes = {}
+        for compression in available_compressions():
+            write_cache_data(path, DATA, SCHEMA, compression)
+            assert path.read_bytes().startswith(CACHE_FILE_MAGIC)
+            assert read_cache_data(path, SCHEMA) == DATA
+            sizes[compression] = path.stat().st_size
+
+        assert {"none", "zlib", "lzma"} <= set(sizes)
+        assert sizes["zlib"] < sizes["none"] / 4
+        assert list(tmp_path.iterdir()) == [path]
+
+    # SWUT_DB_00049: Other schemas are rejected with a reason
+    def test_rejects_other_schema(self, tmp_path):
+        """Test schema mismatches, headerless pickles and damaged files."""
+        path = tmp_path / "data.pkl"
+        write_cache_data(path, DATA, SCHEMA, "zlib")
+        with pytest.raises(CacheSchemaError, match="schema version 1 .00001234."):
+            read_cache_data(path, CacheSchema(2, 0x1234))
+
+        path.write_bytes(pickle.dumps(DATA))
+        with pytest.raises(CacheSchemaError, match="outdated cache format"):
+            read_cache_data(path, SCHEMA)
+
+        write_cache_data(path, DATA, SCHEMA, "zlib")
+        path.write_bytes(path.read_bytes()[:-10])
+        with pytest.raises(CacheFormatError, match="damaged zlib data") as error:
+            read_cache_data(path, SCHEMA)
+        assert not isinstance(error.value, CacheSchemaError)
+
+        path.write_bytes(b"no cache")
+        with pytest.raises(CacheFormatError, match="not a cache file"):
+            read_cache_data(path, SCHEMA)
+
+    # SWUT_DB_00049: A file cut within the header is damaged
+    def test_truncated_header(self, tmp_path):
+        """Test that a short header raises CacheFormatError, not struct.error."""
+        path = tmp_path / "data.pkl"
+        write_cache_data(path, DATA, SCHEMA)
+        path.write_bytes(path.read_bytes()[:12])
+
+        with pytest.raises(CacheFormatError, match="truncated header") as error:
+            read_cache_data(path, SCHEMA)
+        assert not isinstance(error.value, CacheSchemaError)
+        with pytest.raises(CacheFormatError, match="truncated header"):
+            read_compressed_file(path)
+
+        db = FunctionDatabase(source_dir="./demo", cache_dir=str(tmp_path))
+        db.cache_file.write_bytes(path.read_bytes())
+        output = io.StringIO()
+        with redirect_stdout(output):
+            assert not db._load_from_cache(verbose=True)
+        assert "truncated header" in output.getvalue()
+        assert "unpack requires" not in output.getvalue()
+
+    # SWUT_DB_00049: The fingerprint follows the model fields
+    def test_schema_fingerprint(self):
+        """Test that adding a field changes the schema."""
+        before = make_dataclass("Entry", [("checksum", str)])
+        after = make_dataclass("Entry", [("checksum", str), ("size", int)])
+
+        assert CacheSchema.of(1, [before]) == CacheSchema.of(1, [before])
+        assert CacheSchema.of(1, [after]) != CacheSchema.of(1, [before])
+        assert CacheSchema.of(1, [after]).version == 1
+
+    # SWUT_DB_00049: Unknown and missing codecs are reported
+    def test_check_compression(self):
+        """Test unknown codecs and codecs whose package is missing."""
+        with pytest.raises(ValueError, match="unknown cache compression"):
+            check_compression("brotli")
+        with patch.object(cache_file, "zstandard", None):
+            assert "zstd" not in available_compressions()
+            with pytest.raises(ValueError, match="not installed"):
+                check_compression("zstd")
+        with pytest.raises(ValueError):
+            FunctionDatabase(source_dir="./demo", cache_compression="brotli")
+
+    # SWUT_DB_00049: Writes replace the file atomically
+    def test_atomic_write(self, tmp_path):
+        """Test that a failed write leaves the old file and no temporary file."""
+        path = tmp_path / "data.pkl"
+        path.write_bytes(b"old")
+        with pytest.raises(RuntimeError):
+            with atomic_write(path) as f:
+                f.write(b"partial")
+                raise RuntimeError("disk full")
+        assert path.read_bytes() == b"old"
+        assert list(tmp_path.iterdir()) == [path]
+
+        with atomic_write(path) as f:
+            f.write(b"new")
+            assert path.read_bytes() == b"old"
+        assert path.read_bytes() == b"new"
+        assert list(tmp_path.iterdir()) == [path]
+
+
+class TestDatabaseCacheFiles:
+    """Tests: SWUT_DB_00049 - Versioned Compressed Cache Files"""
+
+    # SWUT_DB_00049: A compressed cache is loaded like a plain one
+    def test_compressed_cache(self, tmp_path, build_demo_db):
+        """Test that both cache files are compressed and loaded again."""
+        plain = build_demo_db(tmp_path / "plain")
+        built = build_demo_db(tmp_path / "zlib", cache_compression="zlib")
+        assert read_compressed_file(plain.binary_cache_file) is None
+        assert read_compressed_file(built.binary_cache_file) is not None
+        assert built.binary_cache_file.stat().st_size < (
+            plain.binary_cache_file.stat().st_size
+        )
+        mapped = read_binary_cache(built.binary_cache_file)
+        assert len(mapped.store) == len(plain.store)
+
+        # The file header names the codec, so any setting reads the cache
+        with patch.object(FunctionDatabase, "_build_with_single_stage") as build:
+            loaded = build_demo_db(tmp_path / "zlib")
+        build.assert_not_called()
+        assert loaded.get_all_function_names() == plain.get_all_function_names()
+        assert loaded.lookup_function("Demo_Init") == plain.lookup_function(
+            "Demo_Init"
+        )
+
+    # SWUT_DB_00049: A cache of another schema is rebuilt
+    def test_other_schema_rebuilt(self, tmp_path, build_demo_db):
+        """Test that a schema change invalidates the cache with a message."""
+        build_demo_db(tmp_path / "cache")
+        newer = CacheSchema(function_database.CACHE_SCHEMA_VERSION + 1)
+        with patch.object(function_database, "CACHE_SCHEMA", newer):
+            db = FunctionDatabase(
+                source_dir="./demo", cache_dir=str(tmp_path / "cache")
+            )
+            output = io.StringIO()
+            with redirect_stdout(output):
+                assert not db._load_from_cache(verbose=True)
+        assert "Cache invalid: schema version" in output.getvalue()
+
+    # SWUT_DB_00049: The cache can be written in the background
+    def test_background_cache_write(self, tmp_path, build_demo_db):
+        """Test that build_database() returns before the cache is written."""
+        release = threading.Event()
+        write_cache = FunctionDatabase._write_cache
+
+        def slow_write(db, *args, **kwargs):
+            assert release.wait(10)
+            write_cache(db, *args, **kwargs)
+
+        profiler = Profiler()
+        with patch.object(FunctionDatabase, "_write_cache", slow_write):
+            db = build_demo_db(
+                tmp_path / "cache", background_cache_write=True, profiler=profiler
+            )
+            assert not db.cache_file.exists()
+            assert db.lookup_function("Demo_Init")
+            release.set()
+            db.wait_for_cache_write()
+
+        assert db.cache_file.exists()
+        assert [event.name for event in profiler.stages][-1] == "cache_save"
+        with patch.object(FunctionDatabase, "_build_with_single_stage") as build:
+            build_demo_db(tmp_path / "cache")
+        build.assert_not_called()
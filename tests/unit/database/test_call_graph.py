@@ -0,0 +1,193 @@
+"""Tests for database/call_graph.py (SWUT_DB_00038)"""
+
+from pathlib import Path
+
+from autosar_calltree.analyzers.call_tree_builder import CallTreeBuilder
+from autosar_calltree.database.call_graph import UNRESOLVED, CallGraph
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.database.models import FunctionCall, FunctionInfo
+
+
+class TestCallGraph:
+    """Tests: SWUT_DB_00038 - Resolved Call Graph Index"""
+
+    # SWUT_DB_00038: Calls resolve like lookup_function
+    def test_resolution_matches_lookup(self, tmp_path, build_demo_db):
+        """Test that every resolved callee equals the lookup_function result."""
+        db = build_demo_db(tmp_path / "cache")
+        graph = db.get_call_graph()
+
+        assert len(graph) == db.total_functions_found
+        for func_id in range(len(graph)):
+            func_info = graph.function(func_id)
+            assert graph.get_id(func_info) == func_id
+            for call_index, func_call in enumerate(func_info.calls):
+                matches = db.lookup_function(
+                    func_call.name, context_file=str(func_info.file_path)
+                )
+                callee_id = graph.callee(func_id, call_index)
+                if matches:
+                    assert graph.function(callee_id) is matches[0]
+                else:
+                    assert callee_id == UNRESOLVED
+
+    # SWUT_DB_00038: Unknown callees stay unresolved
+    def test_unresolved_call(self, tmp_path):
+        """Test that calls to unknown functions resolve to UNRESOLVED."""
+        db = FunctionDatabase(source_dir=str(tmp_path))
+        db._add_function(
+            FunctionInfo(
+                name="Caller",
+                return_type="void",
+                file_path=Path("caller.c"),
+                line_number=1,
+                is_static=False,
+                calls=[FunctionCall(name="Missing"), FunctionCall(name="Caller")],
+            )
+        )
+
+        graph = CallGraph.build(db)
+
+        assert [graph.callee(0, 0), graph.callee(0, 1)] == [UNRESOLVED, 0]
+        assert graph.qualified_name(0) == "caller::Caller"
+
+    # SWUT_DB_00042: The reverse index lists every resolved call
+    def test_reverse_index_matches_callees(self, tmp_path, build_demo_db):
+        """Test that callers() inverts callee() for every resolved call."""
+        db = build_demo_db(tmp_path / "cache")
+        graph = db.get_call_graph()
+
+        expected = {func_id: [] for func_id in range(len(graph))}
+        for func_id in range(len(graph)):
+            for call_index in range(len(graph.function(func_id).calls)):
+                callee_id = graph.callee(func_id, call_index)
+                if callee_id != UNRESOLVED:
+                    expected[callee_id].append((func_id, call_index))
+
+        assert {
+            func_id: graph.callers(func_id) for func_id in range(len(graph))
+        } == expected
+        assert sum(len(calls) for calls in expected.values()) > 0
+
+    # SWUT_DB_00042: Callers are looked up by function name
+    def test_lookup_callers(self, tmp_path):
+        """Test that lookup_callers() lists every calling function once."""
+        db = FunctionDatabase(source_dir=str(tmp_path))
+        for name, calls in [
+            ("Main", ["Helper", "Helper"]),
+            ("Other", ["Missing", "Helper"]),
+            ("Helper", []),
+        ]:
+            db._add_function(
+                FunctionInfo(
+                    name=name,
+                    return_type="void",
+                    file_path=Path("main.c"),
+                    line_number=1,
+                    is_static=False,
+                    calls=[FunctionCall(name=call) for call in calls],
+                )
+            )
+
+        assert [f.name for f in db.lookup_callers("Helper")] == ["Main", "Other"]
+        assert db.get_call_graph().callers(2) == [(0, 0), (0, 1), (1, 1)]
+        assert db.lookup_callers("Main") == []
+        assert db.lookup_callers("Missing") == []
+
+    # SWUT_DB_00038: Adding a function invalidates the graph
+    def test_add_function_invalidates_graph(self, tmp_path, build_demo_db):
+        """Test that the graph is rebuilt after the database changes."""
+        db = build_demo_db(tmp_path / "cache")
+        graph = db.get_call_graph()
+
+        db._add_function(
+            FunctionInfo(
+                name="Extra_Func",
+                return_type="void",
+                file_path=Path("extra.c"),
+                line_number=1,
+                is_static=False,
+            )
+        )
+
+        assert db.call_graph is None
+        assert len(db.get_call_graph()) == len(graph) + 1
+
+    # SWUT_DB_00038: Graph is persisted in the cache
+    def test_graph_loaded_from_cache(self, tmp_path, build_demo_db):
+        """Test that the graph is stored in and loaded from the cache."""
+        cache_dir = tmp_path / "cache"
+        built = build_demo_db(cache_dir)
+
+        loaded = build_demo_db(cache_dir)
+
+        assert loaded.call_graph is not None
+        assert loaded.call_graph.callee_ids == built.call_graph.callee_ids
+        start = loaded.lookup_function("Demo_Init")[0]
+        assert loaded.call_graph.get_id(start) is not None
+
+    # SWUT_DB_00038: Tree building walks the graph
+    def test_builder_uses_graph_for_edges(self, tmp_path, build_demo_db):
+        """Test that CallTreeBuilder only looks up the start function by name."""
+        db = build_demo_db(tmp_path / "cache")
+        expected = CallTreeBuilder(db).build_tree("Demo_Init", max_depth=4)
+
+        lookups = []
+        original_lookup = db.lookup_function
+
+        def tracking_lookup(function_name, context_file=None):
+            lookups.append(function_name)
+            return original_lookup(function_name, context_file)
+
+        db.lookup_function = tracking_lookup
+        result = CallTreeBuilder(db).build_tree("Demo_Init", max_depth=4)
+
+        assert lookups == ["Demo_Init"]
+        assert result.statistics.total_functions == expected.statistics.total_functions
+        assert result.statistics.unique_functions == expected.statistics.unique_functions
+
+
+def _write_sources(source_dir):
+    source_dir.mkdir()
+    (source_dir / "main.c").write_text(
+        "void Main(void)\n{\n    Leaf();\n}\n\nvoid Other(void)\n{\n}\n"
+    )
+    (source_dir / "leaf.c").write_text("void Leaf(void)\n{\n    Deep();\n}\n")
+    (source_dir / "deep.c").write_text("void Deep(void)\n{\n}\n")
+
+
+class TestReachableFingerprint:
+    """Tests: SWUT_DB_00047 - Reachable Function Fingerprint"""
+
+    # SWUT_DB_00047: Reachable functions are limited by depth
+    def test_reachable_depth(self, tmp_path, build_demo_db):
+        """Test that reachable() stops after max_depth calls."""
+        _write_sources(tmp_path / "src")
+        db = build_demo_db(tmp_path / "cache", tmp_path / "src")
+        graph = db.get_call_graph()
+        main_id = graph.get_id(db.lookup_function("Main")[0])
+
+        def names(max_depth):
+            return [graph.function(f).name for f in graph.reachable(main_id, max_depth)]
+
+        assert names(0) == ["Main"]
+        assert names(1) == ["Main", "Leaf"]
+        assert names(5) == ["Main", "Leaf", "Deep"]
+
+    # SWUT_DB_00047: Only changes of reachable files change the fingerprint
+    def test_fingerprint_follows_reachable_files(self, tmp_path, build_demo_db):
+        """Test that the fingerprint changes with reachable files only."""
+        source_dir = tmp_path / "src"
+        _write_sources(source_dir)
+        db = build_demo_db(tmp_path / "cache", source_dir)
+        before = db.get_reachable_fingerprint("Main", 1)
+        deep_before = db.get_reachable_fingerprint("Main", 5)
+
+        assert db.get_reachable_fingerprint("Missing", 1) is None
+        assert before != deep_before
+        assert before == db.get_reachable_fingerprint("Main", 1)
+
+        (source_dir / "deep.c").write_text("void Deep(void)\n{\n    Leaf();\n}\n")
+        db = build_demo_db(tmp_path / "cache", source_dir)
+        assert db.get_reachable_fingerprint("Main", 1) == before
+        assert db.get_reachable_fingerprint("Main", 5) != deep_before
@@ -1,16 +1,19 @@
-"""Tests for database/function_database.py (SWUT_DB_00011-00035)"""
+"""Tests for database/function_database.py (SWUT_DB_00011-00037, SWUT_DB_00045)"""
 
 import sys
 import tempfile
 from pathlib import Path
+from unittest.mock import patch
 
 from autosar_calltree.config.module_config import ModuleConfig
+from autosar_calltree.database.cache_file import write_cache_data
 from autosar_calltree.database.function_database import (
+    CACHE_SCHEMA,
     CacheMetadata,
     FunctionDatabase,
     _format_file_size,
 )
-from autosar_calltree.database.models import FunctionInfo, FunctionType
+from autosar_calltree.database.models import FunctionCall, FunctionInfo, FunctionType
 
 
 # Helper to create function info with proper enum
@@ -25,7 +28,10 @@ def create_function(
         line_number=line_number,
         is_static=is_static,
         function_type=FunctionType.TRADITIONAL_C,
-        calls=calls or [],
+        calls=[
+            FunctionCall(name=call) if isinstance(call, str) else call
+            for call in calls or []
+        ],
         sw_module=sw_module,
     )
 
@@ -257,6 +263,30 @@ void valid_func(void) {
             # Should parse at least the valid function
             assert db.total_functions_found >= 1
 
+    def test_parallel_single_stage_matches_serial(self):
+        """SWUT_DB_00005
+
+        Test single-stage build with worker processes matches serial build (SWR_PARSER_00041)."""
+        import shutil
+
+        with tempfile.TemporaryDirectory() as temp_dir:
+            temp_path = Path(temp_dir)
+            for filename in ["hardware.c", "software.c", "communication.c", "demo.c"]:
+                src = Path("./demo/src") / filename
+                if src.exists():
+                    shutil.copy(src, temp_path / filename)
+
+            serial = FunctionDatabase(source_dir=str(temp_path))
+            serial.build_database(use_cache=False, verbose=False)
+
+            parallel = FunctionDatabase(source_dir=str(temp_path), jobs=2)
+            parallel.build_database(use_cache=False, verbose=False)
+
+            assert parallel.total_functions_found == serial.total_functions_found
+            assert sorted(parallel.functions) == sorted(serial.functions)
+            assert sorted(parallel.functions_by_file) == sorted(serial.functions_by_file)
+            assert parallel.parse_errors == serial.parse_errors
+
 
 class TestModuleConfiguration:
     """Test module configuration integration (SWUT_DB_00017)."""
@@ -1158,7 +1188,6 @@ class TestCacheLoadErrorHandling:
         """SWUT_DB_00013
 
         Test cache load with missing metadata and verbose mode (lines 479-481)."""
-        import pickle
         import sys
         from io import StringIO
 
@@ -1178,8 +1207,7 @@ class TestCacheLoadErrorHandling:
                 "parse_errors": [],
             }
 
-            with open(db.cache_file, "wb") as f:
-                pickle.dump(cache_data, f)
+            write_cache_data(db.cache_file, cache_data, CACHE_SCHEMA)
 
             # Capture stdout
             old_stdout = sys.stdout
@@ -1448,7 +1476,6 @@ class TestFunctionDatabaseMissingLinesCoverage:
         """SWUT_DB_00015
 
         Test cache load prints invalid message for missing metadata (line 486)."""
-        import pickle
         import sys
         from io import StringIO
 
@@ -1465,8 +1492,7 @@ class TestFunctionDatabaseMissingLinesCoverage:
                 "functions_by_file": {},
             }
 
-            with open(db.cache_file, "wb") as f:
-                pickle.dump(cache_data, f)
+            write_cache_data(db.cache_file, cache_data, CACHE_SCHEMA)
 
             # Capture stdout
             old_stdout = sys.stdout
@@ -1534,7 +1560,6 @@ class TestFunctionDatabaseMissingLinesCoverage:
         """SWUT_DB_00013
 
         Test cache load missing metadata without verbose mode (line 486)."""
-        import pickle
 
         with tempfile.TemporaryDirectory() as temp_dir:
             cache_dir = Path(temp_dir) / "cache"
@@ -1549,8 +1574,7 @@ class TestFunctionDatabaseMissingLinesCoverage:
                 "functions_by_file": {},
             }
 
-            with open(db.cache_file, "wb") as f:
-                pickle.dump(cache_data, f)
+            write_cache_data(db.cache_file, cache_data, CACHE_SCHEMA)
 
             # Load without verbose
             loaded = db._load_from_cache(verbose=False)
@@ -1562,7 +1586,6 @@ class TestFunctionDatabaseMissingLinesCoverage:
         """SWUT_DB_00013
 
         Test cache load with source directory mismatch in verbose mode (line 486)."""
-        import pickle
         import sys
         from datetime import datetime
         from io import StringIO
@@ -1590,8 +1613,7 @@ class TestFunctionDatabaseMissingLinesCoverage:
                 "parse_errors": [],
             }
 
-            with open(db.cache_file, "wb") as f:
-                pickle.dump(cache_data, f)
+            write_cache_data(db.cache_file, cache_data, CACHE_SCHEMA)
 
             # Capture stdout
             old_stdout = sys.stdout
@@ -1664,7 +1686,6 @@ class TestFunctionDatabaseMissingLinesCoverage:
 
         Test cache load with source directory mismatch without verbose (line 486 not executed).
         """
-        import pickle
         import sys
         from datetime import datetime
         from io import StringIO
@@ -1692,8 +1713,7 @@ class TestFunctionDatabaseMissingLinesCoverage:
                 "parse_errors": [],
             }
 
-            with open(db.cache_file, "wb") as f:
-                pickle.dump(cache_data, f)
+            write_cache_data(db.cache_file, cache_data, CACHE_SCHEMA)
 
             # Capture stdout to ensure nothing is printed
             old_stdout = sys.stdout
@@ -1707,3 +1727,403 @@ class TestFunctionDatabaseMissingLinesCoverage:
             # Should fail but not print anything (line 486 not executed)
             assert loaded is False
             assert output == ""  # No output in non-verbose mode
+
+
+class TestIncrementalCache:
+    """Test incremental per-file cache rebuilds (SWUT_DB_00036)."""
+
+    @staticmethod
+    def _write_sources(source_dir):
+        (source_dir / "a.c").write_text("void func_a(void) {\n    func_b();\n}\n")
+        (source_dir / "b.c").write_text("void func_b(void) {\n    return;\n}\n")
+        (source_dir / "c.c").write_text("void func_c(void) {\n    func_a();\n}\n")
+
+    @staticmethod
+    def _build(source_dir, cache_dir, parsed=None, **kwargs):
+        db = FunctionDatabase(
+            source_dir=str(source_dir), cache_dir=str(cache_dir), **kwargs
+        )
+        original_parse_file = db.c_parser.parse_file
+
+        def tracking_parse_file(file_path):
+            if parsed is not None:
+                parsed.append(Path(file_path).name)
+            return original_parse_file(file_path)
+
+        db.c_parser.parse_file = tracking_parse_file
+        db.build_database(use_cache=True, verbose=True)
+        return db
+
+    def test_unchanged_files_load_from_cache(self, tmp_path, capsys):
+        """SWUT_DB_00036
+
+        Test a cache with unchanged files is loaded without parsing."""
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        self._build(tmp_path, cache_dir)
+
+        parsed = []
+        db = self._build(tmp_path, cache_dir, parsed)
+
+        assert parsed == []
+        assert db.total_functions_found == 3
+        assert "functions from cache" in capsys.readouterr().out
+
+    def test_only_changed_and_added_files_are_parsed(self, tmp_path, capsys):
+        """SWUT_DB_00036
+
+        Test that only changed and added files are reparsed."""
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        full = self._build(tmp_path, cache_dir)
+
+        (tmp_path / "b.c").write_text(
+            "void func_b(void) {\n    return;\n}\n\nvoid func_b2(void) {\n}\n"
+        )
+        (tmp_path / "d.c").write_text("void func_d(void) {\n}\n")
+
+        parsed = []
+        db = self._build(tmp_path, cache_dir, parsed)
+
+        assert sorted(parsed) == ["b.c", "d.c"]
+        assert db.total_files_scanned == 4
+        assert db.total_functions_found == full.total_functions_found + 2
+        assert "func_b2" in db.functions
+        assert "func_d" in db.functions
+        assert [c.name for c in db.functions["func_a"][0].calls] == ["func_b"]
+        output = capsys.readouterr().out
+        assert "Cache stale: 1 changed, 1 added, 0 removed files" in output
+
+    def test_removed_files_are_dropped(self, tmp_path):
+        """SWUT_DB_00036
+
+        Test that functions of removed files leave the database."""
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        self._build(tmp_path, cache_dir)
+
+        (tmp_path / "c.c").unlink()
+
+        parsed = []
+        db = self._build(tmp_path, cache_dir, parsed)
+
+        assert parsed == []
+        assert "func_c" not in db.functions
+        assert "c::func_c" not in db.qualified_functions
+        assert str(tmp_path / "c.c") not in db.functions_by_file
+        assert db.total_functions_found == 2
+        assert db.total_files_scanned == 2
+
+    def test_incremental_build_matches_full_build(self, tmp_path):
+        """SWUT_DB_00036
+
+        Test that incremental indexes equal a rebuild from scratch."""
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        self._build(tmp_path, cache_dir)
+
+        (tmp_path / "a.c").write_text("void func_a(void) {\n    func_c();\n}\n")
+        incremental = self._build(tmp_path, cache_dir)
+
+        full = FunctionDatabase(source_dir=str(tmp_path), cache_dir=str(cache_dir))
+        full.build_database(use_cache=False)
+
+        assert list(incremental.functions) == list(full.functions)
+        assert list(incremental.qualified_functions) == list(full.qualified_functions)
+        assert sorted(incremental.functions_by_file) == sorted(full.functions_by_file)
+        assert incremental.total_functions_found == full.total_functions_found
+
+    def test_preprocessor_config_change_reparses_all(self, tmp_path):
+        """SWUT_DB_00036
+
+        Test that a different preprocessor configuration invalidates all entries."""
+        from autosar_calltree.config import PreprocessorConfig
+
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        self._build(tmp_path, cache_dir)
+
+        config = PreprocessorConfig()
+        config.enabled = False
+        config.extra_flags = ["-DFOO"]
+
+        parsed = []
+        self._build(tmp_path, cache_dir, parsed, preprocessor_config=config)
+
+        assert sorted(parsed) == ["a.c", "b.c", "c.c"]
+
+    def test_failed_files_get_no_entry(self, tmp_path):
+        """SWUT_DB_00036
+
+        Test that files that failed to parse are parsed again next time."""
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+
+        db = FunctionDatabase(source_dir=str(tmp_path), cache_dir=str(cache_dir))
+        original_parse_file = db.c_parser.parse_file
+
+        def failing_parse_file(file_path):
+            if Path(file_path).name == "b.c":
+                raise RuntimeError("Mock parsing error")
+            return original_parse_file(file_path)
+
+        db.c_parser.parse_file = failing_parse_file
+        db.build_database(use_cache=True, verbose=False)
+        assert len(db.parse_errors) == 1
+
+        parsed = []
+        db2 = self._build(tmp_path, cache_dir, parsed)
+
+        assert parsed == ["b.c"]
+        assert db2.parse_errors == []
+        assert "func_b" in db2.functions
+
+    def test_file_edited_during_build_is_parsed_again(self, tmp_path):
+        """SWUT_DB_00036
+
+        Test that an entry keeps the checksum of the content that was parsed."""
+        import os
+
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        edited = "void func_b(void) {\n}\n\nvoid func_b2(void) {\n}\n"
+        write_cache = FunctionDatabase._write_cache
+
+        def edit_then_write(db, *args, **kwargs):
+            (tmp_path / "b.c").write_text(edited)
+            write_cache(db, *args, **kwargs)
+
+        with patch.object(FunctionDatabase, "_write_cache", edit_then_write):
+            db = self._build(tmp_path, cache_dir)
+        assert "func_b2" not in db.functions
+
+        # A later mtime makes the next build compare checksums
+        stat_result = (tmp_path / "b.c").stat()
+        os.utime(
+            tmp_path / "b.c",
+            ns=(stat_result.st_atime_ns, stat_result.st_mtime_ns + 10**9),
+        )
+        parsed = []
+        db = self._build(tmp_path, cache_dir, parsed)
+
+        assert parsed == ["b.c"]
+        assert "func_b2" in db.functions
+
+
+class TestStatChangeDetection:
+    """Test stat-based change detection before hashing (SWUT_DB_00037)."""
+
+    @staticmethod
+    def _build(source_dir, cache_dir, hashed=None):
+        db = FunctionDatabase(source_dir=str(source_dir), cache_dir=str(cache_dir))
+        original_checksum = db._compute_file_checksum
+
+        def tracking_checksum(file_path):
+            if hashed is not None:
+                hashed.append(Path(file_path).name)
+            return original_checksum(file_path)
+
+        db._compute_file_checksum = tracking_checksum
+        db.build_database(use_cache=True, verbose=False)
+        return db
+
+    @staticmethod
+    def _write_sources(source_dir):
+        (source_dir / "a.c").write_text("void func_a(void) {\n}\n")
+        (source_dir / "b.c").write_text("void func_b(void) {\n}\n")
+
+    def test_unchanged_stat_skips_hashing(self, tmp_path):
+        """SWUT_DB_00037
+
+        Test that files with unchanged mtime and size are not hashed."""
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        self._build(tmp_path, cache_dir)
+
+        hashed = []
+        db = self._build(tmp_path, cache_dir, hashed)
+
+        assert hashed == []
+        assert db.total_functions_found == 2
+
+    def test_touched_file_is_hashed_once(self, tmp_path):
+        """SWUT_DB_00037
+
+        Test that a touched but unchanged file is hashed and its stat refreshed."""
+        import os
+
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        self._build(tmp_path, cache_dir)
+
+        stat_result = (tmp_path / "a.c").stat()
+        os.utime(
+            tmp_path / "a.c",
+            ns=(stat_result.st_atime_ns, stat_result.st_mtime_ns + 10**9),
+        )
+
+        hashed = []
+        db = self._build(tmp_path, cache_dir, hashed)
+        assert hashed == ["a.c"]
+        assert db.total_functions_found == 2
+
+        hashed = []
+        self._build(tmp_path, cache_dir, hashed)
+        assert hashed == []
+
+    def test_changed_content_detected(self, tmp_path):
+        """SWUT_DB_00037
+
+        Test that a content change with the same size is detected via mtime."""
+        import os
+
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        self._build(tmp_path, cache_dir)
+
+        stat_result = (tmp_path / "b.c").stat()
+        (tmp_path / "b.c").write_text("void func_x(void) {\n}\n")
+        os.utime(
+            tmp_path / "b.c",
+            ns=(stat_result.st_atime_ns, stat_result.st_mtime_ns + 10**9),
+        )
+
+        db = self._build(tmp_path, cache_dir)
+
+        assert "func_x" in db.functions
+        assert "func_b" not in db.functions
+
+    def test_stat_recorded_before_parsing(self, tmp_path):
+        """SWUT_DB_00037
+
+        Test that a file edited during the build is not taken as unchanged."""
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        edited = "void func_b(void) {\n}\n\nvoid func_x(void) {\n}\n"
+        write_cache = FunctionDatabase._write_cache
+
+        def edit_then_write(db, *args, **kwargs):
+            (tmp_path / "b.c").write_text(edited)
+            write_cache(db, *args, **kwargs)
+
+        with patch.object(FunctionDatabase, "_write_cache", edit_then_write):
+            db = self._build(tmp_path, cache_dir)
+        assert "func_x" not in db.functions
+
+        hashed = []
+        db = self._build(tmp_path, cache_dir, hashed)
+
+        assert hashed == ["b.c"]
+        assert "func_x" in db.functions
+
+    def test_checksum_falls_back_to_blake2b(self, tmp_path):
+        """SWUT_DB_00037
+
+        Test that BLAKE2b is used when xxhash is not installed."""
+        import hashlib
+        from unittest.mock import patch
+
+        test_file = tmp_path / "test.c"
+        test_file.write_bytes(b"void f(void) {}\n")
+        db = FunctionDatabase(source_dir=str(tmp_path))
+
+        with patch("autosar_calltree.database.function_database.xxhash", None):
+            checksum = db._compute_file_checksum(test_file)
+
+        assert checksum == hashlib.blake2b(
+            b"void f(void) {}\n", digest_size=16
+        ).hexdigest()
+
+
+class TestLazyParsing:
+    """Tests: SWUT_DB_00045 - Demand-Driven Lazy Parsing"""
+
+    @staticmethod
+    def _write_sources(source_dir):
+        (source_dir / "a.c").write_text(
+            "void func_a(void) {\n    func_b();\n    helper();\n}\n"
+            "static void helper(void) {\n}\n"
+        )
+        (source_dir / "b.c").write_text(
+            "void func_b(void) {\n    helper();\n}\n"
+            "static void helper(void) {\n}\n"
+        )
+        (source_dir / "c.c").write_text("void func_c(void) {\n    func_a();\n}\n")
+        (source_dir / "d.c").write_text("void unused(void) {\n}\n")
+
+    @staticmethod
+    def _build(source_dir, cache_dir, parsed, lazy=True):
+        db = FunctionDatabase(source_dir=str(source_dir), cache_dir=str(cache_dir))
+        original = db.c_parser.parse_file_with_stats
+
+        def tracking_parse(file_path, *args, **kwargs):
+            parsed.append(Path(file_path).name)
+            return original(file_path, *args, **kwargs)
+
+        db.c_parser.parse_file_with_stats = tracking_parse
+        db.build_database(use_cache=True, lazy=lazy)
+        return db
+
+    # SWUT_DB_00045: Only files defining looked up names are parsed
+    def test_lookup_parses_defining_files(self, tmp_path):
+        """Test that a lookup parses all files defining the name."""
+        self._write_sources(tmp_path)
+        parsed = []
+        db = self._build(tmp_path, tmp_path / "cache", parsed)
+
+        assert parsed == [] and db.is_lazy
+        assert [f.name for f in db.lookup_function("func_b")] == ["func_b"]
+        assert parsed == ["b.c"]
+
+        helpers = db.functions["helper"]
+        db.lookup_function("helper")
+        assert parsed == ["b.c", "a.c"]
+        # Candidates follow discovery order, as after a full build
+        full = FunctionDatabase(source_dir=str(tmp_path), cache_dir=str(tmp_path))
+        full.build_database(use_cache=False)
+        assert [str(f.file_path) for f in db.functions["helper"]] == [
+            str(f.file_path) for f in full.functions["helper"]
+        ]
+        assert len(helpers) == 1
+        assert db.lookup_function("missing") == []
+        assert db.lazy_files_parsed == 2
+
+    # SWUT_DB_00045: Parsed files are cached, pending files are not
+    def test_lazy_cache(self, tmp_path):
+        """Test that the next lazy and full builds reuse the parsed files."""
+        self._write_sources(tmp_path)
+        cache_dir = tmp_path / "cache"
+        db = self._build(tmp_path, cache_dir, [])
+        db.lookup_function("func_a")
+        db.save_lazy_cache()
+
+        parsed = []
+        db = self._build(tmp_path, cache_dir, parsed)
+        assert "func_a" in db.functions
+        db.lookup_function("func_a")
+        assert parsed == []
+
+        parsed = []
+        db = FunctionDatabase(source_dir=str(tmp_path), cache_dir=str(cache_dir))
+        original = db.c_parser.parse_file
+
+        def tracking_parse_file(file_path):
+            parsed.append(Path(file_path).name)
+            return original(file_path)
+
+        db.c_parser.parse_file = tracking_parse_file
+        db.build_database(use_cache=True)
+        assert sorted(parsed) == ["b.c", "c.c", "d.c"]
+        assert db.total_functions_found == 6
+
+    # SWUT_DB_00045: Caller lookups parse all pending files
+    def test_lookup_callers_parses_all(self, tmp_path):
+        """Test that lookup_callers() sees callers in unparsed files."""
+        self._write_sources(tmp_path)
+        db = self._build(tmp_path, tmp_path / "cache", [])
+
+        callers = db.lookup_callers("func_a")
+
+        assert [f.name for f in callers] == ["func_c"]
+        assert not db.is_lazy
+
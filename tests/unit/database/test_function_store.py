@@ -0,0 +1,223 @@
+"""Tests for database/function_store.py (SWUT_DB_00039)"""
+
+import io
+import pickle
+from contextlib import redirect_stdout
+
+import pytest
+
+from autosar_calltree.database.cache_file import read_cache_data, write_cache_data
+from autosar_calltree.database.function_database import (
+    CACHE_SCHEMA,
+    FunctionDatabase,
+)
+from autosar_calltree.database.function_store import (
+    NO_STRING,
+    FunctionIndex,
+    FunctionStore,
+)
+from autosar_calltree.database.models import (
+    FunctionCall,
+    FunctionType,
+    Parameter,
+)
+
+
+@pytest.fixture
+def function(make_function):
+    """make_function with every optional field set, so the columns are covered."""
+
+    def factory(name, file_path="module.c", calls=()):
+        return make_function(
+            name,
+            file_path,
+            [
+                FunctionCall(
+                    name=call,
+                    is_conditional=True,
+                    condition="mode == 1",
+                    is_loop=index % 2 == 1,
+                    loop_condition="i < 4" if index % 2 else None,
+                    line_number=None if index else 7,
+                )
+                for index, call in enumerate(calls)
+            ],
+            return_type="Std_ReturnType",
+            is_static=True,
+            function_type=FunctionType.AUTOSAR_FUNC,
+            memory_class="RTE_CODE",
+            parameters=[
+                Parameter(
+                    name="data",
+                    param_type="uint8",
+                    is_pointer=True,
+                    is_const=True,
+                    memory_class="AUTOMATIC",
+                )
+            ],
+            called_by={"Caller"},
+            macro_type="FUNC",
+            sw_module="ComModule",
+        )
+
+    return factory
+
+
+class TestFunctionStore:
+    """Tests: SWUT_DB_00039 - Columnar Function Store"""
+
+    # SWUT_DB_00039: Materialized functions equal the added ones
+    def test_round_trip(self, function):
+        """Test that every field survives the columnar representation."""
+        original = function("Com_Send", calls=["Com_Write", "Com_Check"])
+        store = FunctionStore()
+
+        restored = store.get(store.add(original))
+
+        assert restored == original
+        assert restored is not original
+        for field_name in (
+            "return_type",
+            "is_static",
+            "function_type",
+            "memory_class",
+            "parameters",
+            "calls",
+            "called_by",
+            "macro_type",
+            "qualified_name",
+            "sw_module",
+        ):
+            assert getattr(restored, field_name) == getattr(original, field_name)
+
+    # SWUT_DB_00039: Objects are materialized once and shared
+    def test_get_returns_same_object(self, function):
+        """Test that get() caches the object and id_of() finds it."""
+        store = FunctionStore()
+        first = store.add(function("A"))
+        second = store.add(function("B"))
+
+        func_info = store.get(first)
+
+        assert store.get(first) is func_info
+        assert store.id_of(func_info) == first
+        assert store.id_of(function("A")) is None
+        assert store.get(second).file_path is func_info.file_path
+
+    # SWUT_DB_00039: Strings are stored once
+    def test_strings_interned(self, function):
+        """Test that repeated strings share one string ID."""
+        store = FunctionStore()
+        store.add(function("A", calls=["Com_Write"]))
+        store.add(function("B", calls=["Com_Write"]))
+
+        assert store.call_name_ids[0] == store.call_name_ids[1]
+        assert store.file_ids[0] == store.file_ids[1]
+        assert store.qualified_name_ids[0] == NO_STRING
+        assert store.strings.strings.count("Com_Write") == 1
+
+    # SWUT_DB_00039: Functions are copied between stores column by column
+    def test_copy_functions(self, function):
+        """Test that copied functions keep their rows and remap strings."""
+        source = FunctionStore()
+        for name in ("A", "B", "C"):
+            source.add(function(name, calls=[f"{name}_Call"]))
+        target = FunctionStore()
+        target.add(function("Z", calls=["Z_Call"]))
+
+        copied = target.copy_functions(source, [0, 2])
+
+        assert copied == range(1, 3)
+        assert [target.get(i).name for i in copied] == ["A", "C"]
+        assert target.get(2).calls == source.get(2).calls
+        assert target.get(2).parameters == source.get(2).parameters
+        assert target.get(1).called_by == {"Caller"}
+        assert target.get(0).calls[0].name == "Z_Call"
+
+    # SWUT_DB_00039: Pickling keeps the columns only
+    def test_pickle_drops_objects(self, function):
+        """Test that materialized objects are not pickled."""
+        store = FunctionStore()
+        func_id = store.add(function("A"))
+        store.get(func_id)
+
+        loaded = pickle.loads(pickle.dumps(store))
+
+        assert loaded._objects == {}
+        assert loaded.get(func_id) == store.get(func_id)
+        assert loaded.add(function("B")) == 1
+        assert loaded.strings.intern("A") == store.strings.intern("A")
+
+    # SWUT_DB_00039: Indexes hold function IDs
+    def test_function_index(self, function):
+        """Test that the index maps keys to materialized function lists."""
+        store = FunctionStore()
+        index = FunctionIndex(store)
+        func_info = function("A")
+
+        index["A"] = [func_info]
+
+        assert "A" in index
+        assert index["A"][0] is func_info
+        assert index.ids == {"A": [0]}
+        assert index == {"A": [func_info]}
+
+
+class TestDatabaseOnStore:
+    """Tests: SWUT_DB_00039 - database indexes on the function store"""
+
+    # SWUT_DB_00039: Lookups only materialize what they return
+    def test_lazy_materialization(self, tmp_path):
+        """Test that a cached database materializes functions on demand."""
+        cache_dir = tmp_path / "cache"
+        with redirect_stdout(io.StringIO()):
+            for _ in range(2):  # Build the cache, then load it
+                db = FunctionDatabase(source_dir="./demo", cache_dir=str(cache_dir))
+                db.build_database()
+
+        assert db.total_functions_found > 1
+        assert db.store._objects == {}
+        assert db.get_all_function_names()
+        assert db.store._objects == {}
+
+        matches = db.lookup_function("Demo_Init")
+
+        assert len(matches) == 1
+        assert list(db.store._objects.values()) == matches
+
+    # SWUT_DB_00039: Old cache formats are rebuilt
+    def test_outdated_cache_format(self, tmp_path):
+        """Test that a cache without a binary cache reference is not loaded."""
+        cache_dir = tmp_path / "cache"
+        with redirect_stdout(io.StringIO()):
+            db = FunctionDatabase(source_dir="./demo", cache_dir=str(cache_dir))
+            db.build_database()
+        cache_data = read_cache_data(db.cache_file, CACHE_SCHEMA)
+        del cache_data["binary_cache"]
+        write_cache_data(db.cache_file, cache_data, CACHE_SCHEMA)
+
+        output = io.StringIO()
+        with redirect_stdout(output):
+            loaded = FunctionDatabase(
+                source_dir="./demo", cache_dir=str(cache_dir)
+            )._load_from_cache(verbose=True)
+
+        assert not loaded
+        assert "outdated cache format" in output.getvalue()
+
+    # SWUT_DB_00039: The call graph is resolved on the columns
+    def test_call_graph_materializes_nothing(self, tmp_path, function):
+        """Test that ambiguous calls resolve like lookup_function, lazily."""
+        db = FunctionDatabase(source_dir=str(tmp_path))
+        db._add_function(function("Caller", "caller.c", calls=["Helper"]))
+        db._add_function(function("Helper", "declared.c"))
+        implementation = function("Helper", "helper.c", calls=["Other"])
+        db._add_function(implementation)
+
+        graph = db.get_call_graph()
+
+        assert db.store._objects == {}
+        assert graph.function(graph.callee(0, 0)) == implementation
+        assert db.lookup_function("Helper", context_file="caller.c") == [
+            implementation
+        ]
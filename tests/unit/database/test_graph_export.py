@@ -0,0 +1,185 @@
+"""Tests for database/graph_export.py (SWUT_DB_00043)"""
+
+import json
+import xml.etree.ElementTree as ET
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from autosar_calltree.database import graph_export
+from autosar_calltree.database.call_graph import UNRESOLVED
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.database.graph_export import (
+    GraphExportError,
+    export_call_graph,
+    graph_format_for_path,
+    read_binary_graph,
+)
+from autosar_calltree.database.models import FunctionCall, FunctionInfo
+
+GRAPHML = "{http://graphml.graphdrawing.org/xmlns}"
+
+
+def _build_small_db(source_dir):
+    db = FunctionDatabase(source_dir=str(source_dir))
+    db._add_function(
+        FunctionInfo(
+            name="Caller",
+            return_type="void",
+            file_path=Path("caller.c"),
+            line_number=3,
+            is_static=False,
+            sw_module="App",
+            calls=[
+                FunctionCall(
+                    name="Helper",
+                    is_conditional=True,
+                    condition="mode == 1",
+                    line_number=5,
+                ),
+                FunctionCall(name="Missing", is_loop=True, loop_condition="i < n"),
+            ],
+        )
+    )
+    db._add_function(
+        FunctionInfo(
+            name="Helper",
+            return_type="void",
+            file_path=Path("helper.c"),
+            line_number=10,
+            is_static=True,
+        )
+    )
+    return db
+
+
+class TestGraphExport:
+    """Tests: SWUT_DB_00043 - Call Graph Export"""
+
+    # SWUT_DB_00043: The binary export holds every function and call
+    def test_binary_round_trip(self, tmp_path, build_demo_db):
+        """Test that the binary columns match the call graph of the demo."""
+        db = build_demo_db(tmp_path / "cache")
+        graph = db.get_call_graph()
+        path = tmp_path / "out" / "calls.bin"
+
+        stats = export_call_graph(db, path)
+        exported = read_binary_graph(path)
+
+        assert stats.nodes == len(graph) == len(exported.nodes["name"])
+        assert stats.edges == len(exported.edges["target"]) > 0
+        edges = []
+        for func_id in range(len(graph)):
+            func_info = graph.function(func_id)
+            assert exported.strings[exported.nodes["name"][func_id]] == func_info.name
+            assert exported.nodes["line"][func_id] == func_info.line_number
+            for call_index, func_call in enumerate(func_info.calls):
+                edges.append(
+                    (func_id, graph.callee(func_id, call_index), func_call.name)
+                )
+        assert [
+            (source, target, exported.strings[name_id])
+            for source, target, name_id in zip(
+                exported.edges["source"],
+                exported.edges["target"],
+                exported.edges["callee_name"],
+            )
+        ] == edges
+        assert stats.unresolved_edges == sum(
+            target == UNRESOLVED for _, target, _ in edges
+        )
+
+    # SWUT_DB_00043: JSON Lines records carry metadata and call flags
+    def test_jsonl_records(self, tmp_path):
+        """Test the node and edge records of the JSON Lines export."""
+        db = _build_small_db(tmp_path)
+        path = tmp_path / "calls.jsonl"
+
+        stats = export_call_graph(db, path)
+        records = [json.loads(line) for line in path.read_text().splitlines()]
+
+        assert (stats.nodes, stats.edges, stats.unresolved_edges) == (2, 2, 1)
+        nodes = {record["name"]: record for record in records[:2]}
+        assert nodes["Caller"]["sw_module"] == "App"
+        assert nodes["Caller"]["file"] == "caller.c"
+        assert nodes["Helper"]["is_static"] is True
+        conditional, loop = records[2:]
+        assert conditional["source"] == nodes["Caller"]["id"]
+        assert conditional["target"] == nodes["Helper"]["id"]
+        assert conditional["is_conditional"] is True
+        assert conditional["condition"] == "mode == 1"
+        assert conditional["line"] == 5
+        assert loop["target"] is None
+        assert loop["callee"] == "Missing"
+        assert loop["is_loop"] is True
+        assert loop["loop_condition"] == "i < n"
+
+    # SWUT_DB_00043: GraphML adds one external node per unknown callee
+    def test_graphml_document(self, tmp_path):
+        """Test that the GraphML export is well formed and links edges."""
+        db = _build_small_db(tmp_path)
+        path = tmp_path / "calls.graphml"
+
+        stats = export_call_graph(db, path)
+        graph = ET.parse(str(path)).getroot().find(f"{GRAPHML}graph")
+
+        node_ids = {node.get("id") for node in graph.iter(f"{GRAPHML}node")}
+        edges = [
+            (edge.get("source"), edge.get("target"))
+            for edge in graph.iter(f"{GRAPHML}edge")
+        ]
+        assert stats.nodes == len(node_ids) == 3
+        assert "x:Missing" in node_ids
+        assert all(
+            source in node_ids and target in node_ids for source, target in edges
+        )
+        assert len(edges) == stats.edges == 2
+
+    # SWUT_DB_00043: The format follows the file suffix
+    def test_format_from_suffix(self):
+        """Test that the output suffix selects the format."""
+        assert graph_format_for_path(Path("a.graphml")) == "graphml"
+        assert graph_format_for_path(Path("a.JSONL")) == "jsonl"
+        assert graph_format_for_path(Path("a.ndjson")) == "jsonl"
+        assert graph_format_for_path(Path("a.bin")) == "binary"
+
+    # SWUT_DB_00043: Unknown formats and foreign files are rejected
+    def test_errors(self, tmp_path):
+        """Test that bad formats and non-export files raise errors."""
+        db = _build_small_db(tmp_path)
+        with pytest.raises(ValueError):
+            export_call_graph(db, tmp_path / "calls.bin", "parquet")
+
+        other = tmp_path / "other.bin"
+        other.write_bytes(b"NOTAGRPH" + b"\0" * 16)
+        with pytest.raises(GraphExportError):
+            read_binary_graph(other)
+
+    # SWUT_DB_00043: An interrupted export keeps the previous file
+    def test_interrupted_export_keeps_file(self, tmp_path):
+        """Test that exports are renamed into place only when complete."""
+        db = _build_small_db(tmp_path)
+        # A step of each format that runs after the file was opened
+        steps = {
+            "calls.bin": "_little_endian",
+            "calls.jsonl": "_edge_rows",
+            "calls.graphml": "_edge_rows",
+        }
+        for name, step in steps.items():
+            path = tmp_path / "out" / name
+            export_call_graph(db, path)
+            previous = path.read_bytes()
+
+            with patch.object(
+                graph_export, step, side_effect=RuntimeError("interrupted")
+            ):
+                with pytest.raises(RuntimeError):
+                    export_call_graph(db, path)
+
+            assert path.read_bytes() == previous
+        assert sorted(p.name for p in (tmp_path / "out").iterdir()) == [
+            "calls.bin",
+            "calls.graphml",
+            "calls.jsonl",
+        ]
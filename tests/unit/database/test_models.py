@@ -758,6 +758,7 @@ def test_analysis_statistics_to_dict():
         "rte_functions",
         "autosar_functions",
         "circular_dependencies_found",
+        "physical_nodes",
     }
     assert set(result.keys()) == expected_keys
 
@@ -0,0 +1,98 @@
+"""Tests for database/module_graph.py (SWUT_DB_00048)"""
+
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from autosar_calltree.config.module_config import ModuleConfig
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.database.module_graph import ModuleEdge, ModuleGraph
+
+DEMO_DIR = Path(__file__).parent.parent.parent.parent / "demo"
+
+
+@pytest.fixture
+def build_mapped_db(build_demo_db):
+    """build_demo_db of the demo sources with the demo module mapping."""
+
+    def factory(cache_dir):
+        module_config = ModuleConfig(DEMO_DIR / "module_mapping.yaml")
+        return build_demo_db(cache_dir, DEMO_DIR / "src", module_config=module_config)
+
+    return factory
+
+
+class TestModuleGraph:
+    """Tests: SWUT_DB_00048 - Module Call Graph"""
+
+    # SWUT_DB_00048: Calls are aggregated by module pair
+    def test_build_aggregates_calls(self, tmp_path, make_function):
+        """Test edge counts, examples, file stem fallback and unresolved calls."""
+        db = FunctionDatabase(source_dir=str(tmp_path))
+        for name, file_name, sw_module, calls in (
+            ("App_Main", "app.c", "App", ["Hw_A", "Hw_B", "App_Helper"]),
+            ("App_Helper", "app.c", "App", ["Hw_A", "Missing"]),
+            ("Hw_A", "hw.c", "Hw", []),
+            ("Hw_B", "hw.c", "Hw", ["util_log"]),
+            ("util_log", "util.c", None, []),
+        ):
+            db._add_function(make_function(name, file_name, calls, sw_module=sw_module))
+
+        graph = ModuleGraph.build(db.get_call_graph(), max_examples=2)
+
+        assert graph.modules == {"App": 2, "Hw": 2, "util": 1}
+        assert graph.edges == [
+            ModuleEdge("App", "Hw", 3, [("App_Main", "Hw_A"), ("App_Main", "Hw_B")]),
+            ModuleEdge("App", "App", 1, [("App_Main", "App_Helper")]),
+            ModuleEdge("Hw", "util", 1, [("Hw_B", "util_log")]),
+        ]
+        assert graph.unresolved_calls == 1
+        assert graph.internal_calls() == {"App": 1}
+        assert [edge.callee_module for edge in graph.dependencies()] == ["Hw", "util"]
+
+    # SWUT_DB_00048: The module graph follows the call graph
+    def test_module_graph_rebuilt_with_call_graph(self, tmp_path, make_function):
+        """Test that adding a function gives a new module graph."""
+        db = FunctionDatabase(source_dir=str(tmp_path))
+        db._add_function(make_function("App_Main", "app.c", ["Hw_A"], sw_module="App"))
+        graph = db.get_module_graph()
+        assert db.get_module_graph() is graph
+        assert graph.dependencies() == []
+
+        db._add_function(make_function("Hw_A", "hw.c", sw_module="Hw"))
+
+        edges = db.get_module_graph().edges
+        assert [(edge.caller_module, edge.callee_module) for edge in edges] == [
+            ("App", "Hw")
+        ]
+
+    # SWUT_DB_00048: The module graph is persisted in the cache
+    def test_module_graph_loaded_from_cache(self, tmp_path, build_mapped_db):
+        """Test that a cached database does not aggregate the graph again."""
+        built = build_mapped_db(tmp_path / "cache")
+        expected = built.get_module_graph()
+        assert expected.dependencies()
+
+        with patch.object(ModuleGraph, "build") as build:
+            loaded = build_mapped_db(tmp_path / "cache")
+            graph = loaded.get_module_graph()
+
+        build.assert_not_called()
+        assert graph == expected
+
+    # SWUT_DB_00048: Cached functions take the current module mapping
+    def test_cache_without_modules_takes_module_config(
+        self, tmp_path, build_demo_db, build_mapped_db
+    ):
+        """Test that a cache built without module config gets the modules."""
+        build_demo_db(tmp_path / "cache", DEMO_DIR / "src")
+        expected = build_mapped_db(tmp_path / "expected")
+
+        with patch.object(FunctionDatabase, "_build_with_single_stage") as build:
+            loaded = build_mapped_db(tmp_path / "cache")
+
+        build.assert_not_called()
+        assert loaded.module_stats == expected.module_stats
+        assert loaded.get_module_graph() == expected.get_module_graph()
+        assert loaded.lookup_function("HW_InitClock")[0].sw_module == "HardwareModule"
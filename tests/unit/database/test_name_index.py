@@ -0,0 +1,174 @@
+"""Tests for database/name_index.py (SWUT_DB_00041)"""
+
+import io
+import re
+from contextlib import redirect_stdout
+
+import pytest
+
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.database.name_index import NameSearchIndex, required_literals
+
+NAMES = [
+    "Com_Init",
+    "COM_MainFunction",
+    "CanIf_Init",
+    "Dem_SetEventStatus",
+    "init_hardware",
+    "Rte_Call_SWC_Init",
+    "Üb_Init",
+]
+
+
+class TestNameSearchIndex:
+    """Tests: SWUT_DB_00041 - Indexed Name Search"""
+
+    # SWUT_DB_00041: Candidates contain every match, in key order
+    def test_candidates_contain_all_matches(self):
+        """Test substring, prefix and regex candidates against a scan."""
+        index = NameSearchIndex.build(NAMES)
+        searches = [
+            ("substring", "init", lambda n: "init" in n.lower()),
+            ("substring", "_MAIN", lambda n: "_main" in n.lower()),
+            ("substring", "üb_", lambda n: "üb_" in n.lower()),
+            ("prefix", "com", lambda n: n.lower().startswith("com")),
+            ("prefix", "zzz", lambda n: False),
+            ("regex", r"^Rte_Call_\w+", lambda n: re.search(r"^Rte_Call_\w+", n)),
+            ("regex", r"Se?tEvent", lambda n: re.search(r"Se?tEvent", n)),
+        ]
+        for mode, pattern, matches in searches:
+            candidates = list(index.candidates(pattern, mode))
+            expected = [i for i, name in enumerate(NAMES) if matches(name)]
+            assert candidates == sorted(candidates)
+            assert set(expected) <= set(candidates), (mode, pattern)
+
+        assert list(index.candidates("MainFunction")) == [1]
+        assert list(index.candidates("com_", "prefix")) == [0, 1]
+        assert list(index.candidates("xyzzy")) == []
+
+    # SWUT_DB_00041: Short patterns select all names
+    def test_short_patterns_scan_all(self):
+        """Test that patterns without trigrams yield every name."""
+        index = NameSearchIndex.build(NAMES)
+
+        assert list(index.candidates("in")) == list(range(len(NAMES)))
+        assert list(index.candidates("(?i)com_init", "regex")) == list(
+            range(len(NAMES))
+        )
+
+    # SWUT_DB_00041: Required regex literals are extracted conservatively
+    def test_required_literals(self):
+        """Test literal extraction for common regex forms."""
+        assert required_literals(r"^Com_.*Init$") == ["Com_", "Init"]
+        assert required_literals(r"Can(If|Tp)_Init") == ["Can", "_Init"]
+        assert required_literals(r"Dem_Set?Event") == ["Dem_Se", "Event"]
+        assert required_literals(r"Nm[A-Z]+_x\.y") == ["Nm", "_x", "y"]
+        assert required_literals(r"Com_Init|CanIf") == []
+        assert required_literals(r"(?:Com|CanIf)_Init") == ["_Init"]
+        assert required_literals(r"(?i)com") == []
+
+    # SWUT_DB_00041: Counted quantifiers are skipped with their count
+    def test_required_literals_counted_quantifiers(self):
+        """Test that the body of {m,n} is not taken as a literal."""
+        assert required_literals(r"a{2}b") == ["b"]
+        assert required_literals(r"Com_Send_{1,2}Signal") == ["Com_Send", "Signal"]
+        assert required_literals(r"Rte_(Read|Write)_x{0,1}y") == ["Rte_", "_", "y"]
+        assert required_literals(r"Nm_{,3}Init{2,}?x") == ["Nm", "Ini", "x"]
+        assert required_literals(r"Com{x}") == []
+
+
+class TestDatabaseSearch:
+    """Tests: SWUT_DB_00041 - search_functions on the name index"""
+
+    @pytest.fixture
+    def demo_db(self):
+        db = FunctionDatabase(source_dir="./demo")
+        with redirect_stdout(io.StringIO()):
+            db.build_database(use_cache=False)
+        return db
+
+    # SWUT_DB_00041: Indexed substring search equals a linear scan
+    def test_substring_matches_scan(self, demo_db):
+        """Test that every substring of names finds the scanned results."""
+        patterns = {"", "x", "in", "Demo", "_Init", "nit", "COM_", "zzz_none"}
+        patterns.update(name[1:5] for name in demo_db.functions)
+        for pattern in patterns:
+            expected = [
+                func_info
+                for name in demo_db.functions
+                if pattern.lower() in name.lower()
+                for func_info in demo_db.functions[name]
+            ]
+            assert demo_db.search_functions(pattern) == expected, pattern
+
+    # SWUT_DB_00041: Prefix and regex modes
+    def test_prefix_and_regex_modes(self, demo_db):
+        """Test prefix and regex searches and their errors."""
+        prefix = demo_db.search_function_names("demo_", mode="prefix")
+        assert prefix
+        assert all(name.lower().startswith("demo_") for name in prefix)
+
+        regex = demo_db.search_function_names(r"^Demo_\w*Init$", mode="regex")
+        assert regex == [
+            name for name in demo_db.functions if re.search(r"^Demo_\w*Init$", name)
+        ]
+
+        with pytest.raises(ValueError):
+            demo_db.search_functions("(", mode="regex")
+        with pytest.raises(ValueError):
+            demo_db.search_functions("Demo", mode="fuzzy")
+
+    # SWUT_DB_00041: Counted quantifiers find every match of a scan
+    def test_regex_counted_quantifiers_match_scan(self, demo_db, make_function):
+        """Test {n}, {m,n} and {0} regex searches against a full scan."""
+        for name in ("aab", "xaabx", "Com_Send_Signal", "Com_Send__Signal", "ComInit"):
+            demo_db._add_function(make_function(name, "extra.c"))
+        for pattern in (
+            r"a{2}b",
+            r"Com_Send_{1,2}Signal",
+            r"Com_{0}Init",
+            r"^Demo_\w{2,}",
+        ):
+            expected = [name for name in demo_db.functions if re.search(pattern, name)]
+            assert expected, pattern
+            assert demo_db.search_function_names(pattern, mode="regex") == expected
+
+    # SWUT_DB_00041: limit returns the first results only
+    def test_limit(self, demo_db):
+        """Test that limit truncates results in order."""
+        all_results = demo_db.search_functions("_")
+        assert len(all_results) > 3
+
+        assert demo_db.search_functions("_", limit=3) == all_results[:3]
+        assert demo_db.search_functions("_", limit=0) == []
+        assert demo_db.search_function_names("_", limit=2) == [
+            f.name for f in all_results[:2]
+        ]
+
+    # SWUT_DB_00041: The index follows changes of the database
+    def test_index_follows_added_functions(self, demo_db, make_function):
+        """Test that functions added after the build are found."""
+        assert demo_db.search_functions("Brand_New") == []
+
+        demo_db._add_function(make_function("Brand_New_Func", "extra.c"))
+        other = make_function("Other_Brand_New", "extra.c")
+        demo_db.functions["Other_Brand_New"] = [other]
+
+        assert [f.name for f in demo_db.search_functions("brand_new")] == [
+            "Brand_New_Func",
+            "Other_Brand_New",
+        ]
+
+    # SWUT_DB_00041: The index is stored in the binary cache
+    def test_loaded_index_decodes_candidates_only(self, tmp_path):
+        """Test that a cached database searches without decoding all names."""
+        cache_dir = tmp_path / "cache"
+        with redirect_stdout(io.StringIO()):
+            for _ in range(2):
+                db = FunctionDatabase(source_dir="./demo", cache_dir=str(cache_dir))
+                db.build_database()
+
+        results = db.search_functions("Demo_MainFunction")
+
+        assert [f.name for f in results] == ["Demo_MainFunction"]
+        assert len(db.store.strings._decoded) < len(db.functions)
@@ -0,0 +1,168 @@
+"""Tests for database/sharding.py (SWUT_DB_00046)"""
+
+import io
+import shutil
+from contextlib import redirect_stdout
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from autosar_calltree.config.module_config import ModuleConfig
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.database.sharding import (
+    ShardError,
+    ShardSpec,
+    find_shard_fragments,
+    select_shard_files,
+)
+from autosar_calltree.parsers.c_parser import CParser
+
+DEMO_DIR = Path(__file__).parent.parent.parent.parent / "demo"
+
+
+def _database(cache_dir, **kwargs):
+    return FunctionDatabase(
+        source_dir=str(DEMO_DIR / "src"), cache_dir=str(cache_dir), **kwargs
+    )
+
+
+def _build_fragments(tmp_path, count, **kwargs):
+    """Build every shard in its own cache directory and collect the fragments."""
+    fragment_dir = tmp_path / "fragments"
+    fragment_dir.mkdir(parents=True, exist_ok=True)
+    for index in range(1, count + 1):
+        db = _database(tmp_path / f"node{index}", **kwargs)
+        with redirect_stdout(io.StringIO()):
+            fragment_file = db.build_shard(ShardSpec(index, count))
+        shutil.copy(fragment_file, fragment_dir)
+        shutil.copy(fragment_file.with_suffix(".bin"), fragment_dir)
+    return find_shard_fragments(fragment_dir)
+
+
+def _signature(db):
+    """Functions, qualified keys and calls of a database in store order."""
+    return (
+        [
+            (name, [(f.file_path, f.line_number, f.sw_module) for f in infos])
+            for name, infos in db.functions.items()
+        ],
+        list(db.qualified_functions.ids),
+        {
+            name: [call.name for call in db.functions[name][0].calls]
+            for name in db.functions
+        },
+    )
+
+
+class TestShardSelection:
+    """Tests: SWUT_DB_00046 - Sharded Database Build"""
+
+    # SWUT_DB_00046: Shards are given as i/N
+    def test_parse_shard_spec(self):
+        """Test that i/N is parsed and out-of-range shards are rejected."""
+        shard = ShardSpec.parse(" 2 / 8 ")
+        assert shard == ShardSpec(2, 8)
+        assert str(shard) == "2/8"
+        assert shard.fragment_name == "shard-2-of-8.pkl"
+        for text in ("0/2", "3/2", "1/0", "2", "a/b", "-1/2"):
+            with pytest.raises(ValueError):
+                ShardSpec.parse(text)
+
+    # SWUT_DB_00046: Each file belongs to exactly one shard
+    def test_shards_partition_files_by_size(self):
+        """Test that the shards cover every file once and balance bytes."""
+        files = [Path(f"f{index:02d}.c") for index in range(20)]
+        sizes = {path: 100 * (index % 7) for index, path in enumerate(files)}
+
+        shards = [
+            select_shard_files(files, ShardSpec(index, 3), sizes.__getitem__)
+            for index in (1, 2, 3)
+        ]
+
+        assert sorted(f for shard in shards for f in shard) == files
+        assert all(shard == sorted(shard) for shard in shards)
+        loads = [sum(sizes[f] for f in shard) for shard in shards]
+        assert max(loads) - min(loads) <= max(sizes.values())
+        assert shards[0] == select_shard_files(
+            list(files), ShardSpec(1, 3), sizes.__getitem__
+        )
+
+
+class TestShardMerge:
+    """Tests: SWUT_DB_00046 - Sharded Database Build"""
+
+    # SWUT_DB_00046: Merged shards equal a full build
+    def test_merge_equals_full_build(self, tmp_path):
+        """Test that merging all fragments gives the database of a full build."""
+        config = ModuleConfig(DEMO_DIR / "module_mapping.yaml")
+        full = _database(tmp_path / "full", module_config=config)
+        with redirect_stdout(io.StringIO()):
+            full.build_database(use_cache=False)
+        fragments = _build_fragments(tmp_path, 3, module_config=config)
+
+        merged = _database(tmp_path / "merged", module_config=config)
+        with redirect_stdout(io.StringIO()):
+            merged.merge_shards(fragments)
+
+        assert len(fragments) == 3
+        assert _signature(merged) == _signature(full)
+        assert merged.module_stats == full.module_stats
+        assert merged.total_files_scanned == full.total_files_scanned
+
+        # The merged cache is loaded as is by the next build
+        loaded = _database(tmp_path / "merged", module_config=config)
+        with patch.object(FunctionDatabase, "_build_with_single_stage") as build:
+            with redirect_stdout(io.StringIO()):
+                loaded.build_database(use_cache=True)
+        build.assert_not_called()
+        assert _signature(loaded) == _signature(full)
+        assert loaded.module_stats == full.module_stats
+
+    # SWUT_DB_00046: Parse errors of all shards are kept
+    def test_merge_keeps_parse_errors(self, tmp_path):
+        """Test that failed files keep their errors and are parsed again."""
+        parse_file = CParser.parse_file
+
+        def failing_parse(parser, file_path):
+            if file_path.name == "demo.c":
+                raise RuntimeError("broken")
+            return parse_file(parser, file_path)
+
+        with patch.object(CParser, "parse_file", failing_parse):
+            fragments = _build_fragments(tmp_path, 2)
+        merged = _database(tmp_path / "merged")
+        with redirect_stdout(io.StringIO()):
+            merged.merge_shards(fragments)
+
+        assert len(merged.parse_errors) == 1
+        assert "broken" in merged.parse_errors[0]
+        assert "Demo_Init" not in merged.functions
+
+        rebuilt = _database(tmp_path / "merged")
+        with redirect_stdout(io.StringIO()):
+            rebuilt.build_database(use_cache=True)
+        assert "Demo_Init" in rebuilt.functions
+        assert rebuilt.parse_errors == []
+
+    # SWUT_DB_00046: Incomplete or mixed fragments are rejected
+    def test_merge_rejects_invalid_fragments(self, tmp_path):
+        """Test missing, duplicated and foreign fragments."""
+        fragments = _build_fragments(tmp_path, 3)
+        merged = _database(tmp_path / "merged")
+
+        with pytest.raises(ShardError, match="no shard fragments"):
+            merged.merge_shards([])
+        with pytest.raises(ShardError, match="missing shard fragments: 2/3"):
+            merged.merge_shards([fragments[0], fragments[2]])
+        with pytest.raises(ShardError, match="found twice"):
+            merged.merge_shards([fragments[0], fragments[0]])
+
+        lexical = _database(tmp_path / "lexical", full_parse=False)
+        with pytest.raises(ShardError, match="other parser"):
+            lexical.merge_shards(fragments)
+
+        other_build = _build_fragments(tmp_path / "other", 2)
+        with pytest.raises(ShardError, match="another build"):
+            merged.merge_shards([fragments[0], other_build[1]])
+        assert not merged.cache_file.exists()
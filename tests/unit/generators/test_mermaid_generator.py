@@ -3,6 +3,7 @@
 Tests the MermaidGenerator class which generates Mermaid sequence diagrams from call trees.
 """
 
+import re
 from datetime import datetime
 from pathlib import Path
 from typing import List, Optional
@@ -17,7 +18,9 @@ from autosar_calltree.database.models import (
     FunctionInfo,
     FunctionType,
     Parameter,
+    TreeTruncation,
 )
+from autosar_calltree.database.module_graph import ModuleEdge, ModuleGraph
 from autosar_calltree.generators.mermaid_generator import MermaidGenerator
 
 
@@ -1671,3 +1674,358 @@ class TestMermaidGeneratorMissingLinesCoverage:
         assert "`uint32 id`" in params
         assert "`uint8* data`" in params
         assert "<br>" in params
+
+
+# SWUT_GEN_00053: Caller Tree Diagram
+def test_caller_tree_diagram() -> None:
+    """SWUT_GEN_00053
+
+    Test that caller trees are drawn from the entry points to the root."""
+    result = create_mock_analysis_result(root_function="Det_ReportError")
+    result.is_caller_tree = True
+    result.call_tree = create_mock_call_tree(
+        [
+            (
+                "Det_ReportError",
+                "det.c",
+                None,
+                [
+                    ("Runnable_1", "swc.c", None, [("Task_A", "os.c", None, [])]),
+                    ("Helper", "swc.c", None, []),
+                ],
+            ),
+        ]
+    )
+    result.call_tree.children[1].is_optional = True
+    result.call_tree.children[1].condition = "error"
+
+    output = MermaidGenerator().generate_to_string(result)
+
+    assert output.startswith("# Callers of: Det_ReportError")
+    assert "## Caller Tree (Text)" in output
+    diagram = output.split("```mermaid")[1].split("```")[0]
+    lines = [line.strip() for line in diagram.strip().splitlines()]
+    assert lines[1:5] == [
+        "participant Task_A",
+        "participant Runnable_1",
+        "participant Helper",
+        "participant Det_ReportError",
+    ]
+    assert lines[6:] == [
+        "Task_A->>Runnable_1: call",
+        "Runnable_1->>Det_ReportError: call",
+        "opt error",
+        "Helper->>Det_ReportError: call",
+        "end",
+    ]
+
+
+# SWUT_GEN_00054: Streaming Document Generation
+def test_write_document_streams_deep_trees(tmp_path: Path) -> None:
+    """SWUT_GEN_00054
+
+    Test that deep trees are written without recursion and match the string."""
+    func = create_mock_function("Chain", "chain.c")
+    node = CallTreeNode(function_info=func, depth=3000)
+    for depth in range(2999, -1, -1):
+        node = CallTreeNode(function_info=func, depth=depth, children=[node])
+    result = create_mock_analysis_result(root_function="Chain")
+    result.call_tree = node
+
+    output_path = tmp_path / "chain.md"
+    MermaidGenerator(include_returns=True).generate(result, str(output_path))
+    content = output_path.read_text(encoding="utf-8")
+
+    as_string = MermaidGenerator(include_returns=True).generate_to_string(result)
+    generated_line = re.compile(r"^- \*\*Generated\*\*: .*$", re.MULTILINE)
+    assert generated_line.sub("", content) == generated_line.sub("", as_string)
+    diagram = content.split("```mermaid")[1].split("```")[0]
+    assert diagram.count("Chain->>Chain: call") == 3000
+    assert diagram.count("Chain-->>Chain: return") == 3000
+    assert "participant Chain\n" in diagram
+
+
+# SWUT_GEN_00054: Streaming Document Generation
+def test_shared_subtrees_written_at_every_occurrence() -> None:
+    """SWUT_GEN_00054
+
+    Test that a children list shared by several nodes is written for each."""
+    leaf = CallTreeNode(function_info=create_mock_function("Leaf", "l.c"), depth=2)
+    shared_children = [leaf]
+    root = CallTreeNode(
+        function_info=create_mock_function("Root", "r.c"),
+        depth=0,
+        children=[
+            CallTreeNode(
+                function_info=create_mock_function(name, "m.c"),
+                depth=1,
+                children=shared_children,
+            )
+            for name in ("A", "B")
+        ],
+    )
+
+    gen = MermaidGenerator()
+    lines: List[str] = []
+    gen._generate_sequence_calls(root, lines)
+
+    assert [line.strip() for line in lines] == [
+        "Root->>A: call",
+        "A->>Leaf: call",
+        "Root->>B: call",
+        "B->>Leaf: call",
+    ]
+    assert gen._collect_participants(root) == ["Root", "A", "Leaf", "B"]
+    assert gen._collect_participants(root, callers_first=True) == [
+        "Leaf",
+        "A",
+        "B",
+        "Root",
+    ]
+
+
+# SWUT_GEN_00055: Truncation Annotation
+def test_truncated_nodes_annotated() -> None:
+    """SWUT_GEN_00055
+
+    Test that nodes left unexpanded by a budget are noted in all sections."""
+    result = create_mock_analysis_result()
+    result.call_tree.children[0].is_truncated = True
+    result.truncation = TreeTruncation(
+        reason="max_nodes", limit=3, truncated_functions=["hw::HW_Init"]
+    )
+
+    output = MermaidGenerator(include_returns=True).generate_to_string(result)
+
+    assert (
+        "- **Truncated**: node budget of 3 reached, 1 node with unexpanded calls"
+        in output
+    )
+    diagram = output.split("```mermaid")[1].split("```")[0]
+    lines = [line.strip() for line in diagram.strip().splitlines()]
+    assert lines[-5:-2] == [
+        "Demo_Init->>HW_Init: call",
+        "Note over HW_Init: further calls not expanded",
+        "HW_Init-->>Demo_Init: return",
+    ]
+    assert "HW_Init (hw.c:1) [TRUNCATED]" in output
+    assert "SW_Init (sw.c:1) [TRUNCATED]" not in output
+
+
+# SWUT_GEN_00056: Output Fingerprint
+def test_fingerprint_in_metadata() -> None:
+    """SWUT_GEN_00056
+
+    Test that the fingerprint of a batch output is written to the metadata."""
+    result = create_mock_analysis_result()
+    assert "Fingerprint" not in MermaidGenerator().generate_to_string(result)
+
+    result.fingerprint = "0123456789abcdef0123456789abcdef"
+    output = MermaidGenerator().generate_to_string(result)
+
+    assert "- **Fingerprint**: `0123456789abcdef0123456789abcdef`" in output
+
+
+# SWUT_GEN_00057: Module Graph Diagram
+def test_module_graph_document(tmp_path: Path) -> None:
+    """SWUT_GEN_00057
+
+    Test that a module graph is rendered as flowchart and tables."""
+    graph = ModuleGraph(
+        modules={"App": 2, 'Hw "Io"': 1},
+        edges=[
+            ModuleEdge("App", 'Hw "Io"', 2, [("App_Main", "Hw_Read")]),
+            ModuleEdge("App", "App", 1, [("App_Main", "App_Helper")]),
+        ],
+        unresolved_calls=4,
+    )
+    output_file = tmp_path / "modules" / "graph.md"
+
+    MermaidGenerator().generate_module_graph(graph, str(output_file))
+
+    output = output_file.read_text(encoding="utf-8")
+    assert output.startswith("# Module Graph\n")
+    assert "- **Module Dependencies**: 1" in output
+    assert "- **Cross-Module Calls**: 2" in output
+    assert "- **Unresolved Calls**: 4" in output
+    diagram = output.split("```mermaid\n")[1].split("```")[0]
+    assert diagram.splitlines() == [
+        "flowchart LR",
+        '    M1["App"]',
+        '    M2["Hw #quot;Io#quot;"]',
+        "    M1 -->|2 calls| M2",
+    ]
+    assert '| App | Hw "Io" | 2 | `App_Main → Hw_Read` |' in output
+    assert "| App | 2 | 1 |" in output
+    assert '| Hw "Io" | 1 | 0 |' in output
+
+
+def _wide_tree_result() -> AnalysisResult:
+    """Root calling A, B and C, each calling three functions of its module."""
+    result = create_mock_analysis_result(root_function="Root")
+    result.call_tree = create_mock_call_tree(
+        [
+            (
+                "Root",
+                "root.c",
+                "RootModule",
+                [
+                    (
+                        name,
+                        f"{name.lower()}.c",
+                        f"{name}Module",
+                        [
+                            (f"{name}_{index}", f"{name.lower()}.c", f"{name}Module")
+                            for index in range(3)
+                        ],
+                    )
+                    for name in ("A", "B", "C")
+                ],
+            ),
+        ]
+    )
+    return result
+
+
+def _diagram_parts(output: str) -> List[List[str]]:
+    """Stripped message lines of every Mermaid diagram of a document."""
+    return [
+        [line.strip() for line in block.split("```")[0].strip().splitlines()]
+        for block in output.split("```mermaid")[1:]
+    ]
+
+
+# SWUT_GEN_00058: Diagram Splitting
+def test_diagram_not_split_below_limit() -> None:
+    """SWUT_GEN_00058
+
+    Test that a diagram within max_messages is written unchanged."""
+    result = _wide_tree_result()
+    generated_line = re.compile(r"^- \*\*Generated\*\*: .*$", re.MULTILINE)
+
+    unsplit = MermaidGenerator().generate_to_string(result)
+    limited = MermaidGenerator(max_messages=12).generate_to_string(result)
+
+    assert generated_line.sub("", limited) == generated_line.sub("", unsplit)
+    assert "Diagram Parts" not in limited
+
+
+# SWUT_GEN_00058: Diagram Splitting
+def test_diagram_split_by_subtree() -> None:
+    """SWUT_GEN_00058
+
+    Test that parts stay within the limit and together hold every call."""
+    result = _wide_tree_result()
+    unsplit_calls = _diagram_parts(MermaidGenerator().generate_to_string(result))[0]
+
+    output = MermaidGenerator(max_messages=8).generate_to_string(result)
+
+    assert "- **Diagram Parts**: 3 (split by subtree above 8 messages)" in output
+    assert "| [Part 2](#part-2) | `A` | [Part 1](#part-1) `Root` |" in output
+    assert '<a id="part-3"></a>\n\n### Part 3: B' in output
+    parts = _diagram_parts(output)
+    assert parts[0][-8:] == [
+        "Root->>A: call",
+        "Note over A: calls continued in Part 2",
+        "Root->>B: call",
+        "Note over B: calls continued in Part 3",
+        "Root->>C: call",
+        "C->>C_0: call",
+        "C->>C_1: call",
+        "C->>C_2: call",
+    ]
+    assert parts[1][:4] == [
+        "sequenceDiagram",
+        "participant Root",
+        "participant A",
+        "participant A_0",
+    ]
+    calls = [line for part in parts for line in part if "->>" in line]
+    assert sorted(set(calls)) == sorted(line for line in unsplit_calls if "->>" in line)
+
+
+# SWUT_GEN_00058: Diagram Splitting
+def test_diagram_split_by_module_keeps_blocks() -> None:
+    """SWUT_GEN_00058
+
+    Test that module splits cut calls into other modules inside their blocks."""
+    result = _wide_tree_result()
+    branch = result.call_tree.children[0]
+    branch.is_loop = True
+    branch.loop_condition = "i < n"
+    inner = branch.children[1]
+    inner.is_optional = True
+    inner.condition = "ready"
+
+    output = MermaidGenerator(
+        max_messages=3, split_by="module", use_module_names=True
+    ).generate_to_string(result)
+
+    parts = _diagram_parts(output)
+    assert len(parts) == 4
+    assert parts[0][-8:] == [
+        "loop i < n",
+        "RootModule->>AModule: A",
+        "Note over AModule: calls continued in Part 2",
+        "end",
+        "RootModule->>BModule: B",
+        "Note over BModule: calls continued in Part 3",
+        "RootModule->>CModule: C",
+        "Note over CModule: calls continued in Part 4",
+    ]
+    assert parts[1][4:] == [
+        "loop i < n",
+        "RootModule->>AModule: A",
+        "AModule->>AModule: A_0",
+        "opt ready",
+        "AModule->>AModule: A_1",
+        "end",
+        "AModule->>AModule: A_2",
+        "end",
+    ]
+
+
+# SWUT_GEN_00058: Diagram Splitting
+def test_caller_tree_split() -> None:
+    """SWUT_GEN_00058
+
+    Test that caller trees are split with links to the callers' parts."""
+    result = _wide_tree_result()
+    result.is_caller_tree = True
+    result.call_tree.children[0].is_truncated = True
+
+    output = MermaidGenerator(max_messages=8, include_returns=True).generate_to_string(
+        result
+    )
+
+    parts = _diagram_parts(output)
+    assert len(parts) == 4
+    assert parts[0][6:9] == [
+        "Note over A: callers continued in Part 2",
+        "A->>Root: call",
+        "Root-->>A: return",
+    ]
+    assert parts[1][1:5] == [
+        "participant A_0",
+        "participant A_1",
+        "participant A_2",
+        "participant A",
+    ]
+    assert parts[1][-3:] == [
+        "A_2->>A: call",
+        "A-->>A_2: return",
+        "Note over A: further callers not expanded",
+    ]
+    notes = [line for part in parts for line in part if "further callers" in line]
+    assert notes == ["Note over A: further callers not expanded"]
+
+
+# SWUT_GEN_00058: Diagram Splitting
+def test_split_options_validated() -> None:
+    """SWUT_GEN_00058
+
+    Test that invalid split options are rejected."""
+    with pytest.raises(ValueError, match="max_messages"):
+        MermaidGenerator(max_messages=0)
+    with pytest.raises(ValueError, match="split_by"):
+        MermaidGenerator(max_messages=10, split_by="depth")
@@ -4,6 +4,7 @@ Tests the RhapsodyXmiGenerator class which generates Rhapsody-compatible XMI 2.1
 UML sequence diagrams from call trees.
 """
 
+import re
 import tempfile
 from pathlib import Path
 from typing import List
@@ -1501,3 +1502,83 @@ class TestRhapsodyXmiGenerator:
 
         finally:
             output_path.unlink()
+
+    # SWR_GEN_00026: Streaming XMI Generation
+    def test_streams_deep_call_chains(self):
+        """Test that trees deeper than the recursion limit are written."""
+        depth = 3000
+        node = CallTreeNode(
+            function_info=create_mock_function(f"Func_{depth}", "chain.c"),
+            depth=depth,
+            is_optional=True,
+            condition='mode < 3 && name != "x"',
+        )
+        for level in range(depth - 1, -1, -1):
+            node = CallTreeNode(
+                function_info=create_mock_function(f"Func_{level}", "chain.c"),
+                children=[node],
+                depth=level,
+            )
+        result = AnalysisResult(
+            root_function="Func_0",
+            call_tree=node,
+            statistics=AnalysisStatistics(max_depth_reached=depth),
+        )
+
+        xmi = RhapsodyXmiGenerator().generate_to_string(result)
+        root = etree.fromstring(xmi.split("\n", 1)[1].encode("utf-8"))
+
+        messages = self._find_elements_by_type(root, "uml:Message")
+        assert len(messages) == depth
+        assert messages[-1].get("name") == f"Func_{depth}"
+        assert len(self._find_elements_by_type(root, "uml:Lifeline")) == depth + 1
+
+        fragment = self._find_elements_by_type(root, "uml:CombinedFragment")[0]
+        operand = self._find_element(fragment, "operand", self.UML_NAMESPACE)
+        assert operand.get("name") == 'mode < 3 && name != "x"'
+        assert self._find_element(operand, "message", self.UML_NAMESPACE) is not None
+        assert "autosar-calltree-messages" not in xmi
+
+    # SWR_GEN_00027: Deterministic Element IDs
+    def test_deterministic_ids(self):
+        """Test that deterministic IDs are stable, unique and GUID+ formatted."""
+        shared = [CallTreeNode(create_mock_function("HW_Write", "hw.c"), depth=2)]
+        tree = CallTreeNode(
+            function_info=create_mock_function("Demo_Init", "demo.c"),
+            children=[
+                CallTreeNode(create_mock_function("COM_Init", "com.c"), 1, shared),
+                CallTreeNode(create_mock_function("IO_Init", "io.c"), 1, shared),
+            ],
+            depth=0,
+        )
+        result = AnalysisResult(
+            root_function="Demo_Init",
+            call_tree=tree,
+            statistics=AnalysisStatistics(),
+        )
+
+        first = RhapsodyXmiGenerator(deterministic_ids=True).generate_to_string(result)
+        second = RhapsodyXmiGenerator(deterministic_ids=True).generate_to_string(result)
+        assert first == second
+        assert first != RhapsodyXmiGenerator().generate_to_string(result)
+        renamed = RhapsodyXmiGenerator(deterministic_ids=True, model_name="Other")
+        assert renamed.generate_to_string(result) != first.replace(
+            'name="CallTree_Demo_Init"', 'name="Other"'
+        )
+
+        root = etree.fromstring(first.split("\n", 1)[1].encode("utf-8"))
+        ids = [
+            elem.get(f"{{{self.XMI_NAMESPACE}}}id")
+            for elem in root.iter()
+            if elem.get(f"{{{self.XMI_NAMESPACE}}}id")
+        ]
+        assert len(ids) == len(set(ids))
+        assert len(self._find_elements_by_type(root, "uml:Message")) == 4
+        uuid_pattern = (
+            r"GUID\+[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}"
+        )
+        message_ids = [
+            elem.get(f"{{{self.XMI_NAMESPACE}}}id")
+            for elem in self._find_elements_by_type(root, "uml:Message")
+        ]
+        assert all(re.fullmatch(uuid_pattern, message_id) for message_id in message_ids)
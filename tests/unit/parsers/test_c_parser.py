@@ -1,9 +1,18 @@
-"""Tests for parsers/c_parser.py (SWUT_PARSER_00026-00035)"""
+"""Tests for parsers/c_parser.py (SWUT_PARSER_00026-00035, SWUT_PARSER_00041, SWUT_PARSER_00043-00046)"""
 
 from pathlib import Path
+from unittest.mock import MagicMock, patch
+
+from pycparser import c_parser as pycparser_c_parser
 
 from autosar_calltree.database.models import FunctionType
-from autosar_calltree.parsers.c_parser import CParser
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.parsers.c_parser import AUTOSAR_TYPEDEF_NAMES, CParser
+from autosar_calltree.preprocessing.cpp_preprocessor import (
+    PreprocessResult,
+    SharedIncludePrefix,
+    resolve_marker_path,
+)
 
 # SWUT_PARSER_00026: Optional Dependency
 
@@ -570,3 +579,677 @@ int y;"""
         assert "int x = 10;" in result
         assert 'char* msg = "/* not a comment */"' in result
         assert 'char* url = "http://example.com"' in result
+
+
+# SWUT_PARSER_00041: Multi-Process Parsing
+
+
+class TestParallelParsing:
+    """Tests: SWUT_PARSER_00041 - parse_all with a process pool."""
+
+    FIXTURES = Path(__file__).parents[2] / "fixtures"
+
+    def _fixture_files(self):
+        return sorted((self.FIXTURES / "traditional_c").glob("*.c")) + sorted(
+            (self.FIXTURES / "autosar_code").glob("*.c")
+        )
+
+    @staticmethod
+    def _summary(stats):
+        return [
+            (
+                r.source_file,
+                r.success,
+                [(f.name, f.line_number, [c.name for c in f.calls]) for f in r.functions],
+            )
+            for r in stats.results
+        ]
+
+    # SWUT_PARSER_00041: Parallel results match serial results
+    def test_parallel_matches_serial(self):
+        """Test that a process pool yields the same results as serial parsing."""
+        files = self._fixture_files()
+        parser = CParser()
+
+        serial = parser.parse_all(files, verbose=False)
+        parallel = parser.parse_all(files, verbose=False, jobs=2)
+
+        assert self._summary(parallel) == self._summary(serial)
+        assert parallel.total_functions == serial.total_functions
+        assert parallel.successful == serial.successful
+
+    # SWUT_PARSER_00041: Progress is reported in input order
+    def test_parallel_progress_in_input_order(self, capsys):
+        """Test that per-file progress lines follow the input order."""
+        files = self._fixture_files()[:4]
+
+        CParser().parse_all(files, verbose=True, jobs=2)
+
+        output = capsys.readouterr().out
+        lines = [line for line in output.splitlines() if line.startswith("[")]
+        assert len(lines) == 4
+        for idx, (line, source_file) in enumerate(zip(lines, files), 1):
+            assert line.startswith(f"[{idx}/4] {source_file.name}")
+            assert "OK (" in line
+
+    # SWUT_PARSER_00041: Pool failure falls back to serial parsing
+    def test_pool_failure_falls_back_to_serial(self, capsys):
+        """Test that files are parsed in-process when the pool is unavailable."""
+        from unittest.mock import patch
+
+        files = self._fixture_files()[:2]
+        parser = CParser()
+
+        with patch(
+            "autosar_calltree.parsers.c_parser.ProcessPoolExecutor",
+            side_effect=OSError("no processes"),
+        ):
+            results = parser.parse_files_parallel([(f, None) for f in files], jobs=2)
+
+        assert [r.source_file for r in results] == files
+        assert all(r.success for r in results)
+        assert "parsing serially" in capsys.readouterr().out
+
+
+# SWUT_PARSER_00043: Single-Pass AUTOSAR Macro Lowering
+
+
+class TestMacroLowering:
+    """Tests: SWUT_PARSER_00043 - _preprocess_content in one pass."""
+
+    def setup_method(self):
+        """Set up test fixtures."""
+        self.parser = CParser()
+
+    def _lower(self, code):
+        return self.parser._preprocess_content(code)
+
+    # SWUT_PARSER_00043: Every macro form is lowered
+    def test_all_macro_forms(self):
+        """Test FUNC, FUNC_P2*, VAR, P2VAR, P2CONST and CONST lowering."""
+        code = (
+            "FUNC(void, RTE_CODE) A(VAR(uint8, AUTOMATIC) x);\n"
+            "FUNC_P2VAR(uint8, AUTOMATIC, RTE_CODE) B(P2VAR(uint16, AUTOMATIC, APPL_DATA) p);\n"
+            "FUNC_P2CONST(uint8, AUTOMATIC, RTE_CODE) C(P2CONST(uint32, AUTOMATIC, APPL_DATA) q);\n"
+            "CONST(uint8, AUTOMATIC) d = 1;\n"
+        )
+
+        assert self._lower(code) == (
+            "void A(uint8 x);\n"
+            "uint8* B(uint16* p);\n"
+            "uint8* C(const uint32* q);\n"
+            "const uint8 d = 1;\n"
+        )
+
+    # SWUT_PARSER_00043: P2VAR is not lowered as VAR
+    def test_p2var_not_corrupted_by_var(self):
+        """Test that P2VAR locals become pointers and parse with pycparser."""
+        code = (
+            "void Demo_Run(void)\n"
+            "{\n"
+            "    P2VAR(uint8, AUTOMATIC, APPL_DATA) ptr = 0;\n"
+            "    Demo_Step(ptr);\n"
+            "}\n"
+        )
+
+        lowered = self._lower(code)
+
+        assert "uint8* ptr = 0;" in lowered
+        assert "P2uint8" not in lowered
+        self.parser.parser.parse(self.parser._preprocess_content(code))
+
+    # SWUT_PARSER_00043: Literals, comments, directives and identifiers
+    def test_literals_comments_and_directives(self):
+        """Test that literals are kept, comments and pragmas dropped."""
+        code = (
+            '#pragma section ".text"\n'
+            'char* s = "VAR(uint8, X) /* kept */";\n'
+            "MY_VAR(a, b); /* VAR(uint8, X) */ // CONST(uint8, X)\n"
+        )
+
+        assert self._lower(code) == (
+            "\n"
+            'char* s = "VAR(uint8, X) /* kept */";\n'
+            "MY_VAR(a, b);  \n"
+        )
+
+
+# SWUT_PARSER_00044: Reused Parser State Across Files
+
+
+class TestParserReuse:
+    """Tests: SWUT_PARSER_00044 - parser state shared by all files."""
+
+    # SWUT_PARSER_00044: AutosarParser is shared with FunctionDatabase
+    def test_autosar_parser_shared_with_database(self, tmp_path):
+        """Test that the database and its CParser use one AutosarParser."""
+        db = FunctionDatabase(source_dir=str(tmp_path))
+
+        assert db.c_parser.autosar_parser is db.autosar_parser
+
+    # SWUT_PARSER_00044: Typedef names are in scope without a preamble
+    def test_typedef_names_seeded(self):
+        """Test that AUTOSAR types parse without prepended typedef lines."""
+        parser = CParser()
+
+        for _ in range(2):
+            ast = parser.parser.parse("uint8 Get(sint16 x) { return (uint8)x; }")
+            assert ast.ext[0].decl.name == "Get"
+
+        assert "uint8" in AUTOSAR_TYPEDEF_NAMES
+        assert "ulong" in AUTOSAR_TYPEDEF_NAMES
+
+    # SWUT_PARSER_00044: Line numbers are those of the source file
+    def test_traditional_line_numbers_match_source(self, tmp_path):
+        """Test that no preamble shifts the line numbers of C functions."""
+        source = tmp_path / "lines.c"
+        source.write_text(
+            "/* Line numbers */\n"
+            "\n"
+            "uint8 First(void)\n"
+            "{\n"
+            "    return 0;\n"
+            "}\n"
+            "\n"
+            "void Second(uint16 value)\n"
+            "{\n"
+            "    First();\n"
+            "}\n"
+        )
+
+        parser = CParser()
+        functions = parser.parse_file(source)
+
+        assert {f.name: f.line_number for f in functions} == {
+            "First": 3,
+            "Second": 8,
+        }
+        assert parser.parse_file(source)[1].calls[0].name == "First"
+
+    # SWUT_PARSER_00044: Parsers without PLY internals get a typedef prelude
+    def test_typedef_prelude_without_internals(self):
+        """Test the public parse() fallback for pycparser without PLY state."""
+        parser = CParser().parser
+        internals = parser.cparser
+        public_parse = pycparser_c_parser.CParser.parse
+        texts = []
+
+        def parse_without_internals(self, text, filename=""):
+            # Stands in for a parser whose internals are not attributes
+            texts.append(text)
+            self.cparser = internals
+            try:
+                return public_parse(self, text, filename)
+            finally:
+                del self.cparser
+
+        del parser.cparser
+        with patch.object(
+            pycparser_c_parser.CParser, "parse", parse_without_internals
+        ):
+            ast = parser.parse(
+                "uint8 Get(Std_Type x)\n{\n    return (uint8)x;\n}\n",
+                filename="get.c",
+                typedef_names=["Std_Type"],
+            )
+
+        assert len(texts) == 1
+        assert "typedef int Std_Type;" in texts[0].splitlines()[0]
+        function = ast.ext[-1]
+        assert function.decl.name == "Get"
+        assert (function.coord.file, function.coord.line) == ("get.c", 1)
+
+
+# SWUT_PARSER_00045: Shared Header Skipping
+
+
+class TestSharedHeaderSkipping:
+    """Tests: SWUT_PARSER_00045 - skip shared headers in preprocessed files."""
+
+    def _setup(self, tmp_path, source_text):
+        header = tmp_path / "Std_Types.h"
+        source = tmp_path / "module.c"
+        source.write_text(source_text)
+        prefix_text = (
+            f'# 1 "{header}" 1\n'
+            "typedef unsigned char boolean;\n"
+            "typedef struct { int major; } Std_VersionInfoType;\n"
+        )
+        preprocessed = tmp_path / "module.i"
+        preprocessed.write_text(
+            f'# 1 "{source}"\n'
+            f'# 1 "{header}" 1\n'
+            "typedef unsigned char boolean;\n"
+            "typedef struct { int major; } Std_VersionInfoType;\n"
+            "extern SharedOnly Header_Func(void) {}\n"
+            f'# 2 "{source}" 2\n'
+            "\n"
+            + source_text
+        )
+        prefix = SharedIncludePrefix(
+            includes=['"Std_Types.h"'],
+            header_files={resolve_marker_path(str(header))},
+            output_text=prefix_text,
+        )
+        return source, preprocessed, prefix
+
+    # SWUT_PARSER_00045: Prefix typedefs are collected once
+    def test_use_shared_prefix_collects_typedefs(self, tmp_path):
+        """Test that the typedef names of the prefix are recorded."""
+        _, _, prefix = self._setup(tmp_path, "")
+        parser = CParser()
+
+        assert parser.use_shared_prefix(prefix)
+        assert prefix.typedef_names == {"boolean", "Std_VersionInfoType"}
+
+    # SWUT_PARSER_00045: Header content is skipped, source lines are kept
+    def test_header_content_skipped(self, tmp_path):
+        """Test that only the file's own functions are parsed, at source lines."""
+        source, preprocessed, prefix = self._setup(
+            tmp_path,
+            "static boolean Check(Std_VersionInfoType info)\n"
+            "{\n"
+            "    return info.major;\n"
+            "}\n",
+        )
+        parser = CParser()
+        parser.use_shared_prefix(prefix)
+
+        stripped, skipped = parser._strip_shared_headers(preprocessed.read_text())
+        functions = parser._parse_preprocessed_file(source, preprocessed)
+
+        assert skipped
+        assert "Header_Func" not in stripped
+        assert [(f.name, f.line_number) for f in functions] == [("Check", 3)]
+
+    # SWUT_PARSER_00045: Without a prefix the file is parsed completely
+    def test_no_prefix_keeps_content(self, tmp_path):
+        """Test that files are unchanged when no shared prefix is used."""
+        _, preprocessed, _ = self._setup(tmp_path, "int x;\n")
+        content = preprocessed.read_text()
+
+        assert CParser()._strip_shared_headers(content) == (content, False)
+
+
+# SWUT_PARSER_00046: Fused Streaming Preprocess and Parse
+
+
+class TestStreamingParse:
+    """Tests: SWUT_PARSER_00046 - parse cpp output without .i files."""
+
+    def _preprocessor(self, outputs):
+        preprocessor = MagicMock()
+        preprocessor.preprocess_file.side_effect = lambda source_file, stream: (
+            PreprocessResult(
+                source_file=source_file,
+                success=outputs[source_file.name] is not None,
+                output_text=outputs[source_file.name],
+                error_message="cpp failed",
+            )
+        )
+        return preprocessor
+
+    # SWUT_PARSER_00046: Streamed text is parsed at source line numbers
+    def test_preprocess_and_parse_all(self, tmp_path):
+        """Test that every file is preprocessed in stream mode and parsed."""
+        first = tmp_path / "first.c"
+        second = tmp_path / "second.c"
+        first.write_text("void First(void)\n{\n}\n")
+        second.write_text("void Second(void)\n{\n    First();\n}\n")
+        preprocessor = self._preprocessor({
+            "first.c": f'# 1 "{first}"\nvoid First(void)\n{{\n}}\n',
+            "second.c": (
+                f'# 1 "{second}"\nvoid Second(void)\n{{\n    First();\n}}\n'
+            ),
+        })
+        preprocessor._record_result.side_effect = lambda stats, result, verbose: (
+            stats.results.append(result)
+        )
+
+        prep_stats, parse_stats = CParser().preprocess_and_parse_all(
+            [first, second], preprocessor, verbose=False
+        )
+
+        assert len(prep_stats.results) == 2
+        assert all(r.output_text is None for r in prep_stats.results)
+        names = [[f.name for f in r.functions] for r in parse_stats.results]
+        assert names == [["First"], ["Second"]]
+        assert parse_stats.results[1].functions[0].calls[0].name == "First"
+        for call in preprocessor.preprocess_file.call_args_list:
+            assert call.kwargs["stream"] is True
+
+    # SWUT_PARSER_00046: A cpp failure falls back to parsing the raw file
+    def test_failed_preprocessing_parses_source(self, tmp_path):
+        """Test that files are still parsed when cpp fails."""
+        source = tmp_path / "module.c"
+        source.write_text("void Raw_Func(void)\n{\n}\n")
+        preprocessor = self._preprocessor({"module.c": None})
+
+        prep_result, parse_result = CParser().preprocess_and_parse(
+            source, preprocessor
+        )
+
+        assert not prep_result.success
+        assert [f.name for f in parse_result.functions] == ["Raw_Func"]
+
+
+# SWUT_PARSER_00047: Per-File Step Timings
+
+
+class TestParseTimings:
+    """Tests: SWUT_PARSER_00047 - per-file step timings of results."""
+
+    # SWUT_PARSER_00047: Results carry the time of every parser step
+    def test_parse_file_with_stats_timings(self, tmp_path):
+        """Test that the pycparser steps and the bytes are recorded."""
+        source = tmp_path / "module.c"
+        source.write_text("void Func(void)\n{\n}\n")
+
+        result = CParser().parse_file_with_stats(source)
+
+        assert result.success
+        assert {"read", "autosar", "lowering", "pycparser", "visitor"} <= set(
+            result.timings
+        )
+        assert result.bytes_processed == len(source.read_text())
+        assert result.start_time is not None
+        assert result.total_time == sum(result.timings.values())
+
+
+# SWUT_PARSER_00049: Lexical Parse Path
+
+
+class TestLexicalParsePath:
+    """Tests: SWUT_PARSER_00049 - pycparser only for files that need it."""
+
+    TRADITIONAL = (
+        "/* Helper(x) in a comment */\n"
+        "static int Helper(int a, const char *name);\n"
+        "\n"
+        "static int Helper(int a, const char *name)\n"
+        "{\n"
+        '    Log("Fake(1)");  // Other(\n'
+        "    return a + Length(name);\n"
+        "}\n"
+        "\n"
+        "int *\n"
+        "Get_Ptr(void)\n"
+        "{\n"
+        "    static int v;\n"
+        "    return &v;\n"
+        "}\n"
+        "\n"
+        "void Run(struct S *s, int n)\n"
+        "{\n"
+        "    int i;\n"
+        "    for (i = 0; i < n; i++) {\n"
+        "        Helper(i, \"x\");\n"
+        "    }\n"
+        "    s->cb(1);\n"
+        "    Get_Ptr();\n"
+        "    Helper(n, \"y\");\n"
+        "}\n"
+    )
+
+    # SWUT_PARSER_00049: Files without traditional definitions skip pycparser
+    def test_autosar_and_data_files_skip_pycparser(self, tmp_path):
+        """Test the parse path of AUTOSAR-only, data-only and C files."""
+        autosar = tmp_path / "Rte_Com.c"
+        autosar.write_text(
+            "FUNC(void, RTE_CODE) Rte_Com_Init(void)\n{\n    Com_Init();\n}\n"
+        )
+        data = tmp_path / "Com_PBcfg.c"
+        data.write_text(
+            "extern void Com_Init(void);\n"
+            "const uint8 Com_Table[3] = {1, 2, 3};\n"
+            "const Com_ConfigType Com_Config = { Com_Table, 3 };\n"
+        )
+        traditional = tmp_path / "helper.c"
+        traditional.write_text("void Helper(void)\n{\n}\n")
+        parser = CParser()
+
+        stats = parser.parse_all([autosar, data, traditional], verbose=False)
+
+        paths = [result.parse_path for result in stats.results]
+        assert paths == ["lexical", "lexical", "pycparser"]
+        assert "pycparser" not in stats.results[0].timings
+        assert [f.name for f in stats.results[0].functions] == ["Rte_Com_Init"]
+        assert stats.results[1].functions == []
+        assert (stats.lexical_files, stats.pycparser_files) == (2, 1)
+        assert "Lexical scan:  2 files" in parser.get_statistics_summary(stats)
+
+    # SWUT_PARSER_00049: The lexical path matches pycparser
+    def test_lexical_matches_pycparser(self, tmp_path):
+        """Test names, lines, static flags, types and calls of both paths."""
+        source = tmp_path / "module.c"
+        source.write_text(self.TRADITIONAL)
+
+        full = CParser().parse_file_with_stats(source)
+        lexical = CParser(full_parse=False).parse_file_with_stats(source)
+
+        assert (full.parse_path, lexical.parse_path) == ("pycparser", "lexical")
+        assert "pycparser" not in lexical.timings
+
+        def summary(result):
+            return [
+                (
+                    f.name,
+                    f.line_number,
+                    f.is_static,
+                    f.return_type,
+                    [call.name for call in f.calls],
+                )
+                for f in result.functions
+            ]
+
+        assert summary(lexical) == summary(full)
+        assert summary(lexical) == [
+            ("Helper", 4, True, "int", ["Log", "Length"]),
+            ("Get_Ptr", 11, False, "int*", []),
+            ("Run", 17, False, "void", ["Helper", "Get_Ptr"]),
+        ]
+        run = lexical.functions[2]
+        assert [(p.name, p.param_type, p.is_pointer) for p in run.parameters] == [
+            ("s", "struct S", True),
+            ("n", "int", False),
+        ]
+
+    # SWUT_PARSER_00049: "(void)" has no parameters on both paths
+    def test_void_parameters_match_pycparser(self, tmp_path):
+        """Test that (void) gives no parameter and void pointers are kept."""
+        source = tmp_path / "module.c"
+        source.write_text(
+            "int Get(void)\n{\n    return 0;\n}\n"
+            "void Put(void *p)\n{\n}\n"
+            "void Cb(void *)\n{\n}\n"
+        )
+
+        def parameters(parser):
+            return [
+                (f.name, [(p.name, p.param_type, p.is_pointer) for p in f.parameters])
+                for f in parser.parse_file(source)
+            ]
+
+        assert parameters(CParser(full_parse=False)) == parameters(CParser())
+        assert parameters(CParser()) == [
+            ("Get", []),
+            ("Put", [("p", "void", True)]),
+            ("Cb", [("", "void", True)]),
+        ]
+
+    # SWUT_PARSER_00049: AUTOSAR definitions are not reported twice
+    def test_lexical_leaves_autosar_definitions(self, tmp_path):
+        """Test that FUNC definitions only come from the AUTOSAR scan."""
+        source = tmp_path / "module.c"
+        source.write_text(
+            "FUNC(void, COM_CODE) Com_Init(void)\n{\n    Helper();\n}\n"
+            "static void Helper(void)\n{\n}\n"
+        )
+
+        functions = CParser(full_parse=False).parse_file(source)
+
+        assert [(f.name, f.function_type) for f in functions] == [
+            ("Com_Init", FunctionType.AUTOSAR_FUNC),
+            ("Helper", FunctionType.TRADITIONAL_C),
+        ]
+
+    # SWUT_PARSER_00049: Line numbers of cpp output follow the line markers
+    def test_lexical_lines_from_line_markers(self, tmp_path):
+        """Test that functions in preprocessed text get their source lines."""
+        source = tmp_path / "module.c"
+        text = (
+            '# 1 "module.c"\n'
+            '# 1 "header.h" 1\n'
+            "typedef int T;\n"
+            '# 5 "module.c" 2\n'
+            "\n"
+            "void Run(void)\n"
+            "{\n"
+            "    Step();\n"
+            "}\n"
+        )
+
+        result = CParser(full_parse=False).parse_file_with_stats(
+            source, preprocessed_text=text
+        )
+
+        assert [(f.name, f.line_number) for f in result.functions] == [("Run", 6)]
+        assert [call.name for call in result.functions[0].calls] == ["Step"]
+
+    # SWUT_PARSER_00049: Both paths keep separate cache entries
+    def test_database_parser_type(self, tmp_path):
+        """Test that full_parse=False changes the cache configuration."""
+        full = FunctionDatabase(str(tmp_path), cache_dir=str(tmp_path / "a"))
+        lexical = FunctionDatabase(
+            str(tmp_path), cache_dir=str(tmp_path / "b"), full_parse=False
+        )
+
+        assert lexical.c_parser.full_parse is False
+        assert lexical.parser_type == "lexical"
+        assert lexical._compute_config_hash() != full._compute_config_hash()
+
+
+# SWUT_PARSER_00051: Single-Pass Call Walker
+
+
+class TestCallWalker:
+    """Tests: SWUT_PARSER_00051 - Single-Pass Call Walker"""
+
+    SOURCE = (
+        "void Run(int x, int *p)\n"
+        "{\n"
+        "    int i;\n"
+        "    Start();\n"
+        "    if (x > 1) { Send(Encode(x)); } else if (x) { Retry(); }\n"
+        "    else { Fail(); }\n"
+        "    for (i = Begin(); i < Count(); i++) { Step(); if (x) Log(); }\n"
+        "    do { Poll(); } while (Ready());\n"
+        "    switch (x) { case 1: One(); break; default: Other(); }\n"
+        "    x = x ? Yes() : No();\n"
+        "    if (x) { Start(); }\n"
+        "}\n"
+    )
+
+    def _calls(self, tmp_path, source):
+        path = tmp_path / "module.c"
+        path.write_text(source)
+        (function,) = CParser().parse_file(path)
+        return {
+            call.name: (
+                call.is_conditional,
+                call.condition,
+                call.is_loop,
+                call.loop_condition,
+            )
+            for call in function.calls
+        }, [call.name for call in function.calls]
+
+    # SWUT_PARSER_00051: Calls in order, including calls in call arguments
+    def test_calls_in_order_with_nested_calls(self, tmp_path):
+        """Test that each callee is listed once in order of first occurrence."""
+        _, names = self._calls(tmp_path, self.SOURCE)
+
+        assert names == [
+            "Start",
+            "Send",
+            "Encode",
+            "Retry",
+            "Fail",
+            "Begin",
+            "Count",
+            "Step",
+            "Log",
+            "Poll",
+            "Ready",
+            "One",
+            "Other",
+            "Yes",
+            "No",
+        ]
+
+    # SWUT_PARSER_00051: Conditional call context
+    def test_conditional_contexts(self, tmp_path):
+        """Test the innermost condition of calls in if, switch and ?:."""
+        calls, _ = self._calls(tmp_path, self.SOURCE)
+
+        assert calls["Send"] == (True, "x > 1", False, None)
+        assert calls["Encode"] == (True, "x > 1", False, None)
+        assert calls["Retry"] == (True, "x", False, None)
+        assert calls["Fail"] == (True, "!(x)", False, None)
+        assert calls["One"] == (True, "x == 1", False, None)
+        assert calls["Other"] == (True, "default", False, None)
+        assert calls["Yes"] == (True, "x", False, None)
+        assert calls["No"] == (True, "!(x)", False, None)
+
+    # SWUT_PARSER_00051: Stacked case labels share their statements
+    def test_stacked_case_labels(self, tmp_path):
+        """Test that calls after stacked labels get the condition of every label."""
+        calls, names = self._calls(
+            tmp_path,
+            "void Run(int x)\n{\n    switch (x) {\n"
+            "    case 1: One(); break;\n"
+            "    case 2: case 3: Both(); break;\n"
+            "    default: case 4: Rest();\n"
+            "    }\n}\n",
+        )
+
+        assert names == ["One", "Both", "Rest"]
+        assert calls["One"] == (True, "x == 1", False, None)
+        assert calls["Both"] == (True, "x == 2 || x == 3", False, None)
+        assert calls["Rest"] == (True, "default || x == 4", False, None)
+
+    # SWUT_PARSER_00051: Loop call context
+    def test_loop_contexts(self, tmp_path):
+        """Test that loop bodies and conditions run in the loop, for init doesn't."""
+        calls, _ = self._calls(tmp_path, self.SOURCE)
+
+        assert calls["Begin"] == (False, None, False, None)
+        assert calls["Count"] == (False, None, True, "i < Count()")
+        assert calls["Step"] == (False, None, True, "i < Count()")
+        assert calls["Log"] == (True, "x", True, "i < Count()")
+        assert calls["Poll"] == (False, None, True, "Ready()")
+        assert calls["Ready"] == (False, None, True, "Ready()")
+
+    # SWUT_PARSER_00051: Unconditional calls win over conditional ones
+    def test_unconditional_call_is_not_conditional(self, tmp_path):
+        """Test that a callee also called outside an if is not conditional."""
+        calls, _ = self._calls(
+            tmp_path,
+            "void Run(int x)\n{\n    if (x) { Step(); }\n    Step();\n"
+            "    while (x) { Once(); }\n    Once();\n}\n",
+        )
+
+        assert calls["Step"] == (False, None, False, None)
+        assert calls["Once"] == (False, None, False, None)
+
+    # SWUT_PARSER_00051: No recursion limit
+    def test_deep_else_if_chain(self, tmp_path):
+        """Test that nesting deeper than the recursion limit is walked."""
+        branches = " else ".join(
+            f"if (x == {i}) {{ Case{i}(); }}" for i in range(1500)
+        )
+
+        calls, names = self._calls(tmp_path, f"void Run(int x)\n{{\n{branches}\n}}\n")
+
+        assert len(names) == 1500
+        assert calls["Case1499"] == (True, "x == 1499", False, None)
@@ -0,0 +1,122 @@
+"""Tests for parsers/_lexer.c (SWUT_PARSER_00050)"""
+
+from pathlib import Path
+from unittest.mock import patch
+
+import pytest
+
+from autosar_calltree.parsers import c_parser, source_scanner
+from autosar_calltree.parsers.c_parser import (
+    _BODY_CALL_PATTERN,
+    _CALL_PATTERN,
+    CParser,
+    _python_find_calls,
+    _python_remove_autosar_functions,
+)
+from autosar_calltree.parsers.source_scanner import (
+    _python_function_definitions,
+    _python_scan_braces,
+)
+
+_lexer = source_scanner._lexer
+
+DEMO_DIR = Path(__file__).parent.parent.parent.parent / "demo"
+
+EDGE_CASES = [
+    "",
+    "{",
+    "}",
+    "void f(void) { g(); }",
+    "int a = { 1 }; void f(int x)\n{\n  if (x) { h(x); }\n}\n",
+    'void f(void) { puts("}{ g() "); c = \'}\'; /* } k() */ l(); // m()\n}',
+    "#define X(a) { a }\nvoid f(void) { x->y(); s.t(); n(1); }",
+    "FUNC(void, RTE_CODE) F(void) { G(); }\nstatic int h(void) { return k(); }",
+    "STATIC FUNC_P2VAR(uint8, AUTOMATIC, CODE) Get(void)\n{\n    return 0;\n}\n",
+    "void f(void) { \"unterminated\n g(); /* open comment",
+    "void été(void) { ça(); _x1(); 9y(); }",
+    "extern void f(void);\nint (*p)(void);\nvoid g(void) { while (1) { h(); } }",
+]
+
+
+def _demo_sources():
+    return [path.read_text() for path in sorted(DEMO_DIR.rglob("*.[ch]"))]
+
+
+@pytest.mark.skipif(_lexer is None, reason="native lexer extension not built")
+class TestNativeLexer:
+    """Tests: SWUT_PARSER_00050 - Native Lexer Accelerator"""
+
+    def setup_method(self):
+        self.excluded = CParser()._excluded_call_names
+
+    # SWUT_PARSER_00050: Brace matching
+    def test_scan_braces_matches_python(self):
+        """Test that line offsets and brace spans equal the Python scan."""
+        for content in EDGE_CASES + _demo_sources():
+            native_offsets, native_spans = _lexer.scan_braces(content)
+            assert (list(native_offsets), dict(native_spans)) == _python_scan_braces(
+                content
+            )
+
+    # SWUT_PARSER_00050: Definition scan
+    def test_function_definitions_match_python(self):
+        """Test that the definition offsets equal the Python scan."""
+        for content in EDGE_CASES + _demo_sources():
+            native = [
+                source_scanner.FunctionDefinition(*offsets)
+                for offsets in _lexer.function_definitions(content)
+            ]
+            assert native == list(_python_function_definitions(content))
+
+    # SWUT_PARSER_00050: Call extraction
+    def test_find_calls_match_python(self):
+        """Test that both call patterns give the same names in any span."""
+        for content in EDGE_CASES + _demo_sources():
+            length = len(content)
+            for start, end in ((0, length), (length // 3, length), (1, length - 2)):
+                start, end = max(0, start), max(0, end)
+                assert _lexer.find_calls(
+                    content, start, end, self.excluded
+                ) == _python_find_calls(
+                    _CALL_PATTERN, content, start, end, self.excluded
+                )
+                assert _lexer.find_body_calls(
+                    content, start, end, self.excluded
+                ) == _python_find_calls(
+                    _BODY_CALL_PATTERN, content, start, end, self.excluded
+                )
+
+    # SWUT_PARSER_00050: AUTOSAR removal
+    def test_remove_autosar_functions_matches_python(self):
+        """Test that removing AUTOSAR definitions gives the same text."""
+        for content in EDGE_CASES + _demo_sources():
+            assert _lexer.remove_autosar_functions(
+                content
+            ) == _python_remove_autosar_functions(content)
+
+
+class TestNativeLexerFallback:
+    """Tests: SWUT_PARSER_00050 - Native Lexer Accelerator"""
+
+    # SWUT_PARSER_00050: Pure-Python fallback
+    def test_parse_results_without_native_lexer(self):
+        """Test that parsing without the extension gives the same functions."""
+        demo_files = sorted((DEMO_DIR / "src").glob("*.c"))
+        assert demo_files
+
+        def parse_all():
+            parser = CParser(full_parse=False)
+            return [
+                (f.name, f.line_number, [call.name for call in f.calls])
+                for path in demo_files
+                for f in parser.parse_file(path)
+            ]
+
+        expected = parse_all()
+        with patch.object(source_scanner, "_lexer", None), patch.object(
+            c_parser, "_lexer", None
+        ):
+            fallback = parse_all()
+
+        assert fallback == expected
+        assert expected
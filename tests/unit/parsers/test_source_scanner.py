@@ -0,0 +1,125 @@
+"""Tests for parsers/source_scanner.py (SWUT_PARSER_00042, SWUT_PARSER_00048)"""
+
+from pathlib import Path
+
+from autosar_calltree.parsers.c_parser import CParser
+from autosar_calltree.parsers.source_scanner import (
+    SourceScanner,
+    scan_function_definitions,
+)
+
+
+class TestSourceScanner:
+    """Tests: SWUT_PARSER_00042 - Single-Pass Body Extraction"""
+
+    # SWUT_PARSER_00042: Line offsets
+    def test_line_start(self):
+        """Test that line offsets point at the first character of each line."""
+        content = "int a;\n\nvoid f(void)\n{\n}\n"
+        scanner = SourceScanner(content)
+
+        assert scanner.line_start(1) == 0
+        assert content[scanner.line_start(3) :].startswith("void f")
+        assert content[scanner.line_start(4)] == "{"
+
+    # SWUT_PARSER_00042: Nested braces
+    def test_body_span_with_nested_braces(self):
+        """Test that the span covers the whole body including nested blocks."""
+        content = "void f(void)\n{\n    if (x) { g(); }\n}\nvoid h(void) {}"
+        scanner = SourceScanner(content)
+
+        start, end = scanner.body_span_after(len("void f(void)"))
+
+        assert content[start:end] == "{\n    if (x) { g(); }\n}"
+
+    # SWUT_PARSER_00042: Braces in literals and comments
+    def test_braces_in_strings_and_comments_are_skipped(self):
+        """Test that braces inside strings, chars and comments do not count."""
+        content = (
+            "void f(void)\n"
+            "{\n"
+            '    puts("}");\n'
+            "    c = '{';\n"
+            "    /* } */\n"
+            "    // }\n"
+            "    g();\n"
+            "}\n"
+            "void h(void) { k(); }"
+        )
+        scanner = SourceScanner(content)
+
+        start, end = scanner.body_span_after(len("void f(void)"))
+
+        assert content[start:end].endswith("g();\n}")
+
+    # SWUT_PARSER_00042: No body
+    def test_no_body_after_declaration(self):
+        """Test that declarations and unbalanced bodies yield no span."""
+        scanner = SourceScanner("void f(void);\nvoid g(void)\n{\n")
+
+        assert scanner.body_span_after(len("void f(void)")) is None
+        assert scanner.body_span_after(scanner.line_start(2) + 12) is None
+
+    # SWUT_PARSER_00042: Duplicate declaration lines
+    def test_duplicate_lines_use_their_own_body(self, tmp_path):
+        """Test that identical FUNC lines each get the body that follows them."""
+        source = tmp_path / "dup.c"
+        source.write_text(
+            "#ifdef VARIANT_A\n"
+            "FUNC(void, RTE_CODE) Rte_Run(void)\n"
+            "{\n"
+            "    Variant_A();\n"
+            "}\n"
+            "#else\n"
+            "FUNC(void, RTE_CODE) Rte_Run(void)\n"
+            "{\n"
+            "    Variant_B();\n"
+            "}\n"
+            "#endif\n"
+        )
+
+        functions = CParser().parse_file(Path(source))
+
+        calls = {f.line_number: [c.name for c in f.calls] for f in functions}
+        assert calls == {2: ["Variant_A"], 7: ["Variant_B"]}
+
+
+class TestDefinitionScan:
+    """Tests: SWUT_PARSER_00048 - Lexical Definition Scan"""
+
+    # SWUT_PARSER_00048: Traditional and AUTOSAR definitions are found
+    def test_definitions(self):
+        """Test that definitions are found and declarations are not."""
+        content = (
+            "#define WRAP(x) { x }\n"
+            "void Proto(void);\n"
+            "int table[2] = {1, 2};\n"
+            "struct point { int x; };\n"
+            "static uint8 *Get_Buffer(void)\n"
+            "{\n"
+            '    puts("} void Fake(void) {");\n'
+            "    if (x) { Inner(); }\n"
+            "}\n"
+            "FUNC(void, COM_CODE) Com_Init(P2VAR(uint8, AUTOMATIC, APPL_DATA) p)"
+            " /* { */\n"
+            "{\n"
+            "}\n"
+        )
+
+        assert scan_function_definitions(content) == ["Get_Buffer", "Com_Init"]
+
+    # SWUT_PARSER_00048: extern "C" blocks stay at file scope
+    def test_extern_c_block(self):
+        """Test that functions inside extern "C" braces are found."""
+        content = 'extern "C" {\nvoid A(void) { B(); }\nvoid C(void) {}\n}\n'
+
+        assert scan_function_definitions(content) == ["A", "C"]
+
+    # SWUT_PARSER_00048: The scan finds every function the parser finds
+    def test_matches_parser_on_demo(self):
+        """Test that the scan covers the parsed functions of the demo files."""
+        parser = CParser()
+        for source in sorted(Path("demo/src").rglob("*.c")):
+            names = set(scan_function_definitions(source.read_text()))
+            parsed = {func.name for func in parser.parse_file(source)}
+            assert parsed <= names, source
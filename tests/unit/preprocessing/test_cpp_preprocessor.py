@@ -7,8 +7,9 @@ Tests cover:
 - CPP path resolution
 - File preprocessing with success/failure cases
 - Statistics collection and reporting
+- Shared include prefix detection
 
-Test IDs: SWUT_PREPROCESS_00001 - SWUT_PREPROCESS_00008
+Test IDs: SWUT_PREPROCESS_00001 - SWUT_PREPROCESS_00010
 """
 
 from pathlib import Path
@@ -22,6 +23,11 @@ from autosar_calltree.preprocessing import (
     PreprocessResult,
     PreprocessStatistics,
 )
+from autosar_calltree.preprocessing.cpp_preprocessor import (
+    find_shared_include_prefix,
+    read_leading_includes,
+    resolve_marker_path,
+)
 
 
 class TestPreprocessResult:
@@ -234,6 +240,60 @@ int main() {
         # Real integration tests will verify actual preprocessing
 
 
+class TestCPPPreprocessorParallel:
+    """Tests for parallel preprocessing.
+
+    Tests: SWUT_PREPROCESS_00009 (Parallel preprocessing with bounded worker pool)
+    """
+
+    # SWUT_PREPROCESS_00009: Default is a single worker
+    def test_default_jobs_is_serial(self):
+        """Test that the preprocessor runs serially unless jobs is given."""
+        assert CPPPreprocessor().jobs == 1
+
+    # SWUT_PREPROCESS_00009: None resolves to CPU count
+    def test_jobs_none_uses_cpu_count(self):
+        """Test that jobs=None resolves to the number of CPUs."""
+        with patch("os.cpu_count", return_value=6):
+            assert CPPPreprocessor(jobs=None).jobs == 6
+
+    # SWUT_PREPROCESS_00009: Results keep input order
+    def test_parallel_results_in_input_order(self, tmp_path, capsys):
+        """Test that concurrent cpp runs are collected in input order."""
+        import time
+
+        files = [tmp_path / f"file_{idx}.c" for idx in range(8)]
+
+        def fake_preprocess(source_file):
+            # Finish later files first to scramble completion order
+            time.sleep(0.01 * (len(files) - files.index(source_file)))
+            success = source_file.name != "file_3.c"
+            return PreprocessResult(
+                source_file=source_file,
+                success=success,
+                output_file=tmp_path / f"{source_file.stem}.i" if success else None,
+                error_message=None if success else "boom",
+                error_type=None if success else "cpp_error",
+            )
+
+        preprocessor = CPPPreprocessor(temp_dir=tmp_path / "prep", jobs=4)
+        preprocessor._cpp_path = "/usr/bin/gcc"
+        with patch.object(preprocessor, "preprocess_file", side_effect=fake_preprocess):
+            stats = preprocessor.preprocess_all(files, verbose=True)
+
+        assert [r.source_file for r in stats.results] == files
+        assert stats.successful == 7
+        assert stats.failed == 1
+
+        output = capsys.readouterr().out
+        lines = [line for line in output.splitlines() if line.startswith("[")]
+        assert len(lines) == 8
+        assert lines[0].startswith("[1/8] file_0.c")
+        assert lines[3].startswith("[4/8] file_3.c")
+        assert "FAILED (cpp_error)" in lines[3]
+        assert lines[7].startswith("[8/8] file_7.c")
+
+
 class TestCPPPreprocessorStatistics:
     """Tests for statistics reporting.
 
@@ -389,3 +449,176 @@ class TestCPPPreprocessorBuildCommand:
         assert "/opt/autosar" in cmd
         assert "-DDEBUG" in cmd
         assert "-std=c99" in cmd
+
+
+class TestSharedIncludePrefix:
+    """Tests for the shared include prefix.
+
+    Tests: SWUT_PREPROCESS_00010 (Shared include prefix)
+    """
+
+    @staticmethod
+    def _write(path, text):
+        path.write_text(text)
+        return path
+
+    # SWUT_PREPROCESS_00010: Leading includes stop at the first code line
+    def test_read_leading_includes(self, tmp_path):
+        """Test that comments are skipped and other lines end the prefix."""
+        source = self._write(
+            tmp_path / "a.c",
+            "/* Header\n * comment */\n"
+            '#include "Std_Types.h"  // types\n'
+            "\n"
+            "#include <string.h>\n"
+            "#define X 1\n"
+            '#include "Late.h"\n',
+        )
+
+        assert read_leading_includes(source) == ['"Std_Types.h"', "<string.h>"]
+
+    # SWUT_PREPROCESS_00010: Longest prefix shared by most files
+    def test_find_shared_include_prefix(self, tmp_path):
+        """Test that the longest prefix of at least half the files wins."""
+        rte = '#include "Std_Types.h"\n#include "Rte_A.h"\n'
+        com = '#include "Std_Types.h"\n#include "Com.h"\n'
+        files = [
+            self._write(tmp_path / "a.c", rte),
+            self._write(tmp_path / "b.c", rte),
+            self._write(tmp_path / "c.c", com),
+            self._write(tmp_path / "d.c", "int x;\n"),
+        ]
+
+        assert find_shared_include_prefix(files) == ['"Std_Types.h"', '"Rte_A.h"']
+        assert find_shared_include_prefix(files[2:]) == []
+        assert find_shared_include_prefix(files[:1]) == []
+
+    # SWUT_PREPROCESS_00010: Prefix headers come from the line markers
+    def test_preprocess_shared_prefix(self, tmp_path):
+        """Test that the prefix is preprocessed once and its headers recorded."""
+        files = [
+            self._write(tmp_path / f"m{idx}.c", '#include "Std_Types.h"\nint v;\n')
+            for idx in range(3)
+        ]
+        header = str(tmp_path / "Std_Types.h")
+        calls = []
+
+        def fake_preprocess(source_file, extra_include_dirs=(), stream=False):
+            calls.append((source_file, list(extra_include_dirs)))
+            return PreprocessResult(
+                source_file=source_file,
+                success=True,
+                output_text=(
+                    f'# 1 "{source_file}"\n'
+                    f'# 1 "{header}" 1\n'
+                    "typedef unsigned char boolean;\n"
+                    f'# 2 "{source_file}" 2\n'
+                ),
+            )
+
+        preprocessor = CPPPreprocessor(temp_dir=tmp_path / "prep")
+        with patch.object(preprocessor, "preprocess_file", side_effect=fake_preprocess):
+            stats = preprocessor.preprocess_all(files, verbose=False)
+
+        prefix = stats.shared_prefix
+        assert prefix is not None
+        assert prefix.includes == ['"Std_Types.h"']
+        assert prefix.header_files == {resolve_marker_path(header)}
+        prefix_source, include_dirs = calls[0]
+        assert prefix_source.read_text() == '#include "Std_Types.h"\n'
+        assert include_dirs == [str(tmp_path.resolve())]
+        assert len(calls) == 4  # prefix once, then every file
+
+    # SWUT_PREPROCESS_00010: Extra include dirs follow the configured ones
+    def test_build_command_extra_include_dirs(self):
+        """Test that extra include directories are appended after config ones."""
+        config = PreprocessorConfig()
+        config.include_dirs = ["/opt/autosar"]
+        preprocessor = CPPPreprocessor(config=config)
+
+        cmd = preprocessor._build_command(
+            "/usr/bin/gcc", Path("test.c"), Path("/tmp/test.i"), ["/src"]
+        )
+
+        assert cmd.index("/opt/autosar") < cmd.index("/src")
+
+
+class TestStreamingPreprocessing:
+    """Tests: SWUT_PREPROCESS_00011 - streaming preprocessing."""
+
+    # SWUT_PREPROCESS_00011: Stream mode returns cpp stdout without a file
+    @patch("subprocess.run")
+    def test_stream_returns_output_text(self, mock_run, tmp_path):
+        """Test that stream mode keeps the output in memory."""
+        mock_run.return_value = MagicMock(returncode=0, stdout="int x;\n")
+        source = tmp_path / "test.c"
+        source.write_text("int x;\n")
+
+        preprocessor = CPPPreprocessor(temp_dir=tmp_path / "prep")
+        preprocessor._cpp_path = "/usr/bin/gcc"
+        result = preprocessor.preprocess_file(source, stream=True)
+
+        assert result.success
+        assert result.output_text == "int x;\n"
+        assert result.output_file is None
+        assert "-o" not in mock_run.call_args[0][0]
+        assert not (tmp_path / "prep").exists()
+
+    # SWUT_PREPROCESS_00011: Empty stream output is an error
+    @patch("subprocess.run")
+    def test_stream_empty_output_fails(self, mock_run, tmp_path):
+        """Test that empty cpp output is reported as a failure."""
+        mock_run.return_value = MagicMock(returncode=0, stdout="")
+        preprocessor = CPPPreprocessor(temp_dir=tmp_path / "prep")
+        preprocessor._cpp_path = "/usr/bin/gcc"
+
+        result = preprocessor.preprocess_file(tmp_path / "test.c", stream=True)
+
+        assert not result.success
+        assert result.error_type == "cpp_error"
+
+    # SWUT_PREPROCESS_00011: Same stems in different directories do not collide
+    def test_output_files_unique_per_path(self, tmp_path):
+        """Test that .i names include a hash of the source path."""
+        preprocessor = CPPPreprocessor(temp_dir=tmp_path / "prep")
+        first = preprocessor.get_output_file(tmp_path / "a" / "Com.c")
+        second = preprocessor.get_output_file(tmp_path / "b" / "Com.c")
+
+        assert first != second
+        assert first.name.startswith("Com_") and first.suffix == ".i"
+        assert first == preprocessor.get_output_file(tmp_path / "a" / "Com.c")
+
+    # SWUT_PREPROCESS_00011: File output is read back by read_output
+    def test_read_output(self, tmp_path):
+        """Test that read_output handles streamed, file and failed results."""
+        output_file = tmp_path / "test.i"
+        output_file.write_text("int y;\n")
+        source = tmp_path / "test.c"
+
+        assert CPPPreprocessor.read_output(
+            PreprocessResult(source_file=source, success=True, output_text="a")
+        ) == "a"
+        assert CPPPreprocessor.read_output(
+            PreprocessResult(source_file=source, success=True, output_file=output_file)
+        ) == "int y;\n"
+        assert CPPPreprocessor.read_output(
+            PreprocessResult(source_file=source, success=False)
+        ) is None
+
+
+class TestPreprocessTimings:
+    """Tests: SWUT_PREPROCESS_00012 - cpp timings of results."""
+
+    # SWUT_PREPROCESS_00012: Results carry the cpp time and output size
+    @patch("subprocess.run")
+    def test_stream_timings(self, mock_run, tmp_path):
+        """Test that the cpp step and the output bytes are recorded."""
+        mock_run.return_value = MagicMock(returncode=0, stdout="int x;\n")
+        preprocessor = CPPPreprocessor(temp_dir=tmp_path / "prep")
+        preprocessor._cpp_path = "/usr/bin/gcc"
+
+        result = preprocessor.preprocess_file(tmp_path / "test.c", stream=True)
+
+        assert set(result.timings) == {"cpp"}
+        assert result.bytes_processed == len("int x;\n")
+        assert result.start_time is not None
@@ -0,0 +1,238 @@
+"""Tests for server/analysis_server.py (SWUT_SERVER_00001-00003)"""
+
+import io
+import json
+import sys
+import threading
+import urllib.error
+import urllib.request
+from contextlib import redirect_stdout
+from pathlib import Path
+
+import pytest
+
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.database.models import CallTreeNode, FunctionInfo
+from autosar_calltree.server.analysis_server import (
+    AnalysisServer,
+    AnalysisService,
+    QueryError,
+    tree_to_json,
+)
+
+
+def _make_factory(source_dir, cache_dir):
+    def factory():
+        db = FunctionDatabase(source_dir=str(source_dir), cache_dir=str(cache_dir))
+        with redirect_stdout(io.StringIO()):
+            db.build_database(use_cache=True, verbose=False)
+        return db
+
+    return factory
+
+
+def _node(name, depth, children=None):
+    func_info = FunctionInfo(
+        name=name,
+        return_type="void",
+        file_path=Path("module.c"),
+        line_number=1,
+        is_static=False,
+    )
+    return CallTreeNode(function_info=func_info, depth=depth, children=children or [])
+
+
+@pytest.fixture
+def demo_service(tmp_path):
+    """AnalysisService over the demo sources."""
+    factory = _make_factory("./demo", tmp_path / "cache")
+    return AnalysisService(factory(), factory)
+
+
+class TestAnalysisService:
+    """Tests: SWUT_SERVER_00001 - Warm In-Memory Database"""
+
+    # SWUT_SERVER_00001: Tree queries in all formats
+    def test_build_tree_formats(self, demo_service):
+        """Test that trees are rendered as JSON, Mermaid and XMI."""
+        content_type, body = demo_service.build_tree("Demo_Init", max_depth=2)
+        data = json.loads(body)
+        assert content_type == "application/json"
+        assert data["root_function"] == "Demo_Init"
+        assert data["call_tree"]["function"] == "Demo_Init"
+        assert data["call_tree"]["children"]
+        assert data["statistics"]["total_functions"] > 1
+
+        content_type, body = demo_service.build_tree("Demo_Init", output_format="mermaid")
+        assert content_type.startswith("text/markdown")
+        assert "```mermaid" in body
+
+        content_type, body = demo_service.build_tree("Demo_Init", output_format="rhapsody")
+        assert content_type.startswith("application/xml")
+        assert "XMI" in body
+
+    # SWUT_SERVER_00001: Errors carry HTTP status
+    def test_build_tree_errors(self, demo_service):
+        """Test that unknown functions and formats raise QueryError."""
+        with pytest.raises(QueryError) as exc_info:
+            demo_service.build_tree("NoSuchFunction")
+        assert exc_info.value.status == 404
+
+        with pytest.raises(QueryError) as exc_info:
+            demo_service.build_tree("Demo_Init", output_format="pdf")
+        assert exc_info.value.status == 400
+
+    # SWUT_SERVER_00001: Tree budgets
+    def test_build_tree_budgets(self, demo_service):
+        """Test that a node budget truncates the tree and is reported."""
+        _, body = demo_service.build_tree("Demo_Init", max_depth=4, max_nodes=3)
+        data = json.loads(body)
+        assert data["truncation"]["reason"] == "max_nodes"
+        assert data["truncation"]["truncated_functions"]
+        assert data["statistics"]["total_functions"] <= 3
+
+        _, body = demo_service.build_tree("Demo_Init", max_depth=1)
+        data = json.loads(body)
+        assert data["truncation"] is None
+        assert data["call_tree"]["is_truncated"] is False
+
+    # SWUT_SERVER_00001: Listing and search
+    def test_list_and_search(self, demo_service):
+        """Test function listing and substring search."""
+        assert "Demo_Init" in demo_service.list_functions()
+        results = demo_service.search("Demo_Ini")
+        assert any(r["name"] == "Demo_Init" for r in results)
+
+        assert len(demo_service.search("Demo", limit=1)) == 1
+        assert all(
+            r["name"].startswith("Demo_")
+            for r in demo_service.search("^Demo_", mode="regex")
+        )
+        with pytest.raises(QueryError) as exc_info:
+            demo_service.search("(", mode="regex")
+        assert exc_info.value.status == 400
+
+
+class TestTreeJson:
+    """Tests: SWUT_SERVER_00002 - HTTP Query Interface"""
+
+    # SWUT_SERVER_00002: Trees deeper than the recursion limit
+    def test_deep_tree(self):
+        """Test that a deep chain is converted without RecursionError."""
+        depth = sys.getrecursionlimit() * 2
+        root = node = _node("F0", 0)
+        for level in range(1, depth):
+            child = _node(f"F{level}", level)
+            node.children.append(child)
+            node = child
+
+        text = tree_to_json(root)
+
+        assert text.count('"function": ') == depth
+        assert text.endswith("]}" * depth)
+        assert json.loads(tree_to_json(_node("Leaf", 0)))["children"] == []
+
+    # SWUT_SERVER_00002: Shared subtrees are written once
+    def test_shared_subtrees_referenced(self):
+        """Test that nodes sharing a children list get a subtree reference."""
+        shared = [_node("C", 2, [_node("D", 3)])]
+        root = _node("Root", 0, [_node("A", 1, shared), _node("B", 1, shared)])
+
+        data = json.loads(tree_to_json(root))
+
+        first, second = data["children"]
+        assert first["subtree_id"] == 0
+        assert [c["function"] for c in first["children"]] == ["C"]
+        assert first["children"][0]["children"][0]["function"] == "D"
+        assert "subtree_id" not in first["children"][0]
+        assert (second["subtree_ref"], second["children"]) == (0, [])
+        assert "subtree_ref" not in first
+
+    # SWUT_SERVER_00002: Service responses reference shared subtrees
+    def test_response_grows_with_physical_nodes(self, tmp_path):
+        """Test that a layered graph gives a response of its physical nodes."""
+        source = tmp_path / "layers.c"
+        lines = []
+        for layer in range(8):
+            for idx in range(3):
+                calls = " ".join(f"L{layer + 1}_{n}();" for n in range(3))
+                body = calls if layer < 7 else ""
+                lines.append(f"void L{layer}_{idx}(void) {{ {body} }}")
+        lines.append("void Root(void) { L0_0(); L0_1(); L0_2(); }")
+        source.write_text("\n".join(lines) + "\n")
+        factory = _make_factory(tmp_path, tmp_path / "cache")
+        service = AnalysisService(factory(), factory)
+
+        _, body = service.build_tree("Root", max_depth=9)
+
+        data = json.loads(body)
+        assert data["statistics"]["total_functions"] > 3**8
+        assert body.count('"function": ') <= data["statistics"]["physical_nodes"]
+
+
+class TestAnalysisServerHttp:
+    """Tests: SWUT_SERVER_00002 - HTTP Query Interface"""
+
+    # SWUT_SERVER_00002: Endpoints answer over HTTP
+    def test_http_endpoints(self, demo_service):
+        """Test status, tree and error responses over a local socket."""
+        server = AnalysisServer(demo_service, port=0)
+        thread = threading.Thread(target=server.serve_forever, daemon=True)
+        thread.start()
+        base = f"http://127.0.0.1:{server.server_address[1]}"
+
+        try:
+            with urllib.request.urlopen(f"{base}/status") as response:
+                status = json.loads(response.read())
+            assert status["functions"] == demo_service.db.total_functions_found
+
+            with urllib.request.urlopen(
+                f"{base}/tree?start=Demo_Init&depth=1&format=json"
+            ) as response:
+                tree = json.loads(response.read())
+            assert all(c["depth"] == 1 for c in tree["call_tree"]["children"])
+
+            with pytest.raises(urllib.error.HTTPError) as exc_info:
+                urllib.request.urlopen(f"{base}/tree")
+            assert exc_info.value.code == 400
+
+            with pytest.raises(urllib.error.HTTPError) as exc_info:
+                urllib.request.urlopen(f"{base}/tree?start=Demo_Init&max_nodes=x")
+            assert exc_info.value.code == 400
+
+            with urllib.request.urlopen(
+                f"{base}/search?pattern=demo_&mode=prefix&limit=2"
+            ) as response:
+                assert len(json.loads(response.read())) == 2
+
+            with pytest.raises(urllib.error.HTTPError) as exc_info:
+                urllib.request.urlopen(f"{base}/search?pattern=Demo&limit=many")
+            assert exc_info.value.code == 400
+
+            with pytest.raises(urllib.error.HTTPError) as exc_info:
+                urllib.request.urlopen(f"{base}/unknown")
+            assert exc_info.value.code == 404
+        finally:
+            server.shutdown()
+            server.server_close()
+
+
+class TestSourceWatching:
+    """Tests: SWUT_SERVER_00003 - Source Directory Watching"""
+
+    # SWUT_SERVER_00003: Changed sources replace the database
+    def test_refresh_if_changed(self, tmp_path):
+        """Test that only a changed source tree triggers a rebuild."""
+        source_dir = tmp_path / "src"
+        source_dir.mkdir()
+        (source_dir / "a.c").write_text("void func_a(void) {\n}\n")
+        factory = _make_factory(source_dir, tmp_path / "cache")
+        service = AnalysisService(factory(), factory)
+
+        assert service.refresh_if_changed() is False
+
+        (source_dir / "b.c").write_text("void func_b(void) {\n    func_a();\n}\n")
+        assert service.refresh_if_changed() is True
+        assert service.refresh_count == 1
+        assert "func_b" in service.list_functions()
+        assert service.refresh_if_changed() is False
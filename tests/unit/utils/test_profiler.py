@@ -0,0 +1,114 @@
+"""Tests for utils/profiler.py (SWUT_DB_00044)"""
+
+import io
+import json
+import time
+from contextlib import redirect_stdout
+from pathlib import Path
+
+from autosar_calltree.database.function_database import FunctionDatabase
+from autosar_calltree.utils.profiler import Profiler
+from autosar_calltree.utils.statistics import ProcessingResult
+
+
+class TestProfiler:
+    """Tests: SWUT_DB_00044 - Build Profiling"""
+
+    # SWUT_DB_00044: Stages record wall time, CPU time and bytes
+    def test_stage(self):
+        """Test that a stage is recorded with the updated bytes."""
+        profiler = Profiler()
+        with profiler.stage("parse") as stage:
+            stage.bytes = 42
+
+        assert [event.name for event in profiler.stages] == ["parse"]
+        assert profiler.stages[0].bytes == 42
+        assert profiler.stages[0].wall >= 0.0
+        assert profiler.stages[0].cpu is not None
+
+    # SWUT_DB_00044: A disabled profiler records nothing
+    def test_disabled(self):
+        """Test that a disabled profiler keeps no events."""
+        profiler = Profiler(enabled=False)
+        with profiler.stage("parse"):
+            pass
+        profiler.add_file("parse", Path("a.c"), None, {"read": 1.0})
+
+        assert profiler.stages == [] and profiler.files == []
+
+    # SWUT_DB_00044: Files are ranked by their time over all stages
+    def test_slowest_files(self):
+        """Test that preprocess and parse times of a file are summed."""
+        profiler = Profiler()
+        profiler.add_results(
+            "preprocess",
+            [
+                ProcessingResult(Path("a.c"), True, timings={"cpp": 0.5}),
+                ProcessingResult(Path("b.c"), True, timings={"cpp": 0.1}),
+            ],
+        )
+        profiler.add_results(
+            "parse",
+            [
+                ProcessingResult(
+                    Path("b.c"), True, timings={"pycparser": 1.0}, bytes_processed=7
+                ),
+                ProcessingResult(Path("c.c"), False),
+            ],
+        )
+
+        slowest = profiler.slowest_files(2)
+
+        assert [profile.file for profile in slowest] == ["b.c", "a.c"]
+        assert slowest[0].steps == {"cpp": 0.1, "pycparser": 1.0}
+        assert slowest[0].bytes == 7
+        report = profiler.format_report(top=1)
+        assert "b.c" in report and "a.c" not in report
+        assert "pycparser" in report
+
+    # SWUT_DB_00044: The trace nests the steps of every file
+    def test_chrome_trace(self, tmp_path):
+        """Test the trace events of overlapping files."""
+        profiler = Profiler()
+        start = time.time()
+        profiler.add_file("parse", Path("a.c"), start, {"read": 1.0, "cpp": 1.0})
+        profiler.add_file("parse", Path("b.c"), start + 0.5, {"read": 1.0})
+        path = tmp_path / "out" / "trace.json"
+
+        profiler.write(path)
+        trace = json.loads(path.read_text())
+
+        spans = [e for e in trace["traceEvents"] if e["ph"] == "X"]
+        assert [(e["name"], e["tid"]) for e in spans] == [
+            ("a.c", 1),
+            ("cpp", 1),
+            ("read", 1),
+            ("b.c", 2),
+            ("read", 2),
+        ]
+        assert spans[1]["ts"] == 0.0 and spans[2]["ts"] == 1e6
+        assert len(trace["files"]) == 2
+
+    # SWUT_DB_00044: build_database profiles its stages and files
+    def test_build_database(self, tmp_path):
+        """Test the stages and files of a demo build and a cached rebuild."""
+        profiler = Profiler()
+        db = FunctionDatabase(
+            "./demo", cache_dir=str(tmp_path / "cache"), profiler=profiler
+        )
+        with redirect_stdout(io.StringIO()):
+            db.build_database(use_cache=True, verbose=False)
+
+        names = [event.name for event in profiler.stages]
+        assert names == [
+            "cache_load",
+            "discover",
+            "checksum",
+            "parse",
+            "call_graph",
+            "name_index",
+            "cache_save",
+        ]
+        assert profiler.stages[-1].bytes > 0
+        assert len(profiler.files) == db.total_files_scanned
+        assert all("index" in event.steps for event in profiler.files)
@@ -171,3 +171,17 @@ class TestTreeFormatter:
         assert "main" in result
         assert "child" in result
         assert "grandchild" in result
+
+    def test_format_deep_tree(self, sample_function_info):
+        """Should format trees deeper than the recursion limit."""
+        node = CallTreeNode(function_info=sample_function_info, depth=3000)
+        for depth in range(2999, -1, -1):
+            node = CallTreeNode(
+                function_info=sample_function_info, depth=depth, children=[node]
+            )
+
+        lines = TreeFormatter.format_tree(node, show_file=False).split("\n")
+
+        assert len(lines) == 3001
+        assert lines[1] == "└── main"
+        assert lines[-1] == " " * 4 * 2999 + "└── main"